@@ -193,6 +193,7 @@ static const ModeInfo modeInfoTable[] = {
 
     // QSO Logger items → QSO Logger menu
     { MODE_QSO_LOG_ENTRY, MODE_QSO_LOGGER_MENU, 0, nullptr },
+    { MODE_QSO_CONTEST, MODE_QSO_LOGGER_MENU, 0, nullptr },
     { MODE_QSO_VIEW_LOGS, MODE_QSO_LOGGER_MENU, 0, nullptr },
     { MODE_QSO_STATISTICS, MODE_QSO_LOGGER_MENU, 0, nullptr },
     { MODE_QSO_LOGGER_SETTINGS, MODE_QSO_LOGGER_MENU, 0, nullptr },
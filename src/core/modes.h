@@ -226,7 +226,10 @@ enum MenuMode {
     MODE_SAT_BYPASS = 179,        // Full catalog sorted by next pass
     MODE_SAT_WINDOW_NOW = 180,    // Sky window: next 60 minutes from now
     MODE_SAT_TLE_UPDATE = 181,    // Action pseudo-mode (no screen)
-    MODE_SAT_FREQS = 182          // Full transmitter list for selected bird
+    MODE_SAT_FREQS = 182,         // Full transmitter list for selected bird
+
+    // QSO Logger contest mode (183)
+    MODE_QSO_CONTEST = 183        // Serial/exchange entry with dupe, mult and rate
 };
 
 extern MenuMode currentMode;
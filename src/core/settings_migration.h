@@ -36,6 +36,7 @@
 #include <Preferences.h>
 #include <nvs_flash.h>
 #include "config.h"
+#include "../storage/sd_write_queue.h"
 
 #define SETTINGS_META_NS  "sysmeta"
 #define SETTINGS_VER_KEY  "schemaVer"
@@ -61,6 +62,7 @@ inline void clearNvsNamespaces(const char* const* namespaces, int count) {
 // be recovered even if the UI won't load.
 inline void factoryReset() {
   Serial.println("[Settings] FACTORY RESET - erasing all NVS, rebooting...");
+  flushSDWriteQueue();    // queued SD writes (QSO ADIF mirrors...) are user data
   delay(100);             // let the serial line flush
   nvs_flash_deinit();     // release NVS handles so the erase proceeds cleanly
   esp_err_t err = nvs_flash_erase();
@@ -143,11 +143,12 @@ static const LVMenuItem deviceBTSubmenuItems[] = {
 // QSO Logger submenu items
 static const LVMenuItem qsoLoggerMenuItems[] = {
     MENU_ITEM_LV(LV_SYMBOL_PLUS, "New Log Entry", MODE_QSO_LOG_ENTRY),
+    MENU_ITEM_LV(LV_SYMBOL_SHUFFLE, "Contest Mode", MODE_QSO_CONTEST),
     MENU_ITEM_LV(LV_SYMBOL_LIST, "View Logs", MODE_QSO_VIEW_LOGS),
     MENU_ITEM_LV(LV_SYMBOL_IMAGE, "Statistics", MODE_QSO_STATISTICS),
     MENU_ITEM_LV(LV_SYMBOL_SETTINGS, "Logger Settings", MODE_QSO_LOGGER_SETTINGS)
 };
-#define QSO_LOGGER_COUNT 4
+#define QSO_LOGGER_COUNT 5
 
 // ============================================
 // Screen Objects
@@ -756,7 +756,7 @@ void onLVGLMenuSelect(int target_mode) {
     }
 
     // Check SD card requirement for QSO log entry
-    if (target_mode == MODE_QSO_LOG_ENTRY) {
+    if (target_mode == MODE_QSO_LOG_ENTRY || target_mode == MODE_QSO_CONTEST) {
         // Try to initialize SD card if not already done
         if (!sdCardAvailable) {
             initSDCard();
@@ -918,6 +918,7 @@ static const ModeCallbackEntry cleanupTable[] = {
     { MODE_CW_MEMORIES,                  cleanupCWMemoriesScreen },
     { MODE_RADIO_OUTPUT,                 cleanupRadioOutputScreen },
     { MODE_QSO_LOG_ENTRY,                cleanupQSOEntryScreen },
+    { MODE_QSO_CONTEST,                  cleanupQSOContestScreen },
     { MODE_QSO_VIEW_LOGS,                cleanupQSOViewLogsScreen },
     { MODE_QSO_STATISTICS,               cleanupQSOStatisticsScreen },
     { MODE_QSO_LOGGER_SETTINGS,          cleanupQSOLoggerSettingsScreen },
@@ -1557,6 +1557,7 @@ static lv_obj_t* vail_wpm_label = NULL;
 static lv_obj_t* vail_strip_batt = NULL;    // status strip battery glyph
 static lv_obj_t* vail_strip_wifi = NULL;    // status strip WiFi glyph
 static lv_obj_t* vail_listen_badge = NULL;   // "TX OFF" strip badge when listen-only
+static lv_obj_t* vail_rec_badge = NULL;      // "REC" strip badge while recording the session
 static lv_obj_t* vail_onair_pill = NULL;     // Red "ON AIR" pill, lit while transmitting
 static lv_obj_t* vail_tx_strip_label = NULL; // TX strip text: keying goes out vs local-only
 
@@ -1708,6 +1709,10 @@ static void updateVailFooter() {
         if (vailListenOnly) lv_obj_clear_flag(vail_listen_badge, LV_OBJ_FLAG_HIDDEN);
         else                lv_obj_add_flag(vail_listen_badge, LV_OBJ_FLAG_HIDDEN);
     }
+    if (vail_rec_badge != NULL) {
+        if (mnSessionIsActive()) lv_obj_clear_flag(vail_rec_badge, LV_OBJ_FLAG_HIDDEN);
+        else                     lv_obj_add_flag(vail_rec_badge, LV_OBJ_FLAG_HIDDEN);
+    }
 }
 
 // Update settings display labels
@@ -1986,6 +1991,12 @@ static void vail_key_event_cb(lv_event_t* e) {
                     updateVailFooter();
                     beep(vailListenOnly ? TONE_ERROR : TONE_SUCCESS, BEEP_SHORT);
                     break;
+                case 'm': case 'M':
+                    // Toggle session recording (RX + TX to a Morse Note)
+                    vailToggleSessionRecording();
+                    updateVailFooter();
+                    beep(mnSessionIsActive() ? TONE_SUCCESS : TONE_MENU_NAV, BEEP_SHORT);
+                    break;
                 // Other keys ignored — paddle keying always works in background
                 // regardless of which letter the operator presses.
             }
@@ -2601,6 +2612,7 @@ lv_obj_t* createVailRepeaterScreen() {
     vail_strip_batt = NULL;
     vail_strip_wifi = NULL;
     vail_listen_badge = NULL;
+    vail_rec_badge = NULL;
     vail_onair_pill = NULL;
     vail_tx_strip_label = NULL;
     vail_tile_listen_icon = NULL;
@@ -2675,6 +2687,13 @@ lv_obj_t* createVailRepeaterScreen() {
     lv_obj_align(vail_listen_badge, LV_ALIGN_RIGHT_MID, -136, 0);
     lv_obj_add_flag(vail_listen_badge, LV_OBJ_FLAG_HIDDEN);
 
+    vail_rec_badge = lv_label_create(strip);
+    lv_label_set_text(vail_rec_badge, "REC");
+    lv_obj_set_style_text_font(vail_rec_badge, getThemeFonts()->font_small, 0);
+    lv_obj_set_style_text_color(vail_rec_badge, LV_COLOR_ERROR, 0);
+    lv_obj_align(vail_rec_badge, LV_ALIGN_RIGHT_MID, -196, 0);
+    lv_obj_add_flag(vail_rec_badge, LV_OBJ_FLAG_HIDDEN);
+
     vail_status_label = NULL;
 
     // Main content area: everything below the strip (panes + tile row)
@@ -3172,6 +3191,7 @@ void cleanupVailRepeaterScreen() {
     vail_strip_batt = NULL;
     vail_strip_wifi = NULL;
     vail_listen_badge = NULL;
+    vail_rec_badge = NULL;
     vail_onair_pill = NULL;
     vail_tx_strip_label = NULL;
     vail_tile_listen_icon = NULL;
@@ -3206,6 +3226,7 @@ void cleanupVailRepeaterScreen() {
 
 static lv_obj_t* qso_entry_screen = NULL;
 static lv_obj_t* qso_entry_focus_container = NULL;
+static lv_obj_t* qso_call_label = NULL;
 static lv_obj_t* qso_callsign_input = NULL;
 static lv_obj_t* qso_freq_input = NULL;
 static lv_obj_t* qso_mode_row = NULL;
@@ -3228,7 +3249,7 @@ static const int QSO_ENTRY_FIELD_COUNT = 10;  // Total navigable fields
 
 // Forward declarations for QSO operations
 extern Preferences qsoPrefs;
-extern bool saveQSO(const QSO& qso);
+extern bool saveQSO(QSO& qso);
 extern String frequencyToBand(float freq);
 extern String getDefaultRST(const char* mode);
 extern void formatCurrentDateTime(char* dateOut, char* timeOut);
@@ -3262,6 +3283,31 @@ static void loadOperatorSettingsToForm() {
     }
 }
 
+// Show dupe / worked-before status next to the callsign label
+static void updateQSOEntryDupeStatus() {
+    if (qso_call_label == NULL || qso_callsign_input == NULL) return;
+
+    const char* callsign = lv_textarea_get_text(qso_callsign_input);
+    String band = frequencyToBand(atof(lv_textarea_get_text(qso_freq_input)) / 1000.0);
+    QSODupeStatus status = checkQSODupe(callsign, band.c_str(),
+                                        qso_mode_names[qso_entry_mode_index],
+                                        lv_textarea_get_text(qso_date_input));
+
+    if (status == QSO_DUPE_NEW) {
+        lv_label_set_text(qso_call_label, strlen(callsign) >= 3 ? "Callsign *   New" : "Callsign *");
+        lv_obj_set_style_text_color(qso_call_label,
+            strlen(callsign) >= 3 ? LV_COLOR_SUCCESS : LV_COLOR_TEXT_SECONDARY, 0);
+    } else {
+        lv_label_set_text_fmt(qso_call_label, "Callsign *   %s", qsoDupeStatusText(status));
+        lv_obj_set_style_text_color(qso_call_label,
+            status == QSO_DUPE_DUPE ? LV_COLOR_ERROR : LV_COLOR_WARNING, 0);
+    }
+}
+
+static void qso_entry_changed_cb(lv_event_t* e) {
+    updateQSOEntryDupeStatus();
+}
+
 // Update mode display and RST defaults
 static void updateQSOEntryMode() {
     if (qso_mode_label != NULL) {
@@ -3276,6 +3322,8 @@ static void updateQSOEntryMode() {
     if (qso_rst_rcvd_input != NULL) {
         lv_textarea_set_text(qso_rst_rcvd_input, defaultRST.c_str());
     }
+
+    updateQSOEntryDupeStatus();
 }
 
 // Update focus to the current field
@@ -3470,10 +3518,10 @@ lv_obj_t* createQSOLogEntryScreen() {
     lv_obj_set_scrollbar_mode(form, LV_SCROLLBAR_MODE_AUTO);
 
     // Row 1: Callsign
-    lv_obj_t* call_label = lv_label_create(form);
-    lv_label_set_text(call_label, "Callsign *");
-    lv_obj_set_style_text_color(call_label, LV_COLOR_TEXT_SECONDARY, 0);
-    lv_obj_set_style_text_font(call_label, getThemeFonts()->font_small, 0);
+    qso_call_label = lv_label_create(form);
+    lv_label_set_text(qso_call_label, "Callsign *");
+    lv_obj_set_style_text_color(qso_call_label, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(qso_call_label, getThemeFonts()->font_small, 0);
 
     qso_callsign_input = lv_textarea_create(form);
     lv_obj_set_size(qso_callsign_input, lv_pct(100), 35);
@@ -3482,6 +3530,7 @@ lv_obj_t* createQSOLogEntryScreen() {
     lv_textarea_set_placeholder_text(qso_callsign_input, "W1ABC");
     applyTextareaStyle(qso_callsign_input);
     lv_obj_add_event_cb(qso_callsign_input, qso_entry_key_cb, LV_EVENT_KEY, NULL);
+    lv_obj_add_event_cb(qso_callsign_input, qso_entry_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
     addNavigableWidget(qso_callsign_input);
 
     // Row 2: Frequency + Mode (side by side)
@@ -3518,6 +3567,7 @@ lv_obj_t* createQSOLogEntryScreen() {
     lv_textarea_set_text(qso_freq_input, "7030");
     applyTextareaStyle(qso_freq_input);
     lv_obj_add_event_cb(qso_freq_input, qso_entry_key_cb, LV_EVENT_KEY, NULL);
+    lv_obj_add_event_cb(qso_freq_input, qso_entry_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
     addNavigableWidget(qso_freq_input);
 
     // Mode column
@@ -3653,6 +3703,7 @@ lv_obj_t* createQSOLogEntryScreen() {
     lv_textarea_set_max_length(qso_date_input, 8);
     applyTextareaStyle(qso_date_input);
     lv_obj_add_event_cb(qso_date_input, qso_entry_key_cb, LV_EVENT_KEY, NULL);
+    lv_obj_add_event_cb(qso_date_input, qso_entry_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
     addNavigableWidget(qso_date_input);
 
     // Time column
@@ -3793,6 +3844,7 @@ lv_obj_t* createQSOLogEntryScreen() {
 void cleanupQSOEntryScreen() {
     qso_entry_screen = NULL;
     qso_entry_focus_container = NULL;
+    qso_call_label = NULL;
     qso_callsign_input = NULL;
     qso_freq_input = NULL;
     qso_mode_row = NULL;
@@ -3806,6 +3858,490 @@ void cleanupQSOEntryScreen() {
     qso_notes_input = NULL;
 }
 
+// ============================================
+// QSO Contest Screen
+// One-line exchange entry with serials, dupe/mult check and rate meter
+// ============================================
+
+static lv_obj_t* contest_screen = NULL;
+static lv_obj_t* contest_title_label = NULL;
+static lv_obj_t* contest_exchange_input = NULL;
+static lv_obj_t* contest_status_label = NULL;
+static lv_obj_t* contest_freq_input = NULL;
+static lv_obj_t* contest_mode_row = NULL;
+static lv_obj_t* contest_mode_label = NULL;
+static lv_obj_t* contest_name_input = NULL;
+static lv_obj_t* contest_sent_input = NULL;
+static lv_obj_t* contest_mult_row = NULL;
+static lv_obj_t* contest_mult_label = NULL;
+static lv_obj_t* contest_perband_row = NULL;
+static lv_obj_t* contest_perband_label = NULL;
+static lv_obj_t* contest_serial_row = NULL;
+static lv_obj_t* contest_serial_label = NULL;
+static lv_obj_t* contest_stats_label = NULL;
+static lv_obj_t* contest_last_label = NULL;
+static lv_timer_t* contest_rate_timer = NULL;
+
+static int contest_mode_index = 0;  // Index into qso_mode_names
+static int contest_focus = 0;
+static const int CONTEST_FIELD_COUNT = 8;
+
+// Multiplier rule names, indexed by ContestMultType
+static const char* contest_mult_names[] = {"None", "Exch", "Prefix"};
+static const int contest_mult_count = 3;
+
+// Show the multiplier / per-band / received-number rules
+static void updateContestRuleLabels() {
+    if (contest_mult_label == NULL) return;
+    int mult = contest.cfg.multType < contest_mult_count ? contest.cfg.multType : 0;
+    lv_label_set_text_fmt(contest_mult_label, "< %s >", contest_mult_names[mult]);
+    lv_label_set_text_fmt(contest_perband_label, "< %s >", contest.cfg.multPerBand ? "Yes" : "No");
+    lv_label_set_text_fmt(contest_serial_label, "< %s >", contest.cfg.serialExchange ? "Serial" : "Text");
+}
+
+// Band of the frequency field
+static String contestCurrentBand() {
+    return frequencyToBand(atof(lv_textarea_get_text(contest_freq_input)) / 1000.0);
+}
+
+// Title, QSO/mult totals, next serial and rate meter
+static void updateContestStats() {
+    if (contest_stats_label == NULL) return;
+
+    if (contest_title_label != NULL) {
+        lv_label_set_text_fmt(contest_title_label, "CONTEST: %s", contest.cfg.name);
+    }
+
+    char dateStr[12] = "", timeStr[8] = "";
+    formatCurrentDateTime(dateStr, timeStr);
+    int rate10 = 0, rate60 = 0;
+    contestGetRates(qsoDateTimeToEpoch(dateStr, timeStr), rate10, rate60);
+
+    lv_label_set_text_fmt(contest_stats_label,
+        "QSOs %u   Mults %u   Next #%03d   Rate %d/hr (10m)  %d/hr (60m)",
+        (unsigned)contest.qsoCount, (unsigned)contest.mults.live, contest.nextSerial,
+        rate10, rate60);
+}
+
+// Parse the exchange line and show dupe / new mult status
+static void updateContestStatus() {
+    if (contest_status_label == NULL || contest_exchange_input == NULL) return;
+
+    ContestExchange ex;
+    contestParseExchange(lv_textarea_get_text(contest_exchange_input), ex);
+    if (ex.callsign[0] == '\0') {
+        lv_label_set_text(contest_status_label, "CALL [RST] [NR] [EXCH]");
+        lv_obj_set_style_text_color(contest_status_label, LV_COLOR_TEXT_SECONDARY, 0);
+        return;
+    }
+
+    ContestCheck check;
+    String band = contestCurrentBand();
+    contestCheck(ex, band.c_str(), qso_mode_names[contest_mode_index], check);
+
+    char parsed[48];
+    if (ex.serial > 0) {
+        snprintf(parsed, sizeof(parsed), "%s  #%03d %s", ex.callsign, ex.serial, ex.exchange);
+    } else {
+        snprintf(parsed, sizeof(parsed), "%s  %s", ex.callsign, ex.exchange);
+    }
+
+    if (check.dupe) {
+        lv_label_set_text_fmt(contest_status_label, "%s   DUPE", parsed);
+        lv_obj_set_style_text_color(contest_status_label, LV_COLOR_ERROR, 0);
+    } else if (check.newMult) {
+        lv_label_set_text_fmt(contest_status_label, "%s   NEW MULT %s", parsed, check.mult);
+        lv_obj_set_style_text_color(contest_status_label, LV_COLOR_WARNING, 0);
+    } else {
+        lv_label_set_text(contest_status_label, parsed);
+        lv_obj_set_style_text_color(contest_status_label, LV_COLOR_SUCCESS, 0);
+    }
+}
+
+static void contest_changed_cb(lv_event_t* e) {
+    updateContestStatus();
+}
+
+static void contest_rate_timer_cb(lv_timer_t* timer) {
+    updateContestStats();
+}
+
+// Apply contest name / sent exchange when leaving those fields
+static void contestApplySettings() {
+    const char* name = lv_textarea_get_text(contest_name_input);
+    if (strlen(name) > 0 && strcasecmp(name, contest.cfg.name) != 0) {
+        // New name starts a new contest: serials, dupes and mults reset
+        startContest(name);
+        lv_textarea_set_text(contest_name_input, contest.cfg.name);
+    }
+
+    const char* sent = lv_textarea_get_text(contest_sent_input);
+    if (strcmp(sent, contest.cfg.sentExchange) != 0) {
+        strlcpy(contest.cfg.sentExchange, sent, sizeof(contest.cfg.sentExchange));
+        saveContestConfig();
+    }
+
+    updateContestStats();
+    updateContestStatus();
+}
+
+static void contest_update_focus() {
+    lv_obj_t* fields[] = {
+        contest_exchange_input,
+        contest_freq_input,
+        contest_mode_row,
+        contest_name_input,
+        contest_sent_input,
+        contest_mult_row,
+        contest_perband_row,
+        contest_serial_row
+    };
+
+    lv_group_t* group = getLVGLInputGroup();
+    if (group && contest_focus >= 0 && contest_focus < CONTEST_FIELD_COUNT) {
+        lv_group_focus_obj(fields[contest_focus]);
+    }
+}
+
+// Log the current exchange line
+static void contestLogCurrent() {
+    ContestExchange ex;
+    contestParseExchange(lv_textarea_get_text(contest_exchange_input), ex);
+    if (strlen(ex.callsign) < 3) {
+        beep(600, 100);  // Error - need callsign
+        return;
+    }
+
+    float freqMHz = atof(lv_textarea_get_text(contest_freq_input)) / 1000.0;
+    QSO qso;
+    if (!contestLogQSO(ex, freqMHz, qso_mode_names[contest_mode_index], qso)) {
+        beep(400, 200);  // Error beep
+        lv_obj_t* msgbox = lv_msgbox_create(NULL, "Save Failed",
+            "Could not log QSO.\nCheck SD card and clock.", NULL, true);
+        lv_obj_center(msgbox);
+        return;
+    }
+
+    beep(1000, 50);
+    char rcvd[16];
+    if (qso.srx > 0) snprintf(rcvd, sizeof(rcvd), "#%03d %s", qso.srx, qso.srx_string);
+    else strlcpy(rcvd, qso.srx_string, sizeof(rcvd));
+    lv_label_set_text_fmt(contest_last_label, "Last: %s %s %s  sent #%03d  rcvd %s",
+                          qso.time_on, qso.band, qso.callsign, qso.stx, rcvd);
+    lv_textarea_set_text(contest_exchange_input, "");
+    updateContestStats();
+    updateContestStatus();
+}
+
+static void contest_key_cb(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_KEY) return;
+
+    uint32_t key = lv_event_get_key(e);
+    bool onSettings = (contest_focus >= 3);
+
+    if (key == LV_KEY_ESC) {
+        if (onSettings) contestApplySettings();
+        lv_event_stop_processing(e);
+        lv_event_stop_bubbling(e);  // Prevent global_esc_handler from also firing
+        onLVGLBackNavigation();
+        return;
+    }
+
+    if (onSettings && (key == LV_KEY_UP || key == LV_KEY_DOWN ||
+                       key == LV_KEY_NEXT || key == LV_KEY_ENTER)) {
+        contestApplySettings();
+    }
+
+    if (key == LV_KEY_UP) {
+        lv_event_stop_bubbling(e);
+        if (contest_focus > 0) {
+            contest_focus--;
+            contest_update_focus();
+            beep(TONE_MENU_NAV, BEEP_SHORT);
+        }
+        return;
+    }
+
+    if (key == LV_KEY_DOWN || key == LV_KEY_NEXT) {
+        lv_event_stop_bubbling(e);
+        if (contest_focus < CONTEST_FIELD_COUNT - 1) {
+            contest_focus++;
+            contest_update_focus();
+            beep(TONE_MENU_NAV, BEEP_SHORT);
+        }
+        return;
+    }
+
+    // LEFT/RIGHT on mode selector (field index 2)
+    if (contest_focus == 2 && (key == LV_KEY_LEFT || key == LV_KEY_RIGHT)) {
+        int step = (key == LV_KEY_LEFT) ? qso_mode_count - 1 : 1;
+        contest_mode_index = (contest_mode_index + step) % qso_mode_count;
+        lv_label_set_text_fmt(contest_mode_label, "< %s >", qso_mode_names[contest_mode_index]);
+        updateContestStatus();
+        lv_event_stop_bubbling(e);
+        return;
+    }
+
+    // LEFT/RIGHT on the rule selectors (field indexes 5-7)
+    if (contest_focus >= 5 && (key == LV_KEY_LEFT || key == LV_KEY_RIGHT)) {
+        uint8_t mult = contest.cfg.multType;
+        bool perBand = contest.cfg.multPerBand;
+        bool serial = contest.cfg.serialExchange;
+        if (contest_focus == 5) {
+            int step = (key == LV_KEY_LEFT) ? contest_mult_count - 1 : 1;
+            mult = (mult + step) % contest_mult_count;
+        } else if (contest_focus == 6) {
+            perBand = !perBand;
+        } else {
+            serial = !serial;
+        }
+        setContestRules(mult, perBand, serial);
+        updateContestRuleLabels();
+        updateContestStats();
+        updateContestStatus();
+        lv_event_stop_bubbling(e);
+        return;
+    }
+
+    if (key == LV_KEY_ENTER) {
+        lv_event_stop_bubbling(e);
+        if (contest_focus == 0) {
+            contestLogCurrent();
+        } else {
+            // ENTER on a settings field returns to the exchange line
+            contest_focus = 0;
+            contest_update_focus();
+        }
+        return;
+    }
+
+    lv_event_stop_bubbling(e);
+}
+
+// Label + one-line textarea in a column
+static lv_obj_t* createContestField(lv_obj_t* parent, const char* title, lv_coord_t width,
+                                    int maxLen, const char* placeholder) {
+    lv_obj_t* col = lv_obj_create(parent);
+    lv_obj_set_size(col, width, LV_SIZE_CONTENT);
+    lv_obj_set_layout(col, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(col, 3, 0);
+    lv_obj_set_style_bg_opa(col, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(col, 0, 0);
+    lv_obj_set_style_pad_all(col, 0, 0);
+    lv_obj_clear_flag(col, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* label = lv_label_create(col);
+    lv_label_set_text(label, title);
+    lv_obj_set_style_text_color(label, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(label, getThemeFonts()->font_small, 0);
+
+    lv_obj_t* ta = lv_textarea_create(col);
+    lv_obj_set_size(ta, lv_pct(100), 35);
+    lv_textarea_set_one_line(ta, true);
+    lv_textarea_set_max_length(ta, maxLen);
+    if (placeholder) lv_textarea_set_placeholder_text(ta, placeholder);
+    applyTextareaStyle(ta);
+    lv_obj_add_event_cb(ta, contest_key_cb, LV_EVENT_KEY, NULL);
+    addNavigableWidget(ta);
+    return ta;
+}
+
+static lv_obj_t* createContestRow(lv_obj_t* parent) {
+    lv_obj_t* row = lv_obj_create(parent);
+    lv_obj_set_size(row, lv_pct(100), LV_SIZE_CONTENT);
+    lv_obj_set_layout(row, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+    lv_obj_set_style_pad_column(row, 15, 0);
+    lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(row, 0, 0);
+    lv_obj_set_style_pad_all(row, 0, 0);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+    return row;
+}
+
+// Titled "< value >" selector in a column (LEFT/RIGHT change it)
+static lv_obj_t* createContestSelector(lv_obj_t* parent, const char* title, lv_coord_t width,
+                                       lv_obj_t** labelOut) {
+    lv_obj_t* col = lv_obj_create(parent);
+    lv_obj_set_size(col, width, LV_SIZE_CONTENT);
+    lv_obj_set_layout(col, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(col, 3, 0);
+    lv_obj_set_style_bg_opa(col, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(col, 0, 0);
+    lv_obj_set_style_pad_all(col, 0, 0);
+    lv_obj_clear_flag(col, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* label = lv_label_create(col);
+    lv_label_set_text(label, title);
+    lv_obj_set_style_text_color(label, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(label, getThemeFonts()->font_small, 0);
+
+    lv_obj_t* row = lv_obj_create(col);
+    lv_obj_set_size(row, lv_pct(100), 35);
+    lv_obj_set_style_bg_color(row, LV_COLOR_BG_LAYER2, 0);
+    lv_obj_set_style_radius(row, 6, 0);
+    lv_obj_set_style_border_width(row, 1, 0);
+    lv_obj_set_style_border_color(row, LV_COLOR_BORDER_SUBTLE, 0);
+    lv_obj_set_style_pad_all(row, 5, 0);
+    lv_obj_set_style_border_color(row, LV_COLOR_ACCENT_PRIMARY, LV_STATE_FOCUSED);
+    lv_obj_set_style_border_width(row, 2, LV_STATE_FOCUSED);
+    lv_obj_set_style_outline_color(row, LV_COLOR_ACCENT_PRIMARY, LV_STATE_FOCUSED);
+    lv_obj_set_style_outline_width(row, 2, LV_STATE_FOCUSED);
+    lv_obj_set_style_outline_opa(row, LV_OPA_50, LV_STATE_FOCUSED);
+    lv_obj_clear_flag(row, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(row, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(row, contest_key_cb, LV_EVENT_KEY, NULL);
+    addNavigableWidget(row);
+
+    *labelOut = lv_label_create(row);
+    lv_obj_set_style_text_font(*labelOut, getThemeFonts()->font_body, 0);
+    lv_obj_center(*labelOut);
+    return row;
+}
+
+lv_obj_t* createQSOContestScreen() {
+    clearNavigationGroup();
+
+    // Rebuild serial counter, dupes and mults for the configured contest
+    openContest();
+
+    lv_obj_t* screen = createScreen();
+    applyScreenStyle(screen);
+
+    contest_mode_index = 0;
+
+    // Title bar
+    lv_obj_t* title_bar = lv_obj_create(screen);
+    lv_obj_set_size(title_bar, SCREEN_WIDTH, HEADER_HEIGHT);
+    lv_obj_set_pos(title_bar, 0, 0);
+    lv_obj_add_style(title_bar, getStyleStatusBar(), 0);
+    lv_obj_clear_flag(title_bar, LV_OBJ_FLAG_SCROLLABLE);
+
+    contest_title_label = lv_label_create(title_bar);
+    lv_obj_add_style(contest_title_label, getStyleLabelTitle(), 0);
+    lv_obj_align(contest_title_label, LV_ALIGN_LEFT_MID, 15, 0);
+
+    createCompactStatusBar(screen);
+
+    lv_obj_t* form = lv_obj_create(screen);
+    lv_obj_set_size(form, SCREEN_WIDTH - 20, SCREEN_HEIGHT - HEADER_HEIGHT - FOOTER_HEIGHT - 10);
+    lv_obj_set_pos(form, 10, HEADER_HEIGHT + 5);
+    lv_obj_set_layout(form, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(form, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_row(form, 6, 0);
+    lv_obj_set_style_pad_all(form, 10, 0);
+    lv_obj_set_style_bg_opa(form, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(form, 0, 0);
+    lv_obj_add_flag(form, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_scrollbar_mode(form, LV_SCROLLBAR_MODE_AUTO);
+
+    // Rate / totals line
+    contest_stats_label = lv_label_create(form);
+    lv_obj_set_style_text_color(contest_stats_label, LV_COLOR_ACCENT_PRIMARY, 0);
+    lv_obj_set_style_text_font(contest_stats_label, getThemeFonts()->font_small, 0);
+
+    // Exchange line
+    contest_status_label = lv_label_create(form);
+    lv_obj_set_style_text_font(contest_status_label, getThemeFonts()->font_small, 0);
+
+    contest_exchange_input = lv_textarea_create(form);
+    lv_obj_set_size(contest_exchange_input, lv_pct(100), 35);
+    lv_textarea_set_one_line(contest_exchange_input, true);
+    lv_textarea_set_max_length(contest_exchange_input, 40);
+    lv_textarea_set_placeholder_text(contest_exchange_input, "W1ABC 599 123");
+    applyTextareaStyle(contest_exchange_input);
+    lv_obj_add_event_cb(contest_exchange_input, contest_key_cb, LV_EVENT_KEY, NULL);
+    lv_obj_add_event_cb(contest_exchange_input, contest_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    addNavigableWidget(contest_exchange_input);
+
+    contest_last_label = lv_label_create(form);
+    lv_label_set_text(contest_last_label, "");
+    lv_obj_set_style_text_color(contest_last_label, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(contest_last_label, getThemeFonts()->font_small, 0);
+
+    // Frequency + Mode
+    lv_obj_t* radio_row = createContestRow(form);
+    contest_freq_input = createContestField(radio_row, "Frequency (kHz)", lv_pct(55), 10, NULL);
+    lv_textarea_set_text(contest_freq_input, "7030");
+    lv_obj_add_event_cb(contest_freq_input, contest_changed_cb, LV_EVENT_VALUE_CHANGED, NULL);
+
+    contest_mode_row = createContestSelector(radio_row, "Mode", lv_pct(40), &contest_mode_label);
+    lv_label_set_text_fmt(contest_mode_label, "< %s >", qso_mode_names[contest_mode_index]);
+
+    // Contest name + sent exchange
+    lv_obj_t* settings_row = createContestRow(form);
+    contest_name_input = createContestField(settings_row, "Contest (new name = new log)",
+                                            lv_pct(55), 30, "CQ-WPX-CW");
+    lv_textarea_set_text(contest_name_input, contest.cfg.name);
+
+    contest_sent_input = createContestField(settings_row, "Sent Exch", lv_pct(40), 10, "CT");
+    lv_textarea_set_text(contest_sent_input, contest.cfg.sentExchange);
+
+    // Multiplier and received-number rules
+    lv_obj_t* rules_row = createContestRow(form);
+    contest_mult_row = createContestSelector(rules_row, "Mults", lv_pct(35), &contest_mult_label);
+    contest_perband_row = createContestSelector(rules_row, "Per Band", lv_pct(25), &contest_perband_label);
+    contest_serial_row = createContestSelector(rules_row, "Rcvd Nr", lv_pct(30), &contest_serial_label);
+    updateContestRuleLabels();
+
+    // Footer
+    lv_obj_t* footer = lv_obj_create(screen);
+    lv_obj_set_size(footer, SCREEN_WIDTH, FOOTER_HEIGHT);
+    lv_obj_set_pos(footer, 0, SCREEN_HEIGHT - FOOTER_HEIGHT);
+    lv_obj_set_style_bg_opa(footer, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(footer, 0, 0);
+    lv_obj_clear_flag(footer, LV_OBJ_FLAG_SCROLLABLE);
+
+    lv_obj_t* help = lv_label_create(footer);
+    lv_label_set_text(help, LV_SYMBOL_UP LV_SYMBOL_DOWN " Navigate   " LV_SYMBOL_LEFT LV_SYMBOL_RIGHT " Change   ENTER Log   ESC Exit");
+    lv_obj_set_style_text_color(help, LV_COLOR_WARNING, 0);
+    lv_obj_set_style_text_font(help, getThemeFonts()->font_small, 0);
+    lv_obj_center(help);
+
+    updateContestStats();
+    updateContestStatus();
+
+    // Rates decay while no QSOs are logged
+    contest_rate_timer = lv_timer_create(contest_rate_timer_cb, 10000, NULL);
+
+    contest_focus = 0;
+    lv_group_t* group = getLVGLInputGroup();
+    if (group) {
+        lv_group_focus_obj(contest_exchange_input);
+    }
+
+    contest_screen = screen;
+    return screen;
+}
+
+// Stop the rate timer and reset widget pointers on back-navigation
+void cleanupQSOContestScreen() {
+    if (contest_rate_timer != NULL) {
+        lv_timer_del(contest_rate_timer);
+        contest_rate_timer = NULL;
+    }
+    contest_screen = NULL;
+    contest_title_label = NULL;
+    contest_exchange_input = NULL;
+    contest_status_label = NULL;
+    contest_freq_input = NULL;
+    contest_mode_row = NULL;
+    contest_mode_label = NULL;
+    contest_name_input = NULL;
+    contest_sent_input = NULL;
+    contest_mult_row = NULL;
+    contest_mult_label = NULL;
+    contest_perband_row = NULL;
+    contest_perband_label = NULL;
+    contest_serial_row = NULL;
+    contest_serial_label = NULL;
+    contest_stats_label = NULL;
+    contest_last_label = NULL;
+}
+
 // ============================================
 // QSO Save Confirmation Screen
 // Shows summary of saved QSO with options
@@ -5015,7 +5551,7 @@ lv_obj_t* createQSOStatisticsScreen() {
     lv_obj_t* screen = createScreen();
     applyScreenStyle(screen);
 
-    // Calculate statistics from QSO files
+    // Read statistics from the maintained aggregates
     calculateStatistics();
 
     // Title bar
@@ -5155,6 +5691,27 @@ lv_obj_t* createQSOStatisticsScreen() {
         lv_obj_set_style_text_font(qso_stats_last_label, getThemeFonts()->font_body, 0);
         lv_obj_align(qso_stats_last_label, LV_ALIGN_BOTTOM_LEFT, 0, 0);
 
+        // Card 5: Countries (only when QSOs carry a country)
+        if (stats.countryCount > 0) {
+            lv_obj_t* country_card = lv_obj_create(cards_row);
+            lv_obj_set_size(country_card, 210, 55);
+            applyCardStyle(country_card);
+            lv_obj_set_style_pad_all(country_card, 8, 0);
+            lv_obj_clear_flag(country_card, LV_OBJ_FLAG_SCROLLABLE);
+
+            lv_obj_t* country_title = lv_label_create(country_card);
+            lv_label_set_text(country_title, "Countries");
+            lv_obj_set_style_text_color(country_title, LV_COLOR_TEXT_SECONDARY, 0);
+            lv_obj_set_style_text_font(country_title, getThemeFonts()->font_small, 0);
+            lv_obj_align(country_title, LV_ALIGN_TOP_LEFT, 0, 0);
+
+            lv_obj_t* country_label = lv_label_create(country_card);
+            lv_label_set_text_fmt(country_label, stats.countriesTruncated ? "%d+" : "%d", stats.countryCount);
+            lv_obj_set_style_text_color(country_label, LV_COLOR_TEXT_PRIMARY, 0);
+            lv_obj_set_style_text_font(country_label, getThemeFonts()->font_subtitle, 0);
+            lv_obj_align(country_label, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+        }
+
         // Bands section
         if (stats.bandCount > 0) {
             lv_obj_t* bands_section = lv_obj_create(qso_stats_scroll_container);
@@ -5171,7 +5728,7 @@ lv_obj_t* createQSOStatisticsScreen() {
             lv_obj_set_style_text_color(bands_title, LV_COLOR_ACCENT_PRIMARY, 0);
             lv_obj_set_style_text_font(bands_title, getThemeFonts()->font_body, 0);
 
-            for (int i = 0; i < stats.bandCount && i < 10; i++) {
+            for (int i = 0; i < stats.bandCount; i++) {
                 lv_obj_t* band_row = lv_obj_create(bands_section);
                 lv_obj_set_size(band_row, lv_pct(100), 20);
                 lv_obj_set_style_bg_opa(band_row, LV_OPA_TRANSP, 0);
@@ -5219,7 +5776,7 @@ lv_obj_t* createQSOStatisticsScreen() {
             lv_obj_set_style_text_color(modes_title, LV_COLOR_SUCCESS, 0);
             lv_obj_set_style_text_font(modes_title, getThemeFonts()->font_body, 0);
 
-            for (int i = 0; i < stats.modeCount && i < 8; i++) {
+            for (int i = 0; i < stats.modeCount; i++) {
                 lv_obj_t* mode_row = lv_obj_create(modes_section);
                 lv_obj_set_size(mode_row, lv_pct(100), 20);
                 lv_obj_set_style_bg_opa(mode_row, LV_OPA_TRANSP, 0);
@@ -5324,6 +5881,7 @@ extern ViewState viewState;
 extern void loadQSOsForView();
 extern void freeQSOsFromView();
 extern bool deleteCurrentQSO();
+extern const QSO* getViewQSO(int index);
 
 // Forward declarations for detail screen
 static void qso_detail_key_cb(lv_event_t* e);
@@ -5368,12 +5926,13 @@ static void qso_delete_msgbox_key_cb(lv_event_t* e);
 // Show QSO detail as a popup modal on the current screen
 void showQSODetailPopup(int qsoIndex) {
     // Validate input
-    if (qsoIndex < 0 || qsoIndex >= viewState.totalQSOs || viewState.qsos == nullptr) {
+    const QSO* qsoPtr = getViewQSO(qsoIndex);
+    if (qsoPtr == nullptr) {
         return;
     }
 
     qso_detail_index = qsoIndex;
-    QSO& qso = viewState.qsos[qsoIndex];
+    const QSO& qso = *qsoPtr;
 
     // Close any existing popup
     if (qso_detail_popup != NULL) {
@@ -5462,8 +6021,8 @@ static void qso_popup_key_cb(lv_event_t* e) {
 
     if (key == 'D' || key == 'd') {
         // Show delete confirmation
-        if (qso_detail_index >= 0 && qso_detail_index < viewState.totalQSOs) {
-            const QSO* qso = &viewState.qsos[qso_detail_index];
+        const QSO* qso = getViewQSO(qso_detail_index);
+        if (qso != nullptr) {
             snprintf(qso_detail_fmt_buf, sizeof(qso_detail_fmt_buf),
                      "Delete %s?", qso->callsign);
 
@@ -5619,7 +6178,7 @@ static void view_logs_key_cb(lv_event_t* e) {
 
     // Enter - defer screen creation to avoid stack overflow in callback
     if (key == LV_KEY_ENTER) {
-        if (viewState.totalQSOs > 0 && viewState.qsos != nullptr) {
+        if (viewState.totalQSOs > 0) {
             // Set flag for deferred creation in main loop
             qso_pending_detail_index = view_logs_selected;
         }
@@ -5650,7 +6209,12 @@ static void rebuildViewLogsList() {
 
     for (int i = 0; i < visibleCount; i++) {
         int qsoIndex = view_logs_scroll_offset + i;
-        QSO& qso = viewState.qsos[qsoIndex];
+        const QSO* qsoPtr = getViewQSO(qsoIndex);
+        if (qsoPtr == nullptr) {
+            view_logs_rows[i] = NULL;
+            continue;
+        }
+        const QSO& qso = *qsoPtr;
 
         // Create row container
         lv_obj_t* row = lv_obj_create(view_logs_list_container);
@@ -5819,6 +6383,8 @@ lv_obj_t* createModeScreenForMode(int mode) {
             return createBTMIDIScreen();
         case MODE_QSO_LOG_ENTRY:
             return createQSOLogEntryScreen();
+        case MODE_QSO_CONTEST:
+            return createQSOContestScreen();
         case MODE_QSO_VIEW_LOGS:
             return createQSOViewLogsScreen();
         case MODE_QSO_STATISTICS:
@@ -10,6 +10,7 @@
 #include "../morse_notes/morse_notes_storage.h"
 #include "../morse_notes/morse_notes_recorder.h"
 #include "../morse_notes/morse_notes_playback.h"
+#include "../morse_notes/morse_notes_transcript.h"
 #include "../keyer/keyer.h"
 
 // Forward declarations
@@ -33,6 +34,15 @@ static lv_obj_t* mnLibraryItems[MN_MAX_RECORDINGS];
 static int mnLibraryItemCount = 0;
 static lv_obj_t* mnLibraryList = nullptr;
 static unsigned long mnSelectedRecordingId = 0;
+static unsigned long mnSelectedSeekMs = 0;         // Playback starts here (search hit)
+
+// Transcript search on the list screen
+static lv_obj_t* mnListTitleLabel = nullptr;
+static char mnSearchQuery[32] = "";
+static bool mnSearchDirty = false;                 // Query edited since the last search
+static bool mnSearchShowing = false;               // List holds search hits
+static MorseNoteSearchHit mnSearchHits[MN_SEARCH_MAX_HITS];
+static int mnSearchHitCount = 0;
 
 // Record screen widgets
 static lv_obj_t* mnRecordBtn = nullptr;
@@ -80,6 +90,10 @@ extern void (*morseNotesKeyCallback)(bool keyDown, unsigned long timestamp);
 // LIBRARY SCREEN - NAVIGATION HANDLERS
 // ===================================
 
+// Forward declarations
+static int mnAppendLibraryPage();
+static void mnRebuildLibraryList(void* unused);
+
 /**
  * List navigation
  */
@@ -113,10 +127,47 @@ static void mnLibraryListNavHandler(lv_event_t* e) {
     }
 
     if (currentIndex < 0) return;
+
+    // Load the next page when moving past the last loaded row
+    if (key == LV_KEY_DOWN && currentIndex == mnLibraryItemCount - 1 && !mnSearchShowing &&
+        mnLibraryItemCount < mnGetLibraryCount()) {
+        if (mnAppendLibraryPage() > 0) {
+            lv_group_focus_obj(mnLibraryItems[currentIndex + 1]);
+            lv_obj_scroll_to_view(mnLibraryItems[currentIndex + 1], LV_ANIM_ON);
+        }
+        lv_event_stop_processing(e);
+    }
+}
+
+/**
+ * List header: title, the query being typed, or the search result count
+ */
+static void mnUpdateListTitle() {
+    if (!mnListTitleLabel) return;
+    char buf[64];
+    if (mnSearchQuery[0] != '\0' && (mnSearchDirty || !mnSearchShowing)) {
+        snprintf(buf, sizeof(buf), "Search: %s_", mnSearchQuery);
+    } else if (mnSearchShowing) {
+        snprintf(buf, sizeof(buf), "\"%s\": %d found", mnSearchQuery, mnSearchHitCount);
+    } else {
+        snprintf(buf, sizeof(buf), "Recordings");
+    }
+    lv_label_set_text(mnListTitleLabel, buf);
+}
+
+/**
+ * Rebuild the list outside the key handler (it deletes the focused row)
+ */
+static void mnScheduleListRebuild() {
+    lv_indev_t* indev = getLVGLKeypad();
+    if (indev != NULL) lv_indev_wait_release(indev);  // No click on the ENTER release
+    lv_async_call(mnRebuildLibraryList, nullptr);
 }
 
 /**
  * List screen-level key handler (ensures ESC works even when empty).
+ * Letters and digits type a transcript search, ENTER runs it, the first
+ * ESC clears it.
  */
 static void mnListScreenKeyHandler(lv_event_t* e) {
     lv_event_code_t code = lv_event_get_code(e);
@@ -124,7 +175,16 @@ static void mnListScreenKeyHandler(lv_event_t* e) {
 
     uint32_t key = lv_event_get_key(e);
     if (key == LV_KEY_ESC) {
-        onLVGLBackNavigation();
+        if (mnSearchQuery[0] != '\0' || mnSearchShowing) {
+            bool rebuild = mnSearchShowing;
+            mnSearchQuery[0] = '\0';
+            mnSearchDirty = false;
+            mnSearchShowing = false;
+            mnUpdateListTitle();
+            if (rebuild) mnScheduleListRebuild();
+        } else {
+            onLVGLBackNavigation();
+        }
         lv_event_stop_processing(e);
         return;
     }
@@ -133,6 +193,44 @@ static void mnListScreenKeyHandler(lv_event_t* e) {
         lv_event_stop_processing(e);
         return;
     }
+
+    if (key == LV_KEY_BACKSPACE) {
+        int len = strlen(mnSearchQuery);
+        if (len > 0) {
+            mnSearchQuery[len - 1] = '\0';
+            mnSearchDirty = true;
+            if (len == 1 && mnSearchShowing) {
+                mnSearchShowing = false;
+                mnSearchDirty = false;
+                mnScheduleListRebuild();
+            }
+            mnUpdateListTitle();
+        }
+        lv_event_stop_processing(e);
+        return;
+    }
+
+    if (key == LV_KEY_ENTER && mnSearchQuery[0] != '\0' && mnSearchDirty) {
+        mnSearchHitCount = mnSearchNotes(mnSearchQuery, mnSearchHits, MN_SEARCH_MAX_HITS);
+        mnSearchShowing = true;
+        mnSearchDirty = false;
+        mnUpdateListTitle();
+        mnScheduleListRebuild();
+        lv_event_stop_processing(e);
+        return;
+    }
+
+    if (key >= 32 && key < 127) {
+        int len = strlen(mnSearchQuery);
+        if (len < (int)sizeof(mnSearchQuery) - 1 && !(key == ' ' && len == 0)) {
+            mnSearchQuery[len] = (char)toupper((int)key);
+            mnSearchQuery[len + 1] = '\0';
+            mnSearchDirty = true;
+            mnUpdateListTitle();
+        }
+        lv_event_stop_processing(e);
+        return;
+    }
 }
 
 /**
@@ -143,12 +241,29 @@ static void mnLibraryItemClick(lv_event_t* e) {
     unsigned long id = (unsigned long)(intptr_t)lv_obj_get_user_data(item);
 
     mnSelectedRecordingId = id;
+    mnSelectedSeekMs = 0;
     Serial.printf("[MorseNotes] Selected recording: %lu\n", id);
 
     // Navigate to playback screen
     onLVGLMenuSelect(MODE_MORSE_NOTES_PLAYBACK);
 }
 
+/**
+ * Search hit click handler: play from the match
+ */
+static void mnSearchHitClick(lv_event_t* e) {
+    lv_obj_t* item = lv_event_get_target(e);
+    int index = (int)(intptr_t)lv_obj_get_user_data(item);
+    if (index < 0 || index >= mnSearchHitCount) return;
+
+    mnSelectedRecordingId = mnSearchHits[index].id;
+    mnSelectedSeekMs = mnSearchHits[index].startMs;
+    Serial.printf("[MorseNotes] Selected search hit: %lu @ %lu ms\n",
+                  mnSelectedRecordingId, mnSelectedSeekMs);
+
+    onLVGLMenuSelect(MODE_MORSE_NOTES_PLAYBACK);
+}
+
 // ===================================
 // LIBRARY SCREEN - CREATION
 // ===================================
@@ -240,6 +355,197 @@ lv_obj_t* createMorseNotesLibraryScreen() {
     return screen;
 }
 
+/**
+ * Add one recording row to the list
+ */
+static void mnAddLibraryItem(const MorseNoteMetadata* meta) {
+    lv_obj_t* item = lv_btn_create(mnLibraryList);
+    lv_obj_set_size(item, 440, 70);
+    lv_obj_set_style_bg_color(item, LV_COLOR_BG_LAYER2, 0);
+    lv_obj_set_style_bg_color(item, LV_COLOR_BG_CARD_ACTIVE, LV_STATE_FOCUSED);
+    lv_obj_set_style_radius(item, 8, 0);
+
+    // Store metadata ID
+    lv_obj_set_user_data(item, (void*)(intptr_t)meta->id);
+
+    // Layout
+    lv_obj_set_flex_flow(item, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(item, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_hor(item, 15, 0);
+
+    // Icon
+    lv_obj_t* icon = lv_label_create(item);
+    lv_label_set_text(icon, LV_SYMBOL_AUDIO);
+    lv_obj_set_style_text_font(icon, getThemeFonts()->font_large, 0);
+    lv_obj_set_style_text_color(icon, LV_COLOR_ACCENT_PRIMARY, 0);
+
+    // Text column
+    lv_obj_t* col = lv_obj_create(item);
+    lv_obj_set_size(col, 300, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(col, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(col, 0, 0);
+    lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_all(col, 0, 0);
+
+    // Title
+    lv_obj_t* title_lbl = lv_label_create(col);
+    lv_label_set_text(title_lbl, meta->title);
+
+    // Info line
+    char info[80];
+    int mins = meta->durationMs / 60000;
+    int secs = (meta->durationMs / 1000) % 60;
+    String dateStr = formatTimestamp(meta->timestamp);
+    snprintf(info, sizeof(info), "%s  •  %dm %02ds  •  %.0f WPM",
+             dateStr.c_str(), mins, secs, meta->avgWPM);
+    lv_obj_t* info_lbl = lv_label_create(col);
+    lv_label_set_text(info_lbl, info);
+    lv_obj_set_style_text_color(info_lbl, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(info_lbl, getThemeFonts()->font_small, 0);
+
+    // Click handler
+    lv_obj_add_event_cb(item, mnLibraryItemClick, LV_EVENT_CLICKED, nullptr);
+    lv_obj_add_event_cb(item, mnLibraryListNavHandler, LV_EVENT_KEY, nullptr);
+    lv_obj_add_event_cb(item, mnListScreenKeyHandler, LV_EVENT_KEY, nullptr);
+    addNavigableWidget(item);
+    mnLibraryItems[mnLibraryItemCount++] = item;
+}
+
+/**
+ * Add the next MN_LIBRARY_PAGE_SIZE recordings to the list
+ * @return rows added
+ */
+static int mnAppendLibraryPage() {
+    static MorseNoteMetadata page[MN_LIBRARY_PAGE_SIZE];
+    int n = mnGetMetadataPage(mnLibraryItemCount, page, MN_LIBRARY_PAGE_SIZE);
+    for (int i = 0; i < n && mnLibraryItemCount < MN_MAX_RECORDINGS; i++) {
+        mnAddLibraryItem(&page[i]);
+    }
+    return n;
+}
+
+/**
+ * Add one search hit row: title, snippet and where it starts
+ */
+static void mnAddSearchHitItem(int index) {
+    const MorseNoteSearchHit& hit = mnSearchHits[index];
+    MorseNoteMetadata meta;
+    if (!mnGetMetadata(hit.id, meta)) return;
+
+    lv_obj_t* item = lv_btn_create(mnLibraryList);
+    lv_obj_set_size(item, 440, 70);
+    lv_obj_set_style_bg_color(item, LV_COLOR_BG_LAYER2, 0);
+    lv_obj_set_style_bg_color(item, LV_COLOR_BG_CARD_ACTIVE, LV_STATE_FOCUSED);
+    lv_obj_set_style_radius(item, 8, 0);
+
+    // Store hit index
+    lv_obj_set_user_data(item, (void*)(intptr_t)index);
+
+    // Layout
+    lv_obj_set_flex_flow(item, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(item, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_hor(item, 15, 0);
+
+    // Icon
+    lv_obj_t* icon = lv_label_create(item);
+    lv_label_set_text(icon, LV_SYMBOL_PLAY);
+    lv_obj_set_style_text_font(icon, getThemeFonts()->font_large, 0);
+    lv_obj_set_style_text_color(icon, LV_COLOR_ACCENT_PRIMARY, 0);
+
+    // Text column
+    lv_obj_t* col = lv_obj_create(item);
+    lv_obj_set_size(col, 300, LV_SIZE_CONTENT);
+    lv_obj_set_style_bg_opa(col, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(col, 0, 0);
+    lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_all(col, 0, 0);
+
+    // Snippet
+    lv_obj_t* snippet_lbl = lv_label_create(col);
+    lv_label_set_text(snippet_lbl, hit.snippet);
+    lv_label_set_long_mode(snippet_lbl, LV_LABEL_LONG_DOT);
+    lv_obj_set_width(snippet_lbl, 300);
+
+    // Title and match time
+    char info[96];
+    snprintf(info, sizeof(info), "%.60s  •  at %lu:%02lu", meta.title,
+             (unsigned long)(hit.startMs / 60000), (unsigned long)((hit.startMs / 1000) % 60));
+    lv_obj_t* info_lbl = lv_label_create(col);
+    lv_label_set_text(info_lbl, info);
+    lv_obj_set_style_text_color(info_lbl, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(info_lbl, getThemeFonts()->font_small, 0);
+
+    // Click handler
+    lv_obj_add_event_cb(item, mnSearchHitClick, LV_EVENT_CLICKED, nullptr);
+    lv_obj_add_event_cb(item, mnLibraryListNavHandler, LV_EVENT_KEY, nullptr);
+    lv_obj_add_event_cb(item, mnListScreenKeyHandler, LV_EVENT_KEY, nullptr);
+    addNavigableWidget(item);
+    mnLibraryItems[mnLibraryItemCount++] = item;
+}
+
+/**
+ * Message card in place of list rows (empty library, no matches)
+ */
+static void mnAddListMessageCard(const char* titleText, const char* helpText) {
+    lv_obj_t* empty_card = lv_obj_create(mnLibraryList);
+    lv_obj_set_size(empty_card, 430, 125);
+    applyCardStyle(empty_card);
+    lv_obj_clear_flag(empty_card, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_style_radius(empty_card, 10, 0);
+    lv_obj_set_style_pad_all(empty_card, 14, 0);
+    lv_obj_set_layout(empty_card, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(empty_card, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_flex_align(empty_card, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_set_style_pad_row(empty_card, 8, 0);
+
+    lv_obj_t* empty_icon = lv_label_create(empty_card);
+    lv_label_set_text(empty_icon, LV_SYMBOL_AUDIO);
+    lv_obj_set_style_text_color(empty_icon, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(empty_icon, getThemeFonts()->font_large, 0);
+
+    lv_obj_t* empty_title = lv_label_create(empty_card);
+    lv_label_set_text(empty_title, titleText);
+    lv_obj_set_style_text_font(empty_title, getThemeFonts()->font_input, 0);
+    lv_obj_set_style_text_color(empty_title, LV_COLOR_TEXT_PRIMARY, 0);
+
+    lv_obj_t* empty_help = lv_label_create(empty_card);
+    lv_label_set_text(empty_help, helpText);
+    lv_obj_set_style_text_color(empty_help, LV_COLOR_TEXT_SECONDARY, 0);
+    lv_obj_set_style_text_font(empty_help, getThemeFonts()->font_body, 0);
+    lv_obj_set_style_text_align(empty_help, LV_TEXT_ALIGN_CENTER, 0);
+
+    // Make empty state keyboard-focusable so ESC back still works.
+    lv_obj_add_event_cb(empty_card, mnListScreenKeyHandler, LV_EVENT_KEY, nullptr);
+    addNavigableWidget(empty_card);
+}
+
+/**
+ * Fill the list: search hits, or the library a page at a time
+ */
+static void mnRebuildLibraryList(void* unused) {
+    (void)unused;
+    if (!mnLibraryList || !lv_obj_is_valid(mnLibraryList)) return;
+
+    lv_obj_clean(mnLibraryList);
+    mnLibraryItemCount = 0;
+
+    if (mnSearchShowing) {
+        for (int i = 0; i < mnSearchHitCount; i++) {
+            mnAddSearchHitItem(i);
+        }
+        if (mnLibraryItemCount == 0) {
+            mnAddListMessageCard("No matches",
+                                 mnTranscriptBusy() ? "Recordings are still being transcribed."
+                                                    : "Search matches whole decoded words.");
+        }
+    } else if (mnGetLibraryCount() == 0) {
+        mnAddListMessageCard("No recordings yet", "Press ESC for menu, then select New to record.");
+    } else {
+        // First page; more are added as focus reaches the end
+        mnAppendLibraryPage();
+    }
+}
+
 /**
  * Recording list (opened from landing via List).
  */
@@ -263,9 +569,9 @@ lv_obj_t* createMorseNotesListScreen() {
     lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_obj_t* title = lv_label_create(header);
-    lv_label_set_text(title, "Recordings");
     lv_obj_add_style(title, getStyleLabelTitle(), 0);
     lv_obj_align(title, LV_ALIGN_LEFT_MID, 15, 0);
+    mnListTitleLabel = title;
 
     // List container
     lv_obj_t* list = lv_obj_create(screen);
@@ -277,98 +583,12 @@ lv_obj_t* createMorseNotesListScreen() {
     lv_obj_set_style_pad_row(list, 8, 0);
     mnLibraryList = list;
 
-    int count = mnGetLibraryCount();
-    mnLibraryItemCount = 0;
-
-    if (count == 0) {
-        lv_obj_t* empty_card = lv_obj_create(list);
-        lv_obj_set_size(empty_card, 430, 125);
-        applyCardStyle(empty_card);
-        lv_obj_clear_flag(empty_card, LV_OBJ_FLAG_SCROLLABLE);
-        lv_obj_set_style_radius(empty_card, 10, 0);
-        lv_obj_set_style_pad_all(empty_card, 14, 0);
-        lv_obj_set_layout(empty_card, LV_LAYOUT_FLEX);
-        lv_obj_set_flex_flow(empty_card, LV_FLEX_FLOW_COLUMN);
-        lv_obj_set_flex_align(empty_card, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-        lv_obj_set_style_pad_row(empty_card, 8, 0);
-
-        lv_obj_t* empty_icon = lv_label_create(empty_card);
-        lv_label_set_text(empty_icon, LV_SYMBOL_AUDIO);
-        lv_obj_set_style_text_color(empty_icon, LV_COLOR_TEXT_SECONDARY, 0);
-        lv_obj_set_style_text_font(empty_icon, getThemeFonts()->font_large, 0);
-
-        lv_obj_t* empty_title = lv_label_create(empty_card);
-        lv_label_set_text(empty_title, "No recordings yet");
-        lv_obj_set_style_text_font(empty_title, getThemeFonts()->font_input, 0);
-        lv_obj_set_style_text_color(empty_title, LV_COLOR_TEXT_PRIMARY, 0);
-
-        lv_obj_t* empty_help = lv_label_create(empty_card);
-        lv_label_set_text(empty_help, "Press ESC for menu, then select New to record.");
-        lv_obj_set_style_text_color(empty_help, LV_COLOR_TEXT_SECONDARY, 0);
-        lv_obj_set_style_text_font(empty_help, getThemeFonts()->font_body, 0);
-        lv_obj_set_style_text_align(empty_help, LV_TEXT_ALIGN_CENTER, 0);
-
-        // Make empty state keyboard-focusable so ESC back still works.
-        lv_obj_add_event_cb(empty_card, mnListScreenKeyHandler, LV_EVENT_KEY, nullptr);
-        addNavigableWidget(empty_card);
-    } else {
-        // Create recording items
-        for (int i = 0; i < count && i < MN_MAX_RECORDINGS; i++) {
-            MorseNoteMetadata* meta = mnGetMetadataByIndex(i);
-            if (!meta) continue;
-
-            lv_obj_t* item = lv_btn_create(list);
-            lv_obj_set_size(item, 440, 70);
-            lv_obj_set_style_bg_color(item, LV_COLOR_BG_LAYER2, 0);
-            lv_obj_set_style_bg_color(item, LV_COLOR_BG_CARD_ACTIVE, LV_STATE_FOCUSED);
-            lv_obj_set_style_radius(item, 8, 0);
-
-            // Store metadata ID
-            lv_obj_set_user_data(item, (void*)(intptr_t)meta->id);
-
-            // Layout
-            lv_obj_set_flex_flow(item, LV_FLEX_FLOW_ROW);
-            lv_obj_set_flex_align(item, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-            lv_obj_set_style_pad_hor(item, 15, 0);
-
-            // Icon
-            lv_obj_t* icon = lv_label_create(item);
-            lv_label_set_text(icon, LV_SYMBOL_AUDIO);
-            lv_obj_set_style_text_font(icon, getThemeFonts()->font_large, 0);
-            lv_obj_set_style_text_color(icon, LV_COLOR_ACCENT_PRIMARY, 0);
-
-            // Text column
-            lv_obj_t* col = lv_obj_create(item);
-            lv_obj_set_size(col, 300, LV_SIZE_CONTENT);
-            lv_obj_set_style_bg_opa(col, LV_OPA_TRANSP, 0);
-            lv_obj_set_style_border_width(col, 0, 0);
-            lv_obj_set_flex_flow(col, LV_FLEX_FLOW_COLUMN);
-            lv_obj_set_style_pad_all(col, 0, 0);
-
-            // Title
-            lv_obj_t* title_lbl = lv_label_create(col);
-            lv_label_set_text(title_lbl, meta->title);
-
-            // Info line
-            char info[80];
-            int mins = meta->durationMs / 60000;
-            int secs = (meta->durationMs / 1000) % 60;
-            String dateStr = formatTimestamp(meta->timestamp);
-            snprintf(info, sizeof(info), "%s  •  %dm %02ds  •  %.0f WPM",
-                     dateStr.c_str(), mins, secs, meta->avgWPM);
-            lv_obj_t* info_lbl = lv_label_create(col);
-            lv_label_set_text(info_lbl, info);
-            lv_obj_set_style_text_color(info_lbl, LV_COLOR_TEXT_SECONDARY, 0);
-            lv_obj_set_style_text_font(info_lbl, getThemeFonts()->font_small, 0);
-
-            // Click handler
-            lv_obj_add_event_cb(item, mnLibraryItemClick, LV_EVENT_CLICKED, nullptr);
-            lv_obj_add_event_cb(item, mnLibraryListNavHandler, LV_EVENT_KEY, nullptr);
-            lv_obj_add_event_cb(item, mnListScreenKeyHandler, LV_EVENT_KEY, nullptr);
-            addNavigableWidget(item);
-            mnLibraryItems[mnLibraryItemCount++] = item;
-        }
+    // Back from a search hit: refresh the hits (the recording may be gone)
+    if (mnSearchShowing) {
+        mnSearchHitCount = mnSearchNotes(mnSearchQuery, mnSearchHits, MN_SEARCH_MAX_HITS);
     }
+    mnUpdateListTitle();
+    mnRebuildLibraryList(nullptr);
 
     // Footer
     lv_obj_t* footer = lv_obj_create(screen);
@@ -379,7 +599,7 @@ lv_obj_t* createMorseNotesListScreen() {
     lv_obj_clear_flag(footer, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_obj_t* hint = lv_label_create(footer);
-    lv_label_set_text(hint, FOOTER_NAV_ENTER_ESC);
+    lv_label_set_text(hint, "Type to Search   ENTER Select   ESC Back");
     lv_obj_set_style_text_color(hint, LV_COLOR_WARNING, 0);
     lv_obj_set_style_text_font(hint, getThemeFonts()->font_small, 0);
     lv_obj_center(hint);
@@ -515,10 +735,7 @@ static void mnPreviewBtnClick(lv_event_t* e) {
         mnStopPreview();
     } else {
         // Start preview
-        float* buffer = mnGetRecordingTimingBuffer();
-        int eventCount = mnGetRecordingEventCount();
-
-        if (mnInitPreviewPlayback(buffer, eventCount, cwTone)) {
+        if (mnInitPreviewPlayback(mnGetRecordingFilename(), mnGetRecordingDuration())) {
             if (mnStartPlayback()) {
                 mnSavePreviewPlaying = true;
 
@@ -936,7 +1153,7 @@ lv_obj_t* createMorseNotesRecordScreen() {
 
     // Duration label
     mnRecordDurationLabel = lv_label_create(content);
-    lv_label_set_text(mnRecordDurationLabel, "00:00 / 05:00");
+    lv_label_set_text(mnRecordDurationLabel, "00:00");
     lv_obj_set_style_text_font(mnRecordDurationLabel, getThemeFonts()->font_large, 0);
 
     // Activity bar
@@ -1096,10 +1313,38 @@ static void mnPlaybackSpeedAdjust(lv_event_t* e) {
     }
 }
 
+/**
+ * Play button key handler (UP/DOWN scrubs)
+ */
+#define MN_PLAYBACK_SCRUB_MS 5000
+
+static void mnPlaybackScrub(lv_event_t* e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code != LV_EVENT_KEY) return;
+
+    uint32_t key = lv_event_get_key(e);
+
+    if (key == LV_KEY_UP || key == LV_KEY_DOWN) {
+        mnSeekPlaybackBy(key == LV_KEY_UP ? MN_PLAYBACK_SCRUB_MS : -MN_PLAYBACK_SCRUB_MS);
+
+        // The timer only refreshes these while playing
+        lv_bar_set_value(mnPlaybackProgressBar, (int)(mnGetPlaybackProgress() * 100), LV_ANIM_OFF);
+        char timeBuf[32];
+        mnGetPlaybackTimeString(timeBuf, sizeof(timeBuf));
+        lv_label_set_text(mnPlaybackTimeLabel, timeBuf);
+        if (!mnIsPlaying()) {
+            lv_label_set_text(lv_obj_get_child(mnPlaybackPlayBtn, 0), LV_SYMBOL_PLAY " Play");
+        }
+
+        lv_event_stop_processing(e);
+    }
+}
+
 /**
  * Delete button click
  */
 static void mnPlaybackDeleteConfirm(lv_event_t* e) {
+    mnUnloadPlayback();  // Close the streamed file first
     if (mnDeleteRecording(mnSelectedRecordingId)) {
         Serial.println("[MorseNotes] Recording deleted");
         onLVGLMenuSelect(MODE_MORSE_NOTES_LIST);
@@ -1185,6 +1430,12 @@ lv_obj_t* createMorseNotesPlaybackScreen() {
         return nullptr;
     }
 
+    // Opened from a search hit: start at the match
+    if (mnSelectedSeekMs > 0) {
+        mnSeekPlayback(mnSelectedSeekMs);
+        mnSelectedSeekMs = 0;
+    }
+
     lv_obj_t* screen = createScreen();
     applyScreenStyle(screen);
     mnPlaybackScreen = screen;
@@ -1233,7 +1484,7 @@ lv_obj_t* createMorseNotesPlaybackScreen() {
     lv_obj_set_size(mnPlaybackProgressBar, 440, 20);
     lv_obj_align(mnPlaybackProgressBar, LV_ALIGN_TOP_MID, 0, pbY);
     lv_bar_set_range(mnPlaybackProgressBar, 0, 100);
-    lv_bar_set_value(mnPlaybackProgressBar, 0, LV_ANIM_OFF);
+    lv_bar_set_value(mnPlaybackProgressBar, (int)(mnGetPlaybackProgress() * 100), LV_ANIM_OFF);
     applyBarStyle(mnPlaybackProgressBar);
 
     // Time label
@@ -1262,6 +1513,7 @@ lv_obj_t* createMorseNotesPlaybackScreen() {
     lv_label_set_text(play_lbl, LV_SYMBOL_PLAY " Play");
     lv_obj_center(play_lbl);
     lv_obj_add_event_cb(mnPlaybackPlayBtn, mnPlaybackPlayBtnClick, LV_EVENT_CLICKED, nullptr);
+    lv_obj_add_event_cb(mnPlaybackPlayBtn, mnPlaybackScrub, LV_EVENT_KEY, nullptr);
     lv_obj_add_event_cb(mnPlaybackPlayBtn, mnPlaybackNavHandler, LV_EVENT_KEY, nullptr);
     addNavigableWidget(mnPlaybackPlayBtn);
     mnPlaybackBtns[0] = mnPlaybackPlayBtn;
@@ -1303,7 +1555,7 @@ lv_obj_t* createMorseNotesPlaybackScreen() {
     lv_obj_clear_flag(pb_footer, LV_OBJ_FLAG_SCROLLABLE);
 
     lv_obj_t* pb_hint = lv_label_create(pb_footer);
-    lv_label_set_text(pb_hint, "L/R Navigate   UP/DN Speed   ESC Back");
+    lv_label_set_text(pb_hint, "L/R Navigate   UP/DN Seek/Speed   ESC Back");
     lv_obj_set_style_text_color(pb_hint, LV_COLOR_WARNING, 0);
     lv_obj_set_style_text_font(pb_hint, getThemeFonts()->font_small, 0);
     lv_obj_center(pb_hint);
@@ -1326,6 +1578,7 @@ void cleanupMorseNotesPlaybackScreen() {
         mnPlaybackTimer = nullptr;
     }
 
+    mnUnloadPlayback();
     mnPlaybackScreen = nullptr;
 }
 
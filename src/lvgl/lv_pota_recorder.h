@@ -21,6 +21,7 @@ extern void onLVGLMenuSelect(int target_mode);
 extern int getCurrentModeAsInt();
 extern void setCurrentModeFromInt(int mode);
 extern void onLVGLBackNavigation();
+extern void formatCurrentDateTime(char* dateOut, char* timeOut);
 
 // Mode constants
 #define POTA_RECORDER_MODE_SETUP    137
@@ -318,9 +319,20 @@ static void pota_rec_update_cb(lv_timer_t* timer) {
         if (pota_rec_call_label) {
             const char* call = parser->getCurrentCallsign();
             if (call && strlen(call) > 0) {
-                lv_label_set_text(pota_rec_call_label, call);
+                // Recorder logs CW with no band, so check against the same key
+                char date[9], time[5];
+                formatCurrentDateTime(date, time);
+                QSODupeStatus status = checkQSODupe(call, "", "CW", date);
+                if (status == QSO_DUPE_NEW) {
+                    lv_label_set_text(pota_rec_call_label, call);
+                } else {
+                    lv_label_set_text_fmt(pota_rec_call_label, "%s  %s", call, qsoDupeStatusText(status));
+                }
+                lv_obj_set_style_text_color(pota_rec_call_label,
+                    status == QSO_DUPE_DUPE ? LV_COLOR_ERROR : lv_color_make(255, 220, 50), 0);
             } else {
                 lv_label_set_text(pota_rec_call_label, "---");
+                lv_obj_set_style_text_color(pota_rec_call_label, lv_color_make(255, 220, 50), 0);
             }
         }
 
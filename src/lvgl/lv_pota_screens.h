@@ -64,6 +64,16 @@ static lv_timer_t* pota_refresh_timer = NULL;
 static lv_timer_t* pota_timestamp_timer = NULL;
 static lv_timer_t* pota_autoload_timer = NULL;
 
+// Spot fetch, ticked by its own timer (see potaFetchJobTick)
+enum POTAFetchKind : uint8_t {
+    POTA_FETCH_BACKGROUND = 0,    // Auto-refresh: toast only
+    POTA_FETCH_AUTOLOAD,          // Opening the screen: loading overlay
+    POTA_FETCH_MANUAL             // R key: loading overlay, result beep
+};
+static lv_timer_t* pota_fetch_timer = NULL;
+static lv_obj_t* pota_fetch_overlay = NULL;
+static POTAFetchKind pota_fetch_kind = POTA_FETCH_BACKGROUND;
+
 // ============================================
 // Forward Declarations
 // ============================================
@@ -75,6 +85,8 @@ lv_obj_t* createPOTAFilterScreen();
 void refreshPOTASpotsDisplay();
 void updatePOTATimestampLabel();
 void cleanupPOTAScreen();
+static void potaStartFetch(POTAFetchKind kind);
+static void potaStopFetch();
 
 // ============================================
 // Timer Callbacks
@@ -85,15 +97,7 @@ static void pota_auto_refresh_cb(lv_timer_t* timer) {
     if (!pota_spots_table || !lv_obj_is_valid(pota_spots_table)) return;
 
     if (getCurrentModeAsInt() == MODE_POTA_ACTIVE_SPOTS && !potaSpotsCache.fetching && !pota_is_loading) {
-        // Background refresh: non-modal toast (a full overlay every 60s would
-        // interrupt reading the table). Render once so it shows before the
-        // blocking fetch.
-        pota_is_loading = true;
-        showToast("Refreshing spots...");
-        lv_refr_now(NULL);
-        fetchActiveSpots(potaSpotsCache);
-        pota_is_loading = false;
-        refreshPOTASpotsDisplay();
+        potaStartFetch(POTA_FETCH_BACKGROUND);
     }
 }
 
@@ -133,6 +137,7 @@ void cleanupPOTAScreen() {
         lv_timer_del(pota_autoload_timer);
         pota_autoload_timer = NULL;
     }
+    potaStopFetch();
     pota_screen = NULL;
     pota_spots_table = NULL;
     pota_loading_bar = NULL;
@@ -491,8 +496,8 @@ void refreshPOTASpotsDisplay() {
 }
 
 void showSpotsLoadingState(bool loading, const char* message = NULL, lv_color_t color = LV_COLOR_TEXT_PRIMARY) {
-    // Note: pota_is_loading is managed at the fetch sites, not here, so a
-    // persistent error message does not block future refresh attempts
+    // Note: pota_is_loading is managed by the fetch (potaStartFetch), not
+    // here, so a persistent error message does not block future refresh attempts
 
     // Show/hide loading container in the table area
     if (pota_loading_label && lv_obj_is_valid(pota_loading_label)) {
@@ -518,6 +523,85 @@ void showSpotsLoadingState(bool loading, const char* message = NULL, lv_color_t
     }
 }
 
+// ============================================
+// Spot Fetch
+// ============================================
+
+static void potaFetchFinishUI(int result) {
+    if (pota_fetch_overlay) {
+        if (lv_obj_is_valid(pota_fetch_overlay)) lv_obj_del(pota_fetch_overlay);
+        pota_fetch_overlay = NULL;
+    }
+    pota_is_loading = false;
+
+    // Screen torn down meanwhile: the cache is updated, nothing to show
+    if (!pota_spots_table || !lv_obj_is_valid(pota_spots_table)) return;
+
+    if (pota_fetch_kind == POTA_FETCH_BACKGROUND) {
+        refreshPOTASpotsDisplay();
+        return;
+    }
+
+    showSpotsLoadingState(false);
+    bool manual = (pota_fetch_kind == POTA_FETCH_MANUAL);
+    if (result >= 0) {
+        Serial.printf("[POTA] Fetch success: %d spots\n", result);
+        refreshPOTASpotsDisplay();
+        if (manual) beep(1000, 100);  // Success
+    } else {
+        Serial.println("[POTA] Fetch failed, showing error");
+        if (manual && WiFi.status() != WL_CONNECTED) {
+            showSpotsLoadingState(true, "WiFi not connected!", LV_COLOR_ERROR);
+        } else {
+            showSpotsLoadingState(true, "Failed to load. Press R to retry.", LV_COLOR_ERROR);
+        }
+        if (manual) beep(400, 200);  // Error
+    }
+}
+
+static void pota_fetch_timer_cb(lv_timer_t* timer) {
+    potaFetchJobTick(20);
+    if (potaFetchJobActive()) return;
+
+    lv_timer_del(pota_fetch_timer);
+    pota_fetch_timer = NULL;
+    potaFetchFinishUI(potaFetchJobResult());
+}
+
+/**
+ * Start fetching spots; the result is shown when the job finishes
+ */
+static void potaStartFetch(POTAFetchKind kind) {
+    pota_fetch_kind = kind;
+    pota_is_loading = true;
+    if (!potaFetchJobStart(potaSpotsCache)) {
+        potaFetchFinishUI(-1);
+        return;
+    }
+
+    if (kind == POTA_FETCH_BACKGROUND) {
+        // Non-modal toast: a full overlay every 60s would interrupt reading the table
+        showToast("Refreshing spots...");
+    } else {
+        pota_fetch_overlay = createLoadingOverlay("Fetching spots...");
+    }
+    pota_fetch_timer = lv_timer_create(pota_fetch_timer_cb, 10, NULL);
+}
+
+// Leaving the screen: drop a fetch in progress with its overlay
+static void potaStopFetch() {
+    if (pota_fetch_timer) {
+        lv_timer_del(pota_fetch_timer);
+        pota_fetch_timer = NULL;
+    }
+    potaFetchJobCancel();
+    if (pota_fetch_overlay) {
+        if (lv_obj_is_valid(pota_fetch_overlay)) lv_obj_del(pota_fetch_overlay);
+        pota_fetch_overlay = NULL;
+    }
+    pota_is_loading = false;
+}
+
 lv_obj_t* createPOTAActiveSpotsScreen() {
     Serial.println("[POTA] Creating Active Spots screen...");
 
@@ -778,33 +862,7 @@ static void pota_spots_key_handler(lv_event_t* e) {
 
         if (!pota_is_loading) {
             Serial.println("[POTA] Starting fetch...");
-            pota_is_loading = true;
-
-            // Modal overlay renders immediately, before the blocking fetch
-            lv_obj_t* overlay = createLoadingOverlay("Fetching spots...");
-
-            Serial.printf("[POTA] Free heap before fetch: %d\n", ESP.getFreeHeap());
-            int result = fetchActiveSpots(potaSpotsCache);
-            Serial.printf("[POTA] Fetch returned: %d, free heap: %d\n", result, ESP.getFreeHeap());
-
-            lv_obj_del(overlay);
-            pota_is_loading = false;
-            showSpotsLoadingState(false);
-
-            if (result >= 0) {
-                Serial.println("[POTA] Fetch success, refreshing display...");
-                refreshPOTASpotsDisplay();
-                Serial.println("[POTA] Display refresh complete");
-                beep(1000, 100);  // Success
-            } else {
-                Serial.println("[POTA] Fetch failed, showing error");
-                if (WiFi.status() != WL_CONNECTED) {
-                    showSpotsLoadingState(true, "WiFi not connected!", LV_COLOR_ERROR);
-                } else {
-                    showSpotsLoadingState(true, "Failed to load. Press R to retry.", LV_COLOR_ERROR);
-                }
-                beep(400, 200);  // Error
-            }
+            potaStartFetch(POTA_FETCH_MANUAL);
         } else {
             Serial.println("[POTA] Already loading, ignoring");
         }
@@ -1730,24 +1788,7 @@ static void pota_autoload_cb(lv_timer_t* timer) {
     // No valid cache - fetch new data
     if (!pota_is_loading && WiFi.status() == WL_CONNECTED) {
         Serial.println("[POTA] Auto-loading spots...");
-        pota_is_loading = true;
-
-        // Modal overlay renders immediately, before the blocking fetch
-        lv_obj_t* overlay = createLoadingOverlay("Fetching spots...");
-
-        int result = fetchActiveSpots(potaSpotsCache);
-
-        lv_obj_del(overlay);
-        pota_is_loading = false;
-        showSpotsLoadingState(false);
-
-        if (result >= 0) {
-            Serial.printf("[POTA] Auto-load success: %d spots\n", potaSpotsCache.count);
-            refreshPOTASpotsDisplay();
-        } else {
-            Serial.println("[POTA] Auto-load failed");
-            showSpotsLoadingState(true, "Failed to load. Press R to retry.", LV_COLOR_ERROR);
-        }
+        potaStartFetch(POTA_FETCH_AUTOLOAD);
     } else if (WiFi.status() != WL_CONNECTED) {
         Serial.println("[POTA] No WiFi - skipping auto-load");
         showSpotsLoadingState(true, "WiFi not connected. Press R when connected.", LV_COLOR_WARNING);
@@ -18,6 +18,9 @@
 #include "../core/deferred_save.h"
 #include "../satellites/sat_data.h"
 #include "../satellites/sat_predict.h"
+#include "../satellites/sat_pass_cache.h"
+#include "../satellites/sat_pass_worker.h"
+#include "../satellites/sat_track.h"
 #include "../satellites/sat_freqs.h"
 #include "../satellites/sat_xmtrs.h"
 #include "../satellites/sat_update.h"
@@ -50,14 +53,15 @@ static char sat_search_filter[13] = "";
 // Where ESC from the passes screen returns (whichever list/window launched it)
 int satPassesReturnMode = MODE_SAT_LIST;
 
-// Background next-pass computation (shown in the NEXT PASS column).
-// aos/los per catalog index: 0 = not computed, -1 = no pass found within the
-// lookahead window. Favorites + curated birds always compute; the "by next
-// pass" variant sweeps the whole catalog (favorites first).
+// Next-pass times (shown in the NEXT PASS column), copied from the pass
+// worker's snapshot (sat_pass_worker.h), which sweeps the whole catalog in
+// the background (favorites first). aos/los per catalog index: 0 = not
+// computed, -1 = no pass found within the lookahead window.
 static time_t sat_np_aos[MAX_SATELLITES];
 static time_t sat_np_los[MAX_SATELLITES];
 static lv_timer_t* sat_list_np_timer = NULL;
-static int sat_np_current = -1;         // catalog index in-flight, -1 = idle
+static uint32_t sat_np_seen_seq = 0;    // last snapshot copied
+static uint32_t sat_np_last_refresh = 0;
 
 // Selection carried between screens
 static int sat_selected_catalog_idx = -1;
@@ -83,18 +87,29 @@ static lv_obj_t* sat_live_az_label = NULL;
 static lv_obj_t* sat_live_el_label = NULL;
 static lv_obj_t* sat_live_dist_label = NULL;
 static lv_obj_t* sat_live_status_label = NULL;
+static lv_obj_t* sat_live_down_label = NULL;       // Doppler readout
+static lv_obj_t* sat_live_up_label = NULL;
+static lv_obj_t* sat_live_sky_line = NULL;         // pass track on the sky plot
+static lv_obj_t* sat_live_sky_dot = NULL;          // current position
+static bool sat_live_sky_drawn = false;
+static uint32_t sat_live_down_hz = 0;              // nominal transmitter frequencies
+static uint32_t sat_live_up_hz = 0;
 static lv_timer_t* sat_live_timer = NULL;
 
+// Pass track table (sat_track.h), filled in slices while detail/live are open
+static lv_timer_t* sat_track_timer = NULL;
+
 // Settings
 static lv_obj_t* sat_set_value_labels[5] = { NULL };
 
 // Sky window ("what's up in the hour after <date time>")
-#define SAT_WIN_MAX_RESULTS 40
 #define SAT_WIN_MINUTES 60
-static struct { int catIdx; SatPass pass; } sat_win_results[SAT_WIN_MAX_RESULTS];
+static SatWindowHit sat_win_results[SAT_WIN_MAX_HITS];
 static int sat_win_count = 0;
-static int sat_win_scan = 0;            // next catalog index to evaluate
-static bool sat_win_inflight = false;
+static int sat_win_scan = 0;            // catalog entries the worker has evaluated
+static int sat_win_total = 0;
+static uint32_t sat_win_request = 0;    // pass worker request id
+static uint32_t sat_win_seen_seq = 0;
 static time_t sat_win_start = 0;        // UTC start of the 60-min window
 static int sat_win_selected_row = 0;
 static lv_obj_t* sat_win_table = NULL;
@@ -114,8 +129,8 @@ void cleanupSatelliteScreens() {
     if (sat_live_timer)   { lv_timer_del(sat_live_timer);   sat_live_timer = NULL; }
     if (sat_list_np_timer) { lv_timer_del(sat_list_np_timer); sat_list_np_timer = NULL; }
     if (sat_win_timer) { lv_timer_del(sat_win_timer); sat_win_timer = NULL; }
-    sat_np_current = -1;
-    sat_win_inflight = false;
+    if (sat_track_timer) { lv_timer_del(sat_track_timer); sat_track_timer = NULL; }
+    // The pass worker keeps sweeping in the background
     satSearch.active = false;
 
     sat_list_table = NULL;
@@ -135,6 +150,10 @@ void cleanupSatelliteScreens() {
     sat_live_el_label = NULL;
     sat_live_dist_label = NULL;
     sat_live_status_label = NULL;
+    sat_live_down_label = NULL;
+    sat_live_up_label = NULL;
+    sat_live_sky_line = NULL;
+    sat_live_sky_dot = NULL;
     for (int i = 0; i < 5; i++) sat_set_value_labels[i] = NULL;
 }
 
@@ -262,7 +281,8 @@ static void satUpdateFinishUI(bool ok) {
     sat_upd_prog_label = NULL;
 
     if (ok) {
-        // Catalog indexes changed - cached next-pass times are invalid
+        // Catalog indexes changed - cached next-pass times are invalid (the
+        // pass worker notices the new catalog generation on its own)
         memset(sat_np_aos, 0, sizeof(sat_np_aos));
         memset(sat_np_los, 0, sizeof(sat_np_los));
         beep(1000, 100);
@@ -277,7 +297,7 @@ static void satUpdateFinishUI(bool ok) {
         }
         if (sat_win_table && lv_obj_is_valid(sat_win_table)) {
             satWinRestartScan();
-            if (!sat_win_timer) sat_win_timer = lv_timer_create(sat_win_timer_cb, 60, NULL);
+            if (!sat_win_timer) sat_win_timer = lv_timer_create(sat_win_timer_cb, 250, NULL);
         }
     } else {
         beep(400, 200);
@@ -307,7 +327,7 @@ static void sat_upd_timer_cb(lv_timer_t* t) {
         char buf[56];
         unsigned long kb = (unsigned long)(satUpd.stageBytes / 1024UL);
         if (satUpd.stage == SATUPD_XMTRS) {
-            snprintf(buf, sizeof(buf), "%lu KB of ~2500 KB   %d freqs kept", kb, satXmtrCount);
+            snprintf(buf, sizeof(buf), "%lu KB of ~2500 KB   %d freqs kept", kb, satXmtrSpooled);
         } else if (satUpd.stageTotal > 0) {
             snprintf(buf, sizeof(buf), "%lu of %d KB   %d satellites", kb, satUpd.stageTotal / 1024, satCatalog.count);
         } else {
@@ -429,27 +449,6 @@ static bool satNextPassWanted(int idx) {
 static bool satIncludeFavorite(uint32_t norad) { return isSatFavorite(norad); }
 static bool satIncludePopular(uint32_t norad) { return lookupSatFreqs(norad) != NULL; }
 
-// Next catalog index needing computation (favorites first), or -1 when
-// everything wanted is current. -1 ("no pass in window") entries stay sticky
-// until a TLE refresh - recomputing them is the most expensive case.
-static int satNextComputeIndex() {
-    if (!satCatalog.valid || !ntpSynced) return -1;
-    double lat, lon;
-    if (!gridToLatLon(satEffectiveGrid(), &lat, &lon)) return -1;
-
-    time_t now = time(nullptr);
-    for (int fav = 1; fav >= 0; fav--) {
-        for (int i = 0; i < satCatalog.count; i++) {
-            if ((int)isSatFavorite(satCatalog.sats[i].norad) != fav) continue;
-            if (!satNextPassWanted(i)) continue;
-            if (sat_np_aos[i] == (time_t)-1) continue;               // known: none in window
-            if (sat_np_aos[i] > 0 && sat_np_los[i] >= now) continue; // still current
-            return i;
-        }
-    }
-    return -1;
-}
-
 // Compute progress for the header label: done/wanted
 static void satNextPassProgress(int* done, int* wanted) {
     *done = 0;
@@ -465,50 +464,29 @@ static void satNextPassProgress(int* done, int* wanted) {
 static void satRefreshListTable();  // forward
 static void sat_list_np_timer_cb(lv_timer_t* t);  // forward
 
-// Make sure the worker timer is running at full speed.
+// Make sure the pass worker is running and the list is polling its snapshot.
 static void satEnsureNextPassWorker() {
+    satPassWorkerStart();
     if (!sat_list_np_timer) {
-        sat_list_np_timer = lv_timer_create(sat_list_np_timer_cb, 60, NULL);
-    } else {
-        lv_timer_set_period(sat_list_np_timer, 60);
+        // Fresh screen: take whatever the worker has right away
+        sat_np_seen_seq = 0;
+        if (satPassWorkerReadNextPass(sat_np_aos, sat_np_los, &sat_np_seen_seq)) {
+            satRefreshListTable();
+        }
+        sat_np_last_refresh = millis();
+        sat_list_np_timer = lv_timer_create(sat_list_np_timer_cb, 500, NULL);
     }
 }
 
-// Chunked worker: one satellite at a time through the shared pass-search
-// state machine, stopping at the first pass found. When nothing needs
-// computing, drop to a slow 30s tick that keeps the relative times fresh
-// and picks up birds whose pass has ended.
+// Poll the pass worker's snapshot: redraw when new results land, and every
+// 30s regardless to keep the relative times / NOW state fresh.
 static void sat_list_np_timer_cb(lv_timer_t* t) {
     if (!sat_list_table || !lv_obj_is_valid(sat_list_table)) return;
 
-    if (sat_np_current < 0) {
-        sat_np_current = satNextComputeIndex();
-        if (sat_np_current < 0) {
-            satRefreshListTable();  // keep relative times / NOW state fresh
-            lv_timer_set_period(t, 30000);
-            return;
-        }
-        lv_timer_set_period(t, 60);
-        if (!satStartPassSearch(sat_np_current)) {
-            sat_np_aos[sat_np_current] = (time_t)-1;
-            sat_np_los[sat_np_current] = (time_t)-1;
-            sat_np_current = -1;
-            return;
-        }
-    }
-
-    satPassSearchStep(25);
-    if (satSearch.count > 0 || satSearch.done) {
-        if (satSearch.count > 0) {
-            sat_np_aos[sat_np_current] = satSearch.passes[0].aos;
-            sat_np_los[sat_np_current] = satSearch.passes[0].los;
-        } else {
-            sat_np_aos[sat_np_current] = (time_t)-1;
-            sat_np_los[sat_np_current] = (time_t)-1;
-        }
-        satSearch.active = false;
-        satSearch.done = true;
-        sat_np_current = -1;
+    satPassWorkerConfigure();  // picks up grid / settings changes
+    bool changed = satPassWorkerReadNextPass(sat_np_aos, sat_np_los, &sat_np_seen_seq);
+    if (changed || millis() - sat_np_last_refresh >= 30000) {
+        sat_np_last_refresh = millis();
         satRefreshListTable();
     }
 }
@@ -710,10 +688,8 @@ static void sat_list_key_handler(lv_event_t* e) {
                     "Time is not synced yet.\nConnect to WiFi so NTP can\nset the clock, then retry.");
             } else {
                 sat_selected_catalog_idx = satDisplayIdx[sat_list_selected_row];
-                // The passes screen owns the shared pass-search state machine;
-                // stop the background next-pass worker before handing over.
+                // The list's snapshot poll isn't needed behind the passes screen
                 if (sat_list_np_timer) { lv_timer_del(sat_list_np_timer); sat_list_np_timer = NULL; }
-                sat_np_current = -1;
                 // ESC from the passes screen returns to this list variant
                 static const int variantModes[4] = { MODE_SAT_LIST, MODE_SAT_MY, MODE_SAT_POPULAR, MODE_SAT_BYPASS };
                 satPassesReturnMode = variantModes[sat_list_variant];
@@ -946,6 +922,7 @@ static void sat_passes_search_timer_cb(lv_timer_t* timer) {
 
     // Done
     if (sat_passes_timer) { lv_timer_del(sat_passes_timer); sat_passes_timer = NULL; }
+    satPassCacheStoreSearch();
     char buf[64];
     snprintf(buf, sizeof(buf), "%d passes in next %dh (min el %d deg)",
              satSearch.count, satSettings.lookaheadHours, satSettings.minElevation);
@@ -953,11 +930,12 @@ static void sat_passes_search_timer_cb(lv_timer_t* timer) {
     satRefreshPassesTable();
 }
 
-static void satStartPassesSearchUI() {
+// useCache false (R key) recomputes the whole window
+static void satStartPassesSearchUI(bool useCache) {
     if (sat_passes_timer) { lv_timer_del(sat_passes_timer); sat_passes_timer = NULL; }
     sat_passes_selected_row = 0;
 
-    if (!satStartPassSearch(sat_selected_catalog_idx)) {
+    if (!satStartCachedPassSearch(sat_selected_catalog_idx, useCache)) {
         if (sat_passes_status_label && lv_obj_is_valid(sat_passes_status_label)) {
             lv_label_set_text(sat_passes_status_label, "Cannot search: check grid + clock");
             lv_obj_set_style_text_color(sat_passes_status_label, LV_COLOR_ERROR, 0);
@@ -992,7 +970,7 @@ static void sat_passes_key_handler(lv_event_t* e) {
     if (key == 'R' || key == 'r') {
         if (!satSearch.active) {
             satRefreshPassesTable();
-            satStartPassesSearchUI();
+            satStartPassesSearchUI(false);
         }
         lv_event_stop_processing(e);
         return;
@@ -1086,7 +1064,7 @@ lv_obj_t* createSatPassesScreen() {
 
     satCreateFooter(screen, "UP/DN Scroll   ENTER Detail   R Re-search   ESC Back");
 
-    satStartPassesSearchUI();
+    satStartPassesSearchUI(true);
     return screen;
 }
 
@@ -1094,6 +1072,23 @@ lv_obj_t* createSatPassesScreen() {
 // Pass Detail Screen
 // ============================================
 
+// Fill the selected pass's track table a slice at a time; the timer goes
+// away once the table is complete
+static void sat_track_timer_cb(lv_timer_t* t) {
+    if (satTrackStep(8) || satTrack.catalogIdx < 0) {
+        lv_timer_del(t);
+        sat_track_timer = NULL;
+    }
+}
+
+static void satStartTrackForSelectedPass() {
+    if (!satSelectedPassValid || !ntpSynced) return;
+    if (!satTrackStart(sat_selected_catalog_idx, satSelectedPass)) return;
+    if (!satTrack.ready && !sat_track_timer) {
+        sat_track_timer = lv_timer_create(sat_track_timer_cb, 30, NULL);
+    }
+}
+
 static void sat_detail_countdown_cb(lv_timer_t* timer) {
     if (!sat_detail_countdown_label || !lv_obj_is_valid(sat_detail_countdown_label)) return;
     if (!satSelectedPassValid || !ntpSynced) return;
@@ -1339,6 +1334,9 @@ lv_obj_t* createSatPassDetailScreen() {
 
     sat_detail_countdown_cb(NULL);
     sat_detail_timer = lv_timer_create(sat_detail_countdown_cb, 1000, NULL);
+
+    // Precompute the pass track while the operator reads the details
+    satStartTrackForSelectedPass();
     return screen;
 }
 
@@ -1478,14 +1476,99 @@ lv_obj_t* createSatFreqsScreen() {
 // Live View Screen
 // ============================================
 
+#define SAT_SKY_SIZE        170     // sky plot diameter (px)
+#define SAT_SKY_MAX_POINTS  64      // track polyline vertices
+
+static lv_point_t sat_live_sky_pts[SAT_SKY_MAX_POINTS];
+
+// Sky plot position for az/el: zenith in the center, horizon on the rim,
+// north up
+static lv_point_t satSkyPoint(float az, float el) {
+    float r = (SAT_SKY_SIZE / 2 - 2) * (90.0f - constrain(el, 0.0f, 90.0f)) / 90.0f;
+    float a = az * DEG_TO_RAD;
+    lv_point_t p;
+    p.x = (lv_coord_t)lroundf(SAT_SKY_SIZE / 2 + r * sinf(a));
+    p.y = (lv_coord_t)lroundf(SAT_SKY_SIZE / 2 - r * cosf(a));
+    return p;
+}
+
+// Draw the selected pass's track once its table is complete
+static void satLiveDrawTrack() {
+    if (sat_live_sky_drawn || !sat_live_sky_line || !satTrack.ready) return;
+    if (satTrack.catalogIdx != sat_selected_catalog_idx || satTrack.aos != satSelectedPass.aos) return;
+
+    int n = 0;
+    int stride = (satTrack.count + SAT_SKY_MAX_POINTS - 1) / SAT_SKY_MAX_POINTS;
+    if (stride < 1) stride = 1;
+    for (int i = 0; i < satTrack.count && n < SAT_SKY_MAX_POINTS; i += stride) {
+        const SatTrackPoint& p = satTrack.points[i];
+        sat_live_sky_pts[n++] = satSkyPoint(p.az / 10.0f, p.el / 10.0f);
+    }
+    lv_line_set_points(sat_live_sky_line, sat_live_sky_pts, n);
+    sat_live_sky_drawn = true;
+}
+
+// Doppler-corrected frequencies from the track's range rate, nominal ones
+// outside the pass
+static void satLiveUpdateDoppler(bool tracking, float rangeRate) {
+    if (!sat_live_down_label) return;
+    char buf[48], mhz[16];
+    if (sat_live_down_hz) {
+        if (tracking) {
+            uint32_t hz = satDopplerDownlinkHz(sat_live_down_hz, rangeRate);
+            long shift = (long)hz - (long)sat_live_down_hz;
+            snprintf(buf, sizeof(buf), "DN %lu.%04lu  %+.1fk", (unsigned long)(hz / 1000000UL),
+                     (unsigned long)((hz % 1000000UL) / 100UL), shift / 1000.0f);
+        } else {
+            satFmtMHz(sat_live_down_hz, mhz, sizeof(mhz));
+            snprintf(buf, sizeof(buf), "DN %s", mhz);
+        }
+        lv_label_set_text(sat_live_down_label, buf);
+    }
+    if (sat_live_up_hz && sat_live_up_label) {
+        if (tracking) {
+            uint32_t hz = satDopplerUplinkHz(sat_live_up_hz, rangeRate);
+            long shift = (long)hz - (long)sat_live_up_hz;
+            snprintf(buf, sizeof(buf), "UP %lu.%04lu  %+.1fk", (unsigned long)(hz / 1000000UL),
+                     (unsigned long)((hz % 1000000UL) / 100UL), shift / 1000.0f);
+        } else {
+            satFmtMHz(sat_live_up_hz, mhz, sizeof(mhz));
+            snprintf(buf, sizeof(buf), "UP %s", mhz);
+        }
+        lv_label_set_text(sat_live_up_label, buf);
+    }
+}
+
 static void sat_live_timer_cb(lv_timer_t* timer) {
     if (!sat_live_az_label || !lv_obj_is_valid(sat_live_az_label)) return;
 
+    satLiveDrawTrack();
+
+    // During the selected pass the track table answers without SGP4
     SatLiveState st;
-    if (!satLiveUpdate(sat_selected_catalog_idx, &st)) {
+    SatTrackSample ts;
+    bool tracking = ntpSynced && satTrack.catalogIdx == sat_selected_catalog_idx &&
+                    satTrackSample((double)time(nullptr), &ts);
+    if (tracking) {
+        st.valid = true;
+        st.az = ts.az;
+        st.el = ts.el;
+        st.distKm = ts.rangeKm;
+    } else if (!satLiveUpdate(sat_selected_catalog_idx, &st)) {
         lv_label_set_text(sat_live_status_label, "Tracking unavailable");
         return;
     }
+    satLiveUpdateDoppler(tracking, tracking ? ts.rangeRate : 0.0f);
+
+    if (sat_live_sky_dot) {
+        if (st.el > 0) {
+            lv_point_t p = satSkyPoint(st.az, st.el);
+            lv_obj_set_pos(sat_live_sky_dot, p.x - 5, p.y - 5);
+            lv_obj_clear_flag(sat_live_sky_dot, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(sat_live_sky_dot, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
 
     char buf[48];
     snprintf(buf, sizeof(buf), "%.1f  %s", st.az, azToCompass(st.az));
@@ -1524,6 +1607,59 @@ static void sat_live_timer_cb(lv_timer_t* timer) {
     }
 }
 
+// Polar sky plot: horizon ring, 30/60 degree rings, cardinal letters, the
+// pass track and a dot for the current position
+static void satCreateSkyPlot(lv_obj_t* screen, int x, int y) {
+    lv_obj_t* sky = lv_obj_create(screen);
+    lv_obj_set_size(sky, SAT_SKY_SIZE, SAT_SKY_SIZE);
+    lv_obj_set_pos(sky, x, y);
+    lv_obj_set_style_radius(sky, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_bg_color(sky, LV_COLOR_BG_CARD, 0);
+    lv_obj_set_style_border_width(sky, 1, 0);
+    lv_obj_set_style_border_color(sky, LV_COLOR_BORDER_SUBTLE, 0);
+    lv_obj_set_style_pad_all(sky, 0, 0);
+    lv_obj_clear_flag(sky, LV_OBJ_FLAG_SCROLLABLE);
+
+    for (int el = 30; el <= 60; el += 30) {
+        int d = (SAT_SKY_SIZE - 4) * (90 - el) / 90;
+        lv_obj_t* ring = lv_obj_create(sky);
+        lv_obj_set_size(ring, d, d);
+        lv_obj_center(ring);
+        lv_obj_set_style_radius(ring, LV_RADIUS_CIRCLE, 0);
+        lv_obj_set_style_bg_opa(ring, LV_OPA_TRANSP, 0);
+        lv_obj_set_style_border_width(ring, 1, 0);
+        lv_obj_set_style_border_color(ring, LV_COLOR_BORDER_SUBTLE, 0);
+        lv_obj_clear_flag(ring, LV_OBJ_FLAG_SCROLLABLE);
+    }
+
+    static const struct { const char* text; lv_align_t align; int dx, dy; } cardinals[4] = {
+        { "N", LV_ALIGN_TOP_MID, 0, 2 }, { "E", LV_ALIGN_RIGHT_MID, -4, 0 },
+        { "S", LV_ALIGN_BOTTOM_MID, 0, -2 }, { "W", LV_ALIGN_LEFT_MID, 4, 0 },
+    };
+    for (int i = 0; i < 4; i++) {
+        lv_obj_t* l = lv_label_create(sky);
+        lv_label_set_text(l, cardinals[i].text);
+        lv_obj_set_style_text_font(l, &lv_font_montserrat_12, 0);
+        lv_obj_set_style_text_color(l, LV_COLOR_TEXT_TERTIARY, 0);
+        lv_obj_align(l, cardinals[i].align, cardinals[i].dx, cardinals[i].dy);
+    }
+
+    sat_live_sky_line = lv_line_create(sky);
+    lv_obj_set_pos(sat_live_sky_line, 0, 0);
+    lv_obj_set_style_line_width(sat_live_sky_line, 2, 0);
+    lv_obj_set_style_line_color(sat_live_sky_line, LV_COLOR_ACCENT_PRIMARY, 0);
+    lv_obj_set_style_line_rounded(sat_live_sky_line, true, 0);
+    sat_live_sky_drawn = false;
+
+    sat_live_sky_dot = lv_obj_create(sky);
+    lv_obj_set_size(sat_live_sky_dot, 10, 10);
+    lv_obj_set_style_radius(sat_live_sky_dot, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_bg_color(sat_live_sky_dot, LV_COLOR_SUCCESS, 0);
+    lv_obj_set_style_border_width(sat_live_sky_dot, 0, 0);
+    lv_obj_clear_flag(sat_live_sky_dot, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(sat_live_sky_dot, LV_OBJ_FLAG_HIDDEN);
+}
+
 lv_obj_t* createSatLiveScreen() {
     clearNavigationGroup();
     lv_obj_t* screen = createScreen();
@@ -1544,20 +1680,22 @@ lv_obj_t* createSatLiveScreen() {
     sat_live_status_label = lv_label_create(screen);
     lv_label_set_text(sat_live_status_label, "");
     lv_obj_set_style_text_font(sat_live_status_label, &lv_font_montserrat_16, 0);
-    lv_obj_align(sat_live_status_label, LV_ALIGN_TOP_MID, 0, HEADER_HEIGHT + 12);
+    lv_obj_align(sat_live_status_label, LV_ALIGN_TOP_MID, 0, HEADER_HEIGHT + 6);
+
+    // Sky plot on the left, readouts stacked on the right
+    satCreateSkyPlot(screen, 12, HEADER_HEIGHT + 32);
 
-    // Big AZ/EL/DIST readouts in a 3-column row
     struct { const char* caption; lv_obj_t** value; } readouts[3] = {
         { "AZIMUTH", &sat_live_az_label },
         { "ELEVATION", &sat_live_el_label },
         { "RANGE", &sat_live_dist_label },
     };
-    int cardW = 145, cardH = 110;
-    int startX = (SCREEN_WIDTH - (cardW * 3 + 20)) / 2;
+    int colX = 12 + SAT_SKY_SIZE + 14;
+    int cardW = SCREEN_WIDTH - colX - 10, cardH = 50;
     for (int i = 0; i < 3; i++) {
         lv_obj_t* card = lv_obj_create(screen);
         lv_obj_set_size(card, cardW, cardH);
-        lv_obj_set_pos(card, startX + i * (cardW + 10), HEADER_HEIGHT + 45);
+        lv_obj_set_pos(card, colX, HEADER_HEIGHT + 32 + i * (cardH + 4));
         applyCardStyle(card);
         lv_obj_clear_flag(card, LV_OBJ_FLAG_SCROLLABLE);
 
@@ -1565,50 +1703,38 @@ lv_obj_t* createSatLiveScreen() {
         lv_label_set_text(cap, readouts[i].caption);
         lv_obj_set_style_text_font(cap, &lv_font_montserrat_12, 0);
         lv_obj_set_style_text_color(cap, LV_COLOR_TEXT_SECONDARY, 0);
-        lv_obj_align(cap, LV_ALIGN_TOP_MID, 0, 4);
+        lv_obj_align(cap, LV_ALIGN_LEFT_MID, 0, 0);
 
         lv_obj_t* val = lv_label_create(card);
         lv_label_set_text(val, "--");
-        lv_obj_set_style_text_font(val, getThemeFonts()->font_title, 0);
+        lv_obj_set_style_text_font(val, getThemeFonts()->font_subtitle, 0);
         lv_obj_set_style_text_color(val, LV_COLOR_ACCENT_PRIMARY, 0);
-        lv_obj_align(val, LV_ALIGN_CENTER, 0, 10);
+        lv_obj_align(val, LV_ALIGN_RIGHT_MID, 0, 0);
         *(readouts[i].value) = val;
     }
 
-    // Frequency reference - operators need the downlink while pointing
+    // Doppler readout: operators need the corrected downlink (and uplink)
+    // while pointing
     uint32_t liveNorad = (sat_selected_catalog_idx >= 0 && sat_selected_catalog_idx < satCatalog.count)
         ? satCatalog.sats[sat_selected_catalog_idx].norad : 0;
-    const SatFreqInfo* lfi = lookupSatFreqs(liveNorad);
-    const SatTransmitter* lbx = lfi ? NULL : satBestXmtr(liveNorad);
-    if (lfi || lbx) {
-        char fbuf[80];
-        if (lfi) {
-            if (lfi->uplink[0] != '\0') {
-                snprintf(fbuf, sizeof(fbuf), "DN %s   UP %s", lfi->downlink, lfi->uplink);
-            } else {
-                snprintf(fbuf, sizeof(fbuf), "DN %s", lfi->downlink);
-            }
-        } else {
-            char up[14], dn[14];
-            satFmtMHz(lbx->upHz, up, sizeof(up));
-            satFmtMHz(lbx->downHz, dn, sizeof(dn));
-            if (lbx->upHz) snprintf(fbuf, sizeof(fbuf), "DN %s   UP %s", dn, up);
-            else snprintf(fbuf, sizeof(fbuf), "DN %s", dn);
-        }
-        lv_obj_t* freq_lbl = lv_label_create(screen);
-        lv_label_set_text(freq_lbl, fbuf);
-        lv_obj_set_style_text_font(freq_lbl, &lv_font_montserrat_14, 0);
-        lv_obj_set_style_text_color(freq_lbl, LV_COLOR_SUCCESS, 0);
-        lv_obj_align(freq_lbl, LV_ALIGN_TOP_MID, 0, HEADER_HEIGHT + 163);
+    satLoadXmtrsFromStorage();
+    satTrackFreqs(liveNorad, &sat_live_down_hz, &sat_live_up_hz);
+    int freqY = HEADER_HEIGHT + 32 + 3 * (cardH + 4) + 2;
+    if (sat_live_down_hz) {
+        sat_live_down_label = lv_label_create(screen);
+        lv_label_set_text(sat_live_down_label, "");
+        lv_obj_set_style_text_font(sat_live_down_label, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_color(sat_live_down_label, LV_COLOR_SUCCESS, 0);
+        lv_obj_set_pos(sat_live_down_label, colX + 4, freqY);
+    }
+    if (sat_live_up_hz) {
+        sat_live_up_label = lv_label_create(screen);
+        lv_label_set_text(sat_live_up_label, "");
+        lv_obj_set_style_text_font(sat_live_up_label, &lv_font_montserrat_14, 0);
+        lv_obj_set_style_text_color(sat_live_up_label, LV_COLOR_TEXT_PRIMARY, 0);
+        lv_obj_set_pos(sat_live_up_label, colX + 4, freqY + 18);
     }
 
-    // Hint
-    lv_obj_t* hint = lv_label_create(screen);
-    lv_label_set_text(hint, "Point the antenna: azimuth is compass heading, elevation is tilt");
-    lv_obj_set_style_text_font(hint, &lv_font_montserrat_12, 0);
-    lv_obj_set_style_text_color(hint, LV_COLOR_TEXT_TERTIARY, 0);
-    lv_obj_align(hint, LV_ALIGN_TOP_MID, 0, HEADER_HEIGHT + 188);
-
     // Invisible focus anchor so ESC back-navigation works
     lv_obj_t* focus_anchor = lv_obj_create(screen);
     lv_obj_set_size(focus_anchor, 1, 1);
@@ -1621,6 +1747,7 @@ lv_obj_t* createSatLiveScreen() {
 
     satCreateFooter(screen, "Updates every second   ESC Back");
 
+    satStartTrackForSelectedPass();
     sat_live_timer_cb(NULL);
     sat_live_timer = lv_timer_create(sat_live_timer_cb, 1000, NULL);
     return screen;
@@ -1651,8 +1778,8 @@ static void satWinUpdateStatus() {
     char buf[64];
     if (!satCatalog.valid) {
         strlcpy(buf, "No TLE data - update from the satellite list", sizeof(buf));
-    } else if (sat_win_scan < satCatalog.count) {
-        snprintf(buf, sizeof(buf), "Scanning %d/%d... %d up", sat_win_scan, satCatalog.count, sat_win_count);
+    } else if (sat_win_scan < sat_win_total) {
+        snprintf(buf, sizeof(buf), "Scanning %d/%d... %d up", sat_win_scan, sat_win_total, sat_win_count);
     } else {
         snprintf(buf, sizeof(buf), "%d satellites in the %d min after start (min el %d)",
                  sat_win_count, SAT_WIN_MINUTES, satSettings.minElevation);
@@ -1667,7 +1794,7 @@ static void satWinRefreshTable() {
     if (sat_win_count == 0) {
         lv_table_set_row_cnt(sat_win_table, 1);
         lv_table_set_cell_value(sat_win_table, 0, 0,
-            (sat_win_scan >= satCatalog.count) ? "Nothing above the horizon in this window" : "");
+            (sat_win_scan >= sat_win_total) ? "Nothing above the horizon in this window" : "");
         for (int c = 1; c < 5; c++) lv_table_set_cell_value(sat_win_table, 0, c, "");
         return;
     }
@@ -1705,64 +1832,30 @@ static void satWinRefreshTable() {
 static void satWinRestartScan() {
     sat_win_count = 0;
     sat_win_scan = 0;
+    sat_win_total = satCatalog.count;
     sat_win_selected_row = 0;
-    sat_win_inflight = false;
-    satSearch.active = false;
-    if (sat_win_timer) lv_timer_set_period(sat_win_timer, 60);
+    sat_win_seen_seq = 0;
+    sat_win_request = satPassWorkerRequestWindow(sat_win_start, SAT_WIN_MINUTES * 60);
+    if (sat_win_timer) lv_timer_set_period(sat_win_timer, 250);
     satWinRefreshTable();
 }
 
-static void satWinInsertResult(int catIdx, const SatPass* p) {
-    if (sat_win_count >= SAT_WIN_MAX_RESULTS) return;
-    int pos = sat_win_count;
-    while (pos > 0 && sat_win_results[pos - 1].pass.aos > p->aos) {
-        sat_win_results[pos] = sat_win_results[pos - 1];
-        pos--;
-    }
-    sat_win_results[pos].catIdx = catIdx;
-    sat_win_results[pos].pass = *p;
-    sat_win_count++;
-}
-
-// Chunked scan: one satellite at a time through the shared search machine
-// over [start, start+60min] (with margin so a pass peaking just past the end
-// is still found), keeping passes that overlap the window.
+// The pass worker scans the catalog one satellite at a time for passes
+// overlapping [start, start+60min]; poll its snapshot for our request.
 static void sat_win_timer_cb(lv_timer_t* t) {
     if (!sat_win_table || !lv_obj_is_valid(sat_win_table)) return;
-    if (!satCatalog.valid || sat_win_scan >= satCatalog.count) {
+    if (!satCatalog.valid) {
         lv_timer_set_period(t, 60000);
         return;
     }
 
-    if (!sat_win_inflight) {
-        if (!satStartPassSearchAt(sat_win_scan, sat_win_start, SAT_WIN_MINUTES / 60.0 + 0.25)) {
-            sat_win_scan++;
-            return;
-        }
-        sat_win_inflight = true;
-    }
-
-    satPassSearchStep(25);
-    if (satSearch.count > 0 || satSearch.done) {
-        time_t winEnd = sat_win_start + SAT_WIN_MINUTES * 60;
-        for (int i = 0; i < satSearch.count; i++) {
-            SatPass& p = satSearch.passes[i];
-            if (p.aos <= winEnd && p.los >= sat_win_start) {
-                satWinInsertResult(sat_win_scan, &p);
-                break;  // one entry per satellite
-            }
-        }
-        satSearch.active = false;
-        satSearch.done = true;
-        sat_win_inflight = false;
-        sat_win_scan++;
-        // Refresh every few birds (and at the end) to keep redraw cost down
-        if ((sat_win_scan % 4) == 0 || sat_win_scan >= satCatalog.count) {
-            satWinRefreshTable();
-        } else {
-            satWinUpdateStatus();
-        }
+    satPassWorkerConfigure();
+    if (!satPassWorkerReadWindow(sat_win_request, sat_win_results, &sat_win_count,
+                                 &sat_win_scan, &sat_win_total, &sat_win_seen_seq)) {
+        return;
     }
+    satWinRefreshTable();
+    if (sat_win_scan >= sat_win_total) lv_timer_set_period(t, 60000);
 }
 
 // Round up to the next quarter hour
@@ -1822,7 +1915,6 @@ static void sat_win_table_key_handler(lv_event_t* e) {
             satSelectedPass = sat_win_results[sat_win_selected_row].pass;
             satSelectedPassValid = true;
             if (sat_win_timer) { lv_timer_del(sat_win_timer); sat_win_timer = NULL; }
-            sat_win_inflight = false;
             // Detail -> ESC -> that bird's passes -> ESC -> back to this window
             satPassesReturnMode = sat_win_focus_table ? MODE_SAT_WINDOW_NOW : MODE_SAT_WINDOW;
             satFlushEnterRelease();  // else the release clicks LIVE VIEW on the detail screen
@@ -1954,9 +2046,9 @@ static lv_obj_t* createSatWindowScreenVariant(bool focusTable) {
                                   : "Set your grid square in Settings and sync the clock first");
             lv_obj_set_style_text_color(sat_win_status_label, LV_COLOR_ERROR, 0);
         }
-        sat_win_scan = satCatalog.count;  // nothing to do
+        sat_win_scan = sat_win_total;  // nothing to do
     } else if (!sat_win_timer) {
-        sat_win_timer = lv_timer_create(sat_win_timer_cb, 60, NULL);
+        sat_win_timer = lv_timer_create(sat_win_timer_cb, 250, NULL);
     }
 
     if (focusTable && sat_win_table) {
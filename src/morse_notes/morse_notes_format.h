@@ -0,0 +1,242 @@
+#ifndef MORSE_NOTES_FORMAT_H
+#define MORSE_NOTES_FORMAT_H
+
+#include "morse_notes_types.h"
+#include <FS.h>
+#include <esp_rom_crc.h>
+
+// ===================================
+// MORSE NOTES - .mr FORMAT V2 CODEC
+// ===================================
+//
+// v1 stores each event as a 4-byte float (ms, + tone / - silence).
+// v2 keeps the 28-byte header (version 2) and follows it with blocks of up
+// to MN_V2_BLOCK_EVENTS events:
+//
+//   MorseNoteBlockHeader | payload (varints) | uint32_t CRC32
+//
+// Every block but the last holds exactly MN_V2_BLOCK_EVENTS events, so
+// event i is always in block i / MN_V2_BLOCK_EVENTS (streaming playback
+// relies on this). The CRC covers the block header and payload, so damage
+// stays local to a block. Durations are integers in 0.1 ms units (MN_V2_UNITS_PER_MS).
+//
+// Raw blocks (ditUnits == 0): one zig-zag varint per event - 2 bytes for
+// anything under ~0.8 s.
+//
+// Dit-quantized blocks (ditUnits > 0, written when MN_FLAG_DIT_QUANTIZED is
+// set): most elements and gaps are 1, 3 or 7 dits, so an event becomes
+//
+//   varint( zigzag(residualMs) << 4 | silence << 3 | k )     k = 1..7 dits
+//   varint( units << 4 | silence << 3 )                      k = 0, escape
+//
+// which is one byte whenever the element is within 3 ms of a whole number
+// of dits. The residual is kept in whole ms - the resolution recordings are
+// made at - so keyed recordings round-trip exactly.
+
+#define MN_V2_BLOCK_EVENTS         256
+#define MN_V2_UNITS_PER_MS         10
+#define MN_V2_MAX_EVENT_BYTES      5
+#define MN_V2_MAX_PAYLOAD          (MN_V2_BLOCK_EVENTS * MN_V2_MAX_EVENT_BYTES)
+
+struct __attribute__((packed)) MorseNoteBlockHeader {
+    uint16_t eventCount;           // Events in this block (1..MN_V2_BLOCK_EVENTS)
+    uint16_t ditUnits;             // Dit length in 0.1 ms, 0 = raw block
+    uint16_t payloadBytes;         // Varint bytes that follow
+};
+
+// ===================================
+// VARINT HELPERS
+// ===================================
+
+static inline uint32_t mnZigZag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t mnUnZigZag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline int mnPutVarint(uint8_t* out, uint32_t v) {
+    int n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static inline bool mnGetVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static inline int32_t mnToUnits(float ms) {
+    float u = ms * MN_V2_UNITS_PER_MS;
+    if (u > 1e8f) u = 1e8f;
+    if (u < -1e8f) u = -1e8f;
+    return (int32_t)lroundf(u);
+}
+
+// ===================================
+// BLOCK ENCODE / DECODE
+// ===================================
+
+/**
+ * Estimate the dit length of a block: mean of the tones no longer than
+ * twice the shortest one, rounded to whole ms so whole-ms durations decode
+ * exactly. Returns 0 (raw block) if there are no tones.
+ */
+static uint16_t mnEstimateDit(const float* timings, int count) {
+    int32_t shortest = INT32_MAX;
+    for (int i = 0; i < count; i++) {
+        int32_t u = mnToUnits(timings[i]);
+        if (u > 0 && u < shortest) shortest = u;
+    }
+    if (shortest == INT32_MAX) return 0;
+
+    int64_t sum = 0;
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        int32_t u = mnToUnits(timings[i]);
+        if (u > 0 && u <= 2 * shortest) {
+            sum += u;
+            n++;
+        }
+    }
+    int64_t dit = ((sum / n + MN_V2_UNITS_PER_MS / 2) / MN_V2_UNITS_PER_MS) * MN_V2_UNITS_PER_MS;
+    return (dit > 0 && dit <= 0xFFFF) ? (uint16_t)dit : 0;
+}
+
+/**
+ * Encode up to MN_V2_BLOCK_EVENTS events into `out` (MN_V2_MAX_PAYLOAD bytes)
+ * @return payload bytes; fills in `header`
+ */
+int mnEncodeBlock(const float* timings, int count, bool quantize,
+                  uint8_t* out, MorseNoteBlockHeader& header) {
+    uint16_t dit = quantize ? mnEstimateDit(timings, count) : 0;
+    int len = 0;
+
+    for (int i = 0; i < count; i++) {
+        int32_t u = mnToUnits(timings[i]);
+        if (dit == 0) {
+            len += mnPutVarint(out + len, mnZigZag(u));
+            continue;
+        }
+
+        uint32_t silence = (u < 0) ? 1 : 0;
+        uint32_t mag = (uint32_t)(u < 0 ? -u : u);
+        uint32_t k = (mag + dit / 2) / dit;
+        if (k >= 1 && k <= 7) {
+            int32_t residualMs = (int32_t)lroundf((float)((int32_t)mag - (int32_t)(k * dit)) /
+                                                  MN_V2_UNITS_PER_MS);
+            uint32_t zz = mnZigZag(residualMs);
+            if (zz < (1u << 27)) {
+                len += mnPutVarint(out + len, (zz << 4) | (silence << 3) | k);
+                continue;
+            }
+        }
+        if (mag >= (1u << 28)) mag = (1u << 28) - 1;
+        len += mnPutVarint(out + len, (mag << 4) | (silence << 3));
+    }
+
+    header.eventCount = (uint16_t)count;
+    header.ditUnits = dit;
+    header.payloadBytes = (uint16_t)len;
+    return len;
+}
+
+/**
+ * Decode a block payload into `timings` (header.eventCount entries)
+ * @return false if the payload does not hold exactly eventCount events
+ */
+bool mnDecodeBlock(const MorseNoteBlockHeader& header, const uint8_t* payload, float* timings) {
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + header.payloadBytes;
+    uint32_t dit = header.ditUnits;
+
+    for (int i = 0; i < header.eventCount; i++) {
+        uint32_t v;
+        if (!mnGetVarint(p, end, v)) return false;
+
+        int32_t u;
+        if (dit == 0) {
+            u = mnUnZigZag(v);
+        } else {
+            uint32_t k = v & 0x07;
+            bool silence = (v & 0x08) != 0;
+            int32_t mag = (k == 0) ? (int32_t)(v >> 4)
+                                   : (int32_t)(k * dit) + mnUnZigZag(v >> 4) * MN_V2_UNITS_PER_MS;
+            if (mag < 0) mag = 0;
+            u = silence ? -mag : mag;
+        }
+        timings[i] = (float)u / MN_V2_UNITS_PER_MS;
+    }
+    return p == end;
+}
+
+// ===================================
+// FILE I/O
+// ===================================
+
+/**
+ * Write events as v2 blocks (after the file header)
+ * @return bytes written, 0 on failure
+ */
+size_t mnWriteBlocks(File& file, const float* timings, int count, bool quantize) {
+    static uint8_t payload[MN_V2_MAX_PAYLOAD];  // Only caller: the recorder, on the loop task
+    size_t total = 0;
+
+    for (int start = 0; start < count; start += MN_V2_BLOCK_EVENTS) {
+        int n = min(MN_V2_BLOCK_EVENTS, count - start);
+        MorseNoteBlockHeader header;
+        int len = mnEncodeBlock(timings + start, n, quantize, payload, header);
+
+        uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)&header, sizeof(header));
+        crc = esp_rom_crc32_le(crc, payload, len);
+
+        size_t expected = sizeof(header) + len + sizeof(crc);
+        size_t written = file.write((const uint8_t*)&header, sizeof(header));
+        written += file.write(payload, len);
+        written += file.write((const uint8_t*)&crc, sizeof(crc));
+        if (written != expected) return 0;
+        total += written;
+    }
+    return total;
+}
+
+/**
+ * Read one v2 block into `timings` (room for MN_V2_BLOCK_EVENTS)
+ * @return events decoded, 0 at end of data, -1 on a short read or bad CRC
+ */
+int mnReadBlock(File& file, float* timings) {
+    uint8_t payload[MN_V2_MAX_PAYLOAD];  // Stack: web export and playback may overlap
+
+    MorseNoteBlockHeader header;
+    size_t got = file.read((uint8_t*)&header, sizeof(header));
+    if (got == 0) return 0;
+    if (got != sizeof(header) || header.eventCount == 0 ||
+        header.eventCount > MN_V2_BLOCK_EVENTS || header.payloadBytes > MN_V2_MAX_PAYLOAD) {
+        return -1;
+    }
+
+    uint32_t stored;
+    if (file.read(payload, header.payloadBytes) != header.payloadBytes ||
+        file.read((uint8_t*)&stored, sizeof(stored)) != sizeof(stored)) {
+        return -1;
+    }
+
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)&header, sizeof(header));
+    crc = esp_rom_crc32_le(crc, payload, header.payloadBytes);
+    if (crc != stored || !mnDecodeBlock(header, payload, timings)) {
+        return -1;
+    }
+    return header.eventCount;
+}
+
+#endif // MORSE_NOTES_FORMAT_H
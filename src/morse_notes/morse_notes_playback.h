@@ -3,6 +3,7 @@
 
 #include "morse_notes_types.h"
 #include "morse_notes_storage.h"
+#include <vector>
 
 // ===================================
 // MORSE NOTES - PLAYBACK ENGINE
@@ -11,29 +12,158 @@
 // Global playback session
 static MorseNotesPlaybackSession mnPlaybackSession;
 
-// Timing buffer allocated in PSRAM on first use (saves 40KB heap)
-static float* mnPlaybackTimingBuffer = nullptr;
-
-// Allocate playback buffer in PSRAM
+// ===================================
+// STREAMING
+// ===================================
+//
+// Saved recordings are streamed from SD instead of loaded whole: two
+// MN_PLAY_BLOCK_EVENTS buffers hold the current block and the next one,
+// which is prefetched once playback is within MN_PLAY_PREFETCH_MS of the
+// end of the current block. Memory use no longer depends on recording
+// length, and starting playback costs a single block read. The save
+// dialog's preview streams the just-finished recording file the same way.
+//
+// A seek index records the file offset and start time of every block read
+// so far, so scrubbing back is one block read and scrubbing forward only
+// reads the blocks it skips (once).
+
+#define MN_PLAY_BLOCK_EVENTS       MN_V2_BLOCK_EVENTS   // Same blocking for v1 files
+#define MN_PLAY_PREFETCH_MS        1500                 // Timeline lead for the next block
+
+struct MorseNotesPlayBlock {
+    float events[MN_PLAY_BLOCK_EVENTS];
+    int number;                    // Block number, -1 = empty
+    int count;
+    float startMs;                 // Recording time at the first event
+    float endMs;
+};
+
+struct MorseNotesSeekEntry {
+    uint32_t offset;               // File offset of the block
+    float startMs;                 // Recording time at its first event
+};
+
+static MorseNotesPlayBlock* mnPlayBlocks = nullptr;      // [2], PSRAM when available
+static std::vector<MorseNotesSeekEntry> mnSeekIndex;     // Entry b = block b
+static File mnPlayFile;
+static MorseNoteFileHeader mnPlayHeader;
+static unsigned long mnPlayTotalMs = 0;
+static MorseNoteMetadata mnPlayMetadata;             // Copy of the library entry being played
+
+// Allocate the two stream buffers (PSRAM when available)
 bool mnEnsurePlaybackBuffer() {
-    if (mnPlaybackTimingBuffer != nullptr) return true;
+    if (mnPlayBlocks != nullptr) return true;
 
+    size_t bytes = 2 * sizeof(MorseNotesPlayBlock);
     if (psramFound()) {
-        mnPlaybackTimingBuffer = (float*)ps_malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-        Serial.printf("[MorseNotes] Playback buffer allocated in PSRAM (%d bytes)\n",
-                      MN_MAX_RECORDING_EVENTS * sizeof(float));
-    } else {
-        mnPlaybackTimingBuffer = (float*)malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-        Serial.println("[MorseNotes] WARNING: PSRAM not found, using heap for playback buffer");
+        mnPlayBlocks = (MorseNotesPlayBlock*)ps_malloc(bytes);
+    }
+    if (mnPlayBlocks == nullptr) {
+        mnPlayBlocks = (MorseNotesPlayBlock*)malloc(bytes);
     }
 
-    if (mnPlaybackTimingBuffer == nullptr) {
+    if (mnPlayBlocks == nullptr) {
         Serial.println("[MorseNotes] ERROR: Failed to allocate playback buffer!");
         return false;
     }
+    mnPlayBlocks[0].number = mnPlayBlocks[1].number = -1;
+    Serial.printf("[MorseNotes] Playback buffers allocated (%u bytes)\n", (unsigned)bytes);
+    return true;
+}
+
+static bool mnIsStreaming() {
+    return (bool)mnPlayFile;
+}
+
+static int mnPlayBlockCount() {
+    return (mnPlaybackSession.eventCount + MN_PLAY_BLOCK_EVENTS - 1) / MN_PLAY_BLOCK_EVENTS;
+}
+
+/**
+ * Read block `number` into `dst`, extending the seek index up to it
+ */
+static bool mnPlayLoadBlock(int number, MorseNotesPlayBlock& dst) {
+    if (number < 0 || number >= mnPlayBlockCount()) return false;
+
+    // Blocks past the end of the index have to be read in order once
+    for (int b = min(number, (int)mnSeekIndex.size() - 1); b <= number; b++) {
+        if (b < number && dst.number == b) continue;
+        if (!mnPlayFile.seek(mnSeekIndex[b].offset)) return false;
+        int n = mnReadEventBlock(mnPlayFile, mnPlayHeader,
+                                 mnPlaybackSession.eventCount - b * MN_PLAY_BLOCK_EVENTS, dst.events);
+        if (n < 0) {
+            Serial.printf("[MorseNotes] ERROR: Bad block %d\n", b);
+            dst.number = -1;
+            return false;
+        }
+        dst.number = b;
+        dst.count = n;
+        dst.startMs = mnSeekIndex[b].startMs;
+        dst.endMs = dst.startMs;
+        for (int i = 0; i < n; i++) dst.endMs += fabsf(dst.events[i]);
+
+        if (b + 1 == (int)mnSeekIndex.size() && b + 1 < mnPlayBlockCount()) {
+            MorseNotesSeekEntry next = { (uint32_t)mnPlayFile.position(), dst.endMs };
+            mnSeekIndex.push_back(next);
+        }
+        if (b == number) return true;
+    }
+    return dst.number == number;
+}
+
+/**
+ * Buffer holding block `number`, loading it if neither does
+ */
+static MorseNotesPlayBlock* mnPlayGetBlock(int number) {
+    for (int i = 0; i < 2; i++) {
+        if (mnPlayBlocks[i].number == number) return &mnPlayBlocks[i];
+    }
+    // Replace the buffer that isn't holding the block before this one
+    int slot = (mnPlayBlocks[0].number == number - 1) ? 1 : 0;
+    return mnPlayLoadBlock(number, mnPlayBlocks[slot]) ? &mnPlayBlocks[slot] : nullptr;
+}
+
+/**
+ * Event at `index` from the stream
+ * @return false if it could not be read
+ */
+static bool mnPlayEventAt(int index, float& value) {
+    if (!mnIsStreaming()) return false;
+    MorseNotesPlayBlock* block = mnPlayGetBlock(index / MN_PLAY_BLOCK_EVENTS);
+    if (!block) return false;
+    value = block->events[index % MN_PLAY_BLOCK_EVENTS];
     return true;
 }
 
+/**
+ * Load the block after the current one once the timeline gets close to it
+ */
+static void mnPlayPrefetch() {
+    if (!mnIsStreaming()) return;
+    int number = mnPlaybackSession.currentIndex / MN_PLAY_BLOCK_EVENTS;
+    MorseNotesPlayBlock* current = nullptr;
+    for (int i = 0; i < 2; i++) {
+        if (mnPlayBlocks[i].number == number) current = &mnPlayBlocks[i];
+    }
+    if (!current || number + 1 >= mnPlayBlockCount()) return;
+
+    MorseNotesPlayBlock* other = (current == &mnPlayBlocks[0]) ? &mnPlayBlocks[1] : &mnPlayBlocks[0];
+    if (other->number == number + 1) return;
+    if (current->endMs - mnPlaybackSession.positionMs > MN_PLAY_PREFETCH_MS * mnPlaybackSession.speed) return;
+
+    mnPlayLoadBlock(number + 1, *other);
+}
+
+/**
+ * Close the stream (leaving the playback screen, before deleting the file)
+ */
+void mnUnloadPlayback() {
+    if (mnPlayFile) mnPlayFile.close();
+    if (mnPlayBlocks) mnPlayBlocks[0].number = mnPlayBlocks[1].number = -1;
+    mnSeekIndex.clear();
+    mnSeekIndex.shrink_to_fit();
+}
+
 // External tone control (from task_manager.h)
 extern void requestStartTone(int frequency);
 extern void requestStopTone();
@@ -46,88 +176,103 @@ void mnStopPlayback();
 // ===================================
 
 /**
- * Load recording for playback
+ * Start streaming an opened .mr file (reads the first block only)
+ */
+static bool mnPlayBeginStream(MorseNoteMetadata* metadata, unsigned long totalMs) {
+    mnPlaybackSession.eventCount = (int)mnPlayHeader.eventCount;
+    mnPlaybackSession.currentIndex = 0;
+    mnPlaybackSession.positionMs = 0.0f;
+    mnPlaybackSession.startTime = 0;
+    mnPlaybackSession.speed = 1.0f;
+    mnPlaybackSession.toneFrequency = (int)mnPlayHeader.toneFrequency;
+    mnPlaybackSession.metadata = metadata;
+    mnPlayTotalMs = totalMs;
+
+    MorseNotesSeekEntry first = { (uint32_t)mnPlayFile.position(), 0.0f };
+    mnSeekIndex.push_back(first);
+    if (mnPlaybackSession.eventCount > 0 && !mnPlayLoadBlock(0, mnPlayBlocks[0])) {
+        mnUnloadPlayback();
+        mnPlaybackSession.state = MN_PLAY_ERROR;
+        Serial.println("[MorseNotes] ERROR: Failed to load recording");
+        return false;
+    }
+
+    mnPlaybackSession.state = MN_PLAY_READY;
+    return true;
+}
+
+/**
+ * Open recording for streaming playback
  */
 bool mnLoadForPlayback(unsigned long id) {
     // Stop any current playback
     if (mnPlaybackSession.state == MN_PLAY_PLAYING) {
         mnStopPlayback();
     }
+    mnUnloadPlayback();
 
-    // Ensure buffer is allocated (in PSRAM)
+    // Ensure buffers are allocated (in PSRAM)
     if (!mnEnsurePlaybackBuffer()) {
         mnPlaybackSession.state = MN_PLAY_ERROR;
         return false;
     }
 
-    // Load recording from SD card
-    int eventCount;
-    int toneFreq;
-    MorseNoteMetadata* metadata;
+    MorseNoteMetadata* metadata = &mnPlayMetadata;
+    if (!mnGetMetadata(id, mnPlayMetadata)) {
+        mnPlaybackSession.state = MN_PLAY_ERROR;
+        Serial.printf("[MorseNotes] ERROR: Recording not found: %lu\n", id);
+        return false;
+    }
 
     mnPlaybackSession.state = MN_PLAY_LOADING;
 
-    bool success = mnLoadRecording(
-        id,
-        mnPlaybackTimingBuffer,
-        MN_MAX_RECORDING_EVENTS,
-        eventCount,
-        toneFreq,
-        &metadata
-    );
-
-    if (!success) {
+    char filename[64];
+    mnPlayFile = mnOpenRecording(metadata, mnPlayHeader, filename, sizeof(filename));
+    if (!mnPlayFile) {
         mnPlaybackSession.state = MN_PLAY_ERROR;
         Serial.println("[MorseNotes] ERROR: Failed to load recording");
         return false;
     }
+    if (!mnPlayBeginStream(metadata, metadata->durationMs)) {
+        return false;
+    }
 
-    // Initialize playback session
-    mnPlaybackSession.state = MN_PLAY_READY;
-    mnPlaybackSession.timingBuffer = mnPlaybackTimingBuffer;
-    mnPlaybackSession.eventCount = eventCount;
-    mnPlaybackSession.currentIndex = 0;
-    mnPlaybackSession.startTime = 0;
-    mnPlaybackSession.speed = 1.0f;
-    mnPlaybackSession.toneFrequency = toneFreq;
-    mnPlaybackSession.metadata = metadata;
-
-    Serial.printf("[MorseNotes] Loaded recording: %s (%d events)\n",
-                  metadata->title, eventCount);
+    Serial.printf("[MorseNotes] Loaded recording: %s (%d events, streaming)\n",
+                  metadata->title, mnPlaybackSession.eventCount);
     return true;
 }
 
 /**
- * Initialize playback from recording buffer (for preview before save)
- * Uses the recording session's timing buffer directly
+ * Initialize playback of a finished but unsaved recording (save dialog
+ * preview), streamed from its file
  */
-bool mnInitPreviewPlayback(float* timingBuffer, int eventCount, int toneFreq) {
+bool mnInitPreviewPlayback(const char* filename, unsigned long totalMs) {
     // Stop any current playback
     if (mnPlaybackSession.state == MN_PLAY_PLAYING) {
         mnStopPlayback();
     }
+    mnUnloadPlayback();
 
-    if (eventCount == 0 || timingBuffer == nullptr) {
-        Serial.println("[MorseNotes] ERROR: No recording data for preview");
+    if (!mnEnsurePlaybackBuffer()) {
         return false;
     }
 
-    // Initialize playback session with recording buffer
-    mnPlaybackSession.state = MN_PLAY_READY;
-    mnPlaybackSession.timingBuffer = timingBuffer;
-    mnPlaybackSession.eventCount = eventCount;
-    mnPlaybackSession.currentIndex = 0;
-    mnPlaybackSession.startTime = 0;
-    mnPlaybackSession.speed = 1.0f;
-    mnPlaybackSession.toneFrequency = toneFreq;
-    mnPlaybackSession.metadata = nullptr;  // No metadata for preview
+    mnPlayFile = mnOpenRecordingFile(filename, mnPlayHeader);
+    if (!mnPlayFile || mnPlayHeader.eventCount == 0) {
+        mnUnloadPlayback();
+        Serial.println("[MorseNotes] ERROR: No recording data for preview");
+        return false;
+    }
+    if (!mnPlayBeginStream(nullptr, totalMs)) {  // No metadata for preview
+        return false;
+    }
 
-    Serial.printf("[MorseNotes] Preview initialized (%d events)\n", eventCount);
+    Serial.printf("[MorseNotes] Preview initialized (%d events)\n", mnPlaybackSession.eventCount);
     return true;
 }
 
 /**
- * Start playback
+ * Start playback (from a scrubbed position if one was set while stopped)
  */
 bool mnStartPlayback() {
     if (mnPlaybackSession.state != MN_PLAY_READY &&
@@ -136,9 +281,13 @@ bool mnStartPlayback() {
         return false;
     }
 
+    if (mnPlaybackSession.state == MN_PLAY_COMPLETE) {
+        mnPlaybackSession.currentIndex = 0;
+        mnPlaybackSession.positionMs = 0.0f;
+    }
     mnPlaybackSession.state = MN_PLAY_PLAYING;
-    mnPlaybackSession.currentIndex = 0;
-    mnPlaybackSession.startTime = millis();
+    mnPlaybackSession.startTime = millis() -
+        (unsigned long)(mnPlaybackSession.positionMs / mnPlaybackSession.speed);
 
     Serial.println("[MorseNotes] Playback started");
     return true;
@@ -154,6 +303,7 @@ void mnStopPlayback() {
 
     mnPlaybackSession.state = MN_PLAY_READY;
     mnPlaybackSession.currentIndex = 0;
+    mnPlaybackSession.positionMs = 0.0f;
 
     Serial.println("[MorseNotes] Playback stopped");
 }
@@ -271,22 +421,20 @@ void mnUpdatePlayback() {
     unsigned long elapsed = (unsigned long)((millis() - mnPlaybackSession.startTime) *
                                             mnPlaybackSession.speed);
 
-    // Calculate cumulative time to current index
-    float cumulativeTime = 0.0f;
-    for (int i = 0; i < mnPlaybackSession.currentIndex && i < mnPlaybackSession.eventCount; i++) {
-        cumulativeTime += abs(mnPlaybackSession.timingBuffer[i]);
-    }
-
     // Process events until we catch up to elapsed time
     while (mnPlaybackSession.currentIndex < mnPlaybackSession.eventCount) {
-        float eventValue = mnPlaybackSession.timingBuffer[mnPlaybackSession.currentIndex];
-        float eventDuration = abs(eventValue);
-
         // Check if this event should have happened by now
-        if (cumulativeTime > (float)elapsed) {
+        if (mnPlaybackSession.positionMs > (float)elapsed) {
             break;  // Wait for time to catch up
         }
 
+        float eventValue;
+        if (!mnPlayEventAt(mnPlaybackSession.currentIndex, eventValue)) {
+            // Unreadable block - end the recording here
+            mnPlaybackSession.eventCount = mnPlaybackSession.currentIndex;
+            break;
+        }
+
         // Process event
         if (eventValue > 0.0f) {
             // Positive = tone on
@@ -298,8 +446,75 @@ void mnUpdatePlayback() {
 
         // Move to next event
         mnPlaybackSession.currentIndex++;
-        cumulativeTime += eventDuration;
+        mnPlaybackSession.positionMs += fabsf(eventValue);
     }
+
+    mnPlayPrefetch();
+}
+
+// ===================================
+// SEEKING
+// ===================================
+
+/**
+ * Move playback to a recording time (scrubbing). Keeps playing if playing;
+ * when stopped, the next mnStartPlayback() starts from here.
+ */
+void mnSeekPlayback(unsigned long targetMs) {
+    if (mnPlaybackSession.state == MN_PLAY_IDLE || mnPlaybackSession.state == MN_PLAY_LOADING ||
+        mnPlaybackSession.state == MN_PLAY_ERROR) {
+        return;
+    }
+    bool playing = (mnPlaybackSession.state == MN_PLAY_PLAYING);
+    if (playing) requestStopTone();
+
+    int index = 0;
+    float position = 0.0f;
+
+    if (mnIsStreaming()) {
+        // Last indexed block starting at or before the target
+        int lo = 0, hi = (int)mnSeekIndex.size() - 1;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (mnSeekIndex[mid].startMs <= (float)targetMs) lo = mid;
+            else hi = mid - 1;
+        }
+        int number = lo;
+
+        // Past the indexed part: read forward, extending the index
+        while (number == (int)mnSeekIndex.size() - 1 && number + 1 < mnPlayBlockCount()) {
+            MorseNotesPlayBlock* block = mnPlayGetBlock(number);
+            if (!block || block->endMs > (float)targetMs) break;
+            number++;
+        }
+
+        MorseNotesPlayBlock* block = mnPlayGetBlock(number);
+        if (block) {
+            index = number * MN_PLAY_BLOCK_EVENTS;
+            position = block->startMs;
+            for (int i = 0; i < block->count; i++) {
+                float d = fabsf(block->events[i]);
+                if (position + d > (float)targetMs) break;
+                position += d;
+                index++;
+            }
+        }
+    }
+
+    mnPlaybackSession.currentIndex = index;
+    mnPlaybackSession.positionMs = position;
+    mnPlaybackSession.startTime = millis() - (unsigned long)(position / mnPlaybackSession.speed);
+    if (!playing) {
+        mnPlaybackSession.state = MN_PLAY_READY;
+    }
+}
+
+/**
+ * Scrub relative to the current position
+ */
+void mnSeekPlaybackBy(long deltaMs) {
+    long target = (long)mnPlaybackSession.positionMs + deltaMs;
+    mnSeekPlayback(target > 0 ? (unsigned long)target : 0);
 }
 
 // ===================================
@@ -322,17 +537,12 @@ float mnGetPlaybackProgress() {
  * Get playback elapsed time in milliseconds
  */
 unsigned long mnGetPlaybackElapsed() {
-    if (mnPlaybackSession.state != MN_PLAY_PLAYING) {
+    if (mnPlaybackSession.state == MN_PLAY_IDLE || mnPlaybackSession.state == MN_PLAY_ERROR) {
         return 0;
     }
 
-    // Calculate based on events processed
-    float cumulativeTime = 0.0f;
-    for (int i = 0; i < mnPlaybackSession.currentIndex && i < mnPlaybackSession.eventCount; i++) {
-        cumulativeTime += abs(mnPlaybackSession.timingBuffer[i]);
-    }
-
-    return (unsigned long)cumulativeTime;
+    // Tracked incrementally as events are played
+    return (unsigned long)mnPlaybackSession.positionMs;
 }
 
 /**
@@ -342,9 +552,7 @@ unsigned long mnGetPlaybackTotalDuration() {
     if (mnPlaybackSession.metadata) {
         return mnPlaybackSession.metadata->durationMs;
     }
-
-    return mnCalculateDuration(mnPlaybackSession.timingBuffer,
-                               mnPlaybackSession.eventCount);
+    return mnPlayTotalMs;
 }
 
 /**
@@ -15,36 +15,125 @@
 static MorseNotesRecordingSession mnRecordingSession;
 static MorseDecoder* mnRecordingDecoder = nullptr;  // For WPM calculation
 
-// Timing buffer allocated in PSRAM on first use (saves 40KB heap)
-static float* mnRecordingTimingBuffer = nullptr;
+// External tone control (from task_manager.h)
+extern void requestStartTone(int frequency);
+extern void requestStopTone();
+
+// External settings (from config)
+extern int cwTone;
+extern int cwSpeed;
 
-// Allocate recording buffer in PSRAM
+// ===================================
+// STREAMING WRITER
+// ===================================
+//
+// Recordings have no length limit: mnKeyerCallback() only appends to a
+// ring, and mnRecordingUpdate() drains it into the .mr file in
+// MN_V2_BLOCK_EVENTS blocks (format v2). The SD card shares the SPI bus
+// with the display, so the file is only touched from the loop task, at
+// most one block per call. RAM use is the ring plus one block, whatever the
+// length. mnStopRecording() writes the final partial block, then patches
+// the header.
+
+#define MN_REC_RING_EVENTS         1024     // Power of two; ~2 min of keying of headroom
+#define MN_REC_WRITER_PERIOD_MS    100
+#define MN_REC_SPACE_CHECK_MS      30000
+
+static float* mnRecRing = nullptr;              // PSRAM when available
+static uint32_t mnRecHead = 0;                  // Next event to queue
+static uint32_t mnRecTail = 0;                  // Next event to write
+static bool mnRecWriterFailed = false;          // Write error or SD full
+static File mnRecFile;
+static unsigned long mnRecLastWrite = 0;
+static unsigned long mnRecLastSpaceCheck = 0;
+
+// Allocate the ring (PSRAM when available)
 bool mnEnsureRecordingBuffer() {
-    if (mnRecordingTimingBuffer != nullptr) return true;
+    if (mnRecRing != nullptr) return true;
 
+    size_t bytes = MN_REC_RING_EVENTS * sizeof(float);
     if (psramFound()) {
-        mnRecordingTimingBuffer = (float*)ps_malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-        Serial.printf("[MorseNotes] Recording buffer allocated in PSRAM (%d bytes)\n",
-                      MN_MAX_RECORDING_EVENTS * sizeof(float));
-    } else {
-        mnRecordingTimingBuffer = (float*)malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-        Serial.println("[MorseNotes] WARNING: PSRAM not found, using heap for recording buffer");
+        mnRecRing = (float*)ps_malloc(bytes);
+    }
+    if (mnRecRing == nullptr) {
+        mnRecRing = (float*)malloc(bytes);
     }
 
-    if (mnRecordingTimingBuffer == nullptr) {
+    if (mnRecRing == nullptr) {
         Serial.println("[MorseNotes] ERROR: Failed to allocate recording buffer!");
         return false;
     }
+    Serial.printf("[MorseNotes] Recording ring allocated (%u bytes)\n", (unsigned)bytes);
     return true;
 }
 
-// External tone control (from task_manager.h)
-extern void requestStartTone(int frequency);
-extern void requestStopTone();
+/**
+ * Queue one event for the writer (keyer path; never touches the card)
+ */
+static void mnRecPush(float duration) {
+    if (mnRecHead - mnRecTail >= MN_REC_RING_EVENTS) {
+        mnRecordingSession.droppedCount++;
+        return;
+    }
+    mnRecRing[mnRecHead & (MN_REC_RING_EVENTS - 1)] = duration;
+    mnRecHead++;
 
-// External settings (from config)
-extern int cwTone;
-extern int cwSpeed;
+    mnRecordingSession.eventCount++;
+    mnRecordingSession.totalMs += fabsf(duration);
+}
+
+/**
+ * Encode and append `count` events from the ring
+ */
+static bool mnRecWriteFromRing(int count) {
+    static float block[MN_V2_BLOCK_EVENTS];
+    for (int i = 0; i < count; i++) {
+        block[i] = mnRecRing[(mnRecTail + i) & (MN_REC_RING_EVENTS - 1)];
+    }
+    if (mnWriteBlocks(mnRecFile, block, count, MN_DIT_QUANTIZE_DEFAULT) == 0) {
+        return false;
+    }
+    mnRecTail += count;
+    return true;
+}
+
+/**
+ * Write the next whole block, if one is ready. Call from loop().
+ */
+void mnRecordingUpdate() {
+    if (mnRecordingSession.state != MN_REC_RECORDING || mnRecWriterFailed) return;
+    if (millis() - mnRecLastWrite < MN_REC_WRITER_PERIOD_MS) return;
+    mnRecLastWrite = millis();
+
+    // Only whole blocks while recording (streaming playback relies on it)
+    if (mnRecHead - mnRecTail >= MN_V2_BLOCK_EVENTS &&
+        !mnRecWriteFromRing(MN_V2_BLOCK_EVENTS)) {
+        Serial.println("[MorseNotes] ERROR: Recording write failed");
+        mnRecWriterFailed = true;
+        return;
+    }
+
+    if (millis() - mnRecLastSpaceCheck >= MN_REC_SPACE_CHECK_MS) {
+        mnRecLastSpaceCheck = millis();
+        if (!mnCheckSpace(MN_RECORD_MIN_FREE_BYTES)) {
+            Serial.println("[MorseNotes] WARNING: SD card almost full");
+            mnRecWriterFailed = true;
+        }
+    }
+}
+
+static void mnRecWriteHeader() {
+    MorseNoteFileHeader header;
+    header.magic = MN_FILE_MAGIC;
+    header.version = MN_FILE_VERSION;
+    header.flags = MN_DIT_QUANTIZE_DEFAULT ? MN_FLAG_DIT_QUANTIZED : 0;
+    header.eventCount = mnRecTail;  // Events actually in the file
+    header.toneFrequency = (uint32_t)cwTone;
+    header.timestamp = (uint64_t)mnRecordingSession.timestamp;
+    float wpm = mnRecordingDecoder ? mnRecordingDecoder->getWPM() : 0.0f;
+    header.avgWPM = (wpm >= 5.0f) ? wpm : (float)cwSpeed;
+    mnRecFile.write((uint8_t*)&header, sizeof(header));
+}
 
 // ===================================
 // RECORDING CONTROL
@@ -60,26 +149,41 @@ bool mnStartRecording() {
         return false;
     }
 
-    // Ensure buffer is allocated (in PSRAM)
+    // Ensure ring is allocated (in PSRAM)
     if (!mnEnsureRecordingBuffer()) {
         Serial.println("[MorseNotes] ERROR: Failed to allocate recording buffer");
         return false;
     }
 
     // Check SD card space (minimum 500KB)
-    if (!mnCheckSpace(500000)) {
+    if (!mnLoadLibrary() || !mnCheckSpace(500000)) {
         Serial.println("[MorseNotes] ERROR: Insufficient SD card space");
         return false;
     }
 
+    // Create the file; the header is patched with the real counts on stop
+    time_t now = time(nullptr);
+    mnGenerateFilename((unsigned long)now, mnRecordingSession.filename,
+                       sizeof(mnRecordingSession.filename));
+    mnRecFile = SD.open(mnRecordingSession.filename, FILE_WRITE);
+    if (!mnRecFile) {
+        Serial.printf("[MorseNotes] ERROR: Failed to create file: %s\n", mnRecordingSession.filename);
+        return false;
+    }
+
     // Initialize session
     mnRecordingSession.state = MN_REC_RECORDING;
-    mnRecordingSession.timingBuffer = mnRecordingTimingBuffer;
     mnRecordingSession.eventCount = 0;
     mnRecordingSession.startTime = millis();
     mnRecordingSession.lastEventTime = 0;
     mnRecordingSession.keyState = false;
+    mnRecordingSession.timestamp = (unsigned long)now;
+    mnRecordingSession.totalMs = 0.0f;
+    mnRecordingSession.droppedCount = 0;
     memset(mnRecordingSession.title, 0, sizeof(mnRecordingSession.title));
+    mnRecHead = mnRecTail = 0;
+    mnRecWriterFailed = false;
+    mnRecLastWrite = mnRecLastSpaceCheck = millis();
 
     // Recreate decoder for WPM calculation (respects decoderType setting)
     delete mnRecordingDecoder;
@@ -88,12 +192,14 @@ bool mnStartRecording() {
         : (MorseDecoder*) new MorseDecoderAdaptive(20, 20, 30);
     mnRecordingDecoder->flush();
 
-    Serial.println("[MorseNotes] Recording started");
+    mnRecWriteHeader();
+
+    Serial.printf("[MorseNotes] Recording started: %s\n", mnRecordingSession.filename);
     return true;
 }
 
 /**
- * Stop recording
+ * Stop recording: flush the writer and finalize the file header
  */
 bool mnStopRecording() {
     if (mnRecordingSession.state != MN_REC_RECORDING) {
@@ -105,6 +211,29 @@ bool mnStopRecording() {
     requestStopTone();
 
     // Update state
+    mnRecordingSession.state = MN_REC_SAVING;
+
+    // Final flush: remaining whole blocks, then the partial one
+    while (!mnRecWriterFailed && mnRecHead != mnRecTail) {
+        int n = (int)min((uint32_t)MN_V2_BLOCK_EVENTS, mnRecHead - mnRecTail);
+        if (!mnRecWriteFromRing(n)) {
+            Serial.println("[MorseNotes] ERROR: Recording write failed");
+            mnRecWriterFailed = true;
+        }
+    }
+
+    // The header counts only the events that reached the file
+    mnRecFile.seek(0);
+    mnRecWriteHeader();
+    mnRecFile.close();
+
+    if (mnRecTail != (uint32_t)mnRecordingSession.eventCount || mnRecordingSession.droppedCount > 0) {
+        Serial.printf("[MorseNotes] WARNING: %u of %d events written, %u dropped\n",
+                      (unsigned)mnRecTail, mnRecordingSession.eventCount,
+                      (unsigned)mnRecordingSession.droppedCount);
+        mnRecordingSession.eventCount = (int)mnRecTail;
+    }
+
     mnRecordingSession.state = MN_REC_COMPLETE;
 
     Serial.printf("[MorseNotes] Recording stopped. Events: %d, Duration: %lu ms\n",
@@ -115,7 +244,8 @@ bool mnStopRecording() {
 }
 
 /**
- * Save recording with title
+ * Save recording with title (the file is already complete; this adds it
+ * to the library)
  */
 bool mnSaveRecording(const char* title) {
     if (mnRecordingSession.state != MN_REC_COMPLETE) {
@@ -124,7 +254,7 @@ bool mnSaveRecording(const char* title) {
     }
 
     if (mnRecordingSession.eventCount == 0) {
-        Serial.println("[MorseNotes] ERROR: Empty recording");
+        Serial.println("[MorseNotes] ERROR: No events recorded");
         return false;
     }
 
@@ -132,8 +262,7 @@ bool mnSaveRecording(const char* title) {
     const char* finalTitle = title;
     char defaultTitle[64];
     if (title == nullptr || strlen(title) == 0) {
-        time_t now = time(nullptr);
-        mnGenerateDefaultTitle((unsigned long)now, defaultTitle, sizeof(defaultTitle));
+        mnGenerateDefaultTitle(mnRecordingSession.timestamp, defaultTitle, sizeof(defaultTitle));
         finalTitle = defaultTitle;
     }
 
@@ -143,18 +272,20 @@ bool mnSaveRecording(const char* title) {
         avgWPM = (float)cwSpeed;  // Fall back to configured speed
     }
 
-    // Save to SD card
-    bool success = mnSaveRecording(
+    // Add to library
+    bool success = mnRegisterRecording(
+        mnRecordingSession.timestamp,
         finalTitle,
-        mnRecordingSession.timingBuffer,
+        (unsigned long)mnRecordingSession.totalMs,
         mnRecordingSession.eventCount,
+        avgWPM,
         cwTone,
-        avgWPM
+        ""
     );
 
     if (success) {
         mnRecordingSession.state = MN_REC_IDLE;
-        Serial.println("[MorseNotes] Recording saved successfully");
+        Serial.printf("[MorseNotes] Saved recording: %s\n", mnRecordingSession.filename);
     } else {
         Serial.println("[MorseNotes] ERROR: Failed to save recording");
     }
@@ -163,9 +294,12 @@ bool mnSaveRecording(const char* title) {
 }
 
 /**
- * Discard recording
+ * Discard recording (deletes the file unless it was saved)
  */
 void mnDiscardRecording() {
+    if (mnRecordingSession.state == MN_REC_COMPLETE && mnRecordingSession.filename[0]) {
+        SD.remove(mnRecordingSession.filename);
+    }
     mnRecordingSession.state = MN_REC_IDLE;
     mnRecordingSession.eventCount = 0;
     Serial.println("[MorseNotes] Recording discarded");
@@ -199,8 +333,7 @@ unsigned long mnGetRecordingDuration() {
     if (mnRecordingSession.state == MN_REC_RECORDING) {
         return millis() - mnRecordingSession.startTime;
     } else if (mnRecordingSession.state == MN_REC_COMPLETE) {
-        return mnCalculateDuration(mnRecordingSession.timingBuffer,
-                                   mnRecordingSession.eventCount);
+        return (unsigned long)mnRecordingSession.totalMs;
     }
     return 0;
 }
@@ -228,10 +361,10 @@ bool mnIsKeyDown() {
 }
 
 /**
- * Get recording timing buffer (for preview playback)
+ * Get the recording's file path (for preview playback)
  */
-float* mnGetRecordingTimingBuffer() {
-    return mnRecordingSession.timingBuffer;
+const char* mnGetRecordingFilename() {
+    return mnRecordingSession.filename;
 }
 
 // ===================================
@@ -251,17 +384,9 @@ void mnKeyerCallback(bool keyDown, unsigned long timestamp) {
         return;
     }
 
-    // Check buffer limit
-    if (mnRecordingSession.eventCount >= MN_MAX_RECORDING_EVENTS) {
-        Serial.println("[MorseNotes] WARNING: Event buffer full, stopping recording");
-        mnStopRecording();
-        return;
-    }
-
-    // Check duration limit
-    unsigned long elapsed = timestamp - mnRecordingSession.startTime;
-    if (elapsed >= MN_MAX_RECORDING_DURATION_MS) {
-        Serial.println("[MorseNotes] WARNING: Duration limit reached, stopping recording");
+    // Writer hit a write error or a full card
+    if (mnRecWriterFailed) {
+        Serial.println("[MorseNotes] WARNING: SD card write failed, stopping recording");
         mnStopRecording();
         return;
     }
@@ -271,7 +396,7 @@ void mnKeyerCallback(bool keyDown, unsigned long timestamp) {
         // Key down - add silence duration
         if (mnRecordingSession.lastEventTime > 0) {
             float silence = -(float)(timestamp - mnRecordingSession.lastEventTime);
-            mnRecordingSession.timingBuffer[mnRecordingSession.eventCount++] = silence;
+            mnRecPush(silence);
 
             // Feed to decoder for WPM calculation
             mnRecordingDecoder->addTiming(silence);
@@ -285,7 +410,7 @@ void mnKeyerCallback(bool keyDown, unsigned long timestamp) {
     else if (!keyDown && mnRecordingSession.keyState) {
         // Key up - add tone duration
         float tone = (float)(timestamp - mnRecordingSession.lastEventTime);
-        mnRecordingSession.timingBuffer[mnRecordingSession.eventCount++] = tone;
+        mnRecPush(tone);
 
         // Feed to decoder for WPM calculation
         mnRecordingDecoder->addTiming(tone);
@@ -314,31 +439,31 @@ void mnGetRecordingStats(char* buffer, size_t bufferSize) {
 
 /**
  * Get formatted recording duration string
- * Format: "MM:SS / 05:00"
+ * Format: "MM:SS", or "H:MM:SS" past an hour
  */
 void mnGetRecordingDurationString(char* buffer, size_t bufferSize) {
-    unsigned long elapsed = mnGetRecordingDuration();
-    unsigned long maxDuration = MN_MAX_RECORDING_DURATION_MS;
+    unsigned long elapsed = mnGetRecordingDuration() / 1000;
 
-    int elapsedMins = elapsed / 60000;
-    int elapsedSecs = (elapsed / 1000) % 60;
-    int maxMins = maxDuration / 60000;
-    int maxSecs = (maxDuration / 1000) % 60;
+    int hours = elapsed / 3600;
+    int mins = (elapsed / 60) % 60;
+    int secs = elapsed % 60;
 
-    snprintf(buffer, bufferSize, "%02d:%02d / %02d:%02d",
-             elapsedMins, elapsedSecs, maxMins, maxSecs);
+    if (hours > 0) {
+        snprintf(buffer, bufferSize, "%d:%02d:%02d", hours, mins, secs);
+    } else {
+        snprintf(buffer, bufferSize, "%02d:%02d", mins, secs);
+    }
 }
 
 /**
- * Check if recording should show warning (near limit)
+ * Check if recording should show warning (events dropped or SD card trouble)
  */
 bool mnShouldShowRecordingWarning() {
     if (mnRecordingSession.state != MN_REC_RECORDING) {
         return false;
     }
 
-    unsigned long elapsed = millis() - mnRecordingSession.startTime;
-    return elapsed >= MN_WARNING_TIME_MS;
+    return mnRecordingSession.droppedCount > 0 || mnRecWriterFailed;
 }
 
 #endif // MORSE_NOTES_RECORDER_H
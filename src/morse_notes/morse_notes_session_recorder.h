@@ -0,0 +1,286 @@
+#ifndef MORSE_NOTES_SESSION_RECORDER_H
+#define MORSE_NOTES_SESSION_RECORDER_H
+
+#include "morse_notes_types.h"
+#include "morse_notes_storage.h"
+#include "../audio/morse_decoder_adaptive.h"
+
+// ===================================
+// MORSE NOTES - MULTI-STATION SESSION RECORDER
+// ===================================
+//
+// Records a whole on-air session (e.g. a Vail repeater net) - received and
+// transmitted elements, each tagged with its sender and start offset - into
+// a .mr file with MN_FLAG_SENDER_TAGS set.
+//
+// Events are appended to one of two PSRAM blocks; a full block is handed to
+// mnSessionService(), which the owning mode calls from its loop when no tone
+// is active. The network/keyer path therefore only ever copies into RAM and
+// never waits on the SD card (which shares SPI2 with the display).
+
+#define MN_SESSION_BLOCK_EVENTS    256      // Events per double-buffer half
+
+extern int cwSpeed;
+
+struct MorseNotesSessionRecorder {
+    bool active;
+    File file;
+    char filename[64];
+    unsigned long startTimestamp;  // Unix seconds (file name + library id)
+    int64_t startMs;               // Session clock origin (caller's ms clock)
+    int64_t lastEndMs;             // End of the last recorded element
+    uint32_t eventCount;           // Events written or buffered
+    uint32_t droppedCount;         // Lost because both halves were full
+    int toneFrequency;
+    char senders[MN_MAX_SESSION_SENDERS][MN_SENDER_CALL_LEN];
+    int senderCount;
+    char titlePrefix[40];
+    char tags[128];
+
+    MorseNoteTaggedEvent* block[2];
+    int blockFill[2];
+    bool blockReady[2];            // Full, waiting for mnSessionService()
+    int activeBlock;
+};
+
+static MorseNotesSessionRecorder mnSession;
+static MorseDecoder* mnSessionDecoder = nullptr;  // For avg WPM only
+
+static bool mnSessionEnsureBlocks() {
+    for (int i = 0; i < 2; i++) {
+        if (mnSession.block[i] != nullptr) continue;
+        size_t bytes = MN_SESSION_BLOCK_EVENTS * sizeof(MorseNoteTaggedEvent);
+        mnSession.block[i] = (MorseNoteTaggedEvent*)(psramFound() ? ps_malloc(bytes) : malloc(bytes));
+        if (mnSession.block[i] == nullptr) {
+            Serial.println("[MorseNotes] ERROR: Failed to allocate session buffer");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Look up (or add) a sender in the session's table
+ * @return sender index; overflow senders share the last slot
+ */
+static uint8_t mnSessionSenderIndex(const char* callsign) {
+    for (int i = 0; i < mnSession.senderCount; i++) {
+        if (strncmp(mnSession.senders[i], callsign, MN_SENDER_CALL_LEN - 1) == 0) {
+            return (uint8_t)i;
+        }
+    }
+    if (mnSession.senderCount >= MN_MAX_SESSION_SENDERS) {
+        return MN_MAX_SESSION_SENDERS - 1;
+    }
+    strlcpy(mnSession.senders[mnSession.senderCount], callsign, MN_SENDER_CALL_LEN);
+    return (uint8_t)mnSession.senderCount++;
+}
+
+static void mnSessionWriteBlock(int b) {
+    if (mnSession.blockFill[b] > 0) {
+        mnSession.file.write((uint8_t*)mnSession.block[b],
+                             mnSession.blockFill[b] * sizeof(MorseNoteTaggedEvent));
+    }
+    mnSession.blockFill[b] = 0;
+    mnSession.blockReady[b] = false;
+}
+
+static void mnSessionWriteHeader() {
+    MorseNoteFileHeader header;
+    header.magic = MN_FILE_MAGIC;
+    header.version = MN_FILE_VERSION_V1;  // Tagged events are a v1 layout
+    header.flags = MN_FLAG_SENDER_TAGS;
+    header.eventCount = mnSession.eventCount;
+    header.toneFrequency = (uint32_t)mnSession.toneFrequency;
+    header.timestamp = (uint64_t)mnSession.startTimestamp;
+    float wpm = mnSessionDecoder ? mnSessionDecoder->getWPM() : 0.0f;
+    header.avgWPM = (wpm >= 5.0f) ? wpm : (float)cwSpeed;
+    mnSession.file.write((uint8_t*)&header, sizeof(header));
+}
+
+static void mnSessionPush(float duration, int64_t atMs, uint8_t sender, uint8_t flags) {
+    int b = mnSession.activeBlock;
+    if (mnSession.blockFill[b] >= MN_SESSION_BLOCK_EVENTS) {
+        int other = b ^ 1;
+        if (mnSession.blockReady[other]) {
+            // Writer hasn't caught up - drop rather than block the caller
+            mnSession.droppedCount++;
+            return;
+        }
+        mnSession.blockReady[b] = true;
+        mnSession.activeBlock = b = other;
+    }
+
+    MorseNoteTaggedEvent& e = mnSession.block[b][mnSession.blockFill[b]++];
+    e.duration = duration;
+    e.offsetMs = (atMs > mnSession.startMs) ? (uint32_t)(atMs - mnSession.startMs) : 0;
+    e.sender = sender;
+    e.flags = flags;
+    mnSession.eventCount++;
+
+    if (mnSessionDecoder) mnSessionDecoder->addTiming(duration);
+}
+
+// ===================================
+// PUBLIC API
+// ===================================
+
+/**
+ * Start a session recording
+ * @param localCallsign Sender 0 (the operator)
+ * @param nowMs Current time on the clock element timestamps will use
+ * @param toneFreq Tone frequency stored in the header
+ * @param titlePrefix Library title prefix (e.g. "Vail General")
+ * @param tags Library tags (e.g. "vail,General")
+ */
+bool mnSessionStart(const char* localCallsign, int64_t nowMs, int toneFreq,
+                    const char* titlePrefix, const char* tags) {
+    if (mnSession.active) return true;
+
+    if (!mnLoadLibrary() || !mnSessionEnsureBlocks()) {
+        return false;
+    }
+    if (!mnCheckSpace(500000)) {
+        Serial.println("[MorseNotes] ERROR: Insufficient SD card space");
+        return false;
+    }
+
+    time_t now = time(nullptr);
+    mnGenerateFilename((unsigned long)now, mnSession.filename, sizeof(mnSession.filename));
+    mnSession.file = SD.open(mnSession.filename, FILE_WRITE);
+    if (!mnSession.file) {
+        Serial.printf("[MorseNotes] ERROR: Failed to create file: %s\n", mnSession.filename);
+        return false;
+    }
+
+    mnSession.startTimestamp = (unsigned long)now;
+    mnSession.startMs = nowMs;
+    mnSession.lastEndMs = 0;
+    mnSession.eventCount = 0;
+    mnSession.droppedCount = 0;
+    mnSession.toneFrequency = toneFreq;
+    mnSession.senderCount = 0;
+    strlcpy(mnSession.titlePrefix, titlePrefix ? titlePrefix : "Session", sizeof(mnSession.titlePrefix));
+    strlcpy(mnSession.tags, tags ? tags : "", sizeof(mnSession.tags));
+    mnSession.blockFill[0] = mnSession.blockFill[1] = 0;
+    mnSession.blockReady[0] = mnSession.blockReady[1] = false;
+    mnSession.activeBlock = 0;
+    mnSessionSenderIndex(localCallsign);
+
+    // Placeholder header; eventCount is patched in mnSessionStop()
+    mnSessionWriteHeader();
+
+    delete mnSessionDecoder;
+    mnSessionDecoder = new MorseDecoderAdaptive(20, 20, 30);
+    mnSessionDecoder->flush();
+
+    mnSession.active = true;
+    Serial.printf("[MorseNotes] Session recording started: %s\n", mnSession.filename);
+    return true;
+}
+
+/**
+ * Record one transmission (a Vail message or a single keyed element)
+ * @param sender Sender callsign
+ * @param startMs Start of the first element on the session clock
+ * @param durations Alternating tone/silence durations in ms (tone first)
+ * @param count Number of durations
+ * @param tx true when keyed locally
+ */
+void mnSessionAddElements(const char* sender, int64_t startMs,
+                          const uint16_t* durations, int count, bool tx) {
+    if (!mnSession.active || count <= 0) return;
+
+    uint8_t idx = tx ? 0 : mnSessionSenderIndex(sender);
+    uint8_t flags = tx ? MN_EVT_TX : 0;
+
+    // Gap since the previous element becomes a silence, so the file still
+    // plays back as one continuous +tone/-silence stream. Overlapping senders
+    // are appended in arrival order; offsetMs keeps their true start times.
+    if (mnSession.lastEndMs > 0 && startMs > mnSession.lastEndMs) {
+        mnSessionPush(-(float)(startMs - mnSession.lastEndMs), mnSession.lastEndMs, idx, flags);
+    }
+
+    int64_t t = startMs;
+    for (int i = 0; i < count; i++) {
+        float d = (i % 2 == 0) ? (float)durations[i] : -(float)durations[i];
+        mnSessionPush(d, t, idx, flags);
+        t += durations[i];
+    }
+    if (t > mnSession.lastEndMs) mnSession.lastEndMs = t;
+}
+
+/**
+ * Write completed blocks to SD. Call from the mode's loop; pass
+ * canWrite=false while a tone is sounding to keep SD traffic out of it.
+ */
+void mnSessionService(bool canWrite) {
+    if (!mnSession.active || !canWrite) return;
+    for (int b = 0; b < 2; b++) {
+        if (mnSession.blockReady[b]) mnSessionWriteBlock(b);
+    }
+}
+
+/**
+ * Stop the session: flush buffers, append the sender table, patch the header
+ * and add the recording to the library
+ */
+bool mnSessionStop() {
+    if (!mnSession.active) return false;
+    mnSession.active = false;
+
+    // Older full block first, then the partially filled active one
+    int active = mnSession.activeBlock;
+    if (mnSession.blockReady[active ^ 1]) mnSessionWriteBlock(active ^ 1);
+    mnSessionWriteBlock(active);
+
+    uint16_t senderCount = (uint16_t)mnSession.senderCount;
+    mnSession.file.write((uint8_t*)&senderCount, sizeof(senderCount));
+    mnSession.file.write((uint8_t*)mnSession.senders, senderCount * MN_SENDER_CALL_LEN);
+
+    mnSession.file.seek(0);
+    mnSessionWriteHeader();
+    mnSession.file.close();
+
+    if (mnSession.droppedCount > 0) {
+        Serial.printf("[MorseNotes] WARNING: Session dropped %u events\n",
+                      (unsigned)mnSession.droppedCount);
+    }
+
+    if (mnSession.eventCount == 0) {
+        SD.remove(mnSession.filename);
+        Serial.println("[MorseNotes] Empty session discarded");
+        return false;
+    }
+
+    // Title: "<prefix> YYYYMMDD_HHMMSS", same date style as mnGenerateDefaultTitle()
+    char title[64];
+    struct tm timeinfo;
+    time_t ts = (time_t)mnSession.startTimestamp;
+    localtime_r(&ts, &timeinfo);
+    snprintf(title, sizeof(title), "%s %04d%02d%02d_%02d%02d%02d",
+             mnSession.titlePrefix,
+             timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+             timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+
+    float wpm = mnSessionDecoder ? mnSessionDecoder->getWPM() : 0.0f;
+    bool ok = mnRegisterRecording(mnSession.startTimestamp, title,
+                                  (unsigned long)(mnSession.lastEndMs - mnSession.startMs),
+                                  (int)mnSession.eventCount,
+                                  (wpm >= 5.0f) ? wpm : (float)cwSpeed,
+                                  mnSession.toneFrequency, mnSession.tags);
+
+    Serial.printf("[MorseNotes] Session saved: %s (%u events, %d senders)\n",
+                  mnSession.filename, (unsigned)mnSession.eventCount, mnSession.senderCount);
+    return ok;
+}
+
+bool mnSessionIsActive() {
+    return mnSession.active;
+}
+
+uint32_t mnSessionEventCount() {
+    return mnSession.eventCount;
+}
+
+#endif // MORSE_NOTES_SESSION_RECORDER_H
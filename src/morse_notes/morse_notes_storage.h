@@ -2,36 +2,112 @@
 #define MORSE_NOTES_STORAGE_H
 
 #include "morse_notes_types.h"
+#include "morse_notes_format.h"
 #include <SD.h>
 #include <ArduinoJson.h>
 #include <time.h>
+#include <stddef.h>
+#include "../storage/atomic_file.h"
 
 // ===================================
 // MORSE NOTES - STORAGE LAYER
 // ===================================
 
-// Global library state (allocated in PSRAM to save ~44KB internal RAM)
-static MorseNoteMetadata* mnLibrary = NULL;
+// ===================================
+// LIBRARY FILE FORMAT
+// ===================================
+//
+// /morse-notes/library.bin keeps one fixed 64-byte record per recording,
+// so a save, rename or delete rewrites one record instead of the whole
+// library:
+//
+//   MorseNoteLibraryHeader (64 bytes)
+//   MorseNoteLibraryRecord x slotCapacity (64 bytes each)
+//   string heap: titles and tags, append-only
+//
+// Header and records are 64-byte aligned so no write straddles an SD
+// sector, and each record carries a CRC32. A record torn by a reset is
+// rebuilt from its recording's .mr header on load, or, failing that,
+// quarantined: kept as is and never reused. Deleted slots are chained into a free list and reused. A rename
+// appends the new title to the heap and rewrites the record; the old bytes
+// are garbage until mnCompactLibrary() rewrites the file, which load does
+// once garbage outweighs live text.
+//
+// Loading reads the header and record region only. Titles and tags stay on
+// the card until asked for (mnGetMetadataPage() and friends), so callers get
+// MorseNoteMetadata copies rather than pointers into the library.
+// library.json from earlier firmware is imported once, then removed.
+
+#define MN_LIB_MAGIC               0x424C4E4D  // "MNLB"
+#define MN_LIB_VERSION             1
+#define MN_LIB_NO_SLOT             0xFFFFFFFF
+#define MN_LIB_RECORD_LIVE         0x01
+#define MN_LIB_COMPACT_MIN_BYTES   8192        // Garbage worth a rewrite
+
+struct __attribute__((packed)) MorseNoteLibraryHeader {
+    uint32_t magic;                // MN_LIB_MAGIC
+    uint16_t version;
+    uint16_t recordSize;           // sizeof(MorseNoteLibraryRecord)
+    uint32_t slotCapacity;         // Record slots before the string heap
+    uint32_t slotsUsed;            // High-water mark of allocated slots
+    uint32_t freeHead;             // First free slot below slotsUsed, or MN_LIB_NO_SLOT
+    uint8_t reserved[40];
+    uint32_t headerCrc;            // CRC32 of the fields above
+};
+
+struct __attribute__((packed)) MorseNoteLibraryRecord {
+    uint32_t id;                   // Unique ID (Unix timestamp)
+    uint32_t timestamp;
+    uint32_t durationMs;
+    uint32_t eventCount;
+    float avgWPM;
+    uint32_t titleOffset;          // Heap-relative
+    uint32_t tagsOffset;
+    uint32_t nextFree;             // Free list link (free slots only)
+    uint16_t toneFrequency;
+    uint8_t titleLen;
+    uint8_t tagsLen;
+    uint8_t flags;                 // MN_LIB_RECORD_LIVE
+    uint8_t reserved[23];
+    uint32_t crc;                  // CRC32 of the fields above
+};
+
+// Resident library state (records only, PSRAM when available)
+static MorseNoteLibraryRecord* mnLibrary = NULL;   // Indexed by slot
+static uint16_t* mnLibraryOrder = NULL;            // Live slots, oldest first
 static int mnLibraryCount = 0;
+static MorseNoteLibraryHeader mnLibraryHeader;
+static uint32_t mnLibraryGarbage = 0;              // Dead heap bytes
 static bool mnLibraryLoaded = false;
+static uint32_t mnLibraryGeneration = 0;           // Bumped on load, save and delete
 
 /**
- * Initialize mnLibrary array in PSRAM (or fallback to internal RAM)
+ * Initialize the library arrays in PSRAM (or fallback to internal RAM)
  * Must be called before any access to mnLibrary
  */
 void initMorseNotesStorage() {
     if (mnLibrary != NULL) return;  // Already initialized
 
-    mnLibrary = (MorseNoteMetadata*)ps_calloc(MN_MAX_RECORDINGS, sizeof(MorseNoteMetadata));
-    if (!mnLibrary) {
+    size_t recordBytes = MN_MAX_RECORDINGS * sizeof(MorseNoteLibraryRecord);
+    size_t orderBytes = MN_MAX_RECORDINGS * sizeof(uint16_t);
+    mnLibrary = (MorseNoteLibraryRecord*)ps_calloc(1, recordBytes);
+    mnLibraryOrder = (uint16_t*)ps_calloc(1, orderBytes);
+    if (!mnLibrary || !mnLibraryOrder) {
         Serial.println("[MorseNotes] PSRAM alloc failed, falling back to internal RAM");
-        mnLibrary = (MorseNoteMetadata*)calloc(MN_MAX_RECORDINGS, sizeof(MorseNoteMetadata));
+        free(mnLibrary);
+        free(mnLibraryOrder);
+        mnLibrary = (MorseNoteLibraryRecord*)calloc(1, recordBytes);
+        mnLibraryOrder = (uint16_t*)calloc(1, orderBytes);
     }
-    if (mnLibrary) {
+    if (mnLibrary && mnLibraryOrder) {
         Serial.printf("[MorseNotes] Library array allocated: %d bytes\n",
-                      MN_MAX_RECORDINGS * (int)sizeof(MorseNoteMetadata));
+                      (int)(recordBytes + orderBytes));
     } else {
         Serial.println("[MorseNotes] ERROR: Failed to allocate library array!");
+        free(mnLibrary);
+        free(mnLibraryOrder);
+        mnLibrary = NULL;
+        mnLibraryOrder = NULL;
     }
 }
 
@@ -58,6 +134,15 @@ void mnGenerateFilename(unsigned long timestamp, char* buffer, size_t bufferSize
              timeinfo.tm_sec);
 }
 
+/**
+ * Generate transcript sidecar filename from timestamp
+ * Format: /morse-notes/YYYYMMDD_HHMMSS.mrt (see morse_notes_transcript.h)
+ */
+void mnGenerateTranscriptFilename(unsigned long timestamp, char* buffer, size_t bufferSize) {
+    mnGenerateFilename(timestamp, buffer, bufferSize);
+    strlcat(buffer, "t", bufferSize);
+}
+
 /**
  * Generate default title from timestamp
  * Format: "Recording YYYYMMDD_HHMMSS"
@@ -77,7 +162,230 @@ void mnGenerateDefaultTitle(unsigned long timestamp, char* buffer, size_t buffer
 }
 
 // ===================================
-// LIBRARY JSON MANAGEMENT
+// LIBRARY FILE ACCESS
+// ===================================
+
+static uint32_t mnLibraryHeapEnd = 0;              // File size: heap appends go here
+
+static uint32_t mnLibRecordPos(uint32_t slot) {
+    return sizeof(MorseNoteLibraryHeader) + slot * sizeof(MorseNoteLibraryRecord);
+}
+
+static uint32_t mnLibHeapPos(const MorseNoteLibraryHeader& header) {
+    return mnLibRecordPos(header.slotCapacity);
+}
+
+static uint32_t mnLibRecordCrc(const MorseNoteLibraryRecord& rec) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&rec, offsetof(MorseNoteLibraryRecord, crc));
+}
+
+static uint32_t mnLibHeaderCrc(const MorseNoteLibraryHeader& header) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(MorseNoteLibraryHeader, headerCrc));
+}
+
+static bool mnLibRecordLive(const MorseNoteLibraryRecord& rec) {
+    return (rec.flags & MN_LIB_RECORD_LIVE) && rec.crc == mnLibRecordCrc(rec);
+}
+
+// Torn by a reset mid-write (slots never written read as zeros, not damaged)
+static bool mnLibRecordDamaged(const MorseNoteLibraryRecord& rec) {
+    static const MorseNoteLibraryRecord blank = {};
+    return rec.crc != mnLibRecordCrc(rec) && memcmp(&rec, &blank, sizeof(rec)) != 0;
+}
+
+static void mnLibInitHeader(MorseNoteLibraryHeader& header, uint32_t capacity) {
+    memset(&header, 0, sizeof(header));
+    header.magic = MN_LIB_MAGIC;
+    header.version = MN_LIB_VERSION;
+    header.recordSize = sizeof(MorseNoteLibraryRecord);
+    header.slotCapacity = capacity;
+    header.slotsUsed = 0;
+    header.freeHead = MN_LIB_NO_SLOT;
+}
+
+static bool mnLibHeaderValid(const MorseNoteLibraryHeader& header) {
+    return header.magic == MN_LIB_MAGIC && header.version == MN_LIB_VERSION &&
+           header.recordSize == sizeof(MorseNoteLibraryRecord) &&
+           header.headerCrc == mnLibHeaderCrc(header);
+}
+
+// Writers take a File (in-place updates) or the AtomicFileWriter of a rebuild
+
+template <typename F>
+static bool mnLibWriteHeader(F& file, MorseNoteLibraryHeader& header) {
+    header.headerCrc = mnLibHeaderCrc(header);
+    file.seek(0);
+    return file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header);
+}
+
+template <typename F>
+static bool mnLibWriteRecord(F& file, uint32_t slot, MorseNoteLibraryRecord& rec) {
+    rec.crc = mnLibRecordCrc(rec);
+    file.seek(mnLibRecordPos(slot));
+    return file.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+}
+
+/**
+ * Append a string to the heap at `heapEnd` (the end of the file)
+ */
+template <typename F>
+static bool mnLibAppendString(F& file, uint32_t heapPos, uint32_t& heapEnd,
+                              const char* str, size_t maxLen,
+                              uint32_t& offset, uint8_t& len) {
+    size_t n = str ? strnlen(str, maxLen) : 0;
+    offset = heapEnd - heapPos;
+    len = (uint8_t)n;
+    if (n == 0) return true;
+
+    file.seek(heapEnd);
+    if (file.write((const uint8_t*)str, n) != n) return false;
+    heapEnd += n;
+    return true;
+}
+
+/**
+ * Append a record's title and, unless `tags` is null, its tags
+ */
+template <typename F>
+static bool mnLibAppendStrings(F& file, uint32_t heapPos, uint32_t& heapEnd,
+                               MorseNoteLibraryRecord& rec, const char* title, const char* tags) {
+    uint32_t offset;
+    uint8_t len;
+    if (!mnLibAppendString(file, heapPos, heapEnd, title, sizeof(MorseNoteMetadata::title) - 1,
+                           offset, len)) {
+        return false;
+    }
+    rec.titleOffset = offset;
+    rec.titleLen = len;
+    if (tags == nullptr) return true;
+
+    if (!mnLibAppendString(file, heapPos, heapEnd, tags, sizeof(MorseNoteMetadata::tags) - 1,
+                           offset, len)) {
+        return false;
+    }
+    rec.tagsOffset = offset;
+    rec.tagsLen = len;
+    return true;
+}
+
+static void mnLibReadString(File& file, uint32_t offset, uint8_t len, char* out, size_t outSize) {
+    size_t n = min((size_t)len, outSize - 1);
+    file.seek(mnLibHeapPos(mnLibraryHeader) + offset);
+    if (n > 0 && file.read((uint8_t*)out, n) != n) n = 0;
+    out[n] = '\0';
+}
+
+static void mnLibFillMetadata(File& file, const MorseNoteLibraryRecord& rec, MorseNoteMetadata& out) {
+    out.id = rec.id;
+    out.timestamp = rec.timestamp;
+    out.durationMs = rec.durationMs;
+    out.eventCount = (int)rec.eventCount;
+    out.avgWPM = rec.avgWPM;
+    out.toneFrequency = rec.toneFrequency;
+    out.title[0] = '\0';
+    out.tags[0] = '\0';
+    if (file) {
+        mnLibReadString(file, rec.titleOffset, rec.titleLen, out.title, sizeof(out.title));
+        mnLibReadString(file, rec.tagsOffset, rec.tagsLen, out.tags, sizeof(out.tags));
+    }
+    if (out.title[0] == '\0') {
+        strlcpy(out.title, "Untitled", sizeof(out.title));
+    }
+}
+
+// List order: oldest first, as recordings were added
+static bool mnLibOrderLess(uint16_t a, uint16_t b) {
+    if (mnLibrary[a].timestamp != mnLibrary[b].timestamp) {
+        return mnLibrary[a].timestamp < mnLibrary[b].timestamp;
+    }
+    return mnLibrary[a].id < mnLibrary[b].id;
+}
+
+static void mnLibOrderInsert(uint16_t slot) {
+    int i = mnLibraryCount;
+    while (i > 0 && mnLibOrderLess(slot, mnLibraryOrder[i - 1])) {
+        mnLibraryOrder[i] = mnLibraryOrder[i - 1];
+        i--;
+    }
+    mnLibraryOrder[i] = slot;
+    mnLibraryCount++;
+}
+
+static void mnLibOrderRemove(uint16_t slot) {
+    for (int i = 0; i < mnLibraryCount; i++) {
+        if (mnLibraryOrder[i] == slot) {
+            memmove(&mnLibraryOrder[i], &mnLibraryOrder[i + 1],
+                    (mnLibraryCount - i - 1) * sizeof(uint16_t));
+            mnLibraryCount--;
+            return;
+        }
+    }
+}
+
+static int mnLibFindSlot(unsigned long id) {
+    if (!mnLibrary) return -1;
+    for (int i = 0; i < mnLibraryCount; i++) {
+        if (mnLibrary[mnLibraryOrder[i]].id == id) {
+            return mnLibraryOrder[i];
+        }
+    }
+    return -1;
+}
+
+// ===================================
+// LIBRARY FILE BUILDER
+// ===================================
+// Writes a fresh library.bin front to back (new library, library.json
+// import, compaction) through an AtomicFileWriter: the old copy stays in
+// place until the new one is complete. The file is plain (no atomic
+// header) since saves rewrite its records in place. The library header
+// still goes in last, so a torn build never validates.
+
+struct MorseNoteLibraryBuilder {
+    AtomicFileWriter out{SD, MN_LIBRARY_FILE, ATOMIC_FORMAT_PLAIN};
+    MorseNoteLibraryHeader header;
+    uint32_t heapEnd;
+};
+
+static bool mnLibBuildBegin(MorseNoteLibraryBuilder& b, uint32_t capacity) {
+    if (!b.out.begin()) {
+        Serial.println("[MorseNotes] ERROR: Failed to create " MN_LIBRARY_FILE);
+        return false;
+    }
+    mnLibInitHeader(b.header, capacity);
+
+    uint8_t zero[sizeof(MorseNoteLibraryRecord)] = {};
+    bool ok = b.out.write(zero, sizeof(MorseNoteLibraryHeader)) == sizeof(MorseNoteLibraryHeader);
+    for (uint32_t i = 0; i < capacity && ok; i++) {
+        ok = b.out.write(zero, sizeof(zero)) == sizeof(zero);
+    }
+    b.heapEnd = mnLibRecordPos(capacity);
+    return ok;
+}
+
+static bool mnLibBuildAdd(MorseNoteLibraryBuilder& b, MorseNoteLibraryRecord rec,
+                          const char* title, const char* tags) {
+    if (b.header.slotsUsed >= b.header.slotCapacity) return false;
+
+    if (!mnLibAppendStrings(b.out, mnLibHeapPos(b.header), b.heapEnd, rec, title, tags ? tags : "")) {
+        return false;
+    }
+    rec.flags = MN_LIB_RECORD_LIVE;
+    rec.nextFree = MN_LIB_NO_SLOT;
+    return mnLibWriteRecord(b.out, b.header.slotsUsed++, rec);
+}
+
+// Header, then swap the new file into place (false keeps the old copy)
+static bool mnLibBuildFinish(MorseNoteLibraryBuilder& b, bool ok) {
+    if (!ok || !mnLibWriteHeader(b.out, b.header)) {
+        b.out.abort();
+        return false;
+    }
+    return b.out.commit();
+}
+
+// ===================================
+// LIBRARY MANAGEMENT
 // ===================================
 
 /**
@@ -95,291 +403,490 @@ bool mnInitStorage() {
 }
 
 /**
- * Load library.json into memory
+ * Import library.json written by earlier firmware into library.bin
  */
-bool mnLoadLibrary() {
-    if (mnLibraryLoaded) {
-        return true;  // Already loaded
-    }
-
-    // Ensure library array is allocated
-    initMorseNotesStorage();
-    if (!mnLibrary) return false;
-
-    // Initialize directory
-    if (!mnInitStorage()) {
-        return false;
-    }
-
-    // Check if library file exists
-    if (!SD.exists(MN_LIBRARY_FILE)) {
-        Serial.println("[MorseNotes] No library file, starting fresh");
-        mnLibraryCount = 0;
-        mnLibraryLoaded = true;
-        return true;
-    }
-
-    // Open library file
-    File file = SD.open(MN_LIBRARY_FILE, FILE_READ);
+static bool mnLibImportJson() {
+    AtomicFileInfo info;
+    File file = atomicFileOpen(SD, MN_LIBRARY_JSON_FILE, &info);
     if (!file) {
-        Serial.println("[MorseNotes] ERROR: Failed to open library file");
+        Serial.println("[MorseNotes] ERROR: Failed to open library.json");
         return false;
     }
 
-    // Parse JSON
     JsonDocument doc;
     DeserializationError err = deserializeJson(doc, file);
     file.close();
-
     if (err) {
         Serial.printf("[MorseNotes] ERROR: JSON parse error: %s\n", err.c_str());
         return false;
     }
 
-    // Load recordings
-    JsonArray recordings = doc["recordings"];
-    mnLibraryCount = 0;
-
-    for (JsonObject rec : recordings) {
-        if (mnLibraryCount >= MN_MAX_RECORDINGS) {
+    MorseNoteLibraryBuilder b;
+    bool ok = mnLibBuildBegin(b, MN_MAX_RECORDINGS);
+    for (JsonObject item : doc["recordings"].as<JsonArray>()) {
+        if (!ok) break;
+        if (b.header.slotsUsed >= MN_MAX_RECORDINGS) {
             Serial.println("[MorseNotes] WARNING: Max recordings reached");
             break;
         }
+        MorseNoteLibraryRecord rec = {};
+        rec.id = item["id"] | 0;
+        rec.timestamp = item["timestamp"] | 0;
+        rec.durationMs = item["durationMs"] | 0;
+        rec.eventCount = item["eventCount"] | 0;
+        rec.avgWPM = item["avgWPM"] | 0.0f;
+        rec.toneFrequency = item["toneFrequency"] | 700;
+        ok = mnLibBuildAdd(b, rec, item["title"] | "Untitled", item["tags"] | "");
+    }
+    if (!mnLibBuildFinish(b, ok)) return false;
+
+    atomicFileRemove(SD, MN_LIBRARY_JSON_FILE);
+    Serial.printf("[MorseNotes] Imported %u recordings from library.json\n",
+                  (unsigned)b.header.slotsUsed);
+    return true;
+}
 
-        MorseNoteMetadata& meta = mnLibrary[mnLibraryCount];
-        meta.id = rec["id"] | 0;
-        strlcpy(meta.title, rec["title"] | "Untitled", sizeof(meta.title));
-        meta.timestamp = rec["timestamp"] | 0;
-        meta.durationMs = rec["durationMs"] | 0;
-        meta.eventCount = rec["eventCount"] | 0;
-        meta.avgWPM = rec["avgWPM"] | 0.0f;
-        meta.toneFrequency = rec["toneFrequency"] | 700;
-        strlcpy(meta.tags, rec["tags"] | "", sizeof(meta.tags));
+File mnOpenRecordingFile(const char* filename, MorseNoteFileHeader& header);
+int mnReadEventBlock(File& file, const MorseNoteFileHeader& header, int remaining, float* out);
+
+/**
+ * Rebuild a damaged record from the .mr file it names, if that file is on
+ * the card and no live record has it. The title falls back to the default
+ * and the duration is summed from the events.
+ */
+static bool mnLibRebuildRecord(File& lib, uint32_t slot) {
+    uint32_t ids[2] = {mnLibrary[slot].timestamp, mnLibrary[slot].id};
+    for (int c = 0; c < 2; c++) {
+        uint32_t ts = ids[c];
+        char filename[64];
+        mnGenerateFilename(ts, filename, sizeof(filename));
+        if (ts == 0 || mnLibFindSlot(ts) >= 0 || !SD.exists(filename)) continue;
+
+        MorseNoteFileHeader header;
+        File file = mnOpenRecordingFile(filename, header);
+        if (!file) continue;
+        if (header.timestamp != ts) {
+            file.close();
+            continue;
+        }
+        static float block[MN_V2_BLOCK_EVENTS];
+        float totalMs = 0.0f;
+        int remaining = (int)header.eventCount;
+        int n;
+        while (remaining > 0 && (n = mnReadEventBlock(file, header, remaining, block)) > 0) {
+            for (int i = 0; i < n; i++) totalMs += fabsf(block[i]);
+            remaining -= n;
+        }
+        file.close();
 
-        mnLibraryCount++;
+        MorseNoteLibraryRecord rec = {};
+        rec.id = ts;
+        rec.timestamp = ts;
+        rec.durationMs = (uint32_t)totalMs;
+        rec.eventCount = header.eventCount - (uint32_t)remaining;
+        rec.avgWPM = header.avgWPM;
+        rec.toneFrequency = (uint16_t)header.toneFrequency;
+        rec.flags = MN_LIB_RECORD_LIVE;
+        rec.nextFree = MN_LIB_NO_SLOT;
+        char title[sizeof(MorseNoteMetadata::title)];
+        mnGenerateDefaultTitle(ts, title, sizeof(title));
+        if (!mnLibAppendStrings(lib, mnLibHeapPos(mnLibraryHeader), mnLibraryHeapEnd, rec, title, "") ||
+            !mnLibWriteRecord(lib, slot, rec)) {
+            return false;
+        }
+        mnLibrary[slot] = rec;
+        mnLibOrderInsert((uint16_t)slot);
+        Serial.printf("[MorseNotes] Rebuilt library record for %s\n", filename);
+        return true;
     }
+    return false;
+}
 
-    Serial.printf("[MorseNotes] Loaded %d recordings\n", mnLibraryCount);
-    mnLibraryLoaded = true;
-    return true;
+/**
+ * Rebuild the on-card free list from the resident records (after a reset
+ * interrupted a save or delete). Damaged records are rebuilt from their
+ * recordings where possible; the rest stay quarantined, off the free list.
+ */
+static bool mnLibRepairFreeList() {
+    File file = SD.open(MN_LIBRARY_FILE, "r+");
+    if (!file) return false;
+
+    bool ok = true;
+    int quarantined = 0;
+    uint32_t head = MN_LIB_NO_SLOT;
+    for (int32_t s = (int32_t)mnLibraryHeader.slotsUsed - 1; s >= 0 && ok; s--) {
+        if (mnLibRecordLive(mnLibrary[s])) continue;
+        if (mnLibRecordDamaged(mnLibrary[s])) {
+            if (!mnLibRebuildRecord(file, (uint32_t)s)) quarantined++;
+            continue;
+        }
+        MorseNoteLibraryRecord rec = {};
+        rec.nextFree = head;
+        ok = mnLibWriteRecord(file, (uint32_t)s, rec);
+        mnLibrary[s] = rec;
+        head = (uint32_t)s;
+    }
+    mnLibraryHeader.freeHead = head;
+    ok = ok && mnLibWriteHeader(file, mnLibraryHeader);
+    file.close();
+    Serial.println("[MorseNotes] Repaired library free list");
+    if (quarantined > 0) {
+        Serial.printf("[MorseNotes] WARNING: %d damaged library records quarantined\n", quarantined);
+    }
+    return ok;
 }
 
 /**
- * Save library to library.json (atomic write)
+ * True if the free list covers every free slot below slotsUsed exactly once
+ * (`damaged` slots are on neither list)
  */
-bool mnSaveLibrary() {
+static bool mnLibFreeListValid(uint32_t damaged) {
+    uint32_t used = mnLibraryHeader.slotsUsed;
+    uint32_t expected = used - (uint32_t)mnLibraryCount - damaged;
+    uint8_t seen[MN_MAX_RECORDINGS] = {};
+    uint32_t n = 0;
+    for (uint32_t s = mnLibraryHeader.freeHead; s != MN_LIB_NO_SLOT; s = mnLibrary[s].nextFree) {
+        if (s >= used || seen[s] || mnLibRecordLive(mnLibrary[s]) ||
+            mnLibRecordDamaged(mnLibrary[s]) || ++n > expected) {
+            return false;
+        }
+        seen[s] = 1;
+    }
+    return n == expected;
+}
+
+bool mnCompactLibrary();
+
+/**
+ * Load the library record region into memory (titles and tags stay on SD)
+ */
+bool mnLoadLibrary() {
+    if (mnLibraryLoaded) {
+        return true;  // Already loaded
+    }
+
+    // Ensure library array is allocated
+    initMorseNotesStorage();
     if (!mnLibrary) return false;
 
-    // Open temp file
-    File file = SD.open(MN_LIBRARY_TMP_FILE, FILE_WRITE);
-    if (!file) {
-        Serial.println("[MorseNotes] ERROR: Failed to open temp file");
+    // Initialize directory
+    if (!mnInitStorage()) {
         return false;
     }
 
-    // Create JSON document
-    JsonDocument doc;
-    doc["version"] = "1.0";
-    doc["lastModified"] = (unsigned long)(millis() / 1000);
+    atomicFileRecover(SD, MN_LIBRARY_FILE);  // Finish a rebuild a reset interrupted
+    if (!SD.exists(MN_LIBRARY_FILE)) {
+        if (SD.exists(MN_LIBRARY_JSON_FILE)) {
+            if (!mnLibImportJson()) {
+                Serial.println("[MorseNotes] ERROR: Failed to import library.json");
+                return false;
+            }
+        } else {
+            Serial.println("[MorseNotes] No library file, starting fresh");
+            MorseNoteLibraryBuilder b;
+            bool created = mnLibBuildBegin(b, MN_MAX_RECORDINGS);
+            if (!mnLibBuildFinish(b, created)) {
+                Serial.println("[MorseNotes] ERROR: Failed to create library file");
+                return false;
+            }
+        }
+    } else if (SD.exists(MN_LIBRARY_JSON_FILE)) {
+        atomicFileRemove(SD, MN_LIBRARY_JSON_FILE);  // Import finished just before a reset
+    }
 
-    JsonArray recordings = doc["recordings"].to<JsonArray>();
+    File file = atomicFileOpen(SD, MN_LIBRARY_FILE);
+    if (!file) {
+        Serial.println("[MorseNotes] ERROR: Failed to open library file");
+        return false;
+    }
 
-    for (int i = 0; i < mnLibraryCount; i++) {
-        MorseNoteMetadata& meta = mnLibrary[i];
-        JsonObject rec = recordings.add<JsonObject>();
-
-        rec["id"] = meta.id;
-        rec["title"] = meta.title;
-        rec["timestamp"] = meta.timestamp;
-        rec["durationMs"] = meta.durationMs;
-        rec["eventCount"] = meta.eventCount;
-        rec["avgWPM"] = meta.avgWPM;
-        rec["toneFrequency"] = meta.toneFrequency;
-        rec["tags"] = meta.tags;
-
-        // Also include filename for web API convenience
-        char filename[64];
-        mnGenerateFilename(meta.timestamp, filename, sizeof(filename));
-        rec["filename"] = filename + strlen(MN_DIR) + 1;  // Strip "/morse-notes/"
+    MorseNoteLibraryHeader header;
+    bool headerOk = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+                    mnLibHeaderValid(header);
+    if (!headerOk) {
+        // Only the capacity can't be rebuilt from the records
+        Serial.println("[MorseNotes] WARNING: Library header damaged, rebuilding");
+        mnLibInitHeader(header, MN_MAX_RECORDINGS);
     }
+    mnLibraryHeader = header;
 
-    // Write JSON
-    serializeJson(doc, file);
+    uint32_t slots = min(header.slotCapacity, (uint32_t)MN_MAX_RECORDINGS);
+    memset(mnLibrary, 0, MN_MAX_RECORDINGS * sizeof(MorseNoteLibraryRecord));
+    file.seek(mnLibRecordPos(0));
+    file.read((uint8_t*)mnLibrary, slots * sizeof(MorseNoteLibraryRecord));  // Short file: rest reads free
+    mnLibraryHeapEnd = max((uint32_t)file.size(), mnLibHeapPos(header));
     file.close();
 
-    // Atomic rename
-    if (SD.exists(MN_LIBRARY_FILE)) {
-        SD.remove(MN_LIBRARY_FILE);
+    // Live records, in list order
+    mnLibraryCount = 0;
+    uint32_t highest = 0;
+    uint32_t liveText = 0;
+    uint32_t damaged = 0;
+    for (uint32_t s = 0; s < slots; s++) {
+        if (mnLibRecordLive(mnLibrary[s])) {
+            mnLibOrderInsert((uint16_t)s);
+            highest = s + 1;
+            liveText += mnLibrary[s].titleLen + mnLibrary[s].tagsLen;
+        } else if (mnLibRecordDamaged(mnLibrary[s])) {
+            highest = s + 1;
+            damaged++;
+        }
     }
-    if (!SD.rename(MN_LIBRARY_TMP_FILE, MN_LIBRARY_FILE)) {
-        Serial.println("[MorseNotes] ERROR: Failed to rename temp file");
-        return false;
+    mnLibraryHeader.slotsUsed = max(highest, min(mnLibraryHeader.slotsUsed, slots));
+    uint32_t heapBytes = mnLibraryHeapEnd - mnLibHeapPos(header);
+    mnLibraryGarbage = (heapBytes > liveText) ? heapBytes - liveText : 0;
+    mnLibraryLoaded = true;
+    mnLibraryGeneration++;
+
+    if (!headerOk || damaged > 0 || mnLibraryHeader.slotsUsed != header.slotsUsed ||
+        !mnLibFreeListValid(damaged)) {
+        mnLibRepairFreeList();
     }
 
-    Serial.println("[MorseNotes] Library saved successfully");
+    Serial.printf("[MorseNotes] Loaded %d recordings\n", mnLibraryCount);
+
+    // Reclaim heap garbage, or move to a changed MN_MAX_RECORDINGS
+    if ((mnLibraryGarbage > MN_LIB_COMPACT_MIN_BYTES && mnLibraryGarbage > liveText) ||
+        header.slotCapacity != MN_MAX_RECORDINGS) {
+        mnCompactLibrary();
+    }
     return true;
 }
 
-// ===================================
-// BINARY FILE I/O
-// ===================================
+/**
+ * Rewrite library.bin with no free slots or heap garbage, at the current
+ * MN_MAX_RECORDINGS capacity (see LIBRARY FILE BUILDER). Quarantined
+ * records are carried over unchanged.
+ */
+bool mnCompactLibrary() {
+    if (!mnLibraryLoaded) return false;
+
+    File src = SD.open(MN_LIBRARY_FILE, FILE_READ);
+    if (!src) return false;
+
+    MorseNoteLibraryBuilder b;
+    bool ok = mnLibBuildBegin(b, MN_MAX_RECORDINGS);
+    char title[sizeof(MorseNoteMetadata::title)];
+    char tags[sizeof(MorseNoteMetadata::tags)];
+    for (int i = 0; i < mnLibraryCount && ok; i++) {
+        const MorseNoteLibraryRecord& rec = mnLibrary[mnLibraryOrder[i]];
+        mnLibReadString(src, rec.titleOffset, rec.titleLen, title, sizeof(title));
+        mnLibReadString(src, rec.tagsOffset, rec.tagsLen, tags, sizeof(tags));
+        ok = mnLibBuildAdd(b, rec, title, tags);
+    }
+    src.close();
+    for (uint32_t s = 0; s < mnLibraryHeader.slotsUsed && ok; s++) {
+        if (!mnLibRecordDamaged(mnLibrary[s])) continue;
+        ok = b.header.slotsUsed < b.header.slotCapacity &&
+             b.out.seek(mnLibRecordPos(b.header.slotsUsed++)) &&
+             b.out.write((const uint8_t*)&mnLibrary[s], sizeof(MorseNoteLibraryRecord)) ==
+                 sizeof(MorseNoteLibraryRecord);
+    }
+
+    if (!mnLibBuildFinish(b, ok)) {
+        Serial.println("[MorseNotes] ERROR: Library compaction failed");
+        return false;
+    }
+
+    Serial.printf("[MorseNotes] Library compacted (%u bytes reclaimed)\n",
+                  (unsigned)mnLibraryGarbage);
+    mnLibraryLoaded = false;
+    return mnLoadLibrary();
+}
 
 /**
- * Save recording to binary .mr file
- * @param title User-provided title
- * @param timings Array of timing events
- * @param eventCount Number of events
- * @param toneFreq Tone frequency used
- * @param avgWPM Average WPM
- * @return true if successful
+ * Add a library record for a recording file that is already on SD
+ * (one record write plus the header)
+ * @return true if the record was written
  */
-bool mnSaveRecording(const char* title, const float* timings, int eventCount,
-                     int toneFreq, float avgWPM) {
-    // Ensure library is loaded
+bool mnRegisterRecording(unsigned long timestamp, const char* title,
+                         unsigned long durationMs, int eventCount,
+                         float avgWPM, int toneFreq, const char* tags) {
     if (!mnLoadLibrary()) {
         return false;
     }
 
-    // Check if we have space
-    if (mnLibraryCount >= MN_MAX_RECORDINGS) {
+    // Reuse a freed slot before growing
+    uint32_t slot = mnLibraryHeader.freeHead;
+    bool reused = (slot != MN_LIB_NO_SLOT);
+    if (!reused) {
+        slot = mnLibraryHeader.slotsUsed;
+    }
+    if (mnLibraryCount >= MN_MAX_RECORDINGS ||
+        slot >= min(mnLibraryHeader.slotCapacity, (uint32_t)MN_MAX_RECORDINGS)) {
         Serial.println("[MorseNotes] ERROR: Library full");
         return false;
     }
 
-    // Generate timestamp and filename
-    time_t now = time(nullptr);
-    char filename[64];
-    mnGenerateFilename((unsigned long)now, filename, sizeof(filename));
-
-    // Calculate duration
-    unsigned long durationMs = mnCalculateDuration(timings, eventCount);
-
-    // Open file
-    File file = SD.open(filename, FILE_WRITE);
+    File file = SD.open(MN_LIBRARY_FILE, "r+");
     if (!file) {
-        Serial.printf("[MorseNotes] ERROR: Failed to create file: %s\n", filename);
+        Serial.println("[MorseNotes] ERROR: Failed to open library file");
         return false;
     }
 
-    // Write header
-    MorseNoteFileHeader header;
-    header.magic = MN_FILE_MAGIC;
-    header.version = MN_FILE_VERSION;
-    header.flags = 0;
-    header.eventCount = (uint32_t)eventCount;
-    header.toneFrequency = (uint32_t)toneFreq;
-    header.timestamp = (uint64_t)now;
-    header.avgWPM = avgWPM;
-
-    file.write((uint8_t*)&header, sizeof(header));
-
-    // Write timing array
-    file.write((uint8_t*)timings, eventCount * sizeof(float));
-
+    MorseNoteLibraryRecord rec = {};
+    rec.id = timestamp;
+    rec.timestamp = timestamp;
+    rec.durationMs = durationMs;
+    rec.eventCount = (uint32_t)eventCount;
+    rec.avgWPM = avgWPM;
+    rec.toneFrequency = (uint16_t)toneFreq;
+    rec.flags = MN_LIB_RECORD_LIVE;
+    rec.nextFree = MN_LIB_NO_SLOT;
+
+    // Strings first: the record only becomes live once they are on the card
+    bool ok = mnLibAppendStrings(file, mnLibHeapPos(mnLibraryHeader), mnLibraryHeapEnd,
+                                 rec, title, tags ? tags : "");
+    file.flush();
+    ok = ok && mnLibWriteRecord(file, slot, rec);
+    if (ok) {
+        if (reused) {
+            mnLibraryHeader.freeHead = mnLibrary[slot].nextFree;
+        } else {
+            mnLibraryHeader.slotsUsed = slot + 1;
+        }
+        if (!mnLibWriteHeader(file, mnLibraryHeader)) {
+            Serial.println("[MorseNotes] WARNING: Failed to update library header");
+        }
+    }
     file.close();
 
-    // Add to library
-    MorseNoteMetadata& meta = mnLibrary[mnLibraryCount];
-    meta.id = (unsigned long)now;
-    strlcpy(meta.title, title, sizeof(meta.title));
-    meta.timestamp = (unsigned long)now;
-    meta.durationMs = durationMs;
-    meta.eventCount = eventCount;
-    meta.avgWPM = avgWPM;
-    meta.toneFrequency = toneFreq;
-    meta.tags[0] = '\0';
+    if (!ok) {
+        Serial.println("[MorseNotes] ERROR: Failed to write library record");
+        return false;
+    }
 
-    mnLibraryCount++;
+    mnLibrary[slot] = rec;
+    mnLibOrderInsert((uint16_t)slot);
+    mnLibraryGeneration++;
+    Serial.println("[MorseNotes] Library saved successfully");
+    return true;
+}
 
-    // Save library
-    if (!mnSaveLibrary()) {
-        Serial.println("[MorseNotes] WARNING: Failed to update library");
-    }
+// ===================================
+// METADATA ACCESS
+// ===================================
+// Metadata is copied out: titles and tags are read from the card on
+// demand, so there is nothing resident to point at.
 
-    Serial.printf("[MorseNotes] Saved recording: %s\n", filename);
+/**
+ * Get metadata by ID
+ */
+bool mnGetMetadata(unsigned long id, MorseNoteMetadata& out) {
+    int slot = mnLibFindSlot(id);
+    if (slot < 0) return false;
+
+    File file = SD.open(MN_LIBRARY_FILE, FILE_READ);
+    mnLibFillMetadata(file, mnLibrary[slot], out);
+    file.close();
     return true;
 }
 
 /**
- * Load recording from binary .mr file
- * @param id Recording ID (timestamp)
- * @param timings Output buffer for timing events (must be preallocated)
- * @param maxEvents Maximum events buffer can hold
- * @param eventCount Output: actual number of events loaded
- * @param toneFreq Output: tone frequency
- * @param metadata Output: pointer to metadata in library
- * @return true if successful
+ * Get metadata by list index (oldest first)
  */
-bool mnLoadRecording(unsigned long id, float* timings, int maxEvents,
-                     int& eventCount, int& toneFreq, MorseNoteMetadata** metadata) {
-    if (!mnLibrary) return false;
+bool mnGetMetadataByIndex(int index, MorseNoteMetadata& out) {
+    if (!mnLibrary || index < 0 || index >= mnLibraryCount) return false;
+    return mnGetMetadata(mnLibrary[mnLibraryOrder[index]].id, out);
+}
 
-    // Find metadata
-    *metadata = nullptr;
-    for (int i = 0; i < mnLibraryCount; i++) {
-        if (mnLibrary[i].id == id) {
-            *metadata = &mnLibrary[i];
-            break;
-        }
-    }
+/**
+ * Get a page of metadata starting at list index `first` (one file open)
+ * @return entries filled
+ */
+int mnGetMetadataPage(int first, MorseNoteMetadata* out, int maxCount) {
+    if (!mnLibrary || first < 0 || first >= mnLibraryCount) return 0;
 
-    if (*metadata == nullptr) {
-        Serial.printf("[MorseNotes] ERROR: Recording not found: %lu\n", id);
-        return false;
+    int n = min(maxCount, mnLibraryCount - first);
+    File file = SD.open(MN_LIBRARY_FILE, FILE_READ);
+    for (int i = 0; i < n; i++) {
+        mnLibFillMetadata(file, mnLibrary[mnLibraryOrder[first + i]], out[i]);
     }
+    file.close();
+    return n;
+}
 
-    // Generate filename
-    char filename[64];
-    mnGenerateFilename((*metadata)->timestamp, filename, sizeof(filename));
+/**
+ * Get library count
+ */
+int mnGetLibraryCount() {
+    return mnLibraryCount;
+}
+
+// ===================================
+// BINARY FILE I/O
+// ===================================
 
-    // Open file
+/**
+ * Open a .mr file and validate its header
+ * @param filename File path
+ * @param header Output: file header
+ * @return File positioned after the header, or an invalid File on error
+ */
+File mnOpenRecordingFile(const char* filename, MorseNoteFileHeader& header) {
     File file = SD.open(filename, FILE_READ);
     if (!file) {
         Serial.printf("[MorseNotes] ERROR: Failed to open file: %s\n", filename);
-        return false;
+        return File();
     }
 
-    // Read and validate header
-    MorseNoteFileHeader header;
     if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) {
         Serial.println("[MorseNotes] ERROR: Failed to read header");
         file.close();
-        return false;
+        return File();
     }
 
     if (header.magic != MN_FILE_MAGIC) {
         Serial.printf("[MorseNotes] ERROR: Invalid magic: 0x%08X\n", header.magic);
         file.close();
-        return false;
-    }
-
-    if (header.version != MN_FILE_VERSION) {
-        Serial.printf("[MorseNotes] WARNING: Version mismatch: 0x%04X\n", header.version);
+        return File();
     }
 
-    // Check event count
-    if (header.eventCount > (uint32_t)maxEvents) {
-        Serial.printf("[MorseNotes] ERROR: Event count too large: %u > %d\n",
-                      header.eventCount, maxEvents);
+    if (header.version > MN_FILE_VERSION) {
+        Serial.printf("[MorseNotes] ERROR: Unsupported version: 0x%04X\n", header.version);
         file.close();
-        return false;
+        return File();
     }
+    return file;
+}
 
-    // Read timing array
-    eventCount = (int)header.eventCount;
-    toneFreq = (int)header.toneFrequency;
+/**
+ * Open a library recording's .mr file (see mnOpenRecordingFile)
+ */
+File mnOpenRecording(const MorseNoteMetadata* meta, MorseNoteFileHeader& header,
+                     char* filename, size_t filenameSize) {
+    mnGenerateFilename(meta->timestamp, filename, filenameSize);
+    return mnOpenRecordingFile(filename, header);
+}
 
-    size_t bytesToRead = eventCount * sizeof(float);
-    if (file.read((uint8_t*)timings, bytesToRead) != bytesToRead) {
-        Serial.println("[MorseNotes] ERROR: Failed to read timing array");
-        file.close();
-        return false;
+/**
+ * Read the next block of events from a file opened by mnOpenRecording()
+ * (any version). v1 files are read in MN_V2_BLOCK_EVENTS chunks so block
+ * numbering is the same for every version.
+ * @param remaining Events left in the recording
+ * @param out Room for MN_V2_BLOCK_EVENTS events
+ * @return events read, -1 on a short read or bad block
+ */
+int mnReadEventBlock(File& file, const MorseNoteFileHeader& header, int remaining, float* out) {
+    int expected = min(MN_V2_BLOCK_EVENTS, remaining);
+    if (expected <= 0) return 0;
+
+    if (header.version >= MN_FILE_VERSION) {
+        int n = mnReadBlock(file, out);
+        return (n == expected) ? n : -1;
+    }
+    if (header.flags & MN_FLAG_SENDER_TAGS) {
+        MorseNoteTaggedEvent chunk[32];
+        for (int done = 0; done < expected; ) {
+            int n = min(32, expected - done);
+            size_t bytes = n * sizeof(MorseNoteTaggedEvent);
+            if (file.read((uint8_t*)chunk, bytes) != bytes) return -1;
+            for (int i = 0; i < n; i++) out[done++] = chunk[i].duration;
+        }
+        return expected;
     }
-
-    file.close();
-
-    Serial.printf("[MorseNotes] Loaded %d events from: %s\n", eventCount, filename);
-    return true;
+    size_t bytes = expected * sizeof(float);
+    return (file.read((uint8_t*)out, bytes) == bytes) ? expected : -1;
 }
 
 // ===================================
@@ -387,28 +894,18 @@ bool mnLoadRecording(unsigned long id, float* timings, int maxEvents,
 // ===================================
 
 /**
- * Delete recording
+ * Delete recording (the freed slot goes on the free list)
  */
 bool mnDeleteRecording(unsigned long id) {
-    if (!mnLibrary) return false;
-
-    // Find in library
-    int index = -1;
-    for (int i = 0; i < mnLibraryCount; i++) {
-        if (mnLibrary[i].id == id) {
-            index = i;
-            break;
-        }
-    }
-
-    if (index < 0) {
+    int slot = mnLibFindSlot(id);
+    if (slot < 0) {
         Serial.printf("[MorseNotes] ERROR: Recording not found: %lu\n", id);
         return false;
     }
 
     // Generate filename
     char filename[64];
-    mnGenerateFilename(mnLibrary[index].timestamp, filename, sizeof(filename));
+    mnGenerateFilename(mnLibrary[slot].timestamp, filename, sizeof(filename));
 
     // Delete file
     if (SD.exists(filename)) {
@@ -418,66 +915,61 @@ bool mnDeleteRecording(unsigned long id) {
         }
     }
 
-    // Remove from library array
-    for (int i = index; i < mnLibraryCount - 1; i++) {
-        mnLibrary[i] = mnLibrary[i + 1];
-    }
-    mnLibraryCount--;
+    // Transcript sidecar; its search postings are dropped on the next index merge
+    mnGenerateTranscriptFilename(mnLibrary[slot].timestamp, filename, sizeof(filename));
+    atomicFileRemove(SD, filename);
 
-    // Save updated library
-    if (!mnSaveLibrary()) {
-        Serial.println("[MorseNotes] WARNING: Failed to update library");
+    // Free the record, then link it in
+    uint32_t deadText = mnLibrary[slot].titleLen + mnLibrary[slot].tagsLen;
+    MorseNoteLibraryRecord rec = {};
+    rec.nextFree = mnLibraryHeader.freeHead;
+
+    File file = SD.open(MN_LIBRARY_FILE, "r+");
+    bool ok = file && mnLibWriteRecord(file, (uint32_t)slot, rec);
+    if (ok) {
+        mnLibraryHeader.freeHead = (uint32_t)slot;
+        ok = mnLibWriteHeader(file, mnLibraryHeader);
+    }
+    file.close();
+    if (!ok) {
+        Serial.println("[MorseNotes] WARNING: Failed to update library");  // Repaired on next load
     }
 
+    mnLibOrderRemove((uint16_t)slot);
+    mnLibrary[slot] = rec;
+    mnLibraryGarbage += deadText;
+    mnLibraryGeneration++;
+
     Serial.printf("[MorseNotes] Deleted recording: %lu\n", id);
     return true;
 }
 
 /**
- * Rename recording (update title only)
+ * Rename recording (appends the title, rewrites one record)
  */
 bool mnRenameRecording(unsigned long id, const char* newTitle) {
-    if (!mnLibrary) return false;
-    for (int i = 0; i < mnLibraryCount; i++) {
-        if (mnLibrary[i].id == id) {
-            strlcpy(mnLibrary[i].title, newTitle, sizeof(mnLibrary[i].title));
-            return mnSaveLibrary();
-        }
+    int slot = mnLibFindSlot(id);
+    if (slot < 0) {
+        Serial.printf("[MorseNotes] ERROR: Recording not found: %lu\n", id);
+        return false;
     }
 
-    Serial.printf("[MorseNotes] ERROR: Recording not found: %lu\n", id);
-    return false;
-}
+    File file = SD.open(MN_LIBRARY_FILE, "r+");
+    if (!file) return false;
 
-/**
- * Get metadata by ID
- */
-MorseNoteMetadata* mnGetMetadata(unsigned long id) {
-    if (!mnLibrary) return nullptr;
-    for (int i = 0; i < mnLibraryCount; i++) {
-        if (mnLibrary[i].id == id) {
-            return &mnLibrary[i];
-        }
-    }
-    return nullptr;
-}
+    MorseNoteLibraryRecord rec = mnLibrary[slot];
+    uint8_t oldLen = rec.titleLen;
+    bool ok = mnLibAppendStrings(file, mnLibHeapPos(mnLibraryHeader), mnLibraryHeapEnd,
+                                 rec, newTitle, nullptr);
+    file.flush();
+    ok = ok && mnLibWriteRecord(file, (uint32_t)slot, rec);
+    file.close();
 
-/**
- * Get metadata by index
- */
-MorseNoteMetadata* mnGetMetadataByIndex(int index) {
-    if (!mnLibrary) return nullptr;
-    if (index >= 0 && index < mnLibraryCount) {
-        return &mnLibrary[index];
+    if (ok) {
+        mnLibrary[slot] = rec;
+        mnLibraryGarbage += oldLen;
     }
-    return nullptr;
-}
-
-/**
- * Get library count
- */
-int mnGetLibraryCount() {
-    return mnLibraryCount;
+    return ok;
 }
 
 /**
@@ -0,0 +1,803 @@
+#ifndef MORSE_NOTES_TRANSCRIPT_H
+#define MORSE_NOTES_TRANSCRIPT_H
+
+#include "morse_notes_types.h"
+#include "morse_notes_storage.h"
+#include "../audio/morse_decoder_adaptive.h"
+#include "../storage/atomic_file.h"
+#include <SD.h>
+#include <vector>
+#include <algorithm>
+
+// ===================================
+// MORSE NOTES - TRANSCRIPTS & SEARCH
+// ===================================
+//
+// Each recording gets a decoded transcript sidecar next to its .mr file,
+// YYYYMMDD_HHMMSS.mrt (atomic_file.h framing):
+//
+//   MorseNoteTranscriptHeader
+//   MorseNoteTranscriptWord x wordCount    where each word starts
+//   text                                   the words, single-space separated
+//
+// MN_SEARCH_INDEX_FILE is an inverted index over all transcripts (also
+// atomic_file.h framing):
+//
+//   MorseNoteSearchIndexHeader
+//   uint32_t ids[idCount]                  recordings covered, ascending
+//   MorseNoteSearchPosting x N             sorted by (hash, id, word)
+//
+// N follows from the payload length. A query binary-searches each word's
+// hash, matches the words as a phrase by word number, then checks them
+// against the sidecar (hash collisions) and cuts the snippet from it.
+//
+// mnTranscriptUpdate() keeps both current from the main loop, one small
+// step per call: check a recording, decode one block of events, or copy a
+// slice of the index. Any library change (load, save, delete) starts a scan
+// for recordings the index does not cover - a fresh save, or after an
+// upgrade the whole backlog. Their postings are batched and merged into a
+// rewritten index in one pass, which also drops deleted recordings.
+
+#define MN_TRANSCRIPT_MAGIC        0x58544E4D  // "MNTX"
+#define MN_TRANSCRIPT_VERSION      1
+#define MN_SEARCH_INDEX_MAGIC      0x49534E4D  // "MNSI"
+#define MN_SEARCH_INDEX_VERSION    1
+#define MN_SEARCH_MERGE_POSTINGS   8192        // Pending postings that force a merge
+#define MN_SEARCH_MERGE_STEP       128         // Postings copied per update
+#define MN_SEARCH_MAX_POSTINGS     512         // Read per query word
+#define MN_SEARCH_HITS_PER_NOTE    3
+#define MN_TRANSCRIPT_SCAN_STEP    8           // Covered recordings skipped per update
+
+struct __attribute__((packed)) MorseNoteTranscriptHeader {
+    uint32_t magic;                // MN_TRANSCRIPT_MAGIC
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t recordingId;
+    uint32_t wordCount;
+    uint32_t textBytes;
+};
+
+struct __attribute__((packed)) MorseNoteTranscriptWord {
+    uint32_t eventIndex;           // First event of the word's first character
+    uint32_t startMs;              // Recording time of that event
+    uint32_t textOffset;           // Into the text block
+};
+
+struct __attribute__((packed)) MorseNoteSearchIndexHeader {
+    uint32_t magic;                // MN_SEARCH_INDEX_MAGIC
+    uint16_t version;
+    uint16_t idCount;
+};
+
+struct __attribute__((packed)) MorseNoteSearchPosting {
+    uint32_t hash;                 // mnSearchHash() of the word
+    uint32_t id;                   // Recording ID
+    uint32_t word;                 // Word number in the transcript
+};
+
+// ===================================
+// HELPERS
+// ===================================
+
+/**
+ * FNV-1a of a word, case-insensitive
+ */
+static uint32_t mnSearchHash(const char* word, int len) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < len; i++) {
+        h ^= (uint8_t)toupper((unsigned char)word[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool mnPostingLess(const MorseNoteSearchPosting& a, const MorseNoteSearchPosting& b) {
+    if (a.hash != b.hash) return a.hash < b.hash;
+    if (a.id != b.id) return a.id < b.id;
+    return a.word < b.word;
+}
+
+static bool mnSortedHas(const std::vector<uint32_t>& ids, uint32_t id) {
+    return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+/**
+ * Length of the word starting at `p` (up to the next space)
+ */
+static int mnWordLen(const char* p, const char* end) {
+    int n = 0;
+    while (p + n < end && p[n] != ' ') n++;
+    return n;
+}
+
+/**
+ * Postings for one transcript
+ */
+static void mnAddPostings(uint32_t id, const MorseNoteTranscriptWord* words, uint32_t wordCount,
+                          const char* text, uint32_t textBytes,
+                          std::vector<MorseNoteSearchPosting>& out) {
+    for (uint32_t i = 0; i < wordCount; i++) {
+        if (words[i].textOffset >= textBytes) continue;
+        const char* w = text + words[i].textOffset;
+        MorseNoteSearchPosting p;
+        p.hash = mnSearchHash(w, mnWordLen(w, text + textBytes));
+        p.id = id;
+        p.word = i;
+        out.push_back(p);
+    }
+}
+
+// ===================================
+// INDEX FILE
+// ===================================
+
+/**
+ * Open the index, positioned after the id list. Searches pass
+ * recover=false: they only read the copy in place, so they never touch the
+ * side files of a merge that is writing the next index.
+ * @return invalid File if there is no usable index
+ */
+static File mnSearchOpenIndex(std::vector<uint32_t>* ids, uint32_t& postingsBase,
+                              uint32_t& postingCount, bool recover = true) {
+    if (ids != nullptr) ids->clear();
+    AtomicFileInfo info;
+    File file = recover ? atomicFileOpen(SD, MN_SEARCH_INDEX_FILE, &info)
+                        : atomicFileOpenCurrent(SD, MN_SEARCH_INDEX_FILE, &info);
+    if (!file) return File();
+
+    uint32_t start = file.position();
+    MorseNoteSearchIndexHeader header;
+    uint32_t idBytes = 0;
+    bool ok = info.status != ATOMIC_FILE_LEGACY &&
+              file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == MN_SEARCH_INDEX_MAGIC && header.version == MN_SEARCH_INDEX_VERSION;
+    if (ok) {
+        idBytes = header.idCount * sizeof(uint32_t);
+        ok = info.length >= sizeof(header) + idBytes;
+    }
+    if (ok && ids != nullptr) {
+        ids->resize(header.idCount);
+        ok = file.read((uint8_t*)ids->data(), idBytes) == idBytes;
+    }
+    if (!ok) {
+        if (ids != nullptr) ids->clear();
+        if (recover) Serial.println("[MorseNotes] Search index unreadable, rebuilding");
+        file.close();
+        return File();
+    }
+
+    postingsBase = start + sizeof(header) + idBytes;
+    postingCount = (info.length - sizeof(header) - idBytes) / sizeof(MorseNoteSearchPosting);
+    file.seek(postingsBase);
+    return file;
+}
+
+/**
+ * First posting whose hash is above `hash` (or not below, if !after)
+ */
+static uint32_t mnSearchBound(File& file, uint32_t base, uint32_t count, uint32_t hash, bool after) {
+    MorseNoteSearchPosting p;
+    uint32_t lo = 0, hi = count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        file.seek(base + mid * sizeof(p));
+        if (file.read((uint8_t*)&p, sizeof(p)) != sizeof(p)) return lo;
+        if (p.hash < hash || (after && p.hash == hash)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * Read the postings for one word hash. Common words keep the newest
+ * MN_SEARCH_MAX_POSTINGS (postings are id-ascending within a hash).
+ */
+static void mnSearchReadTerm(File& file, uint32_t base, uint32_t count, uint32_t hash,
+                             std::vector<MorseNoteSearchPosting>& out) {
+    uint32_t first = mnSearchBound(file, base, count, hash, false);
+    uint32_t last = mnSearchBound(file, base, count, hash, true);
+    if (last - first > MN_SEARCH_MAX_POSTINGS) first = last - MN_SEARCH_MAX_POSTINGS;
+    if (first >= last) return;
+
+    out.resize(last - first);
+    size_t bytes = out.size() * sizeof(MorseNoteSearchPosting);
+    file.seek(base + first * sizeof(MorseNoteSearchPosting));
+    if (file.read((uint8_t*)out.data(), bytes) != bytes) out.clear();
+}
+
+// ===================================
+// TRANSCRIPT FILES
+// ===================================
+
+struct MorseNoteTranscriptReader {
+    File file;
+    MorseNoteTranscriptHeader header;
+    uint32_t wordsPos;
+    uint32_t textPos;
+};
+
+/**
+ * Open a recording's transcript sidecar
+ */
+static bool mnTranscriptOpen(unsigned long id, MorseNoteTranscriptReader& r) {
+    int slot = mnLibFindSlot(id);
+    if (slot < 0) return false;
+
+    char filename[64];
+    mnGenerateTranscriptFilename(mnLibrary[slot].timestamp, filename, sizeof(filename));
+    if (!SD.exists(filename)) return false;
+
+    AtomicFileInfo info;
+    r.file = atomicFileOpen(SD, filename, &info);
+    if (!r.file) return false;
+    if (info.status == ATOMIC_FILE_LEGACY ||
+        r.file.read((uint8_t*)&r.header, sizeof(r.header)) != sizeof(r.header) ||
+        r.header.magic != MN_TRANSCRIPT_MAGIC || r.header.version != MN_TRANSCRIPT_VERSION ||
+        r.header.recordingId != (uint32_t)id) {
+        r.file.close();
+        return false;
+    }
+    r.wordsPos = r.file.position();
+    r.textPos = r.wordsPos + r.header.wordCount * sizeof(MorseNoteTranscriptWord);
+    return true;
+}
+
+static bool mnTranscriptReadWord(MorseNoteTranscriptReader& r, uint32_t index,
+                                 MorseNoteTranscriptWord& word) {
+    if (index >= r.header.wordCount) return false;
+    r.file.seek(r.wordsPos + index * sizeof(word));
+    return r.file.read((uint8_t*)&word, sizeof(word)) == sizeof(word);
+}
+
+/**
+ * Read transcript text from `offset` (at most outSize - 1 bytes)
+ */
+static int mnTranscriptReadText(MorseNoteTranscriptReader& r, uint32_t offset,
+                                char* out, size_t outSize) {
+    if (offset >= r.header.textBytes || outSize == 0) {
+        if (outSize > 0) out[0] = '\0';
+        return 0;
+    }
+    size_t n = min((size_t)(r.header.textBytes - offset), outSize - 1);
+    r.file.seek(r.textPos + offset);
+    n = r.file.read((uint8_t*)out, n);
+    out[n] = '\0';
+    return (int)n;
+}
+
+/**
+ * Write a transcript sidecar
+ */
+static bool mnTranscriptWrite(unsigned long timestamp, unsigned long id,
+                              const std::vector<MorseNoteTranscriptWord>& words,
+                              const String& text) {
+    char filename[64];
+    mnGenerateTranscriptFilename(timestamp, filename, sizeof(filename));
+
+    MorseNoteTranscriptHeader header;
+    header.magic = MN_TRANSCRIPT_MAGIC;
+    header.version = MN_TRANSCRIPT_VERSION;
+    header.reserved = 0;
+    header.recordingId = (uint32_t)id;
+    header.wordCount = words.size();
+    header.textBytes = text.length();
+
+    AtomicFileWriter out(SD, filename);
+    if (!out.begin()) return false;
+    out.write((const uint8_t*)&header, sizeof(header));
+    out.write((const uint8_t*)words.data(), words.size() * sizeof(MorseNoteTranscriptWord));
+    out.write((const uint8_t*)text.c_str(), text.length());
+    return out.commit();
+}
+
+// ===================================
+// BACKGROUND JOB
+// ===================================
+
+enum MorseNotesTranscriptStage {
+    MN_TX_IDLE,
+    MN_TX_SCAN,                    // Looking for recordings the index does not cover
+    MN_TX_DECODE,                  // Decoding one recording, a block per step
+    MN_TX_MERGE                    // Rewriting the index with the pending postings
+};
+
+struct MorseNotesTranscriptJob {
+    MorseNotesTranscriptStage stage = MN_TX_IDLE;
+    uint32_t generation = 0;       // mnLibraryGeneration the scan started from
+    int scanPos = -1;              // Library order index, newest first
+    std::vector<uint32_t> indexedIds;            // In the index file (sorted)
+    std::vector<uint32_t> pendingIds;            // Transcribed, not merged yet
+    std::vector<MorseNoteSearchPosting> pending;
+
+    // MN_TX_DECODE
+    unsigned long id = 0;
+    unsigned long timestamp = 0;
+    File in;
+    MorseNoteFileHeader header;
+    int remaining = 0;
+    uint32_t eventIndex = 0;
+    float positionMs = 0.0f;
+    MorseDecoder* decoder = nullptr;
+    uint32_t charEvent = 0;        // Where the character being decoded started
+    float charMs = 0.0f;
+    bool inWord = false;
+    int wordLen = 0;
+    std::vector<MorseNoteTranscriptWord> words;
+    String text;
+
+    // MN_TX_MERGE
+    File oldIndex;
+    uint32_t oldLeft = 0;
+    size_t pendingPos = 0;
+    std::vector<uint32_t> mergedIds;
+    AtomicFileWriter* out = nullptr;
+};
+
+static MorseNotesTranscriptJob mnTxJob;
+
+/**
+ * Decoder callback: split decoded characters into words
+ */
+static void mnTxOnDecoded(String morse, String text) {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    for (unsigned int i = 0; i < text.length(); i++) {
+        char c = text[i];
+        if (c == ' ') {
+            job.inWord = false;
+            continue;
+        }
+        if (!job.inWord) {
+            if (job.words.size() >= MN_TRANSCRIPT_MAX_WORDS) continue;
+            if (!job.words.empty()) job.text += ' ';
+            MorseNoteTranscriptWord w;
+            w.eventIndex = job.charEvent;
+            w.startMs = (uint32_t)job.charMs;
+            w.textOffset = job.text.length();
+            job.words.push_back(w);
+            job.inWord = true;
+            job.wordLen = 0;
+        }
+        if (job.wordLen < MN_TRANSCRIPT_MAX_WORD_LEN) {
+            job.text += c;
+            job.wordLen++;
+        }
+    }
+}
+
+static void mnTxBeginScan() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    job.generation = mnLibraryGeneration;
+    job.scanPos = mnLibraryCount - 1;
+
+    uint32_t base, count;
+    File index = mnSearchOpenIndex(&job.indexedIds, base, count);
+    if (index) index.close();
+    job.stage = MN_TX_SCAN;
+}
+
+static void mnTxBeginMerge() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+
+    // Covered afterwards: still-live indexed recordings plus the new ones
+    std::vector<uint32_t> live;
+    for (int i = 0; i < mnLibraryCount; i++) {
+        live.push_back(mnLibrary[mnLibraryOrder[i]].id);
+    }
+    std::sort(live.begin(), live.end());
+
+    job.mergedIds.clear();
+    for (uint32_t id : job.indexedIds) {
+        if (mnSortedHas(live, id)) job.mergedIds.push_back(id);
+    }
+    for (uint32_t id : job.pendingIds) {
+        if (mnSortedHas(live, id)) job.mergedIds.push_back(id);
+    }
+    std::sort(job.mergedIds.begin(), job.mergedIds.end());
+    job.mergedIds.erase(std::unique(job.mergedIds.begin(), job.mergedIds.end()),
+                        job.mergedIds.end());
+
+    std::sort(job.pendingIds.begin(), job.pendingIds.end());
+    std::sort(job.pending.begin(), job.pending.end(), mnPostingLess);
+    job.pendingPos = 0;
+
+    uint32_t base;
+    job.oldIndex = mnSearchOpenIndex(nullptr, base, job.oldLeft);
+    if (!job.oldIndex) job.oldLeft = 0;
+
+    MorseNoteSearchIndexHeader header;
+    header.magic = MN_SEARCH_INDEX_MAGIC;
+    header.version = MN_SEARCH_INDEX_VERSION;
+    header.idCount = job.mergedIds.size();
+
+    job.out = new AtomicFileWriter(SD, MN_SEARCH_INDEX_FILE);
+    if (job.out->begin()) {
+        job.out->write((const uint8_t*)&header, sizeof(header));
+        job.out->write((const uint8_t*)job.mergedIds.data(),
+                       job.mergedIds.size() * sizeof(uint32_t));
+    }
+    job.stage = MN_TX_MERGE;
+}
+
+static void mnTxFinishMerge() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    if (job.oldIndex) job.oldIndex.close();
+
+    bool ok = job.out->commit();
+    delete job.out;
+    job.out = nullptr;
+
+    if (ok) {
+        Serial.printf("[MorseNotes] Search index: %d recordings, %d new\n",
+                      (int)job.mergedIds.size(), (int)job.pendingIds.size());
+        job.indexedIds.swap(job.mergedIds);
+    } else {
+        // Picked up again by the next scan
+        Serial.println("[MorseNotes] ERROR: Failed to write search index");
+    }
+    job.mergedIds.clear();
+    job.pendingIds.clear();
+    std::vector<MorseNoteSearchPosting>().swap(job.pending);
+    job.stage = MN_TX_SCAN;
+}
+
+/**
+ * Copy a slice of the old index, merging the pending postings in
+ */
+static void mnTxMergeStep() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    if (!job.out->ok()) {
+        mnTxFinishMerge();
+        return;
+    }
+
+    MorseNoteSearchPosting chunk[MN_SEARCH_MERGE_STEP];
+    uint32_t n = 0;
+    if (job.oldLeft > 0) {
+        n = min((uint32_t)MN_SEARCH_MERGE_STEP, job.oldLeft);
+        size_t bytes = n * sizeof(MorseNoteSearchPosting);
+        if (job.oldIndex.read((uint8_t*)chunk, bytes) != bytes) {
+            job.out->abort();  // Keep the old index rather than lose its postings
+            mnTxFinishMerge();
+            return;
+        }
+        job.oldLeft -= n;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        // Re-indexed and deleted recordings drop out
+        if (mnSortedHas(job.pendingIds, chunk[i].id) || !mnSortedHas(job.mergedIds, chunk[i].id)) {
+            continue;
+        }
+        while (job.pendingPos < job.pending.size() &&
+               mnPostingLess(job.pending[job.pendingPos], chunk[i])) {
+            job.out->write((const uint8_t*)&job.pending[job.pendingPos++],
+                           sizeof(MorseNoteSearchPosting));
+        }
+        job.out->write((const uint8_t*)&chunk[i], sizeof(MorseNoteSearchPosting));
+    }
+
+    if (job.oldLeft == 0) {
+        size_t end = min(job.pending.size(), job.pendingPos + MN_SEARCH_MERGE_STEP * 4);
+        for (; job.pendingPos < end; job.pendingPos++) {
+            job.out->write((const uint8_t*)&job.pending[job.pendingPos],
+                           sizeof(MorseNoteSearchPosting));
+        }
+        if (job.pendingPos >= job.pending.size()) {
+            mnTxFinishMerge();
+        }
+    }
+}
+
+/**
+ * Queue the postings of an existing sidecar (written before a merge was
+ * interrupted) without decoding the recording again
+ */
+static bool mnTxIndexSidecar(unsigned long id) {
+    MorseNoteTranscriptReader r;
+    if (!mnTranscriptOpen(id, r)) return false;
+
+    uint32_t wordCount = min(r.header.wordCount, (uint32_t)MN_TRANSCRIPT_MAX_WORDS);
+    std::vector<MorseNoteTranscriptWord> words(wordCount);
+    std::vector<char> text(r.header.textBytes);
+    size_t wordBytes = wordCount * sizeof(MorseNoteTranscriptWord);
+    bool ok = r.file.read((uint8_t*)words.data(), wordBytes) == wordBytes;
+    if (ok) {
+        r.file.seek(r.textPos);
+        ok = r.file.read((uint8_t*)text.data(), text.size()) == text.size();
+    }
+    r.file.close();
+    if (!ok) return false;
+
+    mnAddPostings(id, words.data(), wordCount, text.data(), text.size(), mnTxJob.pending);
+    return true;
+}
+
+static bool mnTxBeginDecode(int slot) {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    job.id = mnLibrary[slot].id;
+    job.timestamp = mnLibrary[slot].timestamp;
+
+    char filename[64];
+    mnGenerateFilename(job.timestamp, filename, sizeof(filename));
+    job.in = mnOpenRecordingFile(filename, job.header);
+    if (!job.in) return false;
+
+    float wpm = (job.header.avgWPM >= 5.0f && job.header.avgWPM <= 60.0f) ? job.header.avgWPM : 20.0f;
+    job.decoder = new MorseDecoderAdaptive(wpm, wpm, 30);
+    job.decoder->messageCallback = mnTxOnDecoded;
+
+    job.remaining = (int)job.header.eventCount;
+    job.eventIndex = 0;
+    job.positionMs = 0.0f;
+    job.charEvent = 0;
+    job.charMs = 0.0f;
+    job.inWord = false;
+    job.words.clear();
+    job.text = "";
+    job.stage = MN_TX_DECODE;
+    return true;
+}
+
+static void mnTxFinishDecode() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+    job.decoder->flush();
+    delete job.decoder;
+    job.decoder = nullptr;
+    job.in.close();
+
+    // Deleted while decoding: drop it
+    if (mnLibFindSlot(job.id) >= 0) {
+        if (!mnTranscriptWrite(job.timestamp, job.id, job.words, job.text)) {
+            Serial.printf("[MorseNotes] ERROR: Failed to write transcript for %lu\n", job.id);
+        }
+        mnAddPostings(job.id, job.words.data(), job.words.size(),
+                      job.text.c_str(), job.text.length(), job.pending);
+        job.pendingIds.push_back(job.id);
+        Serial.printf("[MorseNotes] Transcribed %lu: %d words\n", job.id, (int)job.words.size());
+    }
+
+    std::vector<MorseNoteTranscriptWord>().swap(job.words);
+    job.text = String();
+    job.stage = MN_TX_SCAN;
+}
+
+/**
+ * Feed one block of events to the decoder
+ */
+static void mnTxDecodeStep() {
+    static float block[MN_V2_BLOCK_EVENTS];
+    MorseNotesTranscriptJob& job = mnTxJob;
+
+    int n = mnReadEventBlock(job.in, job.header, job.remaining, block);
+    if (n <= 0) {
+        job.remaining = 0;  // End, or a damaged block: keep what decoded so far
+    } else {
+        for (int i = 0; i < n; i++) {
+            // An empty decoder means this event starts a character
+            if (job.decoder->isEmpty()) {
+                job.charEvent = job.eventIndex;
+                job.charMs = job.positionMs;
+            }
+            job.decoder->addTiming(block[i]);
+            job.positionMs += fabsf(block[i]);
+            job.eventIndex++;
+        }
+        job.remaining -= n;
+    }
+
+    if (job.remaining <= 0) {
+        mnTxFinishDecode();
+    }
+}
+
+/**
+ * Find the next recording the index does not cover
+ */
+static void mnTxScanStep() {
+    MorseNotesTranscriptJob& job = mnTxJob;
+
+    for (int checked = 0; checked < MN_TRANSCRIPT_SCAN_STEP; checked++) {
+        if (job.pending.size() >= MN_SEARCH_MERGE_POSTINGS) {
+            mnTxBeginMerge();
+            return;
+        }
+        if (job.scanPos < 0) {
+            bool stale = false;
+            for (uint32_t id : job.indexedIds) {
+                if (mnLibFindSlot(id) < 0) {
+                    stale = true;
+                    break;
+                }
+            }
+            if (!job.pendingIds.empty() || stale) {
+                mnTxBeginMerge();
+            } else {
+                job.stage = MN_TX_IDLE;
+            }
+            return;
+        }
+
+        int slot = mnLibraryOrder[job.scanPos--];
+        uint32_t id = mnLibrary[slot].id;
+        if (mnSortedHas(job.indexedIds, id) ||
+            std::find(job.pendingIds.begin(), job.pendingIds.end(), id) != job.pendingIds.end()) {
+            continue;
+        }
+
+        // One recording's worth of SD work per step
+        if (mnTxIndexSidecar(id)) {
+            job.pendingIds.push_back(id);
+        } else if (!mnTxBeginDecode(slot)) {
+            job.pendingIds.push_back(id);  // Unreadable: cover it with no words
+        }
+        return;
+    }
+}
+
+/**
+ * Advance transcript generation and indexing by one small step.
+ * Call from loop() while audio is idle and nothing is recording.
+ */
+void mnTranscriptUpdate() {
+    if (!mnLibraryLoaded) return;
+    MorseNotesTranscriptJob& job = mnTxJob;
+
+    switch (job.stage) {
+        case MN_TX_IDLE:
+        case MN_TX_SCAN:
+            // Library changed: rescan from the newest recording
+            if (job.generation != mnLibraryGeneration) {
+                mnTxBeginScan();
+            } else if (job.stage == MN_TX_SCAN) {
+                mnTxScanStep();
+            }
+            break;
+        case MN_TX_DECODE:
+            mnTxDecodeStep();
+            break;
+        case MN_TX_MERGE:
+            mnTxMergeStep();
+            break;
+    }
+}
+
+/**
+ * True while transcripts or the index are being brought up to date
+ */
+bool mnTranscriptBusy() {
+    return mnTxJob.stage != MN_TX_IDLE || mnTxJob.generation != mnLibraryGeneration;
+}
+
+// ===================================
+// SEARCH
+// ===================================
+
+/**
+ * Split a query into upper-case words
+ * @return words found (at most MN_SEARCH_MAX_TERMS)
+ */
+static int mnSearchSplit(const char* query, char terms[][MN_TRANSCRIPT_MAX_WORD_LEN + 1]) {
+    int count = 0;
+    const char* p = query;
+    while (*p && count < MN_SEARCH_MAX_TERMS) {
+        while (*p == ' ') p++;
+        if (!*p) break;
+        int len = 0;
+        while (p[len] && p[len] != ' ') {
+            if (len < MN_TRANSCRIPT_MAX_WORD_LEN) {
+                terms[count][len] = (char)toupper((unsigned char)p[len]);
+            }
+            len++;
+        }
+        terms[count][min(len, MN_TRANSCRIPT_MAX_WORD_LEN)] = '\0';
+        count++;
+        p += len;
+    }
+    return count;
+}
+
+static bool mnPostingsHave(const std::vector<MorseNoteSearchPosting>& list, uint32_t id, uint32_t word) {
+    MorseNoteSearchPosting key;
+    key.hash = list.empty() ? 0 : list[0].hash;
+    key.id = id;
+    key.word = word;
+    return std::binary_search(list.begin(), list.end(), key, mnPostingLess);
+}
+
+/**
+ * Check the matched words against the transcript and fill in the hit
+ */
+static bool mnSearchConfirm(MorseNoteTranscriptReader& r, uint32_t word,
+                            char terms[][MN_TRANSCRIPT_MAX_WORD_LEN + 1], int termCount,
+                            MorseNoteSearchHit& hit) {
+    MorseNoteTranscriptWord first;
+    if (!mnTranscriptReadWord(r, word, first)) return false;
+
+    for (int t = 0; t < termCount; t++) {
+        MorseNoteTranscriptWord w;
+        char text[MN_TRANSCRIPT_MAX_WORD_LEN + 2];
+        if (!mnTranscriptReadWord(r, word + t, w)) return false;
+        mnTranscriptReadText(r, w.textOffset, text, sizeof(text));
+        int len = mnWordLen(text, text + strlen(text));
+        if (len != (int)strlen(terms[t]) || strncasecmp(text, terms[t], len) != 0) return false;
+    }
+
+    hit.id = r.header.recordingId;
+    hit.eventIndex = first.eventIndex;
+    hit.startMs = first.startMs;
+
+    // Snippet from two words before the match
+    MorseNoteTranscriptWord lead = first;
+    if (word > 0) mnTranscriptReadWord(r, word >= 2 ? word - 2 : 0, lead);
+    int n = mnTranscriptReadText(r, lead.textOffset, hit.snippet, sizeof(hit.snippet));
+    if (lead.textOffset + n < r.header.textBytes) {
+        char* cut = strrchr(hit.snippet, ' ');
+        if (cut != nullptr && cut > hit.snippet + (first.textOffset - lead.textOffset)) *cut = '\0';
+    }
+    return true;
+}
+
+/**
+ * Full-text search across all transcripts. Query words match whole
+ * transcript words (case-insensitive) as a phrase. Newest recordings first,
+ * at most MN_SEARCH_HITS_PER_NOTE hits per recording. Call from the loop
+ * task, like mnTranscriptUpdate(): the index is closed again before this
+ * returns, so a merge never swaps it in while a search holds it open.
+ * @return hits filled
+ */
+int mnSearchNotes(const char* query, MorseNoteSearchHit* hits, int maxHits) {
+    char terms[MN_SEARCH_MAX_TERMS][MN_TRANSCRIPT_MAX_WORD_LEN + 1];
+    int termCount = mnSearchSplit(query, terms);
+    if (termCount == 0 || maxHits <= 0 || !mnLoadLibrary()) return 0;
+
+    uint32_t base, count;
+    File index = mnSearchOpenIndex(nullptr, base, count, false);
+    if (!index) return 0;
+
+    std::vector<MorseNoteSearchPosting> lists[MN_SEARCH_MAX_TERMS];
+    for (int t = 0; t < termCount; t++) {
+        mnSearchReadTerm(index, base, count, mnSearchHash(terms[t], strlen(terms[t])), lists[t]);
+    }
+    index.close();
+
+    int found = 0;
+    int perNote = 0;
+    MorseNoteTranscriptReader reader;
+    bool readerOpen = false;
+    uint32_t readerId = 0;
+
+    // Postings are id-ascending within a word: walk back for newest first
+    for (int i = (int)lists[0].size() - 1; i >= 0 && found < maxHits; i--) {
+        const MorseNoteSearchPosting& p = lists[0][i];
+        bool phrase = true;
+        for (int t = 1; t < termCount && phrase; t++) {
+            phrase = mnPostingsHave(lists[t], p.id, p.word + t);
+        }
+        if (!phrase) continue;
+
+        if (!readerOpen || readerId != p.id) {
+            if (readerOpen) reader.file.close();
+            readerId = p.id;
+            readerOpen = mnTranscriptOpen(p.id, reader);  // Fails for deleted recordings
+            perNote = 0;
+        }
+        if (!readerOpen || perNote >= MN_SEARCH_HITS_PER_NOTE) continue;
+
+        if (mnSearchConfirm(reader, p.word, terms, termCount, hits[found])) {
+            found++;
+            perNote++;
+        }
+    }
+    if (readerOpen) reader.file.close();
+
+    // Within a recording the walk went backwards; put matches in time order
+    for (int a = 0; a < found; ) {
+        int b = a;
+        while (b < found && hits[b].id == hits[a].id) b++;
+        std::reverse(hits + a, hits + b);
+        a = b;
+    }
+    return found;
+}
+
+#endif // MORSE_NOTES_TRANSCRIPT_H
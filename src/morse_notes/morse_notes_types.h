@@ -8,21 +8,41 @@
 // ===================================
 
 // Maximum limits
-#define MN_MAX_RECORDING_EVENTS    10000                    // Max timing events per recording
-#define MN_MAX_RECORDING_DURATION_MS (5 * 60 * 1000)       // 5 minutes
 #define MN_MAX_RECORDINGS          200                      // Max recordings in library
-#define MN_WARNING_TIME_MS         (4 * 60 * 1000 + 30 * 1000)  // Warning at 4:30
+#define MN_RECORD_MIN_FREE_BYTES   262144                   // Recording stops below this much SD space
 
 // File paths
 #define MN_DIR                     "/morse-notes"
-#define MN_LIBRARY_FILE            "/morse-notes/library.json"
-#define MN_LIBRARY_TMP_FILE        "/morse-notes/library.tmp"
+#define MN_LIBRARY_FILE            "/morse-notes/library.bin"
+#define MN_LIBRARY_JSON_FILE       "/morse-notes/library.json"   // Pre-binary library, imported once
+#define MN_LIBRARY_PAGE_SIZE       10       // Recordings per list screen page
+#define MN_SEARCH_INDEX_FILE       "/morse-notes/search.idx"     // Transcript word index
+
+// Transcripts and search (see morse_notes_transcript.h)
+#define MN_TRANSCRIPT_MAX_WORDS    4096     // Longer recordings are indexed up to here
+#define MN_TRANSCRIPT_MAX_WORD_LEN 24       // Longer words are truncated
+#define MN_SEARCH_MAX_TERMS        4        // Words per query (matched as a phrase)
+#define MN_SEARCH_MAX_HITS         20
+#define MN_SEARCH_SNIPPET_LEN      48
 
 // Binary file format constants
 #define MN_FILE_MAGIC              0x4D524E54  // "MRNT" (Morse Record Note Timing)
-#define MN_FILE_VERSION            0x0001
+#define MN_FILE_VERSION_V1         0x0001   // Raw float events (read-only, plus session files)
+#define MN_FILE_VERSION            0x0002   // Varint blocks, see morse_notes_format.h
 #define MN_FILE_HEADER_SIZE        28
 
+// Header flags
+// MN_FLAG_SENDER_TAGS: events are MorseNoteTaggedEvent records instead of
+// bare floats, followed by a sender table trailer (multi-station sessions,
+// e.g. Vail repeater recordings). Sender 0 is always the local station.
+#define MN_FLAG_SENDER_TAGS        0x0001
+// MN_FLAG_DIT_QUANTIZED (v2): blocks were encoded as dit multiples plus a
+// whole-ms residual. Informational - each block says how it is encoded.
+#define MN_FLAG_DIT_QUANTIZED      0x0002
+#define MN_DIT_QUANTIZE_DEFAULT    true
+#define MN_SENDER_CALL_LEN         16       // Callsign slot in the sender table
+#define MN_MAX_SESSION_SENDERS     32       // Distinct senders per session
+
 // Recording state machine
 enum MorseNotesRecordState {
     MN_REC_IDLE,          // Not recording, initial state
@@ -45,7 +65,7 @@ enum MorseNotesPlaybackState {
     MN_PLAY_ERROR         // Load/playback error
 };
 
-// Metadata structure for library.json
+// Metadata for one recording (copied out of the library file)
 struct MorseNoteMetadata {
     unsigned long id;              // Unique ID (Unix timestamp)
     char title[64];                // User-provided title
@@ -62,45 +82,71 @@ struct MorseNoteMetadata {
     }
 };
 
+// One full-text search match
+struct MorseNoteSearchHit {
+    unsigned long id;              // Recording ID
+    uint32_t eventIndex;           // First event of the matched words
+    uint32_t startMs;              // Recording time of that event (seek target)
+    char snippet[MN_SEARCH_SNIPPET_LEN];   // Transcript text around the match
+};
+
 // Binary file header structure (28 bytes)
 // Packed to ensure exact byte layout
 struct __attribute__((packed)) MorseNoteFileHeader {
     uint32_t magic;                // 0x4D524E54 ("MRNT")
-    uint16_t version;              // Format version (0x0001)
-    uint16_t flags;                // Reserved flags (set to 0)
+    uint16_t version;              // Format version (MN_FILE_VERSION_V1 or MN_FILE_VERSION)
+    uint16_t flags;                // MN_FLAG_* bits
     uint32_t eventCount;           // Number of timing events
     uint32_t toneFrequency;        // Tone frequency in Hz
     uint64_t timestamp;            // Unix timestamp
     float avgWPM;                  // Average WPM
 };
 
+// Tagged timing event (10 bytes), used when MN_FLAG_SENDER_TAGS is set.
+// File layout: header, eventCount x MorseNoteTaggedEvent, uint16_t senderCount,
+// senderCount x char[MN_SENDER_CALL_LEN].
+struct __attribute__((packed)) MorseNoteTaggedEvent {
+    float duration;                // Same sign convention as v1: + tone, - silence
+    uint32_t offsetMs;             // Event start, ms since session start
+    uint8_t sender;                // Index into the sender table
+    uint8_t flags;                 // MN_EVT_* bits
+};
+
+#define MN_EVT_TX                  0x01     // Keyed locally (vs received)
+
 // Recording session state
 struct MorseNotesRecordingSession {
     MorseNotesRecordState state;
-    float* timingBuffer;           // Pointer to timing array
     int eventCount;                // Current number of events
     unsigned long startTime;       // Recording start time (millis())
     unsigned long lastEventTime;   // Last key event time (millis())
     bool keyState;                 // Current key state (down=true)
     char title[64];                // Recording title
+    unsigned long timestamp;       // Unix start time (file name + library id)
+    char filename[64];             // .mr file being streamed to
+    float totalMs;                 // Sum of recorded durations
+    uint32_t droppedCount;         // Events lost to a full ring
 
     MorseNotesRecordingSession() {
         state = MN_REC_IDLE;
-        timingBuffer = nullptr;
         eventCount = 0;
         startTime = 0;
         lastEventTime = 0;
         keyState = false;
         memset(title, 0, sizeof(title));
+        timestamp = 0;
+        memset(filename, 0, sizeof(filename));
+        totalMs = 0.0f;
+        droppedCount = 0;
     }
 };
 
 // Playback session state
 struct MorseNotesPlaybackSession {
     MorseNotesPlaybackState state;
-    float* timingBuffer;           // Pointer to timing array
     int eventCount;                // Total number of events
     int currentIndex;              // Current playback index
+    float positionMs;              // Recording time at currentIndex
     unsigned long startTime;       // Playback start time (millis())
     float speed;                   // Playback speed (0.5x - 2.0x)
     int toneFrequency;             // Tone frequency for playback
@@ -108,9 +154,9 @@ struct MorseNotesPlaybackSession {
 
     MorseNotesPlaybackSession() {
         state = MN_PLAY_IDLE;
-        timingBuffer = nullptr;
         eventCount = 0;
         currentIndex = 0;
+        positionMs = 0.0f;
         startTime = 0;
         speed = 1.0f;
         toneFrequency = 700;
@@ -51,51 +51,24 @@ struct __attribute__((packed)) WAVHeader {
 // ===================================
 
 /**
- * Generate WAV file from timing array
+ * Generate WAV file from a recording, streaming it block by block
  * Returns temp filename on success, empty string on failure
  */
 String mnGenerateWAV(unsigned long recordingId) {
-    // Allocate timing buffer in PSRAM (40KB is too large for stack)
-    float* timings = nullptr;
-    if (psramFound()) {
-        timings = (float*)ps_malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-    } else {
-        timings = (float*)malloc(MN_MAX_RECORDING_EVENTS * sizeof(float));
-    }
-
-    if (timings == nullptr) {
-        Serial.println("[MorseNotes] ERROR: Failed to allocate timing buffer for WAV export");
+    MorseNoteMetadata metadata;
+    if (!mnGetMetadata(recordingId, metadata)) {
+        Serial.println("[MorseNotes] ERROR: Failed to load recording for WAV export");
         return "";
     }
 
-    int eventCount;
-    int toneFreq;
-    MorseNoteMetadata* metadata;
-
-    bool success = mnLoadRecording(
-        recordingId,
-        timings,
-        MN_MAX_RECORDING_EVENTS,
-        eventCount,
-        toneFreq,
-        &metadata
-    );
-
-    if (!success || metadata == nullptr) {
+    MorseNoteFileHeader mrHeader;
+    char mrFilename[64];
+    File mrFile = mnOpenRecording(&metadata, mrHeader, mrFilename, sizeof(mrFilename));
+    if (!mrFile) {
         Serial.println("[MorseNotes] ERROR: Failed to load recording for WAV export");
-        free(timings);
         return "";
     }
-
-    // Calculate total duration
-    float totalDurationMs = 0.0f;
-    for (int i = 0; i < eventCount; i++) {
-        totalDurationMs += abs(timings[i]);
-    }
-
-    // Calculate sample count
-    int totalSamples = (int)((totalDurationMs / 1000.0f) * WAV_SAMPLE_RATE);
-    uint32_t dataSize = totalSamples * sizeof(int16_t);
+    int toneFreq = mrHeader.toneFrequency;
 
     // Create temp filename
     char tempFilename[64];
@@ -105,17 +78,16 @@ String mnGenerateWAV(unsigned long recordingId) {
     File file = SD.open(tempFilename, FILE_WRITE);
     if (!file) {
         Serial.println("[MorseNotes] ERROR: Failed to create temp WAV file");
-        free(timings);
+        mrFile.close();
         return "";
     }
 
-    Serial.printf("[MorseNotes] Generating WAV: %d samples, %d events\n",
-                  totalSamples, eventCount);
+    Serial.printf("[MorseNotes] Generating WAV: %u events\n", (unsigned)mrHeader.eventCount);
 
-    // Create and write WAV header
+    // Create WAV header; sizes are patched once all samples are written
     WAVHeader header;
     memcpy(header.riffID, "RIFF", 4);
-    header.riffSize = 36 + dataSize;
+    header.riffSize = 36;
     memcpy(header.waveID, "WAVE", 4);
 
     memcpy(header.fmtID, "fmt ", 4);
@@ -128,7 +100,7 @@ String mnGenerateWAV(unsigned long recordingId) {
     header.bitsPerSample = WAV_BIT_DEPTH;
 
     memcpy(header.dataID, "data", 4);
-    header.dataSize = dataSize;
+    header.dataSize = 0;
 
     file.write((uint8_t*)&header, sizeof(header));
 
@@ -137,7 +109,7 @@ String mnGenerateWAV(unsigned long recordingId) {
     float phaseIncrement = (2.0f * PI * (float)toneFreq) / (float)WAV_SAMPLE_RATE;
     const int16_t amplitude = 16384;  // Half of max int16_t for headroom
 
-    int sampleIndex = 0;
+    uint32_t sampleCount = 0;
     bool toneOn = false;
 
     // Buffer for writing samples in chunks
@@ -145,43 +117,63 @@ String mnGenerateWAV(unsigned long recordingId) {
     int16_t buffer[BUFFER_SIZE];
     int bufferIndex = 0;
 
-    for (int i = 0; i < eventCount; i++) {
-        float duration = abs(timings[i]);
-        toneOn = (timings[i] > 0.0f);  // Positive = tone on
-
-        int samples = (int)((duration / 1000.0f) * WAV_SAMPLE_RATE);
+    // One block of timing events at a time (any .mr version)
+    float* timings = (float*)malloc(MN_V2_BLOCK_EVENTS * sizeof(float));
+    if (timings == nullptr) {
+        Serial.println("[MorseNotes] ERROR: Failed to allocate timing buffer for WAV export");
+        file.close();
+        mrFile.close();
+        SD.remove(tempFilename);
+        return "";
+    }
+    int remaining = mrHeader.eventCount;
+    int count;
+
+    while ((count = mnReadEventBlock(mrFile, mrHeader, remaining, timings)) > 0) {
+        remaining -= count;
+
+        for (int i = 0; i < count; i++) {
+            float duration = abs(timings[i]);
+            toneOn = (timings[i] > 0.0f);  // Positive = tone on
+
+            int samples = (int)((duration / 1000.0f) * WAV_SAMPLE_RATE);
+
+            for (int j = 0; j < samples; j++) {
+                int16_t sample;
+
+                if (toneOn) {
+                    // Generate sine wave
+                    sample = (int16_t)(amplitude * sin(phase));
+                    phase += phaseIncrement;
+                    if (phase >= 2.0f * PI) {
+                        phase -= 2.0f * PI;
+                    }
+                } else {
+                    // Silence
+                    sample = 0;
+                }
 
-        for (int j = 0; j < samples && sampleIndex < totalSamples; j++) {
-            int16_t sample;
+                // Add to buffer
+                buffer[bufferIndex++] = sample;
 
-            if (toneOn) {
-                // Generate sine wave
-                sample = (int16_t)(amplitude * sin(phase));
-                phase += phaseIncrement;
-                if (phase >= 2.0f * PI) {
-                    phase -= 2.0f * PI;
+                // Flush buffer when full
+                if (bufferIndex >= BUFFER_SIZE) {
+                    file.write((uint8_t*)buffer, bufferIndex * sizeof(int16_t));
+                    bufferIndex = 0;
                 }
-            } else {
-                // Silence
-                sample = 0;
-            }
 
-            // Add to buffer
-            buffer[bufferIndex++] = sample;
-
-            // Flush buffer when full
-            if (bufferIndex >= BUFFER_SIZE) {
-                file.write((uint8_t*)buffer, bufferIndex * sizeof(int16_t));
-                bufferIndex = 0;
+                sampleCount++;
             }
-
-            sampleIndex++;
         }
 
-        // Yield periodically to keep system responsive
-        if (i % 100 == 0) {
-            yield();
-        }
+        // Yield per block to keep system responsive
+        yield();
+    }
+    mrFile.close();
+    free(timings);
+
+    if (count < 0) {
+        Serial.println("[MorseNotes] WARNING: Recording damaged, WAV truncated");
     }
 
     // Flush remaining buffer
@@ -189,12 +181,16 @@ String mnGenerateWAV(unsigned long recordingId) {
         file.write((uint8_t*)buffer, bufferIndex * sizeof(int16_t));
     }
 
-    file.close();
+    // Patch sizes now that the sample count is known
+    uint32_t dataSize = sampleCount * sizeof(int16_t);
+    header.riffSize = 36 + dataSize;
+    header.dataSize = dataSize;
+    file.seek(0);
+    file.write((uint8_t*)&header, sizeof(header));
 
-    // Free timing buffer
-    free(timings);
+    file.close();
 
-    Serial.printf("[MorseNotes] WAV generated: %s\n", tempFilename);
+    Serial.printf("[MorseNotes] WAV generated: %s (%u samples)\n", tempFilename, (unsigned)sampleCount);
     return String(tempFilename);
 }
 
@@ -221,13 +217,13 @@ bool mnDeleteTempWAV(const String& filename) {
  * Get WAV file size estimate (without generating)
  */
 uint32_t mnEstimateWAVSize(unsigned long recordingId) {
-    MorseNoteMetadata* metadata = mnGetMetadata(recordingId);
-    if (metadata == nullptr) {
+    MorseNoteMetadata metadata;
+    if (!mnGetMetadata(recordingId, metadata)) {
         return 0;
     }
 
     // Calculate samples
-    int totalSamples = (int)((metadata->durationMs / 1000.0f) * WAV_SAMPLE_RATE);
+    int totalSamples = (int)((metadata.durationMs / 1000.0f) * WAV_SAMPLE_RATE);
     uint32_t dataSize = totalSamples * sizeof(int16_t);
 
     return WAV_HEADER_SIZE + dataSize;
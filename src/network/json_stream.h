@@ -0,0 +1,189 @@
+// Streaming JSON Lexer
+// Tokenizes a JSON document one byte at a time, for response bodies too
+// large to hold in RAM (POTA spots, SatNOGS transmitters)
+
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <Arduino.h>
+
+// ============================================
+// Configuration
+// ============================================
+
+#define JSON_STREAM_KEY_MAX    24   // Longer member names are truncated
+#define JSON_STREAM_VALUE_MAX  64   // Longer values are truncated
+
+// ============================================
+// Lexer State
+// ============================================
+//
+// Only scalar members of objects at one depth (memberDepth) are reported,
+// through onField(); nested values are skipped by depth. onObject() brackets
+// each of those objects. Escapes other than \" \\ \/ become a space, and
+// \uXXXX becomes '?' (not decoded). null, true, false and numbers arrive as
+// their literal text with isString false.
+
+typedef void (*JsonStreamFieldFn)(void* ctx, const char* key, const char* value, bool isString);
+typedef void (*JsonStreamObjectFn)(void* ctx, bool open);
+
+enum JsonStreamLex : uint8_t {
+    JSON_LEX_STRUCT = 0,          // Between tokens
+    JSON_LEX_STRING,
+    JSON_LEX_ESCAPE,              // After a backslash
+    JSON_LEX_UNICODE,             // In the 4 hex digits of \uXXXX
+    JSON_LEX_LITERAL              // Number / true / false / null
+};
+
+struct JsonStreamLexer {
+    JsonStreamFieldFn onField;
+    JsonStreamObjectFn onObject;
+    void* ctx;
+    uint8_t memberDepth;          // Depth of the objects whose members are reported
+    uint8_t lex;
+    uint8_t depth;                // 1 = inside the top-level value
+    bool expectKey;               // At memberDepth, before the ':'
+    bool isKey;                   // The string being read is a member name
+    bool haveKey;                 // key[] names the value being read
+    bool done;                    // The top-level value closed
+    bool topArray;                // The top-level value is an array
+    uint8_t hexLeft;              // \uXXXX digits still to skip
+    uint8_t keyLen;
+    uint8_t valueLen;
+    char key[JSON_STREAM_KEY_MAX];
+    char value[JSON_STREAM_VALUE_MAX];
+};
+
+/**
+ * Reset the lexer for a new document
+ * @param memberDepth Depth of the reported objects (2 = objects in a top-level array)
+ */
+static void jsonStreamBegin(JsonStreamLexer& j, uint8_t memberDepth,
+                            JsonStreamFieldFn onField, JsonStreamObjectFn onObject, void* ctx) {
+    memset(&j, 0, sizeof(j));
+    j.memberDepth = memberDepth;
+    j.onField = onField;
+    j.onObject = onObject;
+    j.ctx = ctx;
+}
+
+// ============================================
+// Tokenizer
+// ============================================
+
+// Whether the current string/literal is worth keeping
+static inline bool jsonStreamCapturing(const JsonStreamLexer& j) {
+    return j.depth == j.memberDepth && (j.isKey || j.haveKey);
+}
+
+static inline void jsonStreamChar(JsonStreamLexer& j, char c) {
+    if (j.isKey) {
+        if (j.keyLen < sizeof(j.key) - 1) j.key[j.keyLen++] = c;
+    } else if (j.valueLen < sizeof(j.value) - 1) {
+        j.value[j.valueLen++] = c;
+    }
+}
+
+/**
+ * A complete member name, string or literal
+ */
+static void jsonStreamToken(JsonStreamLexer& j, bool isString) {
+    if (j.isKey) {
+        j.key[j.keyLen] = '\0';
+        j.isKey = false;
+        j.haveKey = true;
+        return;
+    }
+    j.value[j.valueLen] = '\0';
+    j.haveKey = false;
+    if (j.onField) j.onField(j.ctx, j.key, j.value, isString);
+}
+
+/**
+ * Feed one byte of the document
+ */
+void jsonStreamByte(JsonStreamLexer& j, char c) {
+    switch (j.lex) {
+        case JSON_LEX_STRING:
+            if (c == '"') {
+                j.lex = JSON_LEX_STRUCT;
+                if (jsonStreamCapturing(j)) jsonStreamToken(j, true);
+                else j.isKey = false;
+            } else if (c == '\\') {
+                j.lex = JSON_LEX_ESCAPE;
+            } else if (jsonStreamCapturing(j)) {
+                jsonStreamChar(j, ((uint8_t)c < 0x20) ? ' ' : c);
+            }
+            return;
+
+        case JSON_LEX_ESCAPE:
+            j.lex = JSON_LEX_STRING;
+            if (c == 'u') {
+                j.hexLeft = 4;
+                j.lex = JSON_LEX_UNICODE;
+                if (jsonStreamCapturing(j)) jsonStreamChar(j, '?');  // Not decoded
+            } else if (jsonStreamCapturing(j)) {
+                jsonStreamChar(j, (c == 'n' || c == 't' || c == 'r' || c == 'b' || c == 'f') ? ' ' : c);
+            }
+            return;
+
+        case JSON_LEX_UNICODE:
+            if (--j.hexLeft == 0) j.lex = JSON_LEX_STRING;
+            return;
+
+        case JSON_LEX_LITERAL:
+            if (isalnum((unsigned char)c) || c == '-' || c == '+' || c == '.') {
+                if (jsonStreamCapturing(j)) jsonStreamChar(j, c);
+                return;
+            }
+            j.lex = JSON_LEX_STRUCT;
+            if (jsonStreamCapturing(j)) jsonStreamToken(j, false);
+            break;  // c is structural: handle it below
+
+        default:
+            break;
+    }
+
+    switch (c) {
+        case '"':
+            j.lex = JSON_LEX_STRING;
+            j.isKey = (j.depth == j.memberDepth && j.expectKey);
+            if (j.isKey) j.keyLen = 0;
+            else j.valueLen = 0;
+            break;
+        case '{':
+        case '[':
+            if (j.depth++ == 0) j.topArray = (c == '[');
+            if (j.depth == j.memberDepth && c == '{') {
+                j.expectKey = true;
+                if (j.onObject) j.onObject(j.ctx, true);
+            }
+            j.haveKey = false;  // Nested value: skipped
+            break;
+        case '}':
+        case ']':
+            if (j.depth == j.memberDepth && c == '}' && j.onObject) j.onObject(j.ctx, false);
+            if (j.depth > 0 && --j.depth == 0) j.done = true;
+            j.haveKey = false;
+            break;
+        case ':':
+            if (j.depth == j.memberDepth) j.expectKey = false;
+            break;
+        case ',':
+            if (j.depth == j.memberDepth) {
+                j.expectKey = true;
+                j.haveKey = false;
+            }
+            break;
+        case ' ': case '\t': case '\r': case '\n':
+            break;
+        default:
+            // Start of a number / true / false / null
+            j.lex = JSON_LEX_LITERAL;
+            j.valueLen = 0;
+            if (jsonStreamCapturing(j)) jsonStreamChar(j, c);
+            break;
+    }
+}
+
+#endif // JSON_STREAM_H
@@ -7,8 +7,8 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <HTTPClient.h>
-#include <ArduinoJson.h>
 #include "internet_check.h"
+#include "json_stream.h"
 
 // ============================================
 // Configuration
@@ -78,6 +78,8 @@ static POTASpotsCache potaSpotsCache = {
     false    // initialized
 };
 
+static void potaFetchRelease();  // Fetch Job, below
+
 // ============================================
 // PSRAM Allocation
 // ============================================
@@ -133,6 +135,7 @@ bool initPOTASpotsCache() {
  * Free POTA spots cache memory
  */
 void freePOTASpotsCache() {
+    potaFetchRelease();
     if (potaSpotsCache.spots) {
         free(potaSpotsCache.spots);
         potaSpotsCache.spots = nullptr;
@@ -446,15 +449,216 @@ int filterSpots(const POTASpotsCache& cache, const POTASpotFilter& filter,
 }
 
 // ============================================
-// API Functions
+// Streaming Spot Parser
+// ============================================
+//
+// The activator feed is a JSON array of flat spot objects. It is fed one
+// byte at a time through the shared streaming lexer as it arrives: each
+// scalar member is copied into the matching POTASpot field (truncated to
+// fit), and a finished spot is filtered and appended to the output array.
+// Nested values are skipped by depth. Only one spot is held while parsing.
+
+enum POTASpotField : uint8_t {
+    POTA_F_NONE = 0,
+    POTA_F_SPOT_ID,
+    POTA_F_ACTIVATOR,
+    POTA_F_FREQUENCY,
+    POTA_F_MODE,
+    POTA_F_REFERENCE,
+    POTA_F_NAME,                  // "name", preferred over "parkName"
+    POTA_F_PARK_NAME,
+    POTA_F_SPOT_TIME,
+    POTA_F_SPOTTER,
+    POTA_F_COMMENTS,
+    POTA_F_GRID4,
+    POTA_F_GRID6,
+    POTA_F_LATITUDE,
+    POTA_F_LONGITUDE,
+    POTA_F_LOCATION,
+    POTA_F_COUNT,
+    POTA_F_INVALID
+};
+
+struct POTASpotParser {
+    POTASpot* spots;              // Destination
+    int maxSpots;
+    JsonStreamLexer json;
+    bool haveName;
+    bool invalid;
+    int seen;                     // Spot objects parsed
+    int count;                    // Spots kept
+    POTASpot spot;                // The spot being parsed
+};
+
+static uint8_t potaSpotFieldFor(const char* key) {
+    static const struct { const char* key; uint8_t field; } fields[] = {
+        {"spotId", POTA_F_SPOT_ID},       {"activator", POTA_F_ACTIVATOR},
+        {"frequency", POTA_F_FREQUENCY},  {"mode", POTA_F_MODE},
+        {"reference", POTA_F_REFERENCE},  {"name", POTA_F_NAME},
+        {"parkName", POTA_F_PARK_NAME},   {"spotTime", POTA_F_SPOT_TIME},
+        {"spotter", POTA_F_SPOTTER},      {"comments", POTA_F_COMMENTS},
+        {"grid4", POTA_F_GRID4},          {"grid6", POTA_F_GRID6},
+        {"latitude", POTA_F_LATITUDE},    {"longitude", POTA_F_LONGITUDE},
+        {"locationDesc", POTA_F_LOCATION}, {"count", POTA_F_COUNT},
+        {"invalid", POTA_F_INVALID}
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        if (strcmp(key, fields[i].key) == 0) return fields[i].field;
+    }
+    return POTA_F_NONE;
+}
+
+/**
+ * A string member of a spot object
+ */
+static void potaSpotString(POTASpotParser& p, uint8_t field, const char* value) {
+    POTASpot& s = p.spot;
+    switch (field) {
+        case POTA_F_ACTIVATOR: strlcpy(s.activator, value, sizeof(s.activator)); break;
+        case POTA_F_FREQUENCY: strlcpy(s.frequency, value, sizeof(s.frequency)); break;
+        case POTA_F_MODE:      strlcpy(s.mode, value, sizeof(s.mode)); break;
+        case POTA_F_REFERENCE: strlcpy(s.reference, value, sizeof(s.reference)); break;
+        case POTA_F_NAME:
+            strlcpy(s.parkName, value, sizeof(s.parkName));
+            p.haveName = true;
+            break;
+        case POTA_F_PARK_NAME:
+            if (!p.haveName) strlcpy(s.parkName, value, sizeof(s.parkName));
+            break;
+        case POTA_F_SPOT_TIME: strlcpy(s.spotTime, value, sizeof(s.spotTime)); break;
+        case POTA_F_SPOTTER:   strlcpy(s.spotter, value, sizeof(s.spotter)); break;
+        case POTA_F_COMMENTS:  strlcpy(s.comments, value, sizeof(s.comments)); break;
+        case POTA_F_GRID4:     strlcpy(s.grid4, value, sizeof(s.grid4)); break;
+        case POTA_F_GRID6:     strlcpy(s.grid6, value, sizeof(s.grid6)); break;
+        case POTA_F_LOCATION:  strlcpy(s.locationDesc, value, sizeof(s.locationDesc)); break;
+        default: break;
+    }
+}
+
+/**
+ * A number / true / false / null member of a spot object
+ */
+static void potaSpotLiteral(POTASpotParser& p, uint8_t field, const char* value) {
+    POTASpot& s = p.spot;
+    switch (field) {
+        case POTA_F_SPOT_ID:   s.spotId = strtoul(value, NULL, 10); break;
+        case POTA_F_LATITUDE:  s.latitude = strtof(value, NULL); break;
+        case POTA_F_LONGITUDE: s.longitude = strtof(value, NULL); break;
+        case POTA_F_COUNT:     s.qsoCount = atoi(value); break;
+        case POTA_F_INVALID:   p.invalid = (strcmp(value, "true") == 0); break;
+        case POTA_F_FREQUENCY: strlcpy(s.frequency, value, sizeof(s.frequency)); break;
+        default: break;
+    }
+}
+
+static void potaSpotField(void* ctx, const char* key, const char* value, bool isString) {
+    POTASpotParser& p = *(POTASpotParser*)ctx;
+    uint8_t field = potaSpotFieldFor(key);
+    if (isString) potaSpotString(p, field, value);
+    else potaSpotLiteral(p, field, value);
+}
+
+/**
+ * A spot object opened (clear it) or closed (keep it unless invalid or QRT)
+ */
+static void potaSpotObject(void* ctx, bool open) {
+    POTASpotParser& p = *(POTASpotParser*)ctx;
+    POTASpot& spot = p.spot;
+    if (open) {
+        memset(&spot, 0, sizeof(spot));
+        p.haveName = false;
+        p.invalid = false;
+        return;
+    }
+
+    p.seen++;
+    if (p.invalid) return;
+
+    // Convert callsigns to uppercase
+    for (int i = 0; spot.activator[i]; i++) {
+        spot.activator[i] = toupper(spot.activator[i]);
+    }
+    for (int i = 0; spot.spotter[i]; i++) {
+        spot.spotter[i] = toupper(spot.spotter[i]);
+    }
+
+    // Skip QRT spots
+    if (isSpotQRT(spot)) return;
+
+    if (p.count < p.maxSpots) {
+        p.spots[p.count++] = spot;
+    }
+}
+
+/**
+ * Reset the parser for a new response
+ */
+static void potaSpotParseBegin(POTASpotParser& p, POTASpot* spots, int maxSpots) {
+    memset(&p, 0, sizeof(p));
+    p.spots = spots;
+    p.maxSpots = maxSpots;
+    jsonStreamBegin(p.json, 2, potaSpotField, potaSpotObject, &p);
+}
+
+/**
+ * Closing ']' of the spot array seen
+ */
+static inline bool potaSpotArrayDone(const POTASpotParser& p) {
+    return p.json.done && p.json.topArray;
+}
+
+// ============================================
+// Fetch Job
 // ============================================
+//
+// Fetching runs as a staged job driven by potaFetchJobTick() from an LVGL
+// timer, one bounded slice per tick (as satUpdateJobTick() does), so the
+// screen keeps animating while the feed downloads. Spots are parsed into a
+// staging array and swapped into the cache only if the response turns out
+// to be the spot array: an error object, a failed request or an empty
+// truncated body leaves the current list in place.
+
+enum POTAFetchStage : uint8_t {
+    POTA_FETCH_IDLE = 0,
+    POTA_FETCH_CONNECT,           // Next tick sends the request
+    POTA_FETCH_BODY               // Parsing the response
+};
+
+struct POTAFetchJob {
+    POTAFetchStage stage;
+    POTASpotsCache* cache;
+    POTASpot* incoming;           // Staging array (swapped with cache->spots)
+    int incomingMax;
+    int totalRead;
+    uint32_t lastData;
+    int result;                   // Spots loaded or -1; valid once idle
+};
+
+static POTAFetchJob potaFetch = {POTA_FETCH_IDLE, nullptr, nullptr, 0, 0, 0, -1};
+static HTTPClient potaFetchHttp;  // Too big for the stack
+static POTASpotParser potaFetchParser;
+static uint8_t potaFetchChunk[512];
+
+bool potaFetchJobActive() { return potaFetch.stage != POTA_FETCH_IDLE; }
+
+// Spots loaded by the last finished fetch, or -1 if it failed
+int potaFetchJobResult() { return potaFetch.result; }
+
+static void potaFetchEnd(int result) {
+    if (potaFetch.stage == POTA_FETCH_BODY) potaFetchHttp.end();
+    potaFetch.stage = POTA_FETCH_IDLE;
+    potaFetch.result = result;
+    if (potaFetch.cache) potaFetch.cache->fetching = false;
+}
 
 /**
- * Fetch active spots from POTA API
- * @param cache Cache to populate
- * @return Number of spots fetched, or -1 on error
+ * Begin fetching active spots into `cache`
+ * @return false (result -1) if it cannot start: no internet or no memory
  */
-int fetchActiveSpots(POTASpotsCache& cache) {
+bool potaFetchJobStart(POTASpotsCache& cache) {
+    if (potaFetchJobActive()) return true;
+    potaFetch.result = -1;
+
     // Check internet connectivity (not just WiFi association)
     InternetStatus inetStatus = getInternetStatus();
     if (inetStatus != INET_CONNECTED) {
@@ -463,158 +667,161 @@ int fetchActiveSpots(POTASpotsCache& cache) {
         } else {
             Serial.println("POTA Spots: No WiFi connection");
         }
-        return -1;
+        return false;
     }
 
     // Initialize cache if not already done
     if (!cache.initialized) {
         if (!initPOTASpotsCache()) {
             Serial.println("POTA Spots: Failed to initialize cache");
-            return -1;
+            return false;
         }
     }
 
     // Verify we have a valid spots array
     if (!cache.spots || cache.maxSpots == 0) {
         Serial.println("POTA Spots: Cache not properly allocated");
-        return -1;
+        return false;
     }
 
-    cache.fetching = true;
+    // Staging array, same capacity as the cache (kept between fetches)
+    if (potaFetch.incoming && potaFetch.incomingMax != cache.maxSpots) {
+        free(potaFetch.incoming);
+        potaFetch.incoming = nullptr;
+    }
+    if (!potaFetch.incoming) {
+        size_t bytes = sizeof(POTASpot) * cache.maxSpots;
+        potaFetch.incoming = (POTASpot*)(psramFound() ? ps_malloc(bytes) : malloc(bytes));
+        if (!potaFetch.incoming) {
+            Serial.println("POTA Spots: No memory for the incoming spots");
+            return false;
+        }
+        potaFetch.incomingMax = cache.maxSpots;
+    }
 
     Serial.println("POTA Spots: Fetching active spots...");
     Serial.printf("POTA Spots: Free heap: %d, PSRAM free: %d\n", ESP.getFreeHeap(), ESP.getFreePsram());
     Serial.printf("POTA Spots: Cache can hold up to %d spots\n", cache.maxSpots);
 
-    HTTPClient http;
-    http.begin("https://api.pota.app/spot/activator");
-    http.setTimeout(POTA_SPOTS_TIMEOUT);
-    http.addHeader("Accept", "application/json");
-
-    int httpCode = http.GET();
-
-    if (httpCode != 200) {
-        Serial.printf("POTA Spots: HTTP error %d\n", httpCode);
-        http.end();
-        cache.fetching = false;
-        return -1;
-    }
+    cache.fetching = true;
+    potaFetch.cache = &cache;
+    potaFetch.totalRead = 0;
+    potaFetch.stage = POTA_FETCH_CONNECT;
+    return true;
+}
 
-    // Check if we have enough memory before reading response
-    int contentLength = http.getSize();
-    Serial.printf("POTA Spots: Content-Length: %d\n", contentLength);
+/**
+ * Stop a running fetch, keeping the current list
+ */
+void potaFetchJobCancel() {
+    if (!potaFetchJobActive()) return;
+    Serial.println("POTA Spots: Fetch cancelled");
+    potaFetchEnd(-1);
+}
 
-    // Use PSRAM for large responses if available
-    size_t requiredMem = contentLength + 65536;  // Response + JSON buffer headroom
-    bool havePsram = psramFound() && ESP.getFreePsram() > requiredMem;
+// Stop any fetch and free the staging array (with the cache)
+static void potaFetchRelease() {
+    potaFetchJobCancel();
+    free(potaFetch.incoming);
+    potaFetch.incoming = nullptr;
+    potaFetch.incomingMax = 0;
+}
 
-    if (!havePsram && contentLength > 0 && ESP.getFreeHeap() < requiredMem) {
-        Serial.println("POTA Spots: Not enough memory for response!");
-        http.end();
-        cache.fetching = false;
-        return -1;
+/**
+ * Response finished (or stopped): commit the new list if it was the spot array
+ */
+static void potaFetchFinish() {
+    POTASpotParser& parser = potaFetchParser;
+    POTASpotsCache& cache = *potaFetch.cache;
+    bool full = parser.count >= parser.maxSpots;
+
+    Serial.printf("POTA Spots: Received %d bytes, %d spots in response\n", potaFetch.totalRead, parser.seen);
+    if (full && !potaSpotArrayDone(parser)) {
+        Serial.printf("POTA Spots: Cache full at %d spots\n", cache.maxSpots);
     }
 
-    String payload = http.getString();
-    http.end();
-
-    Serial.printf("POTA Spots: Received %d bytes\n", payload.length());
-    Serial.printf("POTA Spots: Free heap after receive: %d\n", ESP.getFreeHeap());
-
-    // Use larger JSON buffer for more spots
-    // Each spot is ~500 bytes in JSON, so 200 spots = ~100KB
-    // Allocate in PSRAM if available
-    size_t jsonBufferSize = 131072;  // 128KB for ~200 spots
-    DynamicJsonDocument* doc;
-
-    if (psramFound()) {
-        // Allocate JSON document in PSRAM
-        doc = new (ps_malloc(sizeof(DynamicJsonDocument))) DynamicJsonDocument(jsonBufferSize);
-        Serial.printf("POTA Spots: JSON buffer allocated in PSRAM (%d bytes)\n", jsonBufferSize);
-    } else {
-        // Fall back to heap with smaller buffer
-        jsonBufferSize = 32768;  // 32KB for ~50 spots
-        doc = new DynamicJsonDocument(jsonBufferSize);
-        Serial.printf("POTA Spots: JSON buffer allocated in heap (%d bytes)\n", jsonBufferSize);
+    if (!parser.json.topArray) {
+        Serial.println("POTA Spots: Response is not a spot list");
+        potaFetchEnd(-1);
+        return;
     }
 
-    DeserializationError error = deserializeJson(*doc, payload);
-
-    // Free the payload string ASAP to recover memory
-    payload = String();
-
-    if (error) {
-        Serial.printf("POTA Spots: JSON parse error - %s\n", error.c_str());
-        delete doc;
-        cache.fetching = false;
-        return -1;
+    // Whatever completed stands even if the response was cut short.
+    // Nothing parsed at all leaves the previous list in place.
+    if (!potaSpotArrayDone(parser) && !full) {
+        if (parser.seen == 0) {
+            Serial.println("POTA Spots: No spots in response");
+            potaFetchEnd(-1);
+            return;
+        }
+        Serial.println("POTA Spots: Response truncated, keeping complete spots");
     }
 
-    Serial.printf("POTA Spots: Free heap after parse: %d\n", ESP.getFreeHeap());
-
-    JsonArray spotsArray = doc->as<JsonArray>();
-    Serial.printf("POTA Spots: API returned %d spots\n", spotsArray.size());
+    POTASpot* old = cache.spots;
+    cache.spots = potaFetch.incoming;
+    potaFetch.incoming = old;
+    cache.count = parser.count;
+    cache.fetchTime = millis();
+    cache.valid = true;
 
-    // Clear cache
-    cache.count = 0;
+    Serial.printf("POTA Spots: Loaded %d spots\n", cache.count);
+    Serial.printf("POTA Spots: Free heap after fetch: %d, PSRAM free: %d\n", ESP.getFreeHeap(), ESP.getFreePsram());
+    potaFetchEnd(cache.count);
+}
 
-    // Parse each spot
-    for (JsonObject spotObj : spotsArray) {
-        if (cache.count >= cache.maxSpots) {
-            Serial.printf("POTA Spots: Cache full at %d spots\n", cache.maxSpots);
-            break;
+/**
+ * One slice of the fetch, bounded by budgetMs. Call from an LVGL timer.
+ */
+void potaFetchJobTick(uint32_t budgetMs) {
+    if (!potaFetchJobActive()) return;
+    uint32_t t0 = millis();
+
+    if (potaFetch.stage == POTA_FETCH_CONNECT) {
+        // TLS handshake and headers block ~1-3s, once per fetch; a frame
+        // renders right after
+        potaFetchHttp.begin("https://api.pota.app/spot/activator");
+        potaFetchHttp.setTimeout(POTA_SPOTS_TIMEOUT);
+        potaFetchHttp.useHTTP10(true);  // No chunked transfer encoding: the raw stream is the body
+        potaFetchHttp.addHeader("Accept", "application/json");
+
+        int httpCode = potaFetchHttp.GET();
+        if (httpCode != 200) {
+            Serial.printf("POTA Spots: HTTP error %d\n", httpCode);
+            potaFetchHttp.end();
+            potaFetchEnd(-1);
+            return;
         }
+        Serial.printf("POTA Spots: Content-Length: %d\n", potaFetchHttp.getSize());
 
-        // Skip invalid spots
-        if (spotObj["invalid"].as<bool>()) {
-            continue;
-        }
+        potaSpotParseBegin(potaFetchParser, potaFetch.incoming, potaFetch.incomingMax);
+        potaFetch.lastData = millis();
+        potaFetch.stage = POTA_FETCH_BODY;
+        return;
+    }
 
-        POTASpot& spot = cache.spots[cache.count];
-
-        spot.spotId = spotObj["spotId"] | 0;
-        strlcpy(spot.activator, spotObj["activator"] | "", sizeof(spot.activator));
-        strlcpy(spot.frequency, spotObj["frequency"] | "", sizeof(spot.frequency));
-        strlcpy(spot.mode, spotObj["mode"] | "", sizeof(spot.mode));
-        strlcpy(spot.reference, spotObj["reference"] | "", sizeof(spot.reference));
-        strlcpy(spot.parkName, spotObj["name"] | spotObj["parkName"] | "", sizeof(spot.parkName));
-        strlcpy(spot.spotTime, spotObj["spotTime"] | "", sizeof(spot.spotTime));
-        strlcpy(spot.spotter, spotObj["spotter"] | "", sizeof(spot.spotter));
-        strlcpy(spot.comments, spotObj["comments"] | "", sizeof(spot.comments));
-        strlcpy(spot.grid4, spotObj["grid4"] | "", sizeof(spot.grid4));
-        strlcpy(spot.grid6, spotObj["grid6"] | "", sizeof(spot.grid6));
-        spot.latitude = spotObj["latitude"] | 0.0f;
-        spot.longitude = spotObj["longitude"] | 0.0f;
-        strlcpy(spot.locationDesc, spotObj["locationDesc"] | "", sizeof(spot.locationDesc));
-        spot.qsoCount = spotObj["count"] | 0;
-
-        // Convert callsigns to uppercase
-        for (int i = 0; spot.activator[i]; i++) {
-            spot.activator[i] = toupper(spot.activator[i]);
+    WiFiClient* stream = potaFetchHttp.getStreamPtr();
+    while ((millis() - t0) < budgetMs) {
+        if (potaFetchParser.json.done || potaFetchParser.count >= potaFetchParser.maxSpots) {
+            potaFetchFinish();
+            return;
         }
-        for (int i = 0; spot.spotter[i]; i++) {
-            spot.spotter[i] = toupper(spot.spotter[i]);
+        int avail = stream->available();
+        if (avail <= 0) {
+            if (!potaFetchHttp.connected()) {
+                potaFetchFinish();
+            } else if (millis() - potaFetch.lastData > POTA_SPOTS_TIMEOUT) {
+                Serial.println("POTA Spots: Response stalled");
+                potaFetchFinish();
+            }
+            return;  // Nothing yet - let the UI animate
         }
-
-        // Skip QRT spots
-        if (isSpotQRT(spot)) {
-            continue;
+        int n = stream->readBytes(potaFetchChunk, min(avail, (int)sizeof(potaFetchChunk)));
+        potaFetch.lastData = millis();
+        potaFetch.totalRead += n;
+        for (int i = 0; i < n; i++) {
+            jsonStreamByte(potaFetchParser.json, (char)potaFetchChunk[i]);
         }
-
-        cache.count++;
     }
-
-    // Free JSON document
-    delete doc;
-
-    cache.fetchTime = millis();
-    cache.valid = true;
-    cache.fetching = false;
-
-    Serial.printf("POTA Spots: Loaded %d spots\n", cache.count);
-    Serial.printf("POTA Spots: Free heap after cleanup: %d, PSRAM free: %d\n", ESP.getFreeHeap(), ESP.getFreePsram());
-
-    return cache.count;
 }
 
 /**
@@ -29,6 +29,7 @@
 #include "../audio/morse_decoder_adaptive.h"
 #include "../audio/morse_decoder_direct.h"
 #include "../keyer/keyer.h"
+#include "../morse_notes/morse_notes_session_recorder.h"
 #include "internet_check.h"
 #include <esp_timer.h>
 
@@ -152,9 +153,165 @@ struct VailMessage {
 
 std::vector<VailMessage> rxQueue;
 unsigned long playbackDelay = 500;  // 500ms delay for network jitter
-int64_t clockSkew = 0;  // Offset to convert millis() to server time
+int64_t clockSkew = 0;  // Offset to convert millis() to server time (at clockSkewRefMs)
 int clockSkewSamples = 0;  // Number of clock skew samples received
 
+// Clock offset estimator (minimum-delay filter, NTP-style).
+// Each clock-sync message gives skew = serverTs - millis() at arrival, which
+// is the true offset MINUS that packet's one-way network delay. Delay is never
+// negative, so the sample with the LARGEST skew in a recent window is the one
+// that travelled fastest and is the best offset estimate. A single late packet
+// can therefore never drag our TX stamps late. Everything stays int64 - float
+// math on epoch-scale values quantizes to ~131s steps.
+#define VAIL_CLOCK_WINDOW         16       // sync samples kept
+#define VAIL_CLOCK_MAX_AGE_MS     180000   // drop samples older than 3 minutes
+#define VAIL_CLOCK_OUTLIER_MS     1500     // sample this far ABOVE the floor is implausible
+#define VAIL_CLOCK_STEP_MS        2000     // recent best this far BELOW the floor = server step
+#define VAIL_CLOCK_STEP_CONFIRM   3        // consecutive outliers/steps before re-seeding
+#define VAIL_CLOCK_DRIFT_BASE_MS  60000    // min baseline for a drift measurement
+#define VAIL_CLOCK_DRIFT_MAX_PPM  300      // crystal drift clamp
+
+struct VailClockSample {
+  uint32_t localMs;  // millis() at arrival
+  int64_t skew;      // serverTs - localMs
+};
+
+static VailClockSample vailClockSamples[VAIL_CLOCK_WINDOW];
+static int vailClockSampleCount = 0;
+static int vailClockSampleHead = 0;        // next write slot
+static uint32_t clockSkewRefMs = 0;        // millis() that clockSkew refers to
+static int32_t vailClockDriftPpm = 0;      // server-vs-local rate difference (ppm)
+static int64_t vailClockAnchorSkew = 0;    // drift baseline start
+static uint32_t vailClockAnchorMs = 0;
+static bool vailClockAnchorValid = false;
+static int32_t vailClockUncertaintyMs = 0; // typical delay above the floor
+static int vailClockRejectRun = 0;         // consecutive rejected samples
+
+static void resetVailClockSync() {
+  vailClockSampleCount = 0;
+  vailClockSampleHead = 0;
+  vailClockDriftPpm = 0;
+  vailClockAnchorValid = false;
+  vailClockUncertaintyMs = 0;
+  vailClockRejectRun = 0;
+  clockSkewSamples = 0;
+}
+
+// Skew a sample implies at localNow, after drift correction
+static inline int64_t vailClockProject(int64_t skew, uint32_t fromMs, uint32_t toMs) {
+  int32_t dt = (int32_t)(toMs - fromMs);
+  return skew + ((int64_t)vailClockDriftPpm * dt) / 1000000LL;
+}
+
+// Current offset estimate for a given millis() value (drift-corrected)
+static inline int64_t vailClockOffsetAt(uint32_t localMs) {
+  return vailClockProject(clockSkew, clockSkewRefMs, localMs);
+}
+
+// Recompute the floor (best sample) and jitter from the window
+static void recomputeVailClockEstimate(uint32_t now) {
+  int64_t projected[VAIL_CLOCK_WINDOW];
+  int n = 0;
+  int64_t best = INT64_MIN;
+  for (int i = 0; i < vailClockSampleCount; i++) {
+    const VailClockSample &s = vailClockSamples[i];
+    if ((uint32_t)(now - s.localMs) > VAIL_CLOCK_MAX_AGE_MS) continue;
+    int64_t p = vailClockProject(s.skew, s.localMs, now);
+    projected[n++] = p;
+    if (p > best) best = p;
+  }
+  if (n == 0) return;
+
+  clockSkew = best;
+  clockSkewRefMs = now;
+
+  // Uncertainty = median delay above the floor (insertion sort, n <= 16)
+  for (int i = 1; i < n; i++) {
+    int64_t v = projected[i];
+    int j = i - 1;
+    while (j >= 0 && projected[j] > v) { projected[j + 1] = projected[j]; j--; }
+    projected[j + 1] = v;
+  }
+  int64_t spread = best - projected[n / 2];
+  vailClockUncertaintyMs = (int32_t)(spread > 100000 ? 100000 : spread);
+}
+
+// Track rate difference between millis() and the server clock using the
+// floor estimate at two points at least VAIL_CLOCK_DRIFT_BASE_MS apart.
+static void updateVailClockDrift(uint32_t now) {
+  if (!vailClockAnchorValid) {
+    vailClockAnchorSkew = clockSkew;
+    vailClockAnchorMs = now;
+    vailClockAnchorValid = true;
+    return;
+  }
+  int32_t dt = (int32_t)(now - vailClockAnchorMs);
+  if (dt < VAIL_CLOCK_DRIFT_BASE_MS) return;
+
+  // Measured skew change minus what the current drift already predicted
+  int64_t predicted = vailClockProject(vailClockAnchorSkew, vailClockAnchorMs, now);
+  int64_t residualPpm = ((clockSkew - predicted) * 1000000LL) / dt;
+  int64_t ppm = vailClockDriftPpm + residualPpm / 4;  // 1/4 gain - delay noise is large
+  if (ppm > VAIL_CLOCK_DRIFT_MAX_PPM) ppm = VAIL_CLOCK_DRIFT_MAX_PPM;
+  if (ppm < -VAIL_CLOCK_DRIFT_MAX_PPM) ppm = -VAIL_CLOCK_DRIFT_MAX_PPM;
+  vailClockDriftPpm = (int32_t)ppm;
+
+  vailClockAnchorSkew = clockSkew;
+  vailClockAnchorMs = now;
+}
+
+static void vailClockStoreSample(uint32_t localMs, int64_t skew) {
+  vailClockSamples[vailClockSampleHead].localMs = localMs;
+  vailClockSamples[vailClockSampleHead].skew = skew;
+  vailClockSampleHead = (vailClockSampleHead + 1) % VAIL_CLOCK_WINDOW;
+  if (vailClockSampleCount < VAIL_CLOCK_WINDOW) vailClockSampleCount++;
+}
+
+// Feed one server clock-sync stamp received at millis() == localMs
+static void addVailClockSample(int64_t serverTs, uint32_t localMs) {
+  int64_t skew = serverTs - (int64_t)localMs;
+
+  if (clockSkewSamples == 0) {
+    // First sample seeds the estimate directly
+    vailClockStoreSample(localMs, skew);
+    clockSkew = skew;
+    clockSkewRefMs = localMs;
+    clockSkewSamples = 1;
+    vailClockRejectRun = 0;
+    return;
+  }
+
+  int64_t floorNow = vailClockOffsetAt(localMs);
+  int64_t diff = skew - floorNow;
+
+  // Above the floor: the packet arrived "before it was sent" by more than any
+  // plausible jitter. Below by a lot: either very late or the server stepped.
+  // Ignore either, unless it keeps happening - then the server clock really
+  // moved, and we re-seed before its 10s "clock is off" threshold is reached.
+  if (diff > VAIL_CLOCK_OUTLIER_MS || diff < -VAIL_CLOCK_STEP_MS) {
+    vailClockRejectRun++;
+    if (vailClockRejectRun < VAIL_CLOCK_STEP_CONFIRM) {
+      VAIL_LOG("Clock sync: rejected sample (diff=%lld)\n", (long long)diff);
+      return;
+    }
+    VAIL_LOG("Clock sync: server step detected, re-seeding\n");
+    resetVailClockSync();
+    addVailClockSample(serverTs, localMs);
+    return;
+  }
+  vailClockRejectRun = 0;
+
+  vailClockStoreSample(localMs, skew);
+  clockSkewSamples++;
+  recomputeVailClockEstimate(localMs);
+  updateVailClockDrift(localMs);
+}
+
+// Public read-outs for diagnostics/UI
+int64_t getVailClockOffset() { return vailClockOffsetAt(millis()); }
+int32_t getVailClockUncertaintyMs() { return vailClockUncertaintyMs; }
+int32_t getVailClockDriftPpm() { return vailClockDriftPpm; }
+
 // RX decoding (incoming morse -> text) is only allowed on the dedicated
 // "Decoder" room, matching vailmorse.com behavior. On all other rooms the
 // decoder must stay dormant — both decoded text and the dot/dash row.
@@ -351,13 +508,15 @@ float midiNoteToFrequency(uint8_t note) {
 
 // Get current timestamp in milliseconds (Unix epoch)
 int64_t getCurrentTimestamp() {
-  // Prefer the SERVER-derived clock (millis + skew, EMA-updated from every
-  // empty-Duration server message). Receivers schedule playback against the
-  // server clock, so any NTP-vs-server difference in our stamps shows up on
-  // their end as "increase receive delay" errors. NTP is only the fallback
-  // until the first server clock-sync message arrives.
+  // Prefer the SERVER-derived clock (millis + skew, min-delay filtered over
+  // recent empty-Duration server messages, see addVailClockSample()).
+  // Receivers schedule playback against the server clock, so any
+  // NTP-vs-server difference in our stamps shows up on their end as
+  // "increase receive delay" errors. NTP is only the fallback until the
+  // first server clock-sync message arrives.
+  uint32_t nowMs = millis();
   if (clockSkewSamples > 0) {
-    return (int64_t)millis() + clockSkew;
+    return (int64_t)nowMs + vailClockOffsetAt(nowMs);
   }
 
   struct timeval tv;
@@ -366,7 +525,7 @@ int64_t getCurrentTimestamp() {
 
   // If timestamp is unreasonably small, we don't have NTP time yet either
   if (timestamp < 1000000000000LL) {
-    timestamp = (int64_t)millis() + clockSkew;
+    timestamp = (int64_t)nowMs + clockSkew;
   }
 
   return timestamp;
@@ -476,6 +635,11 @@ void connectToVail(String channel) {
 
 // Disconnect from Vail
 void disconnectFromVail() {
+  // Finalize an in-progress session recording even if the link already dropped
+  if (mnSessionIsActive()) {
+    mnSessionStop();
+  }
+
   if (vailState == VAIL_DISCONNECTED) {
     return;  // Already disconnected
   }
@@ -515,7 +679,7 @@ void disconnectFromVail() {
   vailPendingSendCount = 0;
   connectedUsers.clear();
   activeRooms.clear();
-  clockSkewSamples = 0;  // Reset clock sync on disconnect
+  resetVailClockSync();  // Reset clock sync on disconnect
   vailIsTransmitting = false;
 
   // Reset keyer state
@@ -695,6 +859,12 @@ void processReceivedMessage(String jsonPayload) {
     // Add to receive queue with playback delay
     rxQueue.push_back(msg);
 
+    if (mnSessionIsActive()) {
+      const char* sender = doc["Callsign"] | "Unknown";
+      mnSessionAddElements(sender, msg.timestamp, msg.durations.data(),
+                           (int)msg.durations.size(), false);
+    }
+
     VAIL_LOG("Queued message: %d elements at tone %d\n", (int)msg.durations.size(), (int)msg.txTone);
   } else if (!isChatMessage) {
     // Empty duration + no Text = clock sync message (keepalive/room update,
@@ -704,14 +874,16 @@ void processReceivedMessage(String jsonPayload) {
     // keyed element was stamped in the past and the server kicked us
     // ("Your clock is off by too much") the moment we sent.
     //
-    // Direct assignment, last message wins - same as the reference web client.
-    // (An EMA here converges too slowly to recover from one bad sample before
-    // the server's 10s kick threshold, and float math on the epoch-scale skew
-    // quantizes to ~131s steps. Keep this integer and simple.)
-    clockSkew = msg.timestamp - (int64_t)millis();
-    clockSkewSamples++;
+    // Minimum-delay filter rather than last-message-wins: a single delayed
+    // sync packet no longer shifts our TX stamps by its network delay. (An
+    // EMA would converge too slowly to recover from one bad sample before the
+    // server's 10s kick threshold; step detection in the estimator re-seeds
+    // instead.)
+    addVailClockSample(msg.timestamp, (uint32_t)millis());
 
-    VAIL_LOG("Clock sync: skew=%lld (samples=%d)\n", (long long)clockSkew, clockSkewSamples);
+    VAIL_LOG("Clock sync: skew=%lld +/-%ldms drift=%ldppm (samples=%d)\n",
+             (long long)clockSkew, (long)vailClockUncertaintyMs,
+             (long)vailClockDriftPpm, clockSkewSamples);
   }
 }
 
@@ -801,10 +973,27 @@ void sendVailMessage(std::vector<uint16_t> durations, int64_t timestamp) {
 static void flushVailPendingSends() {
   for (int i = 0; i < vailPendingSendCount; i++) {
     sendVailMessage({vailPendingSends[i].durMs}, vailPendingSends[i].ts);
+    if (mnSessionIsActive()) {
+      mnSessionAddElements(vailCallsign.c_str(), vailPendingSends[i].ts,
+                           &vailPendingSends[i].durMs, 1, true);
+    }
   }
   vailPendingSendCount = 0;
 }
 
+// Start/stop recording the room (RX + TX, tagged by sender) to a Morse Note.
+// Timestamps are server-clock ms, so the session clock is getCurrentTimestamp().
+bool vailToggleSessionRecording() {
+  if (mnSessionIsActive()) {
+    mnSessionStop();
+    return false;
+  }
+  String prefix = "Vail " + vailChannel;
+  String tags = "vail," + vailChannel;
+  return mnSessionStart(vailCallsign.c_str(), getCurrentTimestamp(), cwTone,
+                        prefix.c_str(), tags.c_str());
+}
+
 // Keyer callback - called from Core 1 main loop (like practice mode)
 void vailKeyerCallback(bool txOn, int element) {
   unsigned long now = millis();
@@ -933,6 +1122,9 @@ void updateVailRepeater(LGFX &display) {
   // Playback received messages
   playbackMessages();
 
+  // Session recording: write full buffer halves to SD between tones only
+  mnSessionService(!isTonePlaying());
+
   // Note: UI updates are now handled by LVGL via updateVailScreenLVGL()
 }
 
@@ -1838,6 +2030,10 @@ void disconnectFromVail() {
   // Nothing to do
 }
 
+bool vailToggleSessionRecording() {
+  return false;
+}
+
 #endif // VAIL_ENABLED
 
 #endif // VAIL_REPEATER_H
@@ -35,6 +35,8 @@ struct QSO {
   char contest[31];           // Contest name (optional)
   int srx;                    // Serial RX (contest)
   int stx;                    // Serial TX (contest)
+  char srx_string[11];        // Received exchange text (contest, e.g. "MA")
+  char stx_string[11];        // Sent exchange text (contest)
   char operator_call[11];     // Device operator callsign
   char station_call[11];      // Station callsign (same unless guest op)
 
@@ -46,6 +48,10 @@ struct QSO {
   char their_pota_ref[11];    // Their POTA park reference (if activating)
 };
 
+// Visitor for QSO iteration (forEachQSO / forEachQSOInDay in
+// qso_logger_storage.h). Return false to stop the walk early.
+typedef bool (*QSOVisitor)(const QSO& qso, void* ctx);
+
 // ============================================
 // Log Entry Form State
 // ============================================
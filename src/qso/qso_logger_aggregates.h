@@ -0,0 +1,329 @@
+// QSO Logger Aggregates Module
+// Persistent log statistics, updated incrementally on save/edit/delete
+// so the statistics screen never has to rescan the log
+
+#ifndef QSO_LOGGER_AGGREGATES_H
+#define QSO_LOGGER_AGGREGATES_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include <vector>
+#include <algorithm>
+#include "qso_logger.h"  // Same folder
+#include "qso_logger_hash.h"  // Same folder
+#include "../storage/atomic_file.h"
+
+// ============================================
+// Aggregate Storage
+// ============================================
+//
+// Counters per band, mode, day and country (the logged COUNTRY field stands
+// in for the DXCC entity), plus an exact unique-callsign set: a
+// QSOHashCounter of 64-bit callsign hashes with per-call QSO counts.
+// Names past a table's capacity are counted in its "other" bucket, so the
+// table totals always add up.
+//
+// Snapshot on SD in /qso/stats.bin, written via markDeferredSave() so it
+// never lands mid-tone, and replaced atomically (atomic_file.h) so a power
+// cut can't tear it. /qso/stats.dirty is created on the first change after a
+// snapshot; a dirty, missing or corrupt snapshot is rebuilt from the log.
+
+#define QSO_AGG_FILE "/qso/stats.bin"
+#define QSO_AGG_DIRTY_FILE "/qso/stats.dirty"
+#define QSO_AGG_MAGIC 0x47474151        // "QAGG"
+#define QSO_AGG_VERSION 3
+#define QSO_AGG_MAX_BANDS 16
+#define QSO_AGG_MAX_MODES 12
+#define QSO_AGG_MAX_COUNTRIES 400       // > 340 DXCC entities
+#define QSO_AGG_CALLS_INITIAL 1024      // Call table slots (power of two)
+
+struct __attribute__((packed)) QSOAggHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t totalQSOs;
+  uint16_t bandCount;
+  uint16_t modeCount;
+  uint16_t countryCount;
+  uint16_t reserved2;
+  uint32_t dayCount;
+  uint32_t callCount;
+  uint32_t bandOther;
+  uint32_t modeOther;
+  uint32_t countryOther;
+};
+
+struct __attribute__((packed)) QSOAggBand {
+  char band[6];
+  uint32_t count;
+};
+
+struct __attribute__((packed)) QSOAggMode {
+  char mode[8];
+  uint32_t count;
+};
+
+struct __attribute__((packed)) QSOAggCountry {
+  char country[31];
+  uint32_t count;
+};
+
+struct __attribute__((packed)) QSOAggDay {
+  uint32_t date;     // YYYYMMDD
+  uint32_t count;
+};
+
+struct QSOAggregates {
+  uint32_t totalQSOs;
+  QSOAggBand bands[QSO_AGG_MAX_BANDS];
+  int bandCount;
+  uint32_t bandOther;          // QSOs on bands past the table
+  QSOAggMode modes[QSO_AGG_MAX_MODES];
+  int modeCount;
+  uint32_t modeOther;          // QSOs in modes past the table
+  QSOAggCountry* countries;    // PSRAM, QSO_AGG_MAX_COUNTRIES entries
+  int countryCount;
+  uint32_t countryOther;       // QSOs with countries past the table
+  std::vector<QSOAggDay> days; // Sorted by date, only days with QSOs
+  QSOHashCounter calls;        // Callsign hash -> QSO count
+  bool snapshotDirty;          // SD snapshot marked dirty since last save
+};
+
+QSOAggregates qsoAgg = {};
+
+// ============================================
+// Helpers
+// ============================================
+
+static void* qsoAggAlloc(size_t bytes) {
+  void* p = psramFound() ? ps_calloc(1, bytes) : nullptr;
+  return p ? p : calloc(1, bytes);
+}
+
+/*
+ * 64-bit hash of a callsign, case-insensitive
+ */
+uint64_t qsoCallHash64(const char* call) {
+  return qsoHashStr(call);
+}
+
+static void qsoAggCountDay(uint32_t date, int delta, uint32_t times = 1) {
+  QSOAggDay key = {date, 0};
+  auto it = std::lower_bound(qsoAgg.days.begin(), qsoAgg.days.end(), key,
+                             [](const QSOAggDay& a, const QSOAggDay& b) { return a.date < b.date; });
+  if (it != qsoAgg.days.end() && it->date == date) {
+    if (delta > 0) {
+      it->count += times;
+    } else if (it->count <= 1) {
+      qsoAgg.days.erase(it);
+    } else {
+      it->count--;
+    }
+  } else if (delta > 0) {
+    key.count = times;
+    qsoAgg.days.insert(it, key);
+  }
+}
+
+// Shared find-or-add for the small named counter tables. Each entry type
+// starts with its name field, followed by `count`. A name that doesn't fit
+// goes to `other`.
+template <typename T>
+static void qsoAggCountNamed(T* table, int& used, int max, uint32_t& other, size_t fieldLen,
+                             const char* name, int delta, uint32_t times = 1) {
+  for (int i = 0; i < used; i++) {
+    char* entry = (char*)&table[i];
+    if (strncasecmp(entry, name, fieldLen) == 0) {
+      if (delta > 0) table[i].count += times;
+      else if (table[i].count > 0) table[i].count--;
+      return;
+    }
+  }
+  if (delta > 0 && used < max) {
+    memset(&table[used], 0, sizeof(T));
+    strlcpy((char*)&table[used], name, fieldLen);
+    table[used].count = times;
+    used++;
+  } else if (delta > 0) {
+    other += times;
+  } else if (other > 0) {
+    other--;
+  }
+}
+
+// ============================================
+// Public API
+// ============================================
+
+/*
+ * Clear all aggregates (keeps the allocated call table)
+ */
+void resetQSOAggregates() {
+  qsoAgg.totalQSOs = 0;
+  qsoAgg.bandCount = 0;
+  qsoAgg.bandOther = 0;
+  qsoAgg.modeCount = 0;
+  qsoAgg.modeOther = 0;
+  qsoAgg.countryCount = 0;
+  qsoAgg.countryOther = 0;
+  qsoAgg.days.clear();
+  if (qsoAgg.countries == nullptr) {
+    qsoAgg.countries = (QSOAggCountry*)qsoAggAlloc(QSO_AGG_MAX_COUNTRIES * sizeof(QSOAggCountry));
+  }
+  qsoHashInit(qsoAgg.calls, QSO_AGG_CALLS_INITIAL);
+}
+
+/*
+ * Apply one QSO to the aggregates (delta = +1 on save, -1 on delete)
+ */
+void qsoAggApply(const QSO& qso, int delta) {
+  if (delta < 0 && qsoAgg.totalQSOs == 0) return;
+  qsoAgg.totalQSOs += delta;
+
+  if (strlen(qso.band) > 0) {
+    qsoAggCountNamed(qsoAgg.bands, qsoAgg.bandCount, QSO_AGG_MAX_BANDS, qsoAgg.bandOther,
+                     sizeof(QSOAggBand::band), qso.band, delta);
+  }
+  const char* mode = strlen(qso.mode) > 0 ? qso.mode : "CW";
+  qsoAggCountNamed(qsoAgg.modes, qsoAgg.modeCount, QSO_AGG_MAX_MODES, qsoAgg.modeOther,
+                   sizeof(QSOAggMode::mode), mode, delta);
+  if (strlen(qso.country) > 0 && qsoAgg.countries != nullptr) {
+    qsoAggCountNamed(qsoAgg.countries, qsoAgg.countryCount, QSO_AGG_MAX_COUNTRIES,
+                     qsoAgg.countryOther, sizeof(QSOAggCountry::country), qso.country, delta);
+  }
+  if (strlen(qso.date) > 0) {
+    qsoAggCountDay((uint32_t)strtoul(qso.date, nullptr, 10), delta);
+  }
+  if (strlen(qso.callsign) > 0) {
+    qsoHashAdd(qsoAgg.calls, qsoCallHash64(qso.callsign), delta);
+  }
+}
+
+/*
+ * Number of countries with at least one QSO
+ */
+int qsoAggCountryCount() {
+  int n = 0;
+  for (int i = 0; i < qsoAgg.countryCount; i++) {
+    if (qsoAgg.countries[i].count > 0) n++;
+  }
+  return n;
+}
+
+/*
+ * Write the aggregate snapshot to SD (DeferredSaveFn)
+ */
+void saveQSOAggregates() {
+  AtomicFileWriter file(SD, QSO_AGG_FILE);
+  if (!file.begin()) {
+    Serial.println("Failed to write QSO statistics snapshot");
+    return;
+  }
+
+  uint32_t callCount = qsoAgg.calls.live;
+
+  QSOAggHeader header = {};
+  header.magic = QSO_AGG_MAGIC;
+  header.version = QSO_AGG_VERSION;
+  header.totalQSOs = qsoAgg.totalQSOs;
+  header.bandCount = qsoAgg.bandCount;
+  header.modeCount = qsoAgg.modeCount;
+  header.countryCount = qsoAgg.countryCount;
+  header.dayCount = qsoAgg.days.size();
+  header.callCount = callCount;
+  header.bandOther = qsoAgg.bandOther;
+  header.modeOther = qsoAgg.modeOther;
+  header.countryOther = qsoAgg.countryOther;
+
+  file.write((const uint8_t*)&header, sizeof(header));
+  file.write((const uint8_t*)qsoAgg.bands, qsoAgg.bandCount * sizeof(QSOAggBand));
+  file.write((const uint8_t*)qsoAgg.modes, qsoAgg.modeCount * sizeof(QSOAggMode));
+  if (qsoAgg.countryCount > 0) {
+    file.write((const uint8_t*)qsoAgg.countries, qsoAgg.countryCount * sizeof(QSOAggCountry));
+  }
+  if (!qsoAgg.days.empty()) {
+    file.write((const uint8_t*)qsoAgg.days.data(), qsoAgg.days.size() * sizeof(QSOAggDay));
+  }
+  for (uint32_t i = 0; i < qsoAgg.calls.size; i++) {
+    if (qsoAgg.calls.slots[i].count > 0) {
+      file.write((const uint8_t*)&qsoAgg.calls.slots[i], sizeof(QSOHashSlot));
+    }
+  }
+  if (!file.commit()) {
+    Serial.println("Failed to write QSO statistics snapshot");
+    return;
+  }
+
+  // Only a committed snapshot clears the marker
+  SD.remove(QSO_AGG_DIRTY_FILE);
+  qsoAgg.snapshotDirty = false;
+}
+
+/*
+ * Flag the SD snapshot as stale (first change after a save only)
+ */
+void markQSOAggregatesDirty() {
+  if (qsoAgg.snapshotDirty) return;
+  File file = SD.open(QSO_AGG_DIRTY_FILE, FILE_WRITE);
+  if (file) file.close();
+  qsoAgg.snapshotDirty = true;
+}
+
+/*
+ * Load the aggregate snapshot. Returns false if it is missing, dirty or
+ * does not cover expectedTotal QSOs (caller then rebuilds from the log).
+ */
+bool loadQSOAggregates(uint32_t expectedTotal) {
+  resetQSOAggregates();
+
+  if (SD.exists(QSO_AGG_DIRTY_FILE)) return false;
+  File file = atomicFileOpen(SD, QSO_AGG_FILE);
+  if (!file) return false;
+
+  QSOAggHeader header;
+  bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+            header.magic == QSO_AGG_MAGIC && header.version == QSO_AGG_VERSION &&
+            header.totalQSOs == expectedTotal &&
+            header.bandCount <= QSO_AGG_MAX_BANDS && header.modeCount <= QSO_AGG_MAX_MODES &&
+            header.countryCount <= QSO_AGG_MAX_COUNTRIES &&
+            (header.countryCount == 0 || qsoAgg.countries != nullptr) && qsoAgg.calls.slots != nullptr;
+
+  if (ok) {
+    qsoAgg.totalQSOs = header.totalQSOs;
+    qsoAgg.bandCount = header.bandCount;
+    qsoAgg.modeCount = header.modeCount;
+    qsoAgg.countryCount = header.countryCount;
+    qsoAgg.bandOther = header.bandOther;
+    qsoAgg.modeOther = header.modeOther;
+    qsoAgg.countryOther = header.countryOther;
+    file.read((uint8_t*)qsoAgg.bands, header.bandCount * sizeof(QSOAggBand));
+    file.read((uint8_t*)qsoAgg.modes, header.modeCount * sizeof(QSOAggMode));
+    if (header.countryCount > 0) {
+      file.read((uint8_t*)qsoAgg.countries, header.countryCount * sizeof(QSOAggCountry));
+    }
+    qsoAgg.days.resize(header.dayCount);
+    if (header.dayCount > 0) {
+      ok = file.read((uint8_t*)qsoAgg.days.data(), header.dayCount * sizeof(QSOAggDay)) ==
+           header.dayCount * sizeof(QSOAggDay);
+    }
+    for (uint32_t i = 0; ok && i < header.callCount; i++) {
+      QSOHashSlot call;
+      if (file.read((uint8_t*)&call, sizeof(call)) != sizeof(call)) {
+        ok = false;
+        break;
+      }
+      qsoHashAdd(qsoAgg.calls, call.hash, +1, call.count);
+    }
+  }
+  file.close();
+
+  if (!ok) {
+    resetQSOAggregates();
+    return false;
+  }
+  Serial.printf("QSO statistics loaded: %u QSOs, %u unique calls\n",
+                (unsigned)qsoAgg.totalQSOs, (unsigned)qsoAgg.calls.live);
+  return true;
+}
+
+#endif // QSO_LOGGER_AGGREGATES_H
@@ -0,0 +1,485 @@
+/*
+ * QSO Logger Contest Module
+ * Serial numbers, one-line exchange parsing, dupe/multiplier checks,
+ * rate meter and Cabrillo export for contest logging
+ *
+ * Dupes and multipliers live in PSRAM hash tables rebuilt once when the
+ * contest is opened, so checking and logging a QSO costs the same at
+ * QSO 10 as at QSO 2000.
+ */
+
+#ifndef QSO_LOGGER_CONTEST_H
+#define QSO_LOGGER_CONTEST_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "../core/config.h"
+#include "qso_logger.h"  // Same folder
+#include "qso_logger_validation.h"  // Same folder
+#include "qso_logger_hash.h"  // Same folder
+#include "qso_logger_storage.h"  // Same folder
+
+// ============================================
+// Contest Configuration
+// ============================================
+
+#define CONTEST_PREFS "qso_contest"
+#define CONTEST_CABRILLO_FILE "/qso/contest.cbr"
+#define CONTEST_HASH_SLOTS 2048         // Dupe/mult table slots (power of two)
+#define CONTEST_RATE_SLOTS 512          // QSO times kept for the rate meter
+
+enum ContestMultType {
+  CONTEST_MULT_NONE = 0,
+  CONTEST_MULT_EXCHANGE = 1,  // Received exchange text (state, section, zone...)
+  CONTEST_MULT_PREFIX = 2     // WPX-style callsign prefix
+};
+
+struct ContestConfig {
+  char name[31];              // CONTEST_ID written to each QSO
+  char sentExchange[11];      // Sent exchange text (empty = serial only)
+  uint8_t multType;           // ContestMultType
+  bool multPerBand;           // Multipliers count once per band
+  bool serialExchange;        // Received numbers are serials (else exchange text)
+  uint32_t startDate;         // YYYYMMDD, first day scanned on resume
+};
+
+// One parsed exchange line
+struct ContestExchange {
+  char callsign[11];
+  char rst[4];
+  int serial;
+  char exchange[11];
+};
+
+struct ContestCheck {
+  bool dupe;
+  bool newMult;
+  char mult[12];              // Multiplier key for the parsed exchange
+};
+
+struct ContestState {
+  bool open;
+  ContestConfig cfg;
+  int nextSerial;
+  uint32_t qsoCount;
+  QSOHashCounter dupes;       // call + band + mode
+  QSOHashCounter mults;       // mult [+ band]
+  unsigned long lastId;
+
+  // Rate meter: ring of QSO times with one tail per window
+  uint32_t rateTimes[CONTEST_RATE_SLOTS];
+  int rateHead;               // Next slot to write
+  int rateCount10;            // Entries inside the 10 minute window
+  int rateCount60;            // Entries inside the 60 minute window
+};
+
+ContestState contest = {};
+
+// ============================================
+// Settings Persistence
+// ============================================
+
+void loadContestConfig() {
+  extern Preferences qsoPrefs;
+  ContestConfig& cfg = contest.cfg;
+
+  qsoPrefs.begin(CONTEST_PREFS, true);
+  qsoPrefs.getString("name", cfg.name, sizeof(cfg.name));
+  qsoPrefs.getString("sent", cfg.sentExchange, sizeof(cfg.sentExchange));
+  cfg.multType = qsoPrefs.getUChar("mult", CONTEST_MULT_EXCHANGE);
+  cfg.multPerBand = qsoPrefs.getBool("perband", true);
+  cfg.serialExchange = qsoPrefs.getBool("serial", true);
+  cfg.startDate = qsoPrefs.getUInt("start", 0);
+  qsoPrefs.end();
+
+  if (cfg.name[0] == '\0') strlcpy(cfg.name, "CONTEST", sizeof(cfg.name));
+}
+
+void saveContestConfig() {
+  extern Preferences qsoPrefs;
+  const ContestConfig& cfg = contest.cfg;
+
+  qsoPrefs.begin(CONTEST_PREFS, false);
+  qsoPrefs.putString("name", cfg.name);
+  qsoPrefs.putString("sent", cfg.sentExchange);
+  qsoPrefs.putUChar("mult", cfg.multType);
+  qsoPrefs.putBool("perband", cfg.multPerBand);
+  qsoPrefs.putBool("serial", cfg.serialExchange);
+  qsoPrefs.putUInt("start", cfg.startDate);
+  qsoPrefs.end();
+}
+
+// ============================================
+// Keys and Parsing
+// ============================================
+
+static uint64_t contestDupeKey(const char* call, const char* band, const char* mode) {
+  uint64_t h = qsoHashStr(call);
+  h = qsoHashStr("|", h);
+  h = qsoHashStr(band, h);
+  h = qsoHashStr("|", h);
+  return qsoHashStr(mode[0] ? mode : "CW", h);
+}
+
+static uint64_t contestMultKey(const char* mult, const char* band) {
+  uint64_t h = qsoHashStr(mult);
+  if (contest.cfg.multPerBand) {
+    h = qsoHashStr("|", h);
+    h = qsoHashStr(band, h);
+  }
+  return h;
+}
+
+/*
+ * WPX prefix: letters and digits up to the last digit of the call's
+ * prefix part (W1ABC -> W1, VE3/K1ABC -> VE3, K1ABC/P -> K1, RAEM -> RA0)
+ */
+void contestCallPrefix(const char* call, char* out, size_t outLen) {
+  char part[11];
+  strlcpy(part, call, sizeof(part));
+
+  // With a slash, the shorter side is the portable prefix; a side without
+  // digits (/P, /M, /QRP) is just a suffix
+  char* slash = strchr(part, '/');
+  const char* base = part;
+  if (slash) {
+    *slash = '\0';
+    const char* other = slash + 1;
+    if (strpbrk(other, "0123456789") != nullptr && strlen(other) < strlen(part)) {
+      base = other;
+    }
+  }
+
+  // The first character always belongs to the prefix (3DA0RU -> 3DA0)
+  size_t len = strlen(base);
+  size_t end = 0;
+  bool seenDigit = false;
+  for (size_t i = 1; i < len; i++) {
+    if (isdigit((unsigned char)base[i])) {
+      seenDigit = true;
+      end = i + 1;
+    } else if (seenDigit) {
+      break;  // Letters after the digit group are the suffix
+    }
+  }
+
+  if (!seenDigit) {
+    // No digit: first two letters + 0
+    snprintf(out, outLen, "%.2s0", base);
+  } else {
+    if (end >= outLen) end = outLen - 1;
+    memcpy(out, base, end);
+    out[end] = '\0';
+  }
+  for (char* p = out; *p; p++) *p = toupper((unsigned char)*p);
+}
+
+static void contestMultFor(const char* call, const char* exchange, char* out, size_t outLen) {
+  out[0] = '\0';
+  if (contest.cfg.multType == CONTEST_MULT_EXCHANGE) {
+    strlcpy(out, exchange, outLen);
+  } else if (contest.cfg.multType == CONTEST_MULT_PREFIX && call[0]) {
+    contestCallPrefix(call, out, outLen);
+  }
+}
+
+// Number with CW cut digits (T=0, O=0, N=9, A=1); -1 if not numeric
+static int contestParseNumber(const char* tok) {
+  int value = 0;
+  bool digit = false;
+  for (const char* p = tok; *p; p++) {
+    char c = toupper((unsigned char)*p);
+    int d;
+    if (c >= '0' && c <= '9') { d = c - '0'; digit = true; }
+    else if (c == 'T' || c == 'O') d = 0;
+    else if (c == 'N') d = 9;
+    else if (c == 'A') d = 1;
+    else return -1;
+    value = value * 10 + d;
+    if (value > 99999) return -1;
+  }
+  return digit ? value : -1;
+}
+
+/*
+ * Parse a one-line exchange such as "W1ABC 599 123" or "K1XYZ 5NN MA".
+ * Tokens may come in any order; a later token of the same kind replaces
+ * an earlier one, so typing a correction after a mistake just works. The
+ * exception is the RST: only the first 599/5NN-shaped token is taken as
+ * one, so "W1ABC 599 529" logs serial 529.
+ */
+void contestParseExchange(const char* line, ContestExchange& ex) {
+  memset(&ex, 0, sizeof(ex));
+
+  char buf[64];
+  strlcpy(buf, line, sizeof(buf));
+  for (char* p = buf; *p; p++) *p = toupper((unsigned char)*p);
+
+  char* save = nullptr;
+  for (char* tok = strtok_r(buf, " ,", &save); tok; tok = strtok_r(nullptr, " ,", &save)) {
+    size_t len = strlen(tok);
+    int num = contestParseNumber(tok);
+    bool rstFree = ex.rst[0] == '\0';
+
+    if (rstFree && len == 3 && tok[0] == '5' && num >= 0 && (tok[2] == '9' || tok[2] == 'N')) {
+      snprintf(ex.rst, sizeof(ex.rst), "%d", num);        // 599 / 5NN
+    } else if (rstFree && len == 2 && tok[0] == '5' && num >= 51 && num <= 59) {
+      snprintf(ex.rst, sizeof(ex.rst), "%d", num);        // Phone 59
+    } else if (num >= 0 && !isdigit((unsigned char)tok[0]) && validateCallsign(tok)) {
+      strlcpy(ex.callsign, tok, sizeof(ex.callsign));    // e.g. "NT1A" reads as a call
+    } else if (num >= 0 && contest.cfg.serialExchange) {
+      ex.serial = num;
+    } else if (num < 0 && validateCallsign(tok)) {
+      strlcpy(ex.callsign, tok, sizeof(ex.callsign));
+    } else {
+      strlcpy(ex.exchange, tok, sizeof(ex.exchange));    // State, section, zone...
+    }
+  }
+}
+
+// ============================================
+// Rate Meter
+// ============================================
+
+static int contestRateTail(int count) {
+  return (contest.rateHead - count + CONTEST_RATE_SLOTS) % CONTEST_RATE_SLOTS;
+}
+
+/*
+ * Drop QSOs that have aged out of the windows (amortized constant time)
+ */
+void contestRateAdvance(uint32_t now) {
+  while (contest.rateCount10 > 0 && contest.rateTimes[contestRateTail(contest.rateCount10)] + 600 <= now) {
+    contest.rateCount10--;
+  }
+  while (contest.rateCount60 > 0 && contest.rateTimes[contestRateTail(contest.rateCount60)] + 3600 <= now) {
+    contest.rateCount60--;
+  }
+}
+
+static void contestRatePush(uint32_t t) {
+  contest.rateTimes[contest.rateHead] = t;
+  contest.rateHead = (contest.rateHead + 1) % CONTEST_RATE_SLOTS;
+  if (contest.rateCount10 < CONTEST_RATE_SLOTS) contest.rateCount10++;
+  if (contest.rateCount60 < CONTEST_RATE_SLOTS) contest.rateCount60++;
+}
+
+/*
+ * QSOs per hour over the last 10 and 60 minutes
+ */
+void contestGetRates(uint32_t now, int& rate10, int& rate60) {
+  contestRateAdvance(now);
+  rate10 = contest.rateCount10 * 6;
+  rate60 = contest.rateCount60;
+}
+
+// ============================================
+// Contest Session
+// ============================================
+
+static void contestApplyQSO(const QSO& qso) {
+  qsoHashAdd(contest.dupes, contestDupeKey(qso.callsign, qso.band, qso.mode), +1);
+
+  char mult[12];
+  contestMultFor(qso.callsign, qso.srx_string, mult, sizeof(mult));
+  if (mult[0]) qsoHashAdd(contest.mults, contestMultKey(mult, qso.band), +1);
+
+  if (qso.stx >= contest.nextSerial) contest.nextSerial = qso.stx + 1;
+  if (qso.id > contest.lastId) contest.lastId = qso.id;
+  contest.qsoCount++;
+}
+
+static bool contestRebuildVisitor(const QSO& qso, void* ctx) {
+  if (strcasecmp(qso.contest, contest.cfg.name) != 0) return true;
+  contestApplyQSO(qso);
+  contestRatePush(qsoDateTimeToEpoch(qso.date, qso.time_on));
+  return true;
+}
+
+// Walk this contest's QSOs (days from its start date onward)
+static void contestForEachQSO(QSOVisitor fn, void* ctx) {
+  std::vector<uint32_t> days;
+  listQSODays(days);
+  for (uint32_t day : days) {
+    if (day < contest.cfg.startDate) continue;
+    char date[9];
+    snprintf(date, sizeof(date), "%08lu", (unsigned long)day);
+    if (!forEachQSOInDay(date, fn, ctx)) break;
+  }
+}
+
+/*
+ * Open the configured contest: rebuild dupe/mult tables and the serial
+ * counter from QSOs already logged under its name
+ */
+bool openContest() {
+  loadContestConfig();
+  if (!qsoHashInit(contest.dupes, CONTEST_HASH_SLOTS) ||
+      !qsoHashInit(contest.mults, CONTEST_HASH_SLOTS)) {
+    Serial.println("[Contest] Failed to allocate tables");
+    return false;
+  }
+
+  contest.nextSerial = 1;
+  contest.qsoCount = 0;
+  contest.lastId = 0;
+  contest.rateHead = 0;
+  contest.rateCount10 = 0;
+  contest.rateCount60 = 0;
+
+  if (contest.cfg.startDate == 0) {
+    char date[9] = "";
+    formatCurrentDateTime(date, nullptr);
+    contest.cfg.startDate = strtoul(date, nullptr, 10);
+    if (contest.cfg.startDate > 0) saveContestConfig();
+  }
+  if (isQSOStorageReady()) {
+    contestForEachQSO(contestRebuildVisitor, nullptr);
+  }
+
+  contest.open = true;
+  Serial.printf("[Contest] %s: %u QSOs, %u mults, next serial %d\n",
+                contest.cfg.name, (unsigned)contest.qsoCount,
+                (unsigned)contest.mults.live, contest.nextSerial);
+  return true;
+}
+
+/*
+ * Start a new contest (new name resets serials, dupes and multipliers)
+ */
+bool startContest(const char* name) {
+  loadContestConfig();
+  strlcpy(contest.cfg.name, name, sizeof(contest.cfg.name));
+  for (char* p = contest.cfg.name; *p; p++) *p = toupper((unsigned char)*p);
+  contest.cfg.startDate = 0;  // Set to today by openContest()
+  saveContestConfig();
+  return openContest();
+}
+
+/*
+ * Change the multiplier and exchange rules of the open contest. Mults are
+ * counted differently afterwards, so the tables are rebuilt from the log.
+ */
+bool setContestRules(uint8_t multType, bool multPerBand, bool serialExchange) {
+  ContestConfig& cfg = contest.cfg;
+  if (cfg.multType == multType && cfg.multPerBand == multPerBand &&
+      cfg.serialExchange == serialExchange) {
+    return true;
+  }
+  cfg.multType = multType;
+  cfg.multPerBand = multPerBand;
+  cfg.serialExchange = serialExchange;
+  saveContestConfig();
+  return openContest();
+}
+
+/*
+ * Dupe / new multiplier status for a parsed exchange
+ */
+void contestCheck(const ContestExchange& ex, const char* band, const char* mode, ContestCheck& out) {
+  out.dupe = ex.callsign[0] &&
+             qsoHashGet(contest.dupes, contestDupeKey(ex.callsign, band, mode)) > 0;
+  contestMultFor(ex.callsign, ex.exchange, out.mult, sizeof(out.mult));
+  out.newMult = out.mult[0] &&
+                qsoHashGet(contest.mults, contestMultKey(out.mult, band)) == 0;
+}
+
+/*
+ * Log a contest QSO. Fills qso with what was saved.
+ * Returns false if the callsign is missing, the clock is not set, or
+ * the save failed.
+ */
+bool contestLogQSO(const ContestExchange& ex, float freqMHz, const char* mode, QSO& qso) {
+  if (!contest.open || ex.callsign[0] == '\0') return false;
+
+  memset(&qso, 0, sizeof(QSO));
+  formatCurrentDateTime(qso.date, qso.time_on);
+  if (strlen(qso.date) != 8) {
+    Serial.println("[Contest] Clock not set - cannot log");
+    return false;
+  }
+
+  // Unique id even at several QSOs per second
+  qso.id = qsoDateTimeToEpoch(qso.date, qso.time_on);
+  if (qso.id <= contest.lastId) qso.id = contest.lastId + 1;
+
+  strlcpy(qso.callsign, ex.callsign, sizeof(qso.callsign));
+  qso.frequency = freqMHz;
+  strlcpy(qso.band, frequencyToBand(freqMHz).c_str(), sizeof(qso.band));
+  strlcpy(qso.mode, mode, sizeof(qso.mode));
+  strlcpy(qso.rst_sent, getDefaultRST(mode).c_str(), sizeof(qso.rst_sent));
+  strlcpy(qso.rst_rcvd, ex.rst[0] ? ex.rst : qso.rst_sent, sizeof(qso.rst_rcvd));
+  strlcpy(qso.contest, contest.cfg.name, sizeof(qso.contest));
+  qso.stx = contest.nextSerial;
+  qso.srx = ex.serial;
+  strlcpy(qso.srx_string, ex.exchange, sizeof(qso.srx_string));
+  strlcpy(qso.stx_string, contest.cfg.sentExchange, sizeof(qso.stx_string));
+
+  if (!saveQSO(qso)) return false;
+
+  contestApplyQSO(qso);
+  contestRatePush(qsoDateTimeToEpoch(qso.date, qso.time_on));
+  return true;
+}
+
+// ============================================
+// Cabrillo Export
+// ============================================
+
+static const char* contestCabrilloMode(const char* mode) {
+  if (strcasecmp(mode, "CW") == 0) return "CW";
+  if (strcasecmp(mode, "SSB") == 0 || strcasecmp(mode, "AM") == 0) return "PH";
+  if (strcasecmp(mode, "FM") == 0) return "FM";
+  if (strcasecmp(mode, "RTTY") == 0) return "RY";
+  return "DG";
+}
+
+static char contestCabrilloCall[11] = "";
+
+static bool cabrilloQSOVisitor(const QSO& qso, void* ctx) {
+  if (strcasecmp(qso.contest, contest.cfg.name) != 0) return true;
+  File& out = *(File*)ctx;
+
+  char sent[16], rcvd[16];
+  if (qso.stx > 0) snprintf(sent, sizeof(sent), "%03d %s", qso.stx, qso.stx_string);
+  else strlcpy(sent, qso.stx_string, sizeof(sent));
+  if (qso.srx > 0) snprintf(rcvd, sizeof(rcvd), "%03d %s", qso.srx, qso.srx_string);
+  else strlcpy(rcvd, qso.srx_string, sizeof(rcvd));
+
+  out.printf("QSO: %5ld %s %.4s-%.2s-%.2s %s %-13s %-3s %-10s %-13s %-3s %s\n",
+             lroundf(qso.frequency * 1000.0f), contestCabrilloMode(qso.mode),
+             qso.date, qso.date + 4, qso.date + 6, qso.time_on,
+             contestCabrilloCall, qso.rst_sent, sent,
+             qso.callsign, qso.rst_rcvd, rcvd);
+  return true;
+}
+
+/*
+ * Write the open contest's log as Cabrillo 3.0 to CONTEST_CABRILLO_FILE
+ */
+bool generateCabrilloFile() {
+  extern Preferences qsoPrefs;
+  if (!isQSOStorageReady()) return false;
+  if (!contest.open) loadContestConfig();
+
+  qsoPrefs.begin("qso_operator", true);
+  qsoPrefs.getString("callsign", contestCabrilloCall, sizeof(contestCabrilloCall));
+  qsoPrefs.end();
+
+  File out = SD.open(CONTEST_CABRILLO_FILE, FILE_WRITE);
+  if (!out) {
+    Serial.println("[Contest] Failed to create Cabrillo file");
+    return false;
+  }
+
+  out.print("START-OF-LOG: 3.0\n");
+  out.printf("CONTEST: %s\n", contest.cfg.name);
+  out.printf("CALLSIGN: %s\n", contestCabrilloCall);
+  out.printf("CREATED-BY: %s v%s\n", FIRMWARE_NAME, FIRMWARE_VERSION);
+  contestForEachQSO(cabrilloQSOVisitor, &out);
+  out.print("END-OF-LOG:\n");
+  out.close();
+  return true;
+}
+
+#endif // QSO_LOGGER_CONTEST_H
@@ -0,0 +1,160 @@
+// QSO Logger Dupe Index
+// Answers "dupe / worked before on this band / new" while a callsign is
+// being typed or decoded, without touching the SD card
+
+#ifndef QSO_LOGGER_DUPES_H
+#define QSO_LOGGER_DUPES_H
+
+#include <Arduino.h>
+#include "qso_logger.h"  // Same folder
+#include "qso_logger_index.h"  // Same folder
+#include "qso_logger_hash.h"  // Same folder
+
+// ============================================
+// Dupe Index
+// ============================================
+//
+// One QSOHashCounter holds four kinds of key per QSO:
+//   call                              -> worked before
+//   call + band                       -> worked before on this band
+//   call + band + mode + date         -> dupe
+//   call + band + mode + date + time  -> already logged (imports)
+// Built once from /qso/index.bin after boot and kept current by
+// saveQSO/updateQSO/deleteQSO, so a lookup is three PSRAM probes.
+//
+// Fields are clipped to the index record widths so keys built from the
+// index and from a live QSO always agree.
+
+#define QSO_DUPE_SLOTS_INITIAL 4096     // Table slots (power of two)
+
+enum QSODupeStatus {
+  QSO_DUPE_NEW = 0,         // Never worked
+  QSO_DUPE_WORKED,          // Worked before, not on this band
+  QSO_DUPE_WORKED_BAND,     // Worked on this band, not this mode today
+  QSO_DUPE_DUPE             // Same call, band, mode and date already logged
+};
+
+static QSOHashCounter qsoDupes = {};
+static bool qsoDupesReady = false;
+
+// ============================================
+// Keys
+// ============================================
+
+static uint64_t qsoDupeHashField(uint64_t h, const char* s, size_t maxLen) {
+  for (size_t i = 0; i < maxLen && s[i]; i++) {
+    h ^= (uint8_t)toupper((unsigned char)s[i]);
+    h *= 1099511628211ULL;
+  }
+  h ^= '|';
+  h *= 1099511628211ULL;
+  return h;
+}
+
+static uint64_t qsoDupeKey(char kind, const char* call, const char* band,
+                           const char* mode, const char* date, const char* time = nullptr) {
+  uint64_t h = 14695981039346656037ULL;
+  h ^= (uint8_t)kind;
+  h *= 1099511628211ULL;
+  h = qsoDupeHashField(h, call, sizeof(QSOIndexRecord::callsign));
+  if (band) h = qsoDupeHashField(h, band, sizeof(QSOIndexRecord::band));
+  if (mode) h = qsoDupeHashField(h, mode[0] ? mode : "CW", sizeof(QSOIndexRecord::mode));
+  if (date) h = qsoDupeHashField(h, date, 8);
+  if (time) {
+    // HHMM as the index stores it (a number), so "" and "0000" agree
+    char hhmm[5];
+    snprintf(hhmm, sizeof(hhmm), "%04u", (unsigned)(atoi(time) % 10000));
+    h = qsoDupeHashField(h, hhmm, 4);
+  }
+  return h;
+}
+
+static void qsoDupeAddKeys(const char* call, const char* band, const char* mode,
+                           const char* date, const char* time, int delta) {
+  if (call[0] == '\0') return;
+  qsoHashAdd(qsoDupes, qsoDupeKey('C', call, nullptr, nullptr, nullptr), delta);
+  qsoHashAdd(qsoDupes, qsoDupeKey('B', call, band, nullptr, nullptr), delta);
+  qsoHashAdd(qsoDupes, qsoDupeKey('D', call, band, mode, date), delta);
+  qsoHashAdd(qsoDupes, qsoDupeKey('T', call, band, mode, date, time), delta);
+}
+
+// ============================================
+// Public API
+// ============================================
+
+/*
+ * Build the dupe index from the QSO index (call after ensureQSOIndex())
+ */
+void rebuildQSODupeIndex() {
+  if (!qsoHashInit(qsoDupes, QSO_DUPE_SLOTS_INITIAL)) {
+    Serial.println("Dupe index: allocation failed");
+    qsoDupesReady = false;
+    return;
+  }
+
+  QSOIndexRecord recs[QSO_INDEX_CHUNK];
+  QSOIndexCursor cursor = QSO_CURSOR_FIRST;
+  uint32_t total = 0;
+  int n;
+  do {
+    n = qsoIndexQueryLoop(nullptr, &cursor, false, recs, QSO_INDEX_CHUNK);
+    for (int i = 0; i < n; i++) {
+      char call[12], band[6], mode[7], date[9], time[6];
+      qsoIndexField(recs[i].callsign, sizeof(recs[i].callsign), call, sizeof(call));
+      qsoIndexField(recs[i].band, sizeof(recs[i].band), band, sizeof(band));
+      qsoIndexField(recs[i].mode, sizeof(recs[i].mode), mode, sizeof(mode));
+      qsoIndexDateString(recs[i], date);
+      snprintf(time, sizeof(time), "%u", (unsigned)recs[i].time);
+      qsoDupeAddKeys(call, band, mode, date, time, +1);
+    }
+    total += n;
+  } while (n == QSO_INDEX_CHUNK);
+
+  qsoDupesReady = true;
+  Serial.printf("Dupe index: %u QSOs, %u keys\n", (unsigned)total, (unsigned)qsoDupes.live);
+}
+
+/*
+ * Apply one QSO to the dupe index (delta = +1 on save, -1 on delete)
+ */
+void qsoDupeApply(const QSO& qso, int delta) {
+  if (!qsoDupesReady) return;
+  qsoDupeAddKeys(qso.callsign, qso.band, qso.mode, qso.date, qso.time_on, delta);
+}
+
+/*
+ * Look up a callsign against the log. band/mode/date describe the QSO
+ * about to be logged; an empty mode counts as CW (as when saving).
+ */
+QSODupeStatus checkQSODupe(const char* call, const char* band, const char* mode, const char* date) {
+  if (!qsoDupesReady || call == nullptr || call[0] == '\0') return QSO_DUPE_NEW;
+  if (qsoHashGet(qsoDupes, qsoDupeKey('D', call, band, mode, date)) > 0) return QSO_DUPE_DUPE;
+  if (qsoHashGet(qsoDupes, qsoDupeKey('B', call, band, nullptr, nullptr)) > 0) return QSO_DUPE_WORKED_BAND;
+  if (qsoHashGet(qsoDupes, qsoDupeKey('C', call, nullptr, nullptr, nullptr)) > 0) return QSO_DUPE_WORKED;
+  return QSO_DUPE_NEW;
+}
+
+/*
+ * True if a QSO with this call, band, mode, date and start time (HHMM) is
+ * already in the log. Stricter than QSO_DUPE_DUPE, which is per day: used
+ * by imports, where repeat contacts on the same day are real QSOs.
+ */
+bool qsoDupeLogged(const char* call, const char* band, const char* mode, const char* date,
+                   const char* time) {
+  if (!qsoDupesReady || call == nullptr || call[0] == '\0') return false;
+  return qsoHashGet(qsoDupes, qsoDupeKey('T', call, band, mode, date, time)) > 0;
+}
+
+/*
+ * Short label for a dupe status ("" for a new call)
+ */
+const char* qsoDupeStatusText(QSODupeStatus status) {
+  switch (status) {
+    case QSO_DUPE_DUPE:        return "DUPE";
+    case QSO_DUPE_WORKED_BAND: return "Worked (band)";
+    case QSO_DUPE_WORKED:      return "Worked";
+    default:                   return "";
+  }
+}
+
+#endif // QSO_LOGGER_DUPES_H
@@ -0,0 +1,123 @@
+// QSO Logger Hash Counter
+// PSRAM open-addressing table of 64-bit key hashes with per-key counts,
+// shared by the statistics aggregates and the dupe index
+
+#ifndef QSO_LOGGER_HASH_H
+#define QSO_LOGGER_HASH_H
+
+#include <Arduino.h>
+
+// Counts (rather than plain membership) let a delete tell when the last
+// QSO behind a key goes away. Emptied slots keep their hash so probe chains
+// stay intact; they are dropped when the table grows.
+
+struct __attribute__((packed)) QSOHashSlot {
+  uint64_t hash;     // 0 = empty slot
+  uint32_t count;    // 0 = key no longer in the log
+};
+
+struct QSOHashCounter {
+  QSOHashSlot* slots;
+  uint32_t size;     // Power of two
+  uint32_t used;     // Slots holding a hash (including count 0)
+  uint32_t live;     // Slots with count > 0
+};
+
+/*
+ * FNV-1a over a string, case-insensitive, continuing from h
+ */
+uint64_t qsoHashStr(const char* s, uint64_t h = 14695981039346656037ULL) {
+  for (; *s; s++) {
+    h ^= (uint8_t)toupper((unsigned char)*s);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+static QSOHashSlot* qsoHashAllocSlots(uint32_t size) {
+  size_t bytes = size * sizeof(QSOHashSlot);
+  void* p = psramFound() ? ps_calloc(1, bytes) : nullptr;
+  return (QSOHashSlot*)(p ? p : calloc(1, bytes));
+}
+
+/*
+ * Allocate (or clear) a table. size must be a power of two.
+ */
+bool qsoHashInit(QSOHashCounter& c, uint32_t size) {
+  if (c.slots != nullptr) {
+    memset(c.slots, 0, c.size * sizeof(QSOHashSlot));
+  } else {
+    c.slots = qsoHashAllocSlots(size);
+    if (c.slots == nullptr) return false;
+    c.size = size;
+  }
+  c.used = 0;
+  c.live = 0;
+  return true;
+}
+
+static QSOHashSlot* qsoHashFind(QSOHashCounter& c, uint64_t hash, bool insert) {
+  if (hash == 0) hash = 1;  // 0 marks empty slots
+  uint32_t mask = c.size - 1;
+  for (uint32_t i = (uint32_t)hash & mask, n = 0; n < c.size; i = (i + 1) & mask, n++) {
+    QSOHashSlot& slot = c.slots[i];
+    if (slot.hash == hash) return &slot;
+    if (slot.hash == 0) {
+      if (!insert) return nullptr;
+      slot.hash = hash;
+      slot.count = 0;
+      c.used++;
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ * Double the table once it is 70% full (live keys and emptied slots)
+ */
+static void qsoHashGrow(QSOHashCounter& c) {
+  if (c.used * 10 < c.size * 7) return;
+
+  QSOHashCounter bigger = {};
+  bigger.slots = qsoHashAllocSlots(c.size * 2);
+  if (bigger.slots == nullptr) return;  // Keep working at a higher load factor
+  bigger.size = c.size * 2;
+
+  for (uint32_t i = 0; i < c.size; i++) {
+    if (c.slots[i].hash != 0 && c.slots[i].count > 0) {
+      QSOHashSlot* slot = qsoHashFind(bigger, c.slots[i].hash, true);
+      slot->count = c.slots[i].count;
+      bigger.live++;
+    }
+  }
+  free(c.slots);
+  c = bigger;
+}
+
+/*
+ * Current count for a key (0 if absent)
+ */
+uint32_t qsoHashGet(QSOHashCounter& c, uint64_t hash) {
+  if (c.slots == nullptr) return 0;
+  QSOHashSlot* slot = qsoHashFind(c, hash, false);
+  return slot ? slot->count : 0;
+}
+
+/*
+ * Add `times` to a key (delta > 0) or remove one occurrence (delta < 0)
+ */
+void qsoHashAdd(QSOHashCounter& c, uint64_t hash, int delta, uint32_t times = 1) {
+  if (c.slots == nullptr) return;
+  QSOHashSlot* slot = qsoHashFind(c, hash, delta > 0);
+  if (slot == nullptr || (delta < 0 && slot->count == 0)) return;
+  if (delta > 0) {
+    if (slot->count == 0) c.live++;
+    slot->count += times;
+    qsoHashGrow(c);
+  } else if (--slot->count == 0) {
+    c.live--;
+  }
+}
+
+#endif // QSO_LOGGER_HASH_H
@@ -0,0 +1,438 @@
+/*
+ * QSO Logger Import Module
+ * Streaming ADIF parser for importing logs from other loggers
+ *
+ * Data is fed in arbitrary chunks (e.g. straight from a web upload) to a
+ * tag/length state machine, so memory use is constant whatever the file
+ * size. The web task only parses: completed records go into a bounded
+ * queue, and updateADIFImport() in the main loop checks them against the
+ * dupe index and writes them through the storage layer in batches, so the
+ * journals, statistics and dupe table are only ever touched from loop().
+ */
+
+#ifndef QSO_LOGGER_IMPORT_H
+#define QSO_LOGGER_IMPORT_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "qso_logger.h"  // Same folder
+#include "qso_logger_validation.h"  // Same folder
+#include "qso_logger_storage.h"  // Same folder
+
+// ============================================
+// Import Configuration
+// ============================================
+
+#define QSO_IMPORT_BATCH 16             // QSOs per storage write
+#define QSO_IMPORT_QUEUE 64             // Parsed QSOs waiting for the main loop
+#define QSO_IMPORT_NAME_MAX 24          // Longest field name kept
+#define QSO_IMPORT_VALUE_MAX 96         // Longest field value kept (rest skipped)
+
+enum ADIFParseState {
+  ADIF_SEEK_TAG,        // Outside a tag (header text or between fields)
+  ADIF_TAG_NAME,        // After '<'
+  ADIF_TAG_LENGTH,      // After "<NAME:"
+  ADIF_TAG_TYPE,        // After "<NAME:LEN:"
+  ADIF_VALUE            // Reading LEN value bytes
+};
+
+struct QSOImportProgress {
+  bool active;                // Running, or still being stored by the main loop
+  uint32_t bytesReceived;
+  uint32_t bytesTotal;        // From Content-Length (0 if unknown)
+  uint32_t records;           // <EOR> seen
+  uint32_t imported;
+  uint32_t dupes;             // Already in the log (or earlier in the file)
+  uint32_t skipped;           // Missing CALL or QSO_DATE, or write failed
+};
+
+struct QSOImportState {
+  ADIFParseState state;
+  char name[QSO_IMPORT_NAME_MAX + 1];
+  uint8_t nameLen;
+  uint32_t valueLen;          // Declared length
+  uint32_t valueRead;
+  char value[QSO_IMPORT_VALUE_MAX + 1];
+  QSO current;
+  char mySig[8];              // MY_SIG / SIG decide whether *_SIG_INFO is POTA
+  char theirSig[8];
+  char mySigInfo[11];
+  char theirSigInfo[11];
+
+  // Web task -> main loop, guarded by qsoImportMutex
+  QSO queue[QSO_IMPORT_QUEUE];
+  int queueHead;              // Next to store
+  int queueCount;
+
+  // Main loop only
+  char idDay[9];              // Day whose journal ids are in qsoImportDayIds
+  QSO batch[QSO_IMPORT_BATCH];
+  int batchCount;
+};
+
+QSOImportProgress qsoImportProgress = {};
+static QSOImportState* qsoImport = nullptr;  // Allocated for the running import
+static SemaphoreHandle_t qsoImportMutex = nullptr;
+static volatile bool qsoImportInputDone = false;  // Set by the web task: no more records
+static std::vector<unsigned long> qsoImportDayIds;
+
+// ============================================
+// Record Mapping
+// ============================================
+
+static void qsoImportSetField(const char* name, const char* value) {
+  QSO& q = qsoImport->current;
+
+  if (strcasecmp(name, "CALL") == 0) {
+    strlcpy(q.callsign, value, sizeof(q.callsign));
+    for (char* p = q.callsign; *p; p++) *p = toupper((unsigned char)*p);
+  } else if (strcasecmp(name, "FREQ") == 0) {
+    q.frequency = atof(value);
+  } else if (strcasecmp(name, "MODE") == 0) {
+    strlcpy(q.mode, value, sizeof(q.mode));
+  } else if (strcasecmp(name, "BAND") == 0) {
+    strlcpy(q.band, value, sizeof(q.band));
+    for (char* p = q.band; *p; p++) *p = tolower((unsigned char)*p);
+  } else if (strcasecmp(name, "QSO_DATE") == 0) {
+    strlcpy(q.date, value, sizeof(q.date));
+  } else if (strcasecmp(name, "TIME_ON") == 0) {
+    strlcpy(q.time_on, value, sizeof(q.time_on));  // HHMM[SS] -> HHMM
+  } else if (strcasecmp(name, "TIME_OFF") == 0) {
+    strlcpy(q.time_off, value, sizeof(q.time_off));
+  } else if (strcasecmp(name, "RST_SENT") == 0) {
+    strlcpy(q.rst_sent, value, sizeof(q.rst_sent));
+  } else if (strcasecmp(name, "RST_RCVD") == 0) {
+    strlcpy(q.rst_rcvd, value, sizeof(q.rst_rcvd));
+  } else if (strcasecmp(name, "NAME") == 0) {
+    strlcpy(q.name, value, sizeof(q.name));
+  } else if (strcasecmp(name, "QTH") == 0) {
+    strlcpy(q.qth, value, sizeof(q.qth));
+  } else if (strcasecmp(name, "TX_PWR") == 0) {
+    q.power = atoi(value);
+  } else if (strcasecmp(name, "GRIDSQUARE") == 0) {
+    strlcpy(q.gridsquare, value, sizeof(q.gridsquare));
+  } else if (strcasecmp(name, "COUNTRY") == 0) {
+    strlcpy(q.country, value, sizeof(q.country));
+  } else if (strcasecmp(name, "STATE") == 0) {
+    strlcpy(q.state, value, sizeof(q.state));
+  } else if (strcasecmp(name, "IOTA") == 0) {
+    strlcpy(q.iota, value, sizeof(q.iota));
+  } else if (strcasecmp(name, "COMMENT") == 0 || (strcasecmp(name, "NOTES") == 0 && q.notes[0] == '\0')) {
+    strlcpy(q.notes, value, sizeof(q.notes));
+  } else if (strcasecmp(name, "CONTEST_ID") == 0) {
+    strlcpy(q.contest, value, sizeof(q.contest));
+  } else if (strcasecmp(name, "SRX") == 0) {
+    q.srx = atoi(value);
+  } else if (strcasecmp(name, "STX") == 0) {
+    q.stx = atoi(value);
+  } else if (strcasecmp(name, "SRX_STRING") == 0) {
+    strlcpy(q.srx_string, value, sizeof(q.srx_string));
+  } else if (strcasecmp(name, "STX_STRING") == 0) {
+    strlcpy(q.stx_string, value, sizeof(q.stx_string));
+  } else if (strcasecmp(name, "OPERATOR") == 0) {
+    strlcpy(q.operator_call, value, sizeof(q.operator_call));
+  } else if (strcasecmp(name, "STATION_CALLSIGN") == 0) {
+    strlcpy(q.station_call, value, sizeof(q.station_call));
+  } else if (strcasecmp(name, "MY_GRIDSQUARE") == 0) {
+    strlcpy(q.my_gridsquare, value, sizeof(q.my_gridsquare));
+  } else if (strcasecmp(name, "MY_POTA_REF") == 0) {
+    strlcpy(q.my_pota_ref, value, sizeof(q.my_pota_ref));
+  } else if (strcasecmp(name, "POTA_REF") == 0) {
+    strlcpy(q.their_pota_ref, value, sizeof(q.their_pota_ref));
+  } else if (strcasecmp(name, "MY_SIG") == 0) {
+    strlcpy(qsoImport->mySig, value, sizeof(qsoImport->mySig));
+  } else if (strcasecmp(name, "SIG") == 0) {
+    strlcpy(qsoImport->theirSig, value, sizeof(qsoImport->theirSig));
+  } else if (strcasecmp(name, "MY_SIG_INFO") == 0) {
+    strlcpy(qsoImport->mySigInfo, value, sizeof(qsoImport->mySigInfo));
+  } else if (strcasecmp(name, "SIG_INFO") == 0) {
+    strlcpy(qsoImport->theirSigInfo, value, sizeof(qsoImport->theirSigInfo));
+  }
+}
+
+static void qsoImportResetRecord() {
+  memset(&qsoImport->current, 0, sizeof(QSO));
+  qsoImport->mySig[0] = qsoImport->theirSig[0] = '\0';
+  qsoImport->mySigInfo[0] = qsoImport->theirSigInfo[0] = '\0';
+}
+
+// ============================================
+// Queue (web task -> main loop)
+// ============================================
+
+static void qsoImportCountSkipped() {
+  xSemaphoreTake(qsoImportMutex, portMAX_DELAY);
+  qsoImportProgress.skipped++;
+  xSemaphoreGive(qsoImportMutex);
+}
+
+/*
+ * Hand a parsed record to the main loop. A full queue waits for loop()
+ * to store some, which simply slows the upload down.
+ */
+static void qsoImportQueue(const QSO& q) {
+  while (true) {
+    xSemaphoreTake(qsoImportMutex, portMAX_DELAY);
+    if (qsoImport->queueCount < QSO_IMPORT_QUEUE) {
+      int slot = (qsoImport->queueHead + qsoImport->queueCount) % QSO_IMPORT_QUEUE;
+      qsoImport->queue[slot] = q;
+      qsoImport->queueCount++;
+      xSemaphoreGive(qsoImportMutex);
+      return;
+    }
+    xSemaphoreGive(qsoImportMutex);
+    delay(2);
+  }
+}
+
+static bool qsoImportDequeue(QSO& q) {
+  xSemaphoreTake(qsoImportMutex, portMAX_DELAY);
+  bool have = qsoImport->queueCount > 0;
+  if (have) {
+    q = qsoImport->queue[qsoImport->queueHead];
+    qsoImport->queueHead = (qsoImport->queueHead + 1) % QSO_IMPORT_QUEUE;
+    qsoImport->queueCount--;
+  }
+  xSemaphoreGive(qsoImportMutex);
+  return have;
+}
+
+// ============================================
+// Storing (main loop)
+// ============================================
+
+static void qsoImportFlushBatch() {
+  if (qsoImport->batchCount == 0) return;
+  int saved = saveQSOBatch(qsoImport->batch, qsoImport->batchCount);
+  qsoImportProgress.imported += saved;
+  for (int i = saved; i < qsoImport->batchCount; i++) qsoImportCountSkipped();
+  qsoImport->batchCount = 0;
+}
+
+// Same call/band/mode/date/time as a QSO still waiting in the batch
+static bool qsoImportBatchHasDupe(const QSO& q) {
+  for (int i = 0; i < qsoImport->batchCount; i++) {
+    const QSO& b = qsoImport->batch[i];
+    if (strcasecmp(b.callsign, q.callsign) == 0 && strcasecmp(b.band, q.band) == 0 &&
+        strcasecmp(b.mode, q.mode) == 0 && strcmp(b.date, q.date) == 0 &&
+        strncmp(b.time_on, q.time_on, 4) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * Dupe-check a queued record, give it an id and add it to the batch.
+ * The id starts at the record's UTC minute and is bumped past every id the
+ * day's journal already holds (contest QSOs use the same epoch-minute ids,
+ * and a repeated id would replay as an update).
+ */
+static void qsoImportStore(QSO& q) {
+  if (qsoDupeLogged(q.callsign, q.band, q.mode, q.date, q.time_on) || qsoImportBatchHasDupe(q)) {
+    qsoImportProgress.dupes++;
+    return;
+  }
+  if (strcmp(q.date, qsoImport->idDay) != 0) {
+    qsoImportFlushBatch();  // Its ids must be in the journal before the day is re-read
+    loadJournalIds(q.date, qsoImportDayIds);
+    strlcpy(qsoImport->idDay, q.date, sizeof(qsoImport->idDay));
+  }
+  q.id = journalTakeId(qsoImportDayIds, qsoDateTimeToEpoch(q.date, q.time_on));
+  qsoImport->batch[qsoImport->batchCount++] = q;
+  if (qsoImport->batchCount >= QSO_IMPORT_BATCH) qsoImportFlushBatch();
+}
+
+// ============================================
+// Parsing (web task)
+// ============================================
+
+static void qsoImportEndRecord() {
+  QSO& q = qsoImport->current;
+  qsoImportProgress.records++;
+
+  if (strcasecmp(qsoImport->mySig, "POTA") == 0 && q.my_pota_ref[0] == '\0') {
+    strlcpy(q.my_pota_ref, qsoImport->mySigInfo, sizeof(q.my_pota_ref));
+  }
+  if (strcasecmp(qsoImport->theirSig, "POTA") == 0 && q.their_pota_ref[0] == '\0') {
+    strlcpy(q.their_pota_ref, qsoImport->theirSigInfo, sizeof(q.their_pota_ref));
+  }
+  if (q.band[0] == '\0' && q.frequency > 0) {
+    strlcpy(q.band, frequencyToBand(q.frequency).c_str(), sizeof(q.band));
+  }
+  if (q.mode[0] == '\0') strlcpy(q.mode, "CW", sizeof(q.mode));
+
+  if (q.callsign[0] == '\0' || strlen(q.date) != 8) {
+    qsoImportCountSkipped();
+  } else {
+    qsoImportQueue(q);
+  }
+  qsoImportResetRecord();
+}
+
+static void qsoImportEndTag() {
+  if (strcasecmp(qsoImport->name, "EOR") == 0) {
+    qsoImportEndRecord();
+  } else if (strcasecmp(qsoImport->name, "EOH") == 0) {
+    qsoImportResetRecord();  // Anything before <EOH> was header
+  }
+}
+
+// ============================================
+// Public API
+// ============================================
+
+/*
+ * Start an import. totalBytes (optional) is used for progress only.
+ */
+bool beginADIFImport(uint32_t totalBytes) {
+  if (qsoImportProgress.active) return false;
+  if (!beginQSOImport()) return false;
+
+  if (qsoImportMutex == nullptr) {
+    qsoImportMutex = xSemaphoreCreateMutex();
+    if (qsoImportMutex == nullptr) return false;
+  }
+
+  if (qsoImport == nullptr) {
+    void* p = psramFound() ? ps_malloc(sizeof(QSOImportState)) : nullptr;
+    qsoImport = (QSOImportState*)(p ? p : malloc(sizeof(QSOImportState)));
+    if (qsoImport == nullptr) return false;
+  }
+  memset(qsoImport, 0, sizeof(QSOImportState));
+  qsoImport->state = ADIF_SEEK_TAG;
+  qsoImportInputDone = false;
+
+  memset(&qsoImportProgress, 0, sizeof(qsoImportProgress));
+  qsoImportProgress.active = true;
+  qsoImportProgress.bytesTotal = totalBytes;
+  Serial.println("ADIF import started");
+  return true;
+}
+
+/*
+ * Feed the next chunk of ADIF text
+ */
+void feedADIFImport(const uint8_t* data, size_t len) {
+  if (!qsoImportProgress.active) return;
+  QSOImportState& st = *qsoImport;
+  qsoImportProgress.bytesReceived += len;
+
+  for (size_t i = 0; i < len; i++) {
+    char c = (char)data[i];
+    switch (st.state) {
+      case ADIF_SEEK_TAG:
+        if (c == '<') {
+          st.state = ADIF_TAG_NAME;
+          st.nameLen = 0;
+          st.valueLen = 0;
+        }
+        break;
+
+      case ADIF_TAG_NAME:
+        if (c == ':') {
+          st.name[st.nameLen] = '\0';
+          st.state = ADIF_TAG_LENGTH;
+        } else if (c == '>') {
+          st.name[st.nameLen] = '\0';
+          qsoImportEndTag();
+          st.state = ADIF_SEEK_TAG;
+        } else if (c == '<') {
+          st.nameLen = 0;  // Stray '<' in header text: restart
+        } else if (st.nameLen < QSO_IMPORT_NAME_MAX) {
+          st.name[st.nameLen++] = c;
+        }
+        break;
+
+      case ADIF_TAG_LENGTH:
+        if (c >= '0' && c <= '9') {
+          st.valueLen = st.valueLen * 10 + (c - '0');
+        } else if (c == ':') {
+          st.state = ADIF_TAG_TYPE;
+        } else if (c == '>') {
+          st.valueRead = 0;
+          st.state = st.valueLen > 0 ? ADIF_VALUE : ADIF_SEEK_TAG;
+        } else {
+          st.state = ADIF_SEEK_TAG;  // Malformed tag
+        }
+        break;
+
+      case ADIF_TAG_TYPE:
+        if (c == '>') {
+          st.valueRead = 0;
+          st.state = st.valueLen > 0 ? ADIF_VALUE : ADIF_SEEK_TAG;
+        }
+        break;
+
+      case ADIF_VALUE: {
+        // Copy as much of the value as this chunk holds in one go
+        size_t n = min((size_t)(st.valueLen - st.valueRead), len - i);
+        if (st.valueRead < QSO_IMPORT_VALUE_MAX) {
+          size_t keep = min(n, (size_t)(QSO_IMPORT_VALUE_MAX - st.valueRead));
+          memcpy(st.value + st.valueRead, data + i, keep);
+        }
+        st.valueRead += n;
+        i += n - 1;
+        if (st.valueRead >= st.valueLen) {
+          st.value[min(st.valueLen, (uint32_t)QSO_IMPORT_VALUE_MAX)] = '\0';
+          qsoImportSetField(st.name, st.value);
+          st.state = ADIF_SEEK_TAG;
+        }
+        break;
+      }
+    }
+  }
+}
+
+/*
+ * No more data: updateADIFImport() stores what is still queued, then
+ * rebuilds the index and ADIF files
+ */
+void endADIFImport() {
+  if (!qsoImportProgress.active || qsoImportInputDone) return;
+  qsoImportInputDone = true;
+}
+
+/*
+ * Upload cut short (client went away): keep the records already parsed
+ * and finish like a normal import, so the index is rebuilt
+ */
+void abortADIFImport() {
+  if (!qsoImportProgress.active || qsoImportInputDone) return;
+  Serial.println("ADIF import aborted by client");
+  endADIFImport();
+}
+
+/*
+ * Store queued records and, once the upload has ended, rebuild derived
+ * files. Call from loop().
+ */
+void updateADIFImport() {
+  if (!qsoImportProgress.active || qsoImport == nullptr) return;
+
+  // Read the flag first: once it is set, everything has been queued
+  bool inputDone = qsoImportInputDone;
+  QSO q;
+  for (int n = 0; n < QSO_IMPORT_BATCH * 2 && qsoImportDequeue(q); n++) {
+    qsoImportStore(q);
+  }
+  if (!inputDone) return;
+  if (qsoImportDequeue(q)) {
+    qsoImportStore(q);
+    return;  // More next pass
+  }
+
+  qsoImportFlushBatch();
+  endQSOImport();
+  qsoImportDayIds.clear();
+  qsoImportDayIds.shrink_to_fit();
+  qsoImportInputDone = false;
+  qsoImportProgress.active = false;
+
+  Serial.printf("ADIF import done: %u records, %u imported, %u dupes, %u skipped\n",
+                (unsigned)qsoImportProgress.records, (unsigned)qsoImportProgress.imported,
+                (unsigned)qsoImportProgress.dupes, (unsigned)qsoImportProgress.skipped);
+}
+
+#endif // QSO_LOGGER_IMPORT_H
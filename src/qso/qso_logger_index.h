@@ -0,0 +1,500 @@
+// QSO Logger Index Module
+// Fixed-record index of every live QSO, sorted by date/time
+// Lets the log viewer and web API page through the log without loading it
+
+#ifndef QSO_LOGGER_INDEX_H
+#define QSO_LOGGER_INDEX_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include <vector>
+#include <algorithm>
+#include "qso_logger.h"  // Same folder
+
+bool ensureQSOIndex();  // qso_logger_storage.h
+
+// ============================================
+// Index File Format
+// ============================================
+//
+// /qso/index.bin = QSOIndexHeader followed by `count` QSOIndexRecords in
+// (date, time, id) order. Each record points at the QSO's latest line in
+// its day journal, so a page of rows costs one seek per row.
+//
+// The index is derived data: `dirty` is set before any in-place change and
+// cleared afterwards. A dirty, missing or mismatched index is rebuilt from
+// the journals by ensureQSOIndex() (at boot, or before the next query).
+
+#define QSO_INDEX_FILE "/qso/index.bin"
+#define QSO_INDEX_MAGIC 0x58444951      // "QIDX"
+#define QSO_INDEX_VERSION 1
+#define QSO_INDEX_CHUNK 16              // Records per SD read while scanning
+
+struct __attribute__((packed)) QSOIndexHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint8_t dirty;
+  uint8_t reserved;
+  uint32_t count;
+};
+
+struct __attribute__((packed)) QSOIndexRecord {
+  uint32_t id;
+  uint32_t date;          // YYYYMMDD
+  uint16_t time;          // HHMM
+  uint32_t callHash;      // qsoCallHash(callsign)
+  uint32_t offset;        // Byte offset of the record's line in its journal
+  char band[5];
+  char mode[6];
+  char callsign[11];
+};
+
+// A place in the (date, time, id) order, not a position: a page continues
+// strictly after (forward) or before (backward) the last row it returned,
+// so QSOs added or deleted between pages neither skip nor repeat rows.
+// Ids are never 0, so {0, 0, 0} is before every record.
+struct QSOIndexCursor {
+  uint32_t date;          // YYYYMMDD
+  uint16_t time;          // HHMM
+  uint32_t id;
+};
+
+#define QSO_CURSOR_FIRST {0, 0, 0}
+#define QSO_CURSOR_LAST {0xFFFFFFFFu, 0xFFFF, 0xFFFFFFFFu}
+
+// Query filter - empty strings / zero dates match everything
+struct QSOQueryFilter {
+  uint32_t fromDate;      // YYYYMMDD inclusive, 0 = open
+  uint32_t toDate;        // YYYYMMDD inclusive, 0 = open
+  char band[6];
+  char mode[8];
+  char callPrefix[11];
+};
+
+// ============================================
+// Helpers
+// ============================================
+
+/*
+ * FNV-1a hash of a callsign, case-insensitive
+ */
+uint32_t qsoCallHash(const char* call) {
+  uint32_t h = 2166136261u;
+  for (; *call; call++) {
+    h ^= (uint8_t)toupper((unsigned char)*call);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+void qsoIndexMakeRecord(const QSO& qso, uint32_t offset, QSOIndexRecord& rec) {
+  memset(&rec, 0, sizeof(rec));
+  rec.id = (uint32_t)qso.id;
+  rec.date = (uint32_t)strtoul(qso.date, nullptr, 10);
+  rec.time = (uint16_t)atoi(qso.time_on);
+  rec.callHash = qsoCallHash(qso.callsign);
+  rec.offset = offset;
+  strncpy(rec.band, qso.band, sizeof(rec.band));
+  strncpy(rec.mode, qso.mode, sizeof(rec.mode));
+  strncpy(rec.callsign, qso.callsign, sizeof(rec.callsign));
+}
+
+/*
+ * Copy a fixed-width (possibly unterminated) index field into a C string
+ */
+void qsoIndexField(const char* field, size_t fieldLen, char* out, size_t outLen) {
+  size_t n = strnlen(field, fieldLen);
+  if (n >= outLen) n = outLen - 1;
+  memcpy(out, field, n);
+  out[n] = '\0';
+}
+
+void qsoIndexDateString(const QSOIndexRecord& rec, char* date) {
+  snprintf(date, 9, "%08lu", (unsigned long)rec.date);
+}
+
+// Strict ordering used for the sorted file
+bool qsoIndexLess(const QSOIndexRecord& a, const QSOIndexRecord& b) {
+  if (a.date != b.date) return a.date < b.date;
+  if (a.time != b.time) return a.time < b.time;
+  return a.id < b.id;
+}
+
+static bool qsoIndexBeforeCursor(const QSOIndexRecord& rec, const QSOIndexCursor& c) {
+  if (rec.date != c.date) return rec.date < c.date;
+  if (rec.time != c.time) return rec.time < c.time;
+  return rec.id < c.id;
+}
+
+bool qsoIndexCursorDone(const QSOIndexCursor& c, bool backward) {
+  if (backward) return c.date == 0 && c.time == 0 && c.id == 0;
+  return c.date == 0xFFFFFFFFu && c.time == 0xFFFF && c.id == 0xFFFFFFFFu;
+}
+
+void qsoIndexCursorFrom(const QSOIndexRecord& rec, QSOIndexCursor& c) {
+  c.date = rec.date;
+  c.time = rec.time;
+  c.id = rec.id;
+}
+
+/*
+ * Cursor text for the web API ("date.time.id"); parse returns false on junk
+ */
+void qsoIndexCursorFormat(const QSOIndexCursor& c, char* out, size_t size) {
+  snprintf(out, size, "%lu.%u.%lu", (unsigned long)c.date, (unsigned)c.time, (unsigned long)c.id);
+}
+
+bool qsoIndexCursorParse(const char* text, QSOIndexCursor& c) {
+  unsigned long date, id;
+  unsigned time;
+  if (sscanf(text, "%lu.%u.%lu", &date, &time, &id) != 3 || time > 0xFFFF) return false;
+  c.date = date;
+  c.time = time;
+  c.id = id;
+  return true;
+}
+
+bool qsoIndexMatches(const QSOIndexRecord& rec, const QSOQueryFilter* f) {
+  if (f == nullptr) return true;
+  if (f->fromDate && rec.date < f->fromDate) return false;
+  if (f->toDate && rec.date > f->toDate) return false;
+  if (f->band[0] && strncasecmp(rec.band, f->band, sizeof(rec.band)) != 0) return false;
+  if (f->mode[0] && strncasecmp(rec.mode, f->mode, sizeof(rec.mode)) != 0) return false;
+  if (f->callPrefix[0]) {
+    size_t n = strlen(f->callPrefix);
+    if (n > sizeof(rec.callsign) || strncasecmp(rec.callsign, f->callPrefix, n) != 0) return false;
+  }
+  return true;
+}
+
+// ============================================
+// Index File Access
+// ============================================
+
+static uint32_t qsoIndexPos(uint32_t i) {
+  return sizeof(QSOIndexHeader) + i * sizeof(QSOIndexRecord);
+}
+
+static bool qsoIndexReadHeader(File& file, QSOIndexHeader& header) {
+  file.seek(0);
+  if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+  return header.magic == QSO_INDEX_MAGIC && header.version == QSO_INDEX_VERSION;
+}
+
+static void qsoIndexWriteHeader(File& file, uint32_t count, bool dirty) {
+  QSOIndexHeader header = {QSO_INDEX_MAGIC, QSO_INDEX_VERSION, (uint8_t)(dirty ? 1 : 0), 0, count};
+  file.seek(0);
+  file.write((const uint8_t*)&header, sizeof(header));
+  file.flush();
+}
+
+static bool qsoIndexReadAt(File& file, uint32_t i, QSOIndexRecord& rec) {
+  file.seek(qsoIndexPos(i));
+  return file.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec);
+}
+
+/*
+ * True if the index exists, is clean and is consistent with its size
+ */
+bool qsoIndexValid() {
+  File file = SD.open(QSO_INDEX_FILE, FILE_READ);
+  if (!file) return false;
+  QSOIndexHeader header;
+  bool ok = qsoIndexReadHeader(file, header) && !header.dirty &&
+            file.size() >= qsoIndexPos(header.count);
+  file.close();
+  return ok;
+}
+
+/*
+ * Number of indexed QSOs (0 if the index is unusable)
+ */
+uint32_t qsoIndexCount() {
+  File file = SD.open(QSO_INDEX_FILE, FILE_READ);
+  if (!file) return 0;
+  QSOIndexHeader header;
+  uint32_t count = qsoIndexReadHeader(file, header) ? header.count : 0;
+  file.close();
+  return count;
+}
+
+/*
+ * Replace the index with the given records (sorted here)
+ */
+bool qsoIndexWriteAll(std::vector<QSOIndexRecord>& records) {
+  std::sort(records.begin(), records.end(), qsoIndexLess);
+
+  File file = SD.open(QSO_INDEX_FILE, FILE_WRITE);
+  if (!file) {
+    Serial.println("Failed to create QSO index");
+    return false;
+  }
+  qsoIndexWriteHeader(file, records.size(), true);
+  if (!records.empty()) {
+    file.write((const uint8_t*)records.data(), records.size() * sizeof(QSOIndexRecord));
+  }
+  qsoIndexWriteHeader(file, records.size(), false);
+  file.close();
+  return true;
+}
+
+/*
+ * Mark the index unusable so ensureQSOIndex() rebuilds it
+ */
+void qsoIndexInvalidate() {
+  SD.remove(QSO_INDEX_FILE);
+}
+
+/*
+ * First position whose record is not less than `key`
+ */
+static uint32_t qsoIndexLowerBound(File& file, uint32_t count, const QSOIndexRecord& key) {
+  uint32_t lo = 0, hi = count;
+  QSOIndexRecord rec;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (!qsoIndexReadAt(file, mid, rec)) break;
+    if (qsoIndexLess(rec, key)) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/*
+ * First position whose record is not before the cursor
+ */
+static uint32_t qsoIndexCursorBound(File& file, uint32_t count, const QSOIndexCursor& c) {
+  uint32_t lo = 0, hi = count;
+  QSOIndexRecord rec;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (!qsoIndexReadAt(file, mid, rec)) break;
+    if (qsoIndexBeforeCursor(rec, c)) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/*
+ * Cursor just before the record at a list position (for jumps)
+ */
+bool qsoIndexCursorAt(uint32_t pos, QSOIndexCursor& c) {
+  QSOIndexCursor first = QSO_CURSOR_FIRST;
+  c = first;
+  if (pos == 0) return true;
+  File file = SD.open(QSO_INDEX_FILE, FILE_READ);
+  if (!file) return false;
+  QSOIndexHeader header;
+  QSOIndexRecord rec;
+  bool ok = qsoIndexReadHeader(file, header) && pos <= header.count &&
+            qsoIndexReadAt(file, pos - 1, rec);
+  file.close();
+  if (ok) qsoIndexCursorFrom(rec, c);
+  return ok;
+}
+
+/*
+ * Insert a record at its sorted position. New QSOs are normally the latest,
+ * so this is usually a plain append; back-dated ones shift the tail.
+ */
+bool qsoIndexInsert(const QSOIndexRecord& rec) {
+  File file = SD.open(QSO_INDEX_FILE, "r+");
+  if (!file) return false;
+  QSOIndexHeader header;
+  if (!qsoIndexReadHeader(file, header) || header.dirty) {
+    file.close();
+    return false;
+  }
+  uint32_t count = header.count;
+  uint32_t pos = qsoIndexLowerBound(file, count, rec);
+
+  qsoIndexWriteHeader(file, count, true);
+
+  // Shift [pos, count) up one slot, last chunk first
+  QSOIndexRecord buf[QSO_INDEX_CHUNK];
+  uint32_t end = count;
+  while (end > pos) {
+    uint32_t n = min((uint32_t)QSO_INDEX_CHUNK, end - pos);
+    uint32_t start = end - n;
+    file.seek(qsoIndexPos(start));
+    file.read((uint8_t*)buf, n * sizeof(QSOIndexRecord));
+    file.seek(qsoIndexPos(start + 1));
+    file.write((const uint8_t*)buf, n * sizeof(QSOIndexRecord));
+    end = start;
+  }
+
+  file.seek(qsoIndexPos(pos));
+  file.write((const uint8_t*)&rec, sizeof(rec));
+  qsoIndexWriteHeader(file, count + 1, false);
+  file.close();
+  return true;
+}
+
+/*
+ * Find a record by its date/time key and id. Returns its position or -1.
+ */
+static int32_t qsoIndexFind(File& file, uint32_t count, const QSOIndexRecord& key) {
+  QSOIndexRecord search = key;
+  search.id = 0;
+  QSOIndexRecord rec;
+  for (uint32_t i = qsoIndexLowerBound(file, count, search); i < count; i++) {
+    if (!qsoIndexReadAt(file, i, rec)) break;
+    if (rec.date != key.date || rec.time != key.time) break;
+    if (rec.id == key.id) return (int32_t)i;
+  }
+  return -1;
+}
+
+/*
+ * Remove the record for a QSO (located by its date/time and id)
+ */
+bool qsoIndexRemove(const QSO& qso) {
+  File file = SD.open(QSO_INDEX_FILE, "r+");
+  if (!file) return false;
+  QSOIndexHeader header;
+  if (!qsoIndexReadHeader(file, header) || header.dirty) {
+    file.close();
+    return false;
+  }
+  QSOIndexRecord key;
+  qsoIndexMakeRecord(qso, 0, key);
+  int32_t found = qsoIndexFind(file, header.count, key);
+  if (found < 0) {
+    file.close();
+    return false;
+  }
+
+  qsoIndexWriteHeader(file, header.count, true);
+
+  // Shift (found, count) down one slot
+  QSOIndexRecord buf[QSO_INDEX_CHUNK];
+  uint32_t start = (uint32_t)found + 1;
+  while (start < header.count) {
+    uint32_t n = min((uint32_t)QSO_INDEX_CHUNK, header.count - start);
+    file.seek(qsoIndexPos(start));
+    file.read((uint8_t*)buf, n * sizeof(QSOIndexRecord));
+    file.seek(qsoIndexPos(start - 1));
+    file.write((const uint8_t*)buf, n * sizeof(QSOIndexRecord));
+    start += n;
+  }
+
+  qsoIndexWriteHeader(file, header.count - 1, false);
+  file.close();
+  return true;
+}
+
+/*
+ * Point a QSO's record at a new journal offset (after compaction)
+ */
+bool qsoIndexSetOffset(const QSO& qso, uint32_t offset) {
+  File file = SD.open(QSO_INDEX_FILE, "r+");
+  if (!file) return false;
+  QSOIndexHeader header;
+  bool ok = false;
+  if (qsoIndexReadHeader(file, header) && !header.dirty) {
+    QSOIndexRecord key;
+    qsoIndexMakeRecord(qso, 0, key);
+    int32_t found = qsoIndexFind(file, header.count, key);
+    if (found >= 0) {
+      file.seek(qsoIndexPos((uint32_t)found) + offsetof(QSOIndexRecord, offset));
+      file.write((const uint8_t*)&offset, sizeof(offset));
+      ok = true;
+    }
+  }
+  file.close();
+  return ok;
+}
+
+// ============================================
+// Queries
+// ============================================
+
+/*
+ * Read a page of records matching a filter, continuing from *cursor.
+ * Forward: records after the cursor, oldest first
+ * Backward: records before the cursor, newest first
+ * On return *cursor is the last record examined, where the next page
+ * continues, or QSO_CURSOR_LAST / QSO_CURSOR_FIRST once nothing is left
+ * (qsoIndexCursorDone()). Returns the number of records written to out (less than
+ * maxRows means the end was reached), or -1 if the index is dirty or
+ * unreadable - see qsoIndexQueryLoop() for callers that may rebuild it.
+ */
+int qsoIndexQuery(const QSOQueryFilter* filter, QSOIndexCursor* cursor, bool backward,
+                  QSOIndexRecord* out, int maxRows) {
+  File file = SD.open(QSO_INDEX_FILE, FILE_READ);
+  if (!file) return -1;
+  QSOIndexHeader header;
+  if (!qsoIndexReadHeader(file, header) || header.dirty) {
+    file.close();
+    return -1;
+  }
+
+  uint32_t count = header.count;
+  // Forward starts at the first record after the cursor (the cursor's own
+  // record, if still there, was on the previous page); backward just below
+  uint32_t pos = qsoIndexCursorBound(file, count, *cursor);
+  if (!backward && pos < count) {
+    QSOIndexRecord rec;
+    if (qsoIndexReadAt(file, pos, rec) && rec.date == cursor->date &&
+        rec.time == cursor->time && rec.id == cursor->id) {
+      pos++;
+    }
+  }
+  int rows = 0;
+  QSOIndexRecord buf[QSO_INDEX_CHUNK];
+
+  while (rows < maxRows) {
+    if (backward ? (pos == 0) : (pos >= count)) break;
+
+    uint32_t n, start;
+    if (backward) {
+      n = min((uint32_t)QSO_INDEX_CHUNK, pos);
+      start = pos - n;
+    } else {
+      n = min((uint32_t)QSO_INDEX_CHUNK, count - pos);
+      start = pos;
+    }
+    file.seek(qsoIndexPos(start));
+    if (file.read((uint8_t*)buf, n * sizeof(QSOIndexRecord)) != n * sizeof(QSOIndexRecord)) break;
+
+    // Date bounds are sorted: stop as soon as we pass them
+    bool done = false;
+    for (uint32_t k = 0; k < n && rows < maxRows; k++) {
+      uint32_t i = backward ? (n - 1 - k) : k;
+      const QSOIndexRecord& rec = buf[i];
+      pos = backward ? (start + i) : (start + i + 1);
+      if (filter) {
+        if (!backward && filter->toDate && rec.date > filter->toDate) { done = true; break; }
+        if (backward && filter->fromDate && rec.date < filter->fromDate) { done = true; break; }
+      }
+      qsoIndexCursorFrom(rec, *cursor);
+      if (!qsoIndexMatches(rec, filter)) continue;
+      out[rows++] = rec;
+    }
+    if (done) {
+      pos = backward ? 0 : count;
+      break;
+    }
+  }
+  file.close();
+
+  // Nothing left in this direction
+  if (backward ? (pos == 0) : (pos >= count)) {
+    QSOIndexCursor first = QSO_CURSOR_FIRST, last = QSO_CURSOR_LAST;
+    *cursor = backward ? first : last;
+  }
+  return rows;
+}
+
+/*
+ * qsoIndexQuery() on the loop task: a dirty or missing index (an update
+ * cut short) is rebuilt from the journals first
+ */
+int qsoIndexQueryLoop(const QSOQueryFilter* filter, QSOIndexCursor* cursor, bool backward,
+                      QSOIndexRecord* out, int maxRows) {
+  int n = qsoIndexQuery(filter, cursor, backward, out, maxRows);
+  if (n < 0 && ensureQSOIndex()) n = qsoIndexQuery(filter, cursor, backward, out, maxRows);
+  return n < 0 ? 0 : n;
+}
+
+#endif // QSO_LOGGER_INDEX_H
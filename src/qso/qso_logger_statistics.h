@@ -1,5 +1,6 @@
 // QSO Logger Statistics Module
-// Calculate analytics from saved QSO logs
+// Analytics for saved QSO logs, read from the incrementally maintained
+// aggregates in qso_logger_aggregates.h
 // UI is now handled by LVGL in lv_mode_screens.h
 
 #ifndef QSO_LOGGER_STATISTICS_H
@@ -22,7 +23,7 @@ struct QSOStatistics {
     char band[6];
     int count;
   };
-  BandStats bandStats[10];  // Support up to 10 different bands
+  BandStats bandStats[11];  // Up to 10 bands, then "Other"
   int bandCount;
 
   // Mode breakdown
@@ -30,7 +31,7 @@ struct QSOStatistics {
     char mode[8];
     int count;
   };
-  ModeStats modeStats[8];   // Support up to 8 different modes
+  ModeStats modeStats[9];   // Up to 8 modes, then "Other"
   int modeCount;
 
   // Unique callsigns
@@ -42,6 +43,10 @@ struct QSOStatistics {
 
   // Last QSO date
   char lastQSODate[9];
+
+  // Countries worked (logged COUNTRY field)
+  int countryCount;
+  bool countriesTruncated;  // More countries than the aggregates track
 };
 
 QSOStatistics stats;
@@ -88,137 +93,58 @@ int findOrAddMode(const char* mode) {
   return -1;  // No space
 }
 
-// Calculate all statistics from saved QSO logs
+// Fill `stats` from the persistent aggregates (no log scan)
 void calculateStatistics() {
-  Serial.println("Calculating QSO statistics...");
-
   // Reset stats
   memset(&stats, 0, sizeof(stats));
 
-  // Track unique callsigns (simple array, limited to 100 for memory)
-  String uniqueCallsignsList[100];
-  int uniqueCount = 0;
-
-  // Track dates for most active day
-  struct DateCount {
-    char date[9];
-    int count;
-  };
-  DateCount dateCounts[50];  // Track up to 50 different dates
-  int dateCountsSize = 0;
-
-  // Open QSO directory
-  File root = SD.open("/qso");
-  if (!root || !root.isDirectory()) {
-    Serial.println("Failed to open /qso directory");
-    return;
+  stats.totalQSOs = qsoAgg.totalQSOs;
+
+  // Anything that doesn't get a row of its own is shown as "Other"
+  int bandOther = qsoAgg.bandOther;
+  for (int i = 0; i < qsoAgg.bandCount; i++) {
+    if (qsoAgg.bands[i].count == 0) continue;
+    int bandIndex = findOrAddBand(qsoAgg.bands[i].band);
+    if (bandIndex >= 0) {
+      stats.bandStats[bandIndex].count = qsoAgg.bands[i].count;
+    } else {
+      bandOther += qsoAgg.bands[i].count;
+    }
+  }
+  if (bandOther > 0) {
+    strlcpy(stats.bandStats[stats.bandCount].band, "Other", sizeof(stats.bandStats[0].band));
+    stats.bandStats[stats.bandCount++].count = bandOther;
   }
 
-  // Iterate through all log files
-  File file = root.openNextFile();
-  while (file) {
-    if (!file.isDirectory()) {
-      String filename = String(file.name());
-
-      // Extract basename
-      int lastSlash = filename.lastIndexOf('/');
-      if (lastSlash >= 0) {
-        filename = filename.substring(lastSlash + 1);
-      }
-
-      if (filename.startsWith("qso_") && filename.endsWith(".json")) {
-        Serial.print("Processing: ");
-        Serial.println(filename);
-
-        File logFile = SD.open(file.path(), "r");
-        if (logFile) {
-          String content = logFile.readString();
-          logFile.close();
-
-          StaticJsonDocument<8192> doc;
-          DeserializationError error = deserializeJson(doc, content);
-
-          if (!error && doc.containsKey("logs")) {
-            JsonArray logs = doc["logs"].as<JsonArray>();
-
-            for (JsonObject qso : logs) {
-              stats.totalQSOs++;
-
-              // Band stats
-              const char* band = qso["band"] | "";
-              if (strlen(band) > 0) {
-                int bandIndex = findOrAddBand(band);
-                if (bandIndex >= 0) {
-                  stats.bandStats[bandIndex].count++;
-                }
-              }
-
-              // Mode stats
-              const char* mode = qso["mode"] | "CW";
-              int modeIndex = findOrAddMode(mode);
-              if (modeIndex >= 0) {
-                stats.modeStats[modeIndex].count++;
-              }
-
-              // Unique callsigns
-              String callsign = String(qso["callsign"] | "");
-              if (callsign.length() > 0) {
-                bool found = false;
-                for (int i = 0; i < uniqueCount; i++) {
-                  if (uniqueCallsignsList[i] == callsign) {
-                    found = true;
-                    break;
-                  }
-                }
-                if (!found && uniqueCount < 100) {
-                  uniqueCallsignsList[uniqueCount++] = callsign;
-                }
-              }
-
-              // Date tracking
-              const char* date = qso["date"] | "";
-              if (strlen(date) > 0) {
-                // Update last QSO date (assuming files are chronological)
-                strlcpy(stats.lastQSODate, date, sizeof(stats.lastQSODate));
-
-                // Find or add date count
-                int dateIndex = -1;
-                for (int i = 0; i < dateCountsSize; i++) {
-                  if (strcmp(dateCounts[i].date, date) == 0) {
-                    dateIndex = i;
-                    break;
-                  }
-                }
-
-                if (dateIndex >= 0) {
-                  dateCounts[dateIndex].count++;
-                } else if (dateCountsSize < 50) {
-                  strlcpy(dateCounts[dateCountsSize].date, date, sizeof(dateCounts[dateCountsSize].date));
-                  dateCounts[dateCountsSize].count = 1;
-                  dateCountsSize++;
-                }
-              }
-            }
-          }
-        }
-      }
+  int modeOther = qsoAgg.modeOther;
+  for (int i = 0; i < qsoAgg.modeCount; i++) {
+    if (qsoAgg.modes[i].count == 0) continue;
+    int modeIndex = findOrAddMode(qsoAgg.modes[i].mode);
+    if (modeIndex >= 0) {
+      stats.modeStats[modeIndex].count = qsoAgg.modes[i].count;
+    } else {
+      modeOther += qsoAgg.modes[i].count;
     }
-    file = root.openNextFile();
   }
-  root.close();
-
-  // Set unique callsigns count
-  stats.uniqueCallsigns = uniqueCount;
-
-  // Find most active date
-  int maxCount = 0;
-  for (int i = 0; i < dateCountsSize; i++) {
-    if (dateCounts[i].count > maxCount) {
-      maxCount = dateCounts[i].count;
-      strlcpy(stats.mostActiveDate, dateCounts[i].date, sizeof(stats.mostActiveDate));
-      stats.mostActiveDateCount = maxCount;
+  if (modeOther > 0) {
+    strlcpy(stats.modeStats[stats.modeCount].mode, "Other", sizeof(stats.modeStats[0].mode));
+    stats.modeStats[stats.modeCount++].count = modeOther;
+  }
+
+  stats.uniqueCallsigns = qsoAgg.calls.live;
+  stats.countryCount = qsoAggCountryCount();
+  stats.countriesTruncated = qsoAgg.countryOther > 0;
+
+  // Days are sorted and only hold days with QSOs
+  for (const QSOAggDay& day : qsoAgg.days) {
+    if ((int)day.count > stats.mostActiveDateCount) {
+      stats.mostActiveDateCount = day.count;
+      snprintf(stats.mostActiveDate, sizeof(stats.mostActiveDate), "%08lu", (unsigned long)day.date);
     }
   }
+  if (!qsoAgg.days.empty()) {
+    snprintf(stats.lastQSODate, sizeof(stats.lastQSODate), "%08lu", (unsigned long)qsoAgg.days.back().date);
+  }
 
   Serial.println("Statistics calculated:");
   Serial.print("  Total QSOs: ");
@@ -229,6 +155,8 @@ void calculateStatistics() {
   Serial.println(stats.bandCount);
   Serial.print("  Modes: ");
   Serial.println(stats.modeCount);
+  Serial.print("  Countries: ");
+  Serial.println(stats.countryCount);
 }
 
 #endif // QSO_LOGGER_STATISTICS_H
@@ -12,9 +12,17 @@
 #include <SD.h>
 #include <SPIFFS.h>
 #include <ArduinoJson.h>
+#include <vector>
+#include <algorithm>
 #include "qso_logger.h"  // Same folder
+#include "qso_logger_index.h"  // Same folder
+#include "qso_logger_aggregates.h"  // Same folder
+#include "qso_logger_dupes.h"  // Same folder
 #include "../storage/sd_card.h"
+#include "../storage/sd_write_queue.h"
+#include "../storage/atomic_file.h"
 #include "../core/config.h"
+#include "../core/deferred_save.h"
 
 // ============================================
 // Storage Configuration
@@ -26,6 +34,19 @@
 #define METADATA_FILE "/logs/metadata.json"  // Statistics cache on SPIFFS
 #define MASTER_ADIF_FILE "/qso/vail-summit.adi"  // Master ADIF file
 
+// Daily journals: /qso/qso_YYYYMMDD.jsonl, one JSON operation per line.
+//   {"op":"A","id":...,<fields>}   add
+//   {"op":"U","id":...,<fields>}   update (supersedes earlier lines for id)
+//   {"op":"D","id":...}            delete tombstone
+// Lines replay in order and the last one for an id wins, so an A after a D
+// (a QSO moved to another day and back) brings the record back.
+// A save is a single append instead of a read-modify-write of the whole day.
+// Each line is written with a leading '\n', so a record torn by power loss
+// is terminated by the next append and simply fails to parse on replay.
+#define QSO_JOURNAL_EXT ".jsonl"
+#define QSO_JOURNAL_LINE_MAX 1024       // Longest journal line accepted
+#define QSO_COMPACT_THRESHOLD 16        // Superseded lines per day before compaction
+
 // ============================================
 // Storage Statistics
 // ============================================
@@ -52,7 +73,13 @@ void saveMetadata();
 void regenerateADIFFiles(const char* date);
 void generateMasterADIF();
 void generateDailyADIF(const char* date);
-String qsoToADIFRecord(const QSO& qso);
+void writeADIFRecord(Print& out, const QSO& qso);
+bool forEachQSOInDay(const char* date, QSOVisitor fn, void* ctx);
+bool forEachQSO(QSOVisitor fn, void* ctx);
+bool migrateLegacyQSOFiles();
+void rebuildQSOIndex();
+bool ensureQSOIndex();
+void recalculateMetadata();
 
 // ============================================
 // Helper Functions
@@ -121,6 +148,23 @@ bool initQSOStorage() {
   Serial.println("QSO storage initialized successfully on SD card");
   qsoStorageReady = true;
 
+  // One-time conversion of pre-journal qso_YYYYMMDD.json day files
+  if (migrateLegacyQSOFiles()) {
+    qsoIndexInvalidate();
+  }
+
+  // Rebuild the QSO index if it is missing or was interrupted mid-update
+  ensureQSOIndex();
+
+  // Statistics snapshot must cover exactly the indexed QSOs. Header check
+  // only, so a clean shutdown never costs a full log scan at boot
+  if (!loadQSOAggregates(qsoIndexCount())) {
+    recalculateMetadata();
+  }
+
+  // Dupe/worked-before lookups for the entry screens
+  rebuildQSODupeIndex();
+
   // Print storage info
   Serial.print("Total logs: ");
   Serial.println(storageStats.totalLogs);
@@ -181,14 +225,14 @@ int getModeIndex(const char* mode) {
 void loadMetadata() {
   memset(&storageStats, 0, sizeof(StorageStats));
 
-  if (!SPIFFS.exists(METADATA_FILE)) {
-    Serial.println("No metadata file found, starting fresh");
-    return;
-  }
-
-  File file = SPIFFS.open(METADATA_FILE, "r");
+  AtomicFileInfo info;
+  File file = atomicFileOpen(SPIFFS, METADATA_FILE, &info);
   if (!file) {
-    Serial.println("Failed to open metadata file");
+    if (info.status == ATOMIC_FILE_MISSING) {
+      Serial.println("No metadata file found, starting fresh");
+    } else {
+      Serial.println("Failed to open metadata file");
+    }
     return;
   }
 
@@ -242,15 +286,18 @@ void saveMetadata() {
     modes.add(storageStats.logsByMode[i]);
   }
 
-  // Write to file
-  File file = SPIFFS.open(METADATA_FILE, "w");
-  if (!file) {
+  // Write to file (replaced atomically - a torn write keeps the old copy)
+  AtomicFileWriter file(SPIFFS, METADATA_FILE, ATOMIC_FORMAT_PLAIN);
+  if (!file.begin()) {
     Serial.println("Failed to open metadata file for writing");
     return;
   }
 
   serializeJson(doc, file);
-  file.close();
+  if (!file.commit()) {
+    Serial.println("Failed to write metadata file");
+    return;
+  }
 
   Serial.println("Metadata saved");
 }
@@ -285,6 +332,8 @@ void qsoToJson(const QSO& qso, JsonObject& obj) {
   if (strlen(qso.contest) > 0) obj["contest"] = qso.contest;
   if (qso.srx > 0) obj["srx"] = qso.srx;
   if (qso.stx > 0) obj["stx"] = qso.stx;
+  if (strlen(qso.srx_string) > 0) obj["srx_string"] = qso.srx_string;
+  if (strlen(qso.stx_string) > 0) obj["stx_string"] = qso.stx_string;
   if (strlen(qso.operator_call) > 0) obj["operator_call"] = qso.operator_call;
   if (strlen(qso.station_call) > 0) obj["station_call"] = qso.station_call;
 
@@ -321,6 +370,8 @@ void jsonToQso(JsonObject& obj, QSO& qso) {
   strlcpy(qso.contest, obj["contest"] | "", sizeof(qso.contest));
   qso.srx = obj["srx"] | 0;
   qso.stx = obj["stx"] | 0;
+  strlcpy(qso.srx_string, obj["srx_string"] | "", sizeof(qso.srx_string));
+  strlcpy(qso.stx_string, obj["stx_string"] | "", sizeof(qso.stx_string));
   strlcpy(qso.operator_call, obj["operator_call"] | "", sizeof(qso.operator_call));
   strlcpy(qso.station_call, obj["station_call"] | "", sizeof(qso.station_call));
 
@@ -350,325 +401,858 @@ void jsonToQso(JsonObject& obj, QSO& qso) {
 // ============================================
 
 /*
- * Convert a single QSO to ADIF record format
+ * Write one ADIF field ("<NAME:len>value ")
  */
-String qsoToADIFRecord(const QSO& qso) {
-  String record = "";
+void writeADIFField(Print& out, const char* name, const char* value) {
+  out.printf("<%s:%u>%s ", name, (unsigned)strlen(value), value);
+}
 
+/*
+ * Write a single QSO as an ADIF record
+ */
+void writeADIFRecord(Print& out, const QSO& qso) {
   // Required fields
-  record += "<CALL:" + String(strlen(qso.callsign)) + ">" + qso.callsign + " ";
+  writeADIFField(out, "CALL", qso.callsign);
 
   char freqStr[16];
   snprintf(freqStr, sizeof(freqStr), "%.3f", qso.frequency);
-  record += "<FREQ:" + String(strlen(freqStr)) + ">" + freqStr + " ";
+  writeADIFField(out, "FREQ", freqStr);
 
-  record += "<MODE:" + String(strlen(qso.mode)) + ">" + qso.mode + " ";
-  record += "<BAND:" + String(strlen(qso.band)) + ">" + qso.band + " ";
-  record += "<QSO_DATE:" + String(strlen(qso.date)) + ">" + qso.date + " ";
+  writeADIFField(out, "MODE", qso.mode);
+  writeADIFField(out, "BAND", qso.band);
+  writeADIFField(out, "QSO_DATE", qso.date);
 
   // Convert time from HHMM to HHMMSS
   char timeStr[8];
   snprintf(timeStr, sizeof(timeStr), "%s00", qso.time_on);
-  record += "<TIME_ON:" + String(strlen(timeStr)) + ">" + timeStr + " ";
+  writeADIFField(out, "TIME_ON", timeStr);
 
   // RST
-  if (strlen(qso.rst_sent) > 0) {
-    record += "<RST_SENT:" + String(strlen(qso.rst_sent)) + ">" + qso.rst_sent + " ";
-  }
-  if (strlen(qso.rst_rcvd) > 0) {
-    record += "<RST_RCVD:" + String(strlen(qso.rst_rcvd)) + ">" + qso.rst_rcvd + " ";
-  }
+  if (strlen(qso.rst_sent) > 0) writeADIFField(out, "RST_SENT", qso.rst_sent);
+  if (strlen(qso.rst_rcvd) > 0) writeADIFField(out, "RST_RCVD", qso.rst_rcvd);
 
   // Optional fields
-  if (strlen(qso.name) > 0) {
-    record += "<NAME:" + String(strlen(qso.name)) + ">" + qso.name + " ";
-  }
-  if (strlen(qso.qth) > 0) {
-    record += "<QTH:" + String(strlen(qso.qth)) + ">" + qso.qth + " ";
-  }
-  if (strlen(qso.gridsquare) > 0) {
-    record += "<GRIDSQUARE:" + String(strlen(qso.gridsquare)) + ">" + qso.gridsquare + " ";
-  }
-  if (strlen(qso.country) > 0) {
-    record += "<COUNTRY:" + String(strlen(qso.country)) + ">" + qso.country + " ";
-  }
-  if (strlen(qso.state) > 0) {
-    record += "<STATE:" + String(strlen(qso.state)) + ">" + qso.state + " ";
-  }
+  if (strlen(qso.name) > 0) writeADIFField(out, "NAME", qso.name);
+  if (strlen(qso.qth) > 0) writeADIFField(out, "QTH", qso.qth);
+  if (strlen(qso.gridsquare) > 0) writeADIFField(out, "GRIDSQUARE", qso.gridsquare);
+  if (strlen(qso.country) > 0) writeADIFField(out, "COUNTRY", qso.country);
+  if (strlen(qso.state) > 0) writeADIFField(out, "STATE", qso.state);
   if (qso.power > 0) {
     char powerStr[8];
     snprintf(powerStr, sizeof(powerStr), "%d", qso.power);
-    record += "<TX_PWR:" + String(strlen(powerStr)) + ">" + powerStr + " ";
+    writeADIFField(out, "TX_PWR", powerStr);
   }
-  if (strlen(qso.notes) > 0) {
-    record += "<COMMENT:" + String(strlen(qso.notes)) + ">" + qso.notes + " ";
+  if (strlen(qso.notes) > 0) writeADIFField(out, "COMMENT", qso.notes);
+
+  // Contest fields
+  if (strlen(qso.contest) > 0) writeADIFField(out, "CONTEST_ID", qso.contest);
+  if (qso.srx > 0 || qso.stx > 0) {
+    char serialStr[8];
+    snprintf(serialStr, sizeof(serialStr), "%d", qso.srx);
+    if (qso.srx > 0) writeADIFField(out, "SRX", serialStr);
+    snprintf(serialStr, sizeof(serialStr), "%d", qso.stx);
+    if (qso.stx > 0) writeADIFField(out, "STX", serialStr);
   }
+  if (strlen(qso.srx_string) > 0) writeADIFField(out, "SRX_STRING", qso.srx_string);
+  if (strlen(qso.stx_string) > 0) writeADIFField(out, "STX_STRING", qso.stx_string);
 
   // My location fields
-  if (strlen(qso.my_gridsquare) > 0) {
-    record += "<MY_GRIDSQUARE:" + String(strlen(qso.my_gridsquare)) + ">" + qso.my_gridsquare + " ";
-  }
+  if (strlen(qso.my_gridsquare) > 0) writeADIFField(out, "MY_GRIDSQUARE", qso.my_gridsquare);
 
   // POTA fields
   if (strlen(qso.my_pota_ref) > 0) {
-    record += "<MY_SIG:4>POTA ";
-    record += "<MY_SIG_INFO:" + String(strlen(qso.my_pota_ref)) + ">" + qso.my_pota_ref + " ";
+    writeADIFField(out, "MY_SIG", "POTA");
+    writeADIFField(out, "MY_SIG_INFO", qso.my_pota_ref);
   }
   if (strlen(qso.their_pota_ref) > 0) {
-    record += "<SIG:4>POTA ";
-    record += "<SIG_INFO:" + String(strlen(qso.their_pota_ref)) + ">" + qso.their_pota_ref + " ";
+    writeADIFField(out, "SIG", "POTA");
+    writeADIFField(out, "SIG_INFO", qso.their_pota_ref);
   }
 
   // Operator/station
-  if (strlen(qso.operator_call) > 0) {
-    record += "<OPERATOR:" + String(strlen(qso.operator_call)) + ">" + qso.operator_call + " ";
-  }
-  if (strlen(qso.station_call) > 0) {
-    record += "<STATION_CALLSIGN:" + String(strlen(qso.station_call)) + ">" + qso.station_call + " ";
-  }
+  if (strlen(qso.operator_call) > 0) writeADIFField(out, "OPERATOR", qso.operator_call);
+  if (strlen(qso.station_call) > 0) writeADIFField(out, "STATION_CALLSIGN", qso.station_call);
 
-  record += "<EOR>\n";
-  return record;
+  out.print("<EOR>\n");
 }
 
 /*
- * Generate ADIF header
+ * Write ADIF header
  */
-String generateADIFHeader() {
-  String header = "ADIF Export from VAIL SUMMIT\n";
-  header += "Generated by " + String(FIRMWARE_NAME) + " v" + String(FIRMWARE_VERSION) + "\n\n";
-  header += "<PROGRAMID:11>VAIL SUMMIT\n";
-  header += "<PROGRAMVERSION:" + String(strlen(FIRMWARE_VERSION)) + ">" + FIRMWARE_VERSION + "\n";
-  header += "<ADIF_VER:5>3.1.4\n";
-  header += "<EOH>\n\n";
-  return header;
+void writeADIFHeader(Print& out) {
+  out.print("ADIF Export from VAIL SUMMIT\n");
+  out.printf("Generated by %s v%s\n\n", FIRMWARE_NAME, FIRMWARE_VERSION);
+  out.print("<PROGRAMID:11>VAIL SUMMIT\n");
+  out.printf("<PROGRAMVERSION:%u>%s\n", (unsigned)strlen(FIRMWARE_VERSION), FIRMWARE_VERSION);
+  out.print("<ADIF_VER:5>3.1.4\n");
+  out.print("<EOH>\n\n");
 }
 
+// ============================================
+// QSO Journal (SD Card)
+// ============================================
+
 /*
- * Generate daily ADIF file for a specific date
+ * Get journal filename for a day (YYYYMMDD)
  */
-void generateDailyADIF(const char* date) {
-  if (!sdCardAvailable) return;
+String getLogFilename(const char* date) {
+  char filename[40];
+  snprintf(filename, sizeof(filename), "%s/qso_%s%s", QSO_DIR, date, QSO_JOURNAL_EXT);
+  return String(filename);
+}
 
-  // Build filenames
-  char jsonPath[40];
-  char adifPath[40];
-  snprintf(jsonPath, sizeof(jsonPath), "%s/qso_%s.json", QSO_DIR, date);
-  snprintf(adifPath, sizeof(adifPath), "%s/qso_%s.adi", QSO_DIR, date);
+/*
+ * Extract YYYYMMDD from a journal file name ("qso_20250101.jsonl" or a full
+ * path). Returns false for anything that isn't a day journal.
+ */
+bool journalNameToDate(const char* name, char* date) {
+  const char* base = strrchr(name, '/');
+  base = base ? base + 1 : name;
+  if (strlen(base) != 12 + strlen(QSO_JOURNAL_EXT)) return false;
+  if (strncmp(base, "qso_", 4) != 0) return false;
+  if (strcmp(base + 12, QSO_JOURNAL_EXT) != 0) return false;
+  for (int i = 0; i < 8; i++) {
+    if (!isdigit((unsigned char)base[4 + i])) return false;
+    date[i] = base[4 + i];
+  }
+  date[8] = '\0';
+  return true;
+}
 
-  Serial.print("Generating daily ADIF: ");
-  Serial.println(adifPath);
+/*
+ * Serialize one journal operation (with its leading '\n') into line
+ * qso may be null for "D" (only id is written)
+ * Returns the number of bytes to write, or 0 if it does not fit
+ */
+size_t formatJournalOp(char op, const QSO* qso, unsigned long id, char* line, size_t size) {
+  JsonDocument doc;
+  char opStr[2] = {op, '\0'};
+  doc["op"] = opStr;              // op and id first: replay peeks at the prefix
+  if (qso != nullptr) {
+    JsonObject obj = doc.as<JsonObject>();
+    qsoToJson(*qso, obj);
+  } else {
+    doc["id"] = id;
+  }
 
-  // Check if JSON file exists
-  if (!SD.exists(jsonPath)) {
-    Serial.println("No JSON file for this date");
-    return;
+  line[0] = '\n';
+  size_t len = serializeJson(doc, line + 1, size - 1);
+  if (len == 0 || len >= size - 1) {
+    Serial.println("Journal line too long");
+    return 0;
   }
+  return len + 1;
+}
 
-  // Read JSON file
-  File jsonFile = SD.open(jsonPath, "r");
-  if (!jsonFile) {
-    Serial.println("Failed to open JSON file");
-    return;
+// Superseded-line counts for recently edited days (see maybeCompactJournal)
+#define QSO_JOURNAL_COUNT_DAYS 4
+
+struct JournalDayCount {
+  char date[9];          // Empty = unused
+  int superseded;
+};
+
+static JournalDayCount journalDayCounts[QSO_JOURNAL_COUNT_DAYS];
+static int journalDayCountNext = 0;
+
+static JournalDayCount* journalDayCountFind(const char* date) {
+  for (int i = 0; i < QSO_JOURNAL_COUNT_DAYS; i++) {
+    if (journalDayCounts[i].date[0] != '\0' && strcmp(journalDayCounts[i].date, date) == 0) {
+      return &journalDayCounts[i];
+    }
   }
+  return nullptr;
+}
 
-  JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, jsonFile);
-  jsonFile.close();
+static JournalDayCount* journalDayCountSet(const char* date, int superseded) {
+  JournalDayCount* c = journalDayCountFind(date);
+  if (c == nullptr) {
+    c = &journalDayCounts[journalDayCountNext];
+    journalDayCountNext = (journalDayCountNext + 1) % QSO_JOURNAL_COUNT_DAYS;
+    strlcpy(c->date, date, sizeof(c->date));
+  }
+  c->superseded = superseded;
+  return c;
+}
 
-  if (error) {
-    Serial.print("Failed to parse JSON: ");
-    Serial.println(error.c_str());
-    return;
+/*
+ * Append one operation line to a day journal
+ * qso may be null for "D" (only id is written)
+ * offsetOut (optional) receives the byte offset of the new line
+ */
+bool appendJournalOp(const char* date, char op, const QSO* qso, unsigned long id,
+                     uint32_t* offsetOut = nullptr) {
+  char line[QSO_JOURNAL_LINE_MAX];
+  size_t len = formatJournalOp(op, qso, id, line, sizeof(line));
+  if (len == 0) return false;
+
+  String filename = getLogFilename(date);
+  File file = SD.open(filename, FILE_APPEND);
+  if (!file) {
+    Serial.println("Failed to open journal for append");
+    return false;
   }
+  if (offsetOut) *offsetOut = file.size() + 1;  // Past the leading '\n'
+  size_t written = file.write((const uint8_t*)line, len);
+  file.close();
+  if (written != len) return false;
 
-  // Generate ADIF content
-  String adifContent = generateADIFHeader();
+  // U retires one earlier line; D retires one plus itself
+  JournalDayCount* c = journalDayCountFind(date);
+  if (c != nullptr && op != 'A') c->superseded += (op == 'D') ? 2 : 1;
+  return true;
+}
 
-  JsonArray logs = doc["logs"];
-  for (JsonObject logObj : logs) {
-    QSO qso;
-    jsonToQso(logObj, qso);
-    adifContent += qsoToADIFRecord(qso);
+/*
+ * Read the next journal line into buf. Returns its length, 0 for a blank
+ * line, or -1 at end of file. Overlong lines are consumed and reported blank.
+ */
+int readJournalLine(File& file, char* buf, size_t size) {
+  if (!file.available()) return -1;
+  size_t len = file.readBytesUntil('\n', buf, size - 1);
+  buf[len] = '\0';
+  if (len == size - 1) {
+    // Overlong - skip the rest of it
+    while (file.available() && file.read() != '\n') {}
+    return 0;
   }
+  return (int)len;
+}
 
-  // Write ADIF file (use "w" mode to truncate)
-  File adifFile = SD.open(adifPath, "w");
-  if (!adifFile) {
-    Serial.println("Failed to create ADIF file");
-    return;
+/*
+ * Fast path: pull op and id out of a line written by appendJournalOp()
+ * ({"op":"X","id":N...}) without a JSON parse. Returns false if the line
+ * doesn't look like that.
+ */
+bool peekJournalOp(const char* line, char* op, unsigned long* id) {
+  if (strncmp(line, "{\"op\":\"", 7) != 0) return false;
+  *op = line[7];
+  if (strncmp(line + 8, "\",\"id\":", 7) != 0) return false;
+  *id = strtoul(line + 15, nullptr, 10);
+  return true;
+}
+
+// Latest journal line for an id within a day
+struct JournalLatest {
+  unsigned long id;
+  uint32_t offset;   // Byte offset of the last line for this id
+  bool deleted;      // Last line was a 'D'
+};
+
+static bool journalLatestLess(const JournalLatest& a, const JournalLatest& b) {
+  return a.id < b.id;
+}
+
+/*
+ * Pass 1 over a day journal: the last line for each id, in order, so A/U/D
+ * all count (a QSO moved to another day and back is live again). Sorted by
+ * id for journalLatestFind(). Returns the number of lines that no longer
+ * hold a live record.
+ */
+int scanJournalLatest(File& file, std::vector<JournalLatest>& latest) {
+  char line[QSO_JOURNAL_LINE_MAX];
+  int lines = 0;
+  while (true) {
+    uint32_t offset = file.position();
+    int len = readJournalLine(file, line, sizeof(line));
+    if (len < 0) break;
+    char op;
+    unsigned long id;
+    if (len == 0 || !peekJournalOp(line, &op, &id)) continue;
+    latest.push_back({id, offset, op == 'D'});
+    lines++;
   }
 
-  adifFile.print(adifContent);
-  adifFile.close();
+  // Stable sort keeps file order within an id; the last entry wins
+  std::stable_sort(latest.begin(), latest.end(), journalLatestLess);
+  size_t out = 0;
+  int live = 0;
+  for (size_t i = 0; i < latest.size(); i++) {
+    if (i + 1 < latest.size() && latest[i + 1].id == latest[i].id) continue;
+    latest[out++] = latest[i];
+    if (!latest[i].deleted) live++;
+  }
+  latest.resize(out);
+  return lines - live;
+}
 
-  Serial.print("Daily ADIF generated: ");
-  Serial.print(logs.size());
-  Serial.println(" QSOs");
+/*
+ * Every id used by a line of a day journal (live, updated or deleted),
+ * sorted, for journalTakeId()
+ */
+void loadJournalIds(const char* date, std::vector<unsigned long>& ids) {
+  ids.clear();
+  File file = SD.open(getLogFilename(date), FILE_READ);
+  if (!file) return;
+  char line[QSO_JOURNAL_LINE_MAX];
+  int len;
+  while ((len = readJournalLine(file, line, sizeof(line))) >= 0) {
+    char op;
+    unsigned long id;
+    if (len > 0 && peekJournalOp(line, &op, &id)) ids.push_back(id);
+  }
+  file.close();
+  std::sort(ids.begin(), ids.end());
 }
 
 /*
- * Generate master ADIF file containing all QSOs
+ * Id for a new QSO in a day: `id`, bumped past any id the day's journal
+ * already uses (a repeated id would replay as an update and replace the
+ * earlier QSO). Ids come from millis(), which restarts every boot, or from
+ * epoch minutes (contest, import), so collisions do happen. The id is
+ * added to `ids`; never returns 0.
  */
-void generateMasterADIF() {
-  if (!sdCardAvailable) return;
+unsigned long journalTakeId(std::vector<unsigned long>& ids, unsigned long id) {
+  if (id == 0) id = 1;
+  auto it = std::lower_bound(ids.begin(), ids.end(), id);
+  for (; it != ids.end() && *it <= id; it++) {
+    if (*it == id) id++;  // Ids may repeat (updates)
+  }
+  ids.insert(it, id);
+  return id;
+}
 
-  Serial.println("Generating master ADIF file...");
+static const JournalLatest* journalLatestFind(const std::vector<JournalLatest>& latest,
+                                              unsigned long id) {
+  JournalLatest key = {id, 0, false};
+  auto it = std::lower_bound(latest.begin(), latest.end(), key, journalLatestLess);
+  return (it != latest.end() && it->id == id) ? &*it : nullptr;
+}
 
-  // Start with header
-  String adifContent = generateADIFHeader();
+// Visitor that also receives the byte offset of the QSO's journal line
+typedef bool (*QSOLineVisitor)(const QSO& qso, uint32_t offset, void* ctx);
 
-  // Iterate all JSON files in QSO directory
-  File root = SD.open(QSO_DIR);
-  if (!root || !root.isDirectory()) {
-    Serial.println("Failed to open QSO directory");
-    return;
+/*
+ * Replay one day journal, calling fn for each live QSO in log order
+ * Returns false if fn stopped the walk
+ */
+bool forEachQSOLineInDay(const char* date, QSOLineVisitor fn, void* ctx) {
+  File file = SD.open(getLogFilename(date), FILE_READ);
+  if (!file) return true;
+
+  std::vector<JournalLatest> latest;
+  scanJournalLatest(file, latest);
+  file.seek(0);
+
+  char line[QSO_JOURNAL_LINE_MAX];
+  bool keepGoing = true;
+  while (keepGoing) {
+    uint32_t offset = file.position();
+    int len = readJournalLine(file, line, sizeof(line));
+    if (len < 0) break;
+    if (len == 0) continue;
+
+    char op;
+    unsigned long id;
+    if (peekJournalOp(line, &op, &id)) {
+      if (op == 'D') continue;
+      const JournalLatest* last = journalLatestFind(latest, id);
+      if (last != nullptr && (last->deleted || last->offset != offset)) continue;
+    }
+
+    JsonDocument doc;
+    if (deserializeJson(doc, line, len)) continue;  // torn/corrupt line
+    JsonObject obj = doc.as<JsonObject>();
+    if ((obj["op"] | "A")[0] == 'D') continue;
+    QSO qso;
+    jsonToQso(obj, qso);
+    keepGoing = fn(qso, offset, ctx);
   }
+  file.close();
+  return keepGoing;
+}
+
+struct QSOVisitorAdapter {
+  QSOVisitor fn;
+  void* ctx;
+};
+
+static bool qsoVisitorAdapter(const QSO& qso, uint32_t offset, void* ctx) {
+  QSOVisitorAdapter* a = (QSOVisitorAdapter*)ctx;
+  return a->fn(qso, a->ctx);
+}
+
+bool forEachQSOInDay(const char* date, QSOVisitor fn, void* ctx) {
+  QSOVisitorAdapter adapter = {fn, ctx};
+  return forEachQSOLineInDay(date, qsoVisitorAdapter, &adapter);
+}
+
+/*
+ * List the days that have a journal, ascending (YYYYMMDD as integers)
+ */
+void listQSODays(std::vector<uint32_t>& days) {
+  days.clear();
+  File root = SD.open(QSO_DIR);
+  if (!root || !root.isDirectory()) return;
 
-  int totalQSOs = 0;
   File file = root.openNextFile();
   while (file) {
-    String filename = file.name();
+    char date[9];
+    if (!file.isDirectory() && journalNameToDate(file.name(), date)) {
+      days.push_back((uint32_t)strtoul(date, nullptr, 10));
+    }
+    file.close();
+    file = root.openNextFile();
+  }
+  root.close();
+  std::sort(days.begin(), days.end());
+}
+
+/*
+ * Replay every day journal in date order
+ * Returns false if fn stopped the walk
+ */
+bool forEachQSO(QSOVisitor fn, void* ctx) {
+  std::vector<uint32_t> days;
+  listQSODays(days);
+  for (uint32_t day : days) {
+    char date[9];
+    snprintf(date, sizeof(date), "%08lu", (unsigned long)day);
+    if (!forEachQSOInDay(date, fn, ctx)) return false;
+  }
+  return true;
+}
+
+struct FindQSOCtx {
+  unsigned long id;
+  QSO* out;
+  bool found;
+};
+
+static bool findQSOVisitor(const QSO& qso, void* ctx) {
+  FindQSOCtx* f = (FindQSOCtx*)ctx;
+  if (qso.id != f->id) return true;
+  if (f->out) *f->out = qso;
+  f->found = true;
+  return false;
+}
 
-    // Only process JSON files
-    if (filename.endsWith(".json")) {
-      Serial.print("Processing: ");
-      Serial.println(filename);
+/*
+ * Look up a live QSO by id. date narrows the search to one day journal;
+ * pass null/"" to search every day.
+ */
+bool findQSO(const char* date, unsigned long id, QSO* out) {
+  FindQSOCtx ctx = {id, out, false};
+  if (date != nullptr && strlen(date) == 8) {
+    forEachQSOInDay(date, findQSOVisitor, &ctx);
+  } else {
+    forEachQSO(findQSOVisitor, &ctx);
+  }
+  return ctx.found;
+}
 
+/*
+ * Read the QSO whose journal line starts at offset (from the index).
+ * Falls back to a scan of the day if the line no longer holds that id.
+ */
+bool readQSOAt(const char* date, uint32_t offset, unsigned long id, QSO* out) {
+  File file = SD.open(getLogFilename(date), FILE_READ);
+  if (file) {
+    char line[QSO_JOURNAL_LINE_MAX];
+    bool ok = false;
+    if (file.seek(offset)) {
+      int len = readJournalLine(file, line, sizeof(line));
       JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, file);
-
-      if (!error) {
-        JsonArray logs = doc["logs"];
-        for (JsonObject logObj : logs) {
-          QSO qso;
-          jsonToQso(logObj, qso);
-          adifContent += qsoToADIFRecord(qso);
-          totalQSOs++;
+      if (len > 0 && !deserializeJson(doc, line, len)) {
+        JsonObject obj = doc.as<JsonObject>();
+        if ((obj["op"] | "A")[0] != 'D' && (obj["id"] | 0UL) == id) {
+          jsonToQso(obj, *out);
+          ok = true;
         }
       }
     }
+    file.close();
+    if (ok) return true;
+  }
+  return findQSO(date, id, out);
+}
 
+struct CompactCtx {
+  File* out;
+  int count;
+};
+
+static bool compactVisitor(const QSO& qso, uint32_t offset, void* ctx) {
+  CompactCtx* c = (CompactCtx*)ctx;
+  JsonDocument doc;
+  doc["op"] = "A";
+  JsonObject obj = doc.as<JsonObject>();
+  qsoToJson(qso, obj);
+  c->out->write('\n');
+  qsoIndexSetOffset(qso, c->out->position());
+  serializeJson(doc, *c->out);
+  c->count++;
+  return true;
+}
+
+/*
+ * Rewrite a day journal with only its live records (drops superseded lines
+ * and tombstones). Removes the journal if the day is now empty.
+ */
+bool compactJournal(const char* date) {
+  String filename = getLogFilename(date);
+  String tmpName = filename + ".tmp";
+
+  File out = SD.open(tmpName, FILE_WRITE);
+  if (!out) return false;
+  CompactCtx ctx = {&out, 0};
+  forEachQSOLineInDay(date, compactVisitor, &ctx);
+  out.close();
+
+  if (ctx.count == 0) {
+    SD.remove(tmpName);
+    SD.remove(filename);
+  } else {
+    // Keep the old journal until the compacted one is in place
+    String oldName = filename + ".old";
+    SD.remove(oldName);
+    SD.rename(filename, oldName);
+    if (!SD.rename(tmpName, filename)) {
+      SD.rename(oldName, filename);
+      Serial.println("Journal compaction rename failed");
+      return false;
+    }
+    SD.remove(oldName);
+  }
+
+  journalDayCountSet(date, 0);
+  Serial.printf("Compacted journal %s: %d QSOs\n", date, ctx.count);
+  return true;
+}
+
+/*
+ * Compact a day journal once enough lines have been superseded. The count
+ * comes from one scan per day per session; appendJournalOp() keeps it up
+ * to date after that, so an edit doesn't reread the day.
+ */
+void maybeCompactJournal(const char* date) {
+  JournalDayCount* c = journalDayCountFind(date);
+  if (c == nullptr) {
+    File file = SD.open(getLogFilename(date), FILE_READ);
+    if (!file) return;
+    std::vector<JournalLatest> latest;
+    int superseded = scanJournalLatest(file, latest);
+    file.close();
+    c = journalDayCountSet(date, superseded);
+  }
+  if (c->superseded >= QSO_COMPACT_THRESHOLD) {
+    compactJournal(date);
+  }
+}
+
+/*
+ * Convert pre-journal day files (qso_YYYYMMDD.json, {"logs":[...]}) into
+ * journals. The original is kept as .json.bak.
+ * Returns true if anything was migrated.
+ */
+bool migrateLegacyQSOFiles() {
+  File root = SD.open(QSO_DIR);
+  if (!root || !root.isDirectory()) return false;
+
+  std::vector<String> legacy;
+  File file = root.openNextFile();
+  while (file) {
+    String name = String(file.name());
+    int lastSlash = name.lastIndexOf('/');
+    if (lastSlash >= 0) name = name.substring(lastSlash + 1);
+    if (!file.isDirectory() && name.startsWith("qso_") && name.endsWith(".json")) {
+      legacy.push_back(name);
+    }
     file.close();
     file = root.openNextFile();
   }
   root.close();
 
-  // Write master ADIF file (use "w" mode to truncate)
-  File adifFile = SD.open(MASTER_ADIF_FILE, "w");
-  if (!adifFile) {
-    Serial.println("Failed to create master ADIF file");
-    return;
+  for (const String& name : legacy) {
+    String path = String(QSO_DIR) + "/" + name;
+    String date = name.substring(4, 12);
+
+    File in = SD.open(path, FILE_READ);
+    if (!in) continue;
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, in);
+    in.close();
+    if (error) {
+      Serial.printf("Legacy QSO file %s unreadable: %s\n", name.c_str(), error.c_str());
+      continue;
+    }
+
+    int count = 0;
+    for (JsonObject logObj : doc["logs"].as<JsonArray>()) {
+      QSO qso;
+      jsonToQso(logObj, qso);
+      if (appendJournalOp(date.c_str(), 'A', &qso, qso.id)) count++;
+    }
+    SD.rename(path, path + ".bak");
+    Serial.printf("Migrated %s: %d QSOs\n", name.c_str(), count);
   }
+  return !legacy.empty();
+}
 
-  adifFile.print(adifContent);
-  adifFile.close();
+static bool indexRebuildVisitor(const QSO& qso, uint32_t offset, void* ctx) {
+  QSOIndexRecord rec;
+  qsoIndexMakeRecord(qso, offset, rec);
+  ((std::vector<QSOIndexRecord>*)ctx)->push_back(rec);
+  return true;
+}
 
-  Serial.print("Master ADIF generated: ");
-  Serial.print(totalQSOs);
-  Serial.println(" QSOs");
+/*
+ * Rebuild the QSO index from every day journal
+ */
+void rebuildQSOIndex() {
+  Serial.println("Rebuilding QSO index...");
+
+  std::vector<QSOIndexRecord> records;
+  std::vector<uint32_t> days;
+  listQSODays(days);
+  for (uint32_t day : days) {
+    char date[9];
+    snprintf(date, sizeof(date), "%08lu", (unsigned long)day);
+    forEachQSOLineInDay(date, indexRebuildVisitor, &records);
+  }
+  qsoIndexWriteAll(records);
+
+  Serial.printf("QSO index rebuilt: %u QSOs\n", (unsigned)records.size());
 }
 
 /*
- * Regenerate ADIF files after any QSO change
+ * Make sure the QSO index is usable, rebuilding it if an update failed
  */
-void regenerateADIFFiles(const char* date) {
-  generateDailyADIF(date);
-  generateMasterADIF();
+bool ensureQSOIndex() {
+  if (qsoIndexValid()) return true;
+  if (!isQSOStorageReady()) return false;
+  rebuildQSOIndex();
+  return qsoIndexValid();
 }
 
 // ============================================
-// QSO Storage Operations (SD Card)
+// ADIF Files (derived from the journals)
 // ============================================
+//
+// New QSOs are appended to the daily and master .adi files, so a save costs
+// the same no matter how big the log is. Edits and deletes rewrite only the
+// affected day and remove the master file; a missing master means "stale"
+// and it is rebuilt on demand by ensureMasterADIF() (e.g. at export time).
+// Rewrites go through AtomicFileWriter, so a power cut mid-rebuild leaves
+// the previous copy (or none) rather than a truncated file.
+
+static bool adifWriteVisitor(const QSO& qso, void* ctx) {
+  writeADIFRecord(*(Print*)ctx, qso);
+  return true;
+}
+
+String getDailyADIFFilename(const char* date) {
+  char adifPath[40];
+  snprintf(adifPath, sizeof(adifPath), "%s/qso_%s.adi", QSO_DIR, date);
+  return String(adifPath);
+}
 
 /*
- * Get filename for a QSO log (based on date)
+ * Generate daily ADIF file for a specific date
  */
-String getLogFilename(const char* date) {
-  char filename[40];
-  snprintf(filename, sizeof(filename), "%s/qso_%s.json", QSO_DIR, date);
-  return String(filename);
+void generateDailyADIF(const char* date) {
+  if (!sdCardAvailable) return;
+
+  String adifPath = getDailyADIFFilename(date);
+  sdQueueDiscard(adifPath.c_str());  // Rebuilt from the journal below
+
+  if (!SD.exists(getLogFilename(date))) {
+    atomicFileRemove(SD, adifPath.c_str());  // Day emptied by deletes
+    return;
+  }
+
+  AtomicFileWriter adifFile(SD, adifPath.c_str(), ATOMIC_FORMAT_PLAIN);
+  if (!adifFile.begin()) {
+    Serial.println("Failed to create ADIF file");
+    return;
+  }
+  Print& out = adifFile;
+  writeADIFHeader(out);
+  forEachQSOInDay(date, adifWriteVisitor, &out);
+  if (!adifFile.commit()) {
+    Serial.println("Failed to write ADIF file");
+    return;
+  }
+
+  Serial.print("Daily ADIF generated: ");
+  Serial.println(adifPath);
 }
 
 /*
- * Save a QSO to SD card storage
+ * Generate master ADIF file containing all QSOs
  */
-bool saveQSO(const QSO& qso) {
-  if (!isQSOStorageReady()) {
-    Serial.println("ERROR: QSO storage not ready (SD card required)");
-    return false;
+void generateMasterADIF() {
+  if (!sdCardAvailable) return;
+
+  Serial.println("Generating master ADIF file...");
+  sdQueueDiscard(MASTER_ADIF_FILE);
+
+  AtomicFileWriter adifFile(SD, MASTER_ADIF_FILE, ATOMIC_FORMAT_PLAIN);
+  if (!adifFile.begin()) {
+    Serial.println("Failed to create master ADIF file");
+    return;
+  }
+  Print& out = adifFile;
+  writeADIFHeader(out);
+  forEachQSO(adifWriteVisitor, &out);
+  if (!adifFile.commit()) {
+    Serial.println("Failed to write master ADIF file");
+    return;
   }
 
-  Serial.print("Saving QSO: ");
-  Serial.println(qso.callsign);
+  Serial.println("Master ADIF generated");
+}
 
-  // Get filename based on date
-  String filename = getLogFilename(qso.date);
-  Serial.print("Filename: ");
-  Serial.println(filename);
+/*
+ * Whether the master ADIF file can be served as-is: present, with no
+ * appends still waiting in the SD write queue. Only reads the card, so
+ * it is safe from the web task.
+ */
+bool masterADIFCurrent() {
+  return sdCardAvailable && !sdQueuePending(MASTER_ADIF_FILE) && SD.exists(MASTER_ADIF_FILE);
+}
 
-  // Load existing logs for this day (if any)
-  JsonDocument doc;
-  JsonArray logs;
-
-  if (SD.exists(filename)) {
-    File file = SD.open(filename, "r");
-    if (file) {
-      DeserializationError error = deserializeJson(doc, file);
-      file.close();
-      if (!error) {
-        logs = doc["logs"].as<JsonArray>();
-      }
-    }
+/*
+ * Make sure the master ADIF file exists and is current. A rewrite cut
+ * short is finished or rolled back first; no usable copy counts as stale.
+ * Returns false if it could not be generated
+ */
+bool ensureMasterADIF() {
+  if (!sdCardAvailable) return false;
+  sdQueueFlushPath(MASTER_ADIF_FILE);
+  AtomicFileStatus status = atomicFileRecover(SD, MASTER_ADIF_FILE);
+  if (status == ATOMIC_FILE_MISSING || status == ATOMIC_FILE_CORRUPT) {
+    generateMasterADIF();
   }
+  return SD.exists(MASTER_ADIF_FILE);
+}
+
+// A failed master append leaves it incomplete; drop it so
+// ensureMasterADIF() rebuilds it from the journals
+static void masterADIFCommitted(bool ok, void* ctx) {
+  if (!ok) atomicFileRemove(SD, MASTER_ADIF_FILE);
+}
 
-  // If doc is empty, create new structure
-  if (logs.isNull()) {
-    logs = doc["logs"].to<JsonArray>();
+/*
+ * Append a newly saved QSO to the daily and master ADIF files.
+ * Both are derived from the journal, so the appends go through the SD
+ * write queue and commit together once audio is idle.
+ */
+void appendADIFRecord(const QSO& qso) {
+  if (!sdCardAvailable) return;
+
+  // Daily file: rebuild from the journal if missing (first QSO of the day
+  // or a previously emptied day), otherwise append
+  String adifPath = getDailyADIFFilename(qso.date);
+  if (!SD.exists(adifPath)) {
+    generateDailyADIF(qso.date);
+  } else {
+    SDQueuedPrint adifFile(adifPath.c_str());
+    writeADIFRecord(adifFile, qso);
   }
 
-  // Add new QSO
-  JsonObject newLog = logs.add<JsonObject>();
-  qsoToJson(qso, newLog);
+  // Master file: append only if it is current; a missing master is rebuilt
+  // lazily by ensureMasterADIF()
+  if (SD.exists(MASTER_ADIF_FILE)) {
+    SDQueuedPrint adifFile(MASTER_ADIF_FILE);
+    writeADIFRecord(adifFile, qso);
+    adifFile.commit(masterADIFCommitted);
+  }
+}
 
-  // Write back to file (use "w" mode to truncate and overwrite)
-  File file = SD.open(filename, "w");
-  if (!file) {
-    Serial.println("Failed to open log file for writing");
-    return false;
+/*
+ * Regenerate ADIF files after an edit or delete
+ * Rewrites the day's file and marks the master stale
+ */
+void regenerateADIFFiles(const char* date) {
+  generateDailyADIF(date);
+  if (sdCardAvailable) {
+    sdQueueDiscard(MASTER_ADIF_FILE);
+    atomicFileRemove(SD, MASTER_ADIF_FILE);
   }
+}
 
-  size_t bytesWritten = serializeJson(doc, file);
-  file.close();
+// ============================================
+// QSO Storage Operations (SD Card)
+// ============================================
 
-  Serial.print("Bytes written: ");
-  Serial.println(bytesWritten);
+/*
+ * Apply a QSO's band/mode to the cached statistics (delta = +1 or -1)
+ */
+void applyQSOToStats(const QSO& qso, int delta) {
+  qsoAggApply(qso, delta);
 
-  // Update metadata
-  storageStats.totalLogs++;
-  if (storageStats.newestLogId == 0 || qso.id > storageStats.newestLogId) {
-    storageStats.newestLogId = qso.id;
-  }
-  if (storageStats.oldestLogId == 0 || qso.id < storageStats.oldestLogId) {
-    storageStats.oldestLogId = qso.id;
-  }
+  storageStats.totalLogs += delta;
+  if (storageStats.totalLogs < 0) storageStats.totalLogs = 0;
 
-  // Update band statistics
   int bandIdx = getBandIndex(qso.band);
-  if (bandIdx >= 0) {
-    storageStats.logsByBand[bandIdx]++;
+  if (bandIdx >= 0 && storageStats.logsByBand[bandIdx] + delta >= 0) {
+    storageStats.logsByBand[bandIdx] += delta;
   }
-
-  // Update mode statistics
   int modeIdx = getModeIndex(qso.mode);
-  if (modeIdx >= 0) {
-    storageStats.logsByMode[modeIdx]++;
+  if (modeIdx >= 0 && storageStats.logsByMode[modeIdx] + delta >= 0) {
+    storageStats.logsByMode[modeIdx] += delta;
   }
 
+  if (delta > 0) {
+    if (storageStats.newestLogId == 0 || qso.id > storageStats.newestLogId) {
+      storageStats.newestLogId = qso.id;
+    }
+    if (storageStats.oldestLogId == 0 || qso.id < storageStats.oldestLogId) {
+      storageStats.oldestLogId = qso.id;
+    }
+  }
+}
+
+/*
+ * Persist cached statistics after a save/edit/delete. The SPIFFS metadata
+ * is small and written now; the statistics snapshot is deferred.
+ */
+void commitQSOStats() {
   saveMetadata();
+  markQSOAggregatesDirty();
+  markDeferredSave(saveQSOAggregates);
+}
 
-  // Regenerate ADIF files
-  regenerateADIFFiles(qso.date);
+/*
+ * Save a QSO to SD card storage (single journal append)
+ * qso.id is bumped if the day already uses it
+ */
+bool saveQSO(QSO& qso) {
+  if (!isQSOStorageReady()) {
+    Serial.println("ERROR: QSO storage not ready (SD card required)");
+    return false;
+  }
+
+  Serial.print("Saving QSO: ");
+  Serial.println(qso.callsign);
+
+  std::vector<unsigned long> ids;
+  loadJournalIds(qso.date, ids);
+  unsigned long id = journalTakeId(ids, qso.id);
+  if (id != qso.id) {
+    Serial.printf("QSO id %lu already used on %s, saving as %lu\n", qso.id, qso.date, id);
+    qso.id = id;
+  }
+
+  uint32_t offset;
+  if (!appendJournalOp(qso.date, 'A', &qso, qso.id, &offset)) {
+    Serial.println("Failed to append QSO to journal");
+    return false;
+  }
+
+  QSOIndexRecord rec;
+  qsoIndexMakeRecord(qso, offset, rec);
+  if (!qsoIndexInsert(rec)) {
+    qsoIndexInvalidate();  // Rebuilt by the next ensureQSOIndex()
+  }
+
+  applyQSOToStats(qso, +1);
+  qsoDupeApply(qso, +1);
+  commitQSOStats();
+
+  // Append to the ADIF files (no full regeneration)
+  appendADIFRecord(qso);
 
   Serial.println("QSO saved successfully");
 
@@ -680,227 +1264,230 @@ bool saveQSO(const QSO& qso) {
   return true;
 }
 
+// ============================================
+// Bulk Import
+// ============================================
+//
+// Imports append QSOs in batches: one journal open per run of same-day
+// QSOs, and the index, daily ADIF files and statistics snapshot are
+// brought up to date once in endQSOImport() rather than per QSO.
+
+static std::vector<uint32_t> importDays;  // Days touched by the running import
+
 /*
- * Load all QSOs from SD card storage (for viewing/exporting)
- * Returns number of logs loaded
+ * Start a bulk import
  */
-int loadAllQSOs(QSO* qsos, int maxCount) {
+bool beginQSOImport() {
   if (!isQSOStorageReady()) {
-    Serial.println("ERROR: QSO storage not ready");
-    return 0;
+    Serial.println("ERROR: QSO storage not ready (SD card required)");
+    return false;
   }
+  importDays.clear();
+  return true;
+}
 
-  Serial.println("Loading all QSOs from SD card...");
+/*
+ * Append a batch of QSOs (call between beginQSOImport/endQSOImport)
+ * Returns the number saved
+ */
+int saveQSOBatch(const QSO* qsos, int count) {
+  if (!isQSOStorageReady() || count <= 0) return 0;
+
+  // The index is rebuilt at the end; drop it now so an interrupted
+  // import (or a rebuild that ran mid-import) is never trusted
+  qsoIndexInvalidate();
+
+  static char line[QSO_JOURNAL_LINE_MAX];
+  int saved = 0;
+  int i = 0;
+  while (i < count) {
+    File file = SD.open(getLogFilename(qsos[i].date), FILE_APPEND);
+    if (!file) {
+      Serial.println("Failed to open journal for append");
+      break;
+    }
 
-  int count = 0;
-  File root = SD.open(QSO_DIR);
-  if (!root || !root.isDirectory()) {
-    Serial.println("Failed to open QSO directory");
-    return 0;
+    uint32_t day = (uint32_t)strtoul(qsos[i].date, nullptr, 10);
+    auto it = std::lower_bound(importDays.begin(), importDays.end(), day);
+    if (it == importDays.end() || *it != day) importDays.insert(it, day);
+
+    // Everything for this day in one open
+    int runStart = i;
+    for (; i < count && strcmp(qsos[i].date, qsos[runStart].date) == 0; i++) {
+      size_t len = formatJournalOp('A', &qsos[i], qsos[i].id, line, sizeof(line));
+      if (len == 0 || file.write((const uint8_t*)line, len) != len) continue;
+      applyQSOToStats(qsos[i], +1);
+      qsoDupeApply(qsos[i], +1);
+      saved++;
+    }
+    file.close();
   }
+  return saved;
+}
 
-  File file = root.openNextFile();
-  while (file && count < maxCount) {
-    String filename = file.name();
+/*
+ * Finish a bulk import: rebuild the index, regenerate the touched daily
+ * ADIF files and persist statistics
+ */
+void endQSOImport() {
+  qsoIndexInvalidate();
+  rebuildQSOIndex();
+
+  for (uint32_t day : importDays) {
+    char date[9];
+    snprintf(date, sizeof(date), "%08lu", (unsigned long)day);
+    generateDailyADIF(date);
+  }
+  if (!importDays.empty()) {
+    sdQueueDiscard(MASTER_ADIF_FILE);
+    atomicFileRemove(SD, MASTER_ADIF_FILE);  // Stale; rebuilt by ensureMasterADIF()
+  }
+  importDays.clear();
 
-    // Only process QSO log files (qso_YYYYMMDD.json)
-    if (filename.endsWith(".json")) {
-      Serial.print("Reading: ");
-      Serial.println(filename);
+  commitQSOStats();
+}
 
-      // Parse JSON
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, file);
-
-      if (!error) {
-        JsonArray logs = doc["logs"];
-        for (JsonObject logObj : logs) {
-          if (count < maxCount) {
-            jsonToQso(logObj, qsos[count]);
-            count++;
-          } else {
-            break;
-          }
-        }
-      } else {
-        Serial.print("Failed to parse: ");
-        Serial.println(error.c_str());
-      }
-    }
+struct LoadAllCtx {
+  QSO* qsos;
+  int maxCount;
+  int count;
+};
 
-    file.close();
-    file = root.openNextFile();
+static bool loadAllVisitor(const QSO& qso, void* ctx) {
+  LoadAllCtx* c = (LoadAllCtx*)ctx;
+  if (c->count >= c->maxCount) return false;
+  c->qsos[c->count++] = qso;
+  return true;
+}
+
+/*
+ * Load all QSOs from SD card storage (for viewing/exporting)
+ * Returns number of logs loaded
+ */
+int loadAllQSOs(QSO* qsos, int maxCount) {
+  if (!isQSOStorageReady()) {
+    Serial.println("ERROR: QSO storage not ready");
+    return 0;
   }
 
-  root.close();
+  LoadAllCtx ctx = {qsos, maxCount, 0};
+  forEachQSO(loadAllVisitor, &ctx);
 
   Serial.print("Loaded ");
-  Serial.print(count);
+  Serial.print(ctx.count);
   Serial.println(" QSOs");
 
-  return count;
+  return ctx.count;
 }
 
 /*
- * Delete a QSO by ID
+ * Delete a QSO from a known day (tombstone append)
  */
-bool deleteQSO(unsigned long id) {
+bool deleteQSOOnDate(const char* date, unsigned long id) {
   if (!isQSOStorageReady()) {
     Serial.println("ERROR: QSO storage not ready");
     return false;
   }
 
-  Serial.print("Deleting QSO ID: ");
-  Serial.println(id);
-
-  // Search through all log files
-  File root = SD.open(QSO_DIR);
-  if (!root || !root.isDirectory()) {
+  QSO old;
+  if (!findQSO(date, id, &old)) {
+    Serial.println("QSO not found");
     return false;
   }
 
-  bool found = false;
-  String deletedDate = "";
-  File file = root.openNextFile();
-
-  while (file && !found) {
-    String filename = file.name();
-
-    if (filename.endsWith(".json")) {
-      // Load file
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, file);
-      file.close();
-
-      if (!error) {
-        JsonArray logs = doc["logs"];
-
-        // Find and remove the QSO
-        for (size_t i = 0; i < logs.size(); i++) {
-          if (logs[i]["id"] == id) {
-            // Extract date for ADIF regeneration
-            const char* date = logs[i]["date"];
-            if (date) {
-              deletedDate = String(date);
-            }
-
-            // Remove from array
-            logs.remove(i);
-            found = true;
-
-            // Write back to file
-            String fullPath = String(QSO_DIR) + "/" + filename;
-            File outFile = SD.open(fullPath, FILE_WRITE);
-            if (outFile) {
-              serializeJson(doc, outFile);
-              outFile.close();
-
-              // Update metadata
-              storageStats.totalLogs--;
-              saveMetadata();
-
-              // Regenerate ADIF files
-              if (deletedDate.length() > 0) {
-                regenerateADIFFiles(deletedDate.c_str());
-              }
-
-              Serial.println("QSO deleted successfully");
-              root.close();
-              return true;
-            }
-            break;
-          }
-        }
-      }
-    } else {
-      file.close();
-    }
-
-    file = root.openNextFile();
+  if (!appendJournalOp(old.date, 'D', nullptr, id)) {
+    return false;
+  }
+  if (!qsoIndexRemove(old)) {
+    qsoIndexInvalidate();
   }
 
-  root.close();
+  applyQSOToStats(old, -1);
+  qsoDupeApply(old, -1);
+  commitQSOStats();
 
-  if (!found) {
-    Serial.println("QSO not found");
-  }
+  maybeCompactJournal(old.date);
+  regenerateADIFFiles(old.date);
 
-  return found;
+  Serial.println("QSO deleted successfully");
+  return true;
+}
+
+/*
+ * Delete a QSO by ID (searches every day)
+ */
+bool deleteQSO(unsigned long id) {
+  Serial.print("Deleting QSO ID: ");
+  Serial.println(id);
+  return deleteQSOOnDate(nullptr, id);
 }
 
 /*
  * Update an existing QSO
+ * If qso.date changed, the record moves to the new day's journal (under a
+ * new id if that day already uses this one).
  */
-bool updateQSO(const QSO& qso) {
+bool updateQSO(const QSO& edited) {
   if (!isQSOStorageReady()) {
     Serial.println("ERROR: QSO storage not ready");
     return false;
   }
 
   Serial.print("Updating QSO ID: ");
-  Serial.println(qso.id);
+  Serial.println(edited.id);
 
-  // Search through all log files
-  File root = SD.open(QSO_DIR);
-  if (!root || !root.isDirectory()) {
+  QSO old;
+  if (!findQSO(edited.date, edited.id, &old) && !findQSO(nullptr, edited.id, &old)) {
+    Serial.println("QSO not found for update");
     return false;
   }
 
-  bool found = false;
-  File file = root.openNextFile();
-
-  while (file && !found) {
-    String filename = file.name();
-
-    if (filename.endsWith(".json")) {
-      // Load file
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, file);
-      file.close();
-
-      if (!error) {
-        JsonArray logs = doc["logs"];
-
-        // Find and update the QSO
-        for (size_t i = 0; i < logs.size(); i++) {
-          if (logs[i]["id"] == qso.id) {
-            // Update the entry
-            JsonObject logObj = logs[i];
-            qsoToJson(qso, logObj);
-            found = true;
-
-            // Write back to file
-            String fullPath = String(QSO_DIR) + "/" + filename;
-            File outFile = SD.open(fullPath, FILE_WRITE);
-            if (outFile) {
-              serializeJson(doc, outFile);
-              outFile.close();
-
-              // Regenerate ADIF files
-              regenerateADIFFiles(qso.date);
-
-              Serial.println("QSO updated successfully");
-              root.close();
-              return true;
-            }
-            break;
-          }
-        }
+  QSO qso = edited;
+  uint32_t offset;
+  bool sameDay = strcmp(old.date, qso.date) == 0;
+  if (sameDay) {
+    if (!appendJournalOp(qso.date, 'U', &qso, qso.id, &offset)) return false;
+  } else {
+    // A new day may already use the id (see journalTakeId())
+    std::vector<unsigned long> ids;
+    loadJournalIds(qso.date, ids);
+    qso.id = journalTakeId(ids, qso.id);
+
+    // Add to the new day first; if the old day's tombstone then fails,
+    // tombstone the new copy so the QSO stays where it was
+    if (!appendJournalOp(qso.date, 'A', &qso, qso.id, &offset)) return false;
+    if (!appendJournalOp(old.date, 'D', nullptr, old.id)) {
+      if (!appendJournalOp(qso.date, 'D', nullptr, qso.id)) {
+        Serial.println("QSO move rollback failed - record is in both days");
+        qsoIndexInvalidate();
       }
-    } else {
-      file.close();
+      return false;
     }
-
-    file = root.openNextFile();
   }
 
-  root.close();
+  // Date/time may have changed, so re-slot the index record
+  QSOIndexRecord rec;
+  qsoIndexMakeRecord(qso, offset, rec);
+  if (!qsoIndexRemove(old) || !qsoIndexInsert(rec)) {
+    qsoIndexInvalidate();
+  }
 
-  if (!found) {
-    Serial.println("QSO not found for update");
+  if (!sameDay) {
+    maybeCompactJournal(old.date);
+    generateDailyADIF(old.date);
   }
 
-  return found;
+  applyQSOToStats(old, -1);
+  applyQSOToStats(qso, +1);
+  qsoDupeApply(old, -1);
+  qsoDupeApply(qso, +1);
+  commitQSOStats();
+
+  maybeCompactJournal(qso.date);
+  regenerateADIFFiles(qso.date);
+
+  Serial.println("QSO updated successfully");
+  return true;
 }
 
 /*
@@ -910,8 +1497,13 @@ int getTotalLogs() {
   return storageStats.totalLogs;
 }
 
+static bool recalcVisitor(const QSO& qso, void* ctx) {
+  applyQSOToStats(qso, +1);
+  return true;
+}
+
 /*
- * Recalculate metadata by scanning all QSO files
+ * Recalculate metadata and statistics by scanning all QSO files
  * Useful if metadata gets out of sync
  */
 void recalculateMetadata() {
@@ -920,54 +1512,10 @@ void recalculateMetadata() {
   Serial.println("Recalculating metadata from SD card...");
 
   memset(&storageStats, 0, sizeof(StorageStats));
-
-  File root = SD.open(QSO_DIR);
-  if (!root || !root.isDirectory()) {
-    return;
-  }
-
-  File file = root.openNextFile();
-  while (file) {
-    String filename = file.name();
-
-    if (filename.endsWith(".json")) {
-      JsonDocument doc;
-      DeserializationError error = deserializeJson(doc, file);
-
-      if (!error) {
-        JsonArray logs = doc["logs"];
-        for (JsonObject logObj : logs) {
-          storageStats.totalLogs++;
-
-          unsigned long id = logObj["id"] | 0;
-          if (storageStats.oldestLogId == 0 || id < storageStats.oldestLogId) {
-            storageStats.oldestLogId = id;
-          }
-          if (id > storageStats.newestLogId) {
-            storageStats.newestLogId = id;
-          }
-
-          const char* band = logObj["band"] | "";
-          int bandIdx = getBandIndex(band);
-          if (bandIdx >= 0) {
-            storageStats.logsByBand[bandIdx]++;
-          }
-
-          const char* mode = logObj["mode"] | "";
-          int modeIdx = getModeIndex(mode);
-          if (modeIdx >= 0) {
-            storageStats.logsByMode[modeIdx]++;
-          }
-        }
-      }
-    }
-
-    file.close();
-    file = root.openNextFile();
-  }
-
-  root.close();
+  resetQSOAggregates();
+  forEachQSO(recalcVisitor, nullptr);
   saveMetadata();
+  saveQSOAggregates();
 
   Serial.print("Recalculated: ");
   Serial.print(storageStats.totalLogs);
@@ -97,6 +97,17 @@ void drawQSOLogEntryUI(LGFX& tft) {
   tft.setCursor(18, cardY + 12);
   tft.print(fieldLabels[currentField]);
 
+  // Dupe / worked-before status for the callsign being entered
+  if (currentField == FIELD_CALLSIGN && strlen(logEntryState.callsign) >= 3) {
+    String band = frequencyToBand(atof(logEntryState.frequency));
+    QSODupeStatus status = checkQSODupe(logEntryState.callsign, band.c_str(),
+                                        QSO_MODES[logEntryState.modeIndex], logEntryState.date);
+    tft.setTextColor(status == QSO_DUPE_DUPE ? ST77XX_RED :
+                     status == QSO_DUPE_NEW ? ST77XX_GREEN : COLOR_WARNING);
+    tft.setCursor(230, cardY + 12);
+    tft.print(status == QSO_DUPE_NEW ? "New" : qsoDupeStatusText(status));
+  }
+
   // Field value (larger text)
   tft.setTextSize(2);
   tft.setTextColor(ST77XX_WHITE);
@@ -246,6 +246,24 @@ String formatCurrentDateTime() {
   return String("");
 }
 
+/*
+ * Unix time (UTC) for a QSO date YYYYMMDD and time HHMM
+ */
+unsigned long qsoDateTimeToEpoch(const char* date, const char* timeOn) {
+  unsigned long ymd = strtoul(date, nullptr, 10);
+  int hhmm = atoi(timeOn);
+  int y = ymd / 10000, m = (ymd / 100) % 100, d = ymd % 100;
+
+  // Days since 1970-01-01 (proleptic Gregorian)
+  y -= m <= 2;
+  long era = (y >= 0 ? y : y - 399) / 400;
+  long yoe = y - era * 400;
+  long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  long days = era * 146097 + yoe * 365 + yoe / 4 - yoe / 100 + doy - 719468;
+
+  return (unsigned long)days * 86400UL + (hhmm / 100) * 3600UL + (hhmm % 100) * 60UL;
+}
+
 /*
  * Format current date/time into separate buffers
  * dateOut: buffer for date in YYYYMMDD format (at least 9 chars)
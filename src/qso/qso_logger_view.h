@@ -17,170 +17,142 @@ enum ViewMode {
   VIEW_MODE_DELETE_CONFIRM = 2
 };
 
+// QSOs are paged in from the on-SD index, QSO_VIEW_PAGE_SIZE at a time,
+// so memory use does not grow with the size of the log
+#define QSO_VIEW_PAGE_SIZE 20
+
 struct ViewState {
   ViewMode mode;
   int selectedIndex;        // Currently selected QSO in list
   int scrollOffset;         // Top visible item in list
-  int totalQSOs;           // Total number of QSOs loaded
-  QSO* qsos;               // Array of loaded QSOs (dynamically allocated)
+  int totalQSOs;           // Total number of QSOs in the index
+  QSO* qsos;               // Current page of QSOs (dynamically allocated)
   int detailScrollOffset;  // Scroll position in detail view
   bool deleteConfirm;      // Waiting for delete confirmation
+  int pageStart;           // Index of qsos[0] in the full list
+  int pageCount;           // Valid entries in qsos
+  QSOIndexCursor pageFirst;  // Index keys of qsos[0] and the last entry
+  QSOIndexCursor pageLast;
 };
 
-ViewState viewState = {VIEW_MODE_LIST, 0, 0, 0, nullptr, 0, false};
+ViewState viewState = {VIEW_MODE_LIST, 0, 0, 0, nullptr, 0, false, 0, 0, {}, {}};
 
 // Forward declarations
 void loadQSOsForView();
 void freeQSOsFromView();
+const QSO* getViewQSO(int index);
 
-// Load all QSOs from storage into memory
+// Count QSOs and allocate the page buffer (rows are read by getViewQSO())
 void loadQSOsForView() {
   Serial.println("Loading QSOs for view...");
 
-  // First, count total QSOs
-  int totalCount = 0;
-  File root = SD.open("/qso");
-  if (!root || !root.isDirectory()) {
-    Serial.println("Failed to open /qso directory");
-    return;
+  // Free any existing allocation before allocating new
+  if (viewState.qsos != nullptr) {
+    delete[] viewState.qsos;
+    viewState.qsos = nullptr;
   }
+  viewState.pageStart = 0;
+  viewState.pageCount = 0;
+  viewState.totalQSOs = 0;
 
-  // Count QSOs across all daily log files
-  File file = root.openNextFile();
-  while (file) {
-    if (!file.isDirectory()) {
-      String filename = String(file.name());
-      Serial.print("Checking file: ");
-      Serial.println(filename);
-
-      // Extract just the filename from full path if needed
-      int lastSlash = filename.lastIndexOf('/');
-      if (lastSlash >= 0) {
-        filename = filename.substring(lastSlash + 1);
-      }
-
-      Serial.print("  Basename: ");
-      Serial.println(filename);
-
-      if (filename.startsWith("qso_") && filename.endsWith(".json")) {
-        Serial.println("  -> Loading this file");
-        // Load this file and count entries
-        File logFile = SD.open(file.path(), "r");
-        if (logFile) {
-          String content = logFile.readString();
-          logFile.close();
-
-          Serial.print("    File content length: ");
-          Serial.println(content.length());
-          Serial.print("    First 200 chars: ");
-          Serial.println(content.substring(0, min(200, (int)content.length())));
-
-          StaticJsonDocument<8192> doc;
-          DeserializationError error = deserializeJson(doc, content);
-
-          Serial.print("    JSON parse result: ");
-          Serial.println(error.c_str());
-          Serial.print("    Contains 'logs' key: ");
-          Serial.println(doc.containsKey("logs") ? "YES" : "NO");
-
-          if (!error && doc.containsKey("logs")) {
-            JsonArray qsos = doc["logs"].as<JsonArray>();
-            int qsoCount = qsos.size();
-            Serial.print("    Found ");
-            Serial.print(qsoCount);
-            Serial.println(" QSOs in this file");
-            totalCount += qsoCount;
-          } else {
-            Serial.print("    JSON error or no qsos key: ");
-            Serial.println(error.c_str());
-          }
-        }
-      }
-    }
-    file = root.openNextFile();
+  if (!ensureQSOIndex()) {
+    Serial.println("ERROR: QSO index unavailable");
+    return;
   }
-  root.close();
+
+  int totalCount = (int)qsoIndexCount();
 
   Serial.print("Total QSOs found: ");
   Serial.println(totalCount);
 
   if (totalCount == 0) {
-    viewState.totalQSOs = 0;
-    viewState.qsos = nullptr;
     return;
   }
 
-  // Free any existing allocation before allocating new
-  if (viewState.qsos != nullptr) {
-    delete[] viewState.qsos;
-    viewState.qsos = nullptr;
-  }
-
-  // Allocate memory for QSOs
-  viewState.qsos = new QSO[totalCount];
+  viewState.qsos = new QSO[QSO_VIEW_PAGE_SIZE];
   if (viewState.qsos == nullptr) {
     Serial.println("ERROR: Failed to allocate memory for QSOs");
-    viewState.totalQSOs = 0;
     return;
   }
   viewState.totalQSOs = totalCount;
-  Serial.printf("Allocated memory for %d QSOs at %p\n", totalCount, viewState.qsos);
-
-  // Initialize all QSOs to zero
-  memset(viewState.qsos, 0, sizeof(QSO) * totalCount);
+}
 
-  // Load QSOs into array
-  int qsoIndex = 0;
-  root = SD.open("/qso");
-  if (!root || !root.isDirectory()) {
-    Serial.println("ERROR: Failed to reopen /qso directory for loading");
-    delete[] viewState.qsos;
-    viewState.qsos = nullptr;
-    viewState.totalQSOs = 0;
-    return;
+// Fill the page from index records, oldest first
+static void fillViewPage(int start, const QSOIndexRecord* recs, int n) {
+  viewState.pageStart = start;
+  viewState.pageCount = 0;
+  for (int i = 0; i < n; i++) {
+    char date[9];
+    qsoIndexDateString(recs[i], date);
+    QSO& qso = viewState.qsos[viewState.pageCount];
+    memset(&qso, 0, sizeof(QSO));
+    if (!readQSOAt(date, recs[i].offset, recs[i].id, &qso)) {
+      // Journal and index disagree - show what the index knows
+      qso.id = recs[i].id;
+      strlcpy(qso.date, date, sizeof(qso.date));
+      snprintf(qso.time_on, sizeof(qso.time_on), "%04u", (unsigned)recs[i].time);
+      qsoIndexField(recs[i].callsign, sizeof(recs[i].callsign), qso.callsign, sizeof(qso.callsign));
+      qsoIndexField(recs[i].band, sizeof(recs[i].band), qso.band, sizeof(qso.band));
+      qsoIndexField(recs[i].mode, sizeof(recs[i].mode), qso.mode, sizeof(qso.mode));
+    }
+    viewState.pageCount++;
   }
-  file = root.openNextFile();
-
-  while (file && qsoIndex < totalCount) {
-    if (!file.isDirectory()) {
-      String filename = String(file.name());
-
-      // Extract just the filename from full path if needed
-      int lastSlash = filename.lastIndexOf('/');
-      if (lastSlash >= 0) {
-        filename = filename.substring(lastSlash + 1);
-      }
-
-      if (filename.startsWith("qso_") && filename.endsWith(".json")) {
-        File logFile = SD.open(file.path(), "r");
-        if (logFile) {
-          String content = logFile.readString();
-          logFile.close();
-
-          StaticJsonDocument<8192> doc;
-          DeserializationError error = deserializeJson(doc, content);
-
-          if (!error && doc.containsKey("logs")) {
-            JsonArray qsos = doc["logs"].as<JsonArray>();
-            for (JsonObject qsoObj : qsos) {
-              if (qsoIndex >= totalCount) break;
-
-              // Use the standard jsonToQso function to load all fields
-              jsonToQso(qsoObj, viewState.qsos[qsoIndex]);
+  if (n > 0) {
+    qsoIndexCursorFrom(recs[0], viewState.pageFirst);
+    qsoIndexCursorFrom(recs[n - 1], viewState.pageLast);
+  }
+}
 
-              qsoIndex++;
-            }
-          }
-        }
-      }
+// Read the page holding list position `index`. The pages either side of the
+// current one are read by key from its first/last row, so QSOs saved or
+// deleted meanwhile don't make rows skip or repeat; other jumps start from
+// a list position.
+static void loadViewPage(int index) {
+  static QSOIndexRecord recs[QSO_VIEW_PAGE_SIZE];  // Static: called from LVGL callbacks
+  QSOIndexCursor cursor;
+  int pageEnd = viewState.pageStart + viewState.pageCount;
+
+  if (viewState.pageCount > 0 && index >= pageEnd && index < pageEnd + QSO_VIEW_PAGE_SIZE) {
+    cursor = viewState.pageLast;
+    int n = qsoIndexQueryLoop(nullptr, &cursor, false, recs, QSO_VIEW_PAGE_SIZE);
+    if (n > 0) {
+      fillViewPage(pageEnd, recs, n);
+      return;
+    }
+  } else if (viewState.pageCount > 0 && index < viewState.pageStart &&
+             index >= viewState.pageStart - QSO_VIEW_PAGE_SIZE) {
+    // Scrolling up: the new page ends just above the current one
+    cursor = viewState.pageFirst;
+    int n = qsoIndexQueryLoop(nullptr, &cursor, true, recs, QSO_VIEW_PAGE_SIZE);
+    std::reverse(recs, recs + n);
+    int start = viewState.pageStart - n;
+    if (n > 0 && start >= 0 && index >= start) {
+      fillViewPage(start, recs, n);
+      return;
     }
-    file = root.openNextFile();
   }
-  root.close();
 
-  Serial.print("Loaded ");
-  Serial.print(qsoIndex);
-  Serial.println(" QSOs into memory");
+  // Jump: keep the requested row at the bottom when scrolling up
+  int start = (index < viewState.pageStart) ? index - QSO_VIEW_PAGE_SIZE + 1 : index;
+  if (start < 0) start = 0;
+  int n = 0;
+  if (qsoIndexCursorAt((uint32_t)start, cursor)) {
+    n = qsoIndexQueryLoop(nullptr, &cursor, false, recs, QSO_VIEW_PAGE_SIZE);
+  }
+  fillViewPage(start, recs, n);
+}
+
+// Get a QSO by list position, paging it in if needed (nullptr if out of range)
+const QSO* getViewQSO(int index) {
+  if (index < 0 || index >= viewState.totalQSOs || viewState.qsos == nullptr) {
+    return nullptr;
+  }
+  if (index < viewState.pageStart || index >= viewState.pageStart + viewState.pageCount) {
+    loadViewPage(index);
+  }
+  int slot = index - viewState.pageStart;
+  if (slot < 0 || slot >= viewState.pageCount) return nullptr;
+  return &viewState.qsos[slot];
 }
 
 // Free QSO memory when exiting view
@@ -190,6 +162,8 @@ void freeQSOsFromView() {
     viewState.qsos = nullptr;
   }
   viewState.totalQSOs = 0;
+  viewState.pageStart = 0;
+  viewState.pageCount = 0;
 }
 
 // Delete the currently viewed QSO from storage
@@ -198,90 +172,18 @@ bool deleteCurrentQSO() {
     return false;
   }
 
-  QSO& qsoToDelete = viewState.qsos[viewState.selectedIndex];
+  const QSO* selected = getViewQSO(viewState.selectedIndex);
+  if (selected == nullptr) {
+    return false;
+  }
+  QSO qsoToDelete = *selected;
 
   Serial.print("Deleting QSO: ");
   Serial.print(qsoToDelete.callsign);
   Serial.print(" ID: ");
   Serial.println(qsoToDelete.id);
 
-  // Get the log filename for this QSO's date
-  String filename = getLogFilename(qsoToDelete.date);
-
-  if (!SD.exists(filename)) {
-    Serial.println("Log file doesn't exist!");
-    return false;
-  }
-
-  // Read the entire log file
-  File file = SD.open(filename, "r");
-  if (!file) {
-    Serial.println("Failed to open log file for reading");
-    return false;
-  }
-
-  String content = file.readString();
-  file.close();
-
-  // Parse JSON
-  StaticJsonDocument<8192> doc;
-  DeserializationError error = deserializeJson(doc, content);
-
-  if (error) {
-    Serial.print("Failed to parse JSON: ");
-    Serial.println(error.c_str());
-    return false;
-  }
-
-  if (!doc.containsKey("logs")) {
-    Serial.println("No logs array found");
-    return false;
-  }
-
-  // Create new array without the deleted QSO
-  JsonArray oldLogs = doc["logs"].as<JsonArray>();
-  StaticJsonDocument<8192> newDoc;
-  JsonArray newLogs = newDoc.createNestedArray("logs");
-
-  int removedCount = 0;
-  for (JsonObject qsoObj : oldLogs) {
-    unsigned long id = qsoObj["id"] | 0;
-    if (id != qsoToDelete.id) {
-      // Keep this QSO
-      newLogs.add(qsoObj);
-    } else {
-      // Skip this QSO (delete it)
-      removedCount++;
-      Serial.print("Removed QSO with ID: ");
-      Serial.println(id);
-    }
-  }
-
-  if (removedCount == 0) {
-    Serial.println("QSO not found in file!");
-    return false;
-  }
-
-  // Write back to file
-  file = SD.open(filename, "w");
-  if (!file) {
-    Serial.println("Failed to open log file for writing");
-    return false;
-  }
-
-  serializeJson(newDoc, file);
-  file.close();
-
-  // Update metadata to decrement total count
-  if (storageStats.totalLogs > 0) {
-    storageStats.totalLogs--;
-    saveMetadata();
-    Serial.print("Updated metadata: totalLogs now = ");
-    Serial.println(storageStats.totalLogs);
-  }
-
-  Serial.println("QSO deleted successfully");
-  return true;
+  return deleteQSOOnDate(qsoToDelete.date, qsoToDelete.id);
 }
 
 #endif // QSO_LOGGER_VIEW_H
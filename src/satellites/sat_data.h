@@ -12,6 +12,7 @@
 #include <HTTPClient.h>
 #include <SPIFFS.h>
 #include <esp_task_wdt.h>
+#include <esp_rom_crc.h>
 #include <time.h>
 #include "../storage/sd_card.h"
 
@@ -59,6 +60,26 @@ struct SatCatalog {
 
 static SatCatalog satCatalog = { nullptr, 0, false, false, 0 };
 
+// Catalog generation, read by the background pass worker (sat_pass_worker.h)
+// as a sequence lock: odd while the catalog is being rewritten, bumped again
+// when the new contents are in place. Only the loop task edits the catalog.
+static volatile uint32_t satCatalogGeneration = 0;
+static int satCatalogEditDepth = 0;
+
+static void satCatalogBeginEdit() {
+    if (satCatalogEditDepth++ == 0) {
+        satCatalogGeneration++;
+        __sync_synchronize();  // odd generation visible before any entry changes
+    }
+}
+
+static void satCatalogEndEdit() {
+    if (satCatalogEditDepth > 0 && --satCatalogEditDepth == 0) {
+        __sync_synchronize();  // entries visible before the even generation
+        satCatalogGeneration++;
+    }
+}
+
 // ============================================
 // PSRAM Allocation
 // ============================================
@@ -95,6 +116,12 @@ static void satTrimRight(char* s) {
     }
 }
 
+// CRC32 of both TLE lines: identifies an element set (covers the epoch)
+uint32_t satTleCrc(const char* line1, const char* line2) {
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t*)line1, strlen(line1));
+    return esp_rom_crc32_le(crc, (const uint8_t*)line2, strlen(line2));
+}
+
 static int satFindByNorad(uint32_t norad) {
     for (int i = 0; i < satCatalog.count; i++) {
         if (satCatalog.sats[i].norad == norad) return i;
@@ -164,6 +191,14 @@ static bool satEnsureFlashFS() {
     return true;
 }
 
+// Filesystem holding the TLE cache; files derived from the catalog live
+// next to it. nullptr when the catalog is RAM only.
+static fs::FS* satTLEStorageFS() {
+    if (satTLEStorage == SAT_STORE_SD && sdCardAvailable) return &SD;
+    if (satTLEStorage == SAT_STORE_FLASH && satEnsureFlashFS()) return &SPIFFS;
+    return nullptr;
+}
+
 static bool satWriteTLECache(fs::FS& fs) {
     File f = fs.open(SAT_SD_TLE_FILE, FILE_WRITE);
     if (!f) return false;
@@ -186,6 +221,7 @@ static bool satReadTLECache(fs::FS& fs) {
     File f = fs.open(SAT_SD_TLE_FILE);
     if (!f) return false;
 
+    satCatalogBeginEdit();
     satCatalog.count = 0;
     SatTLEParseState st;
     memset(&st, 0, sizeof(st));
@@ -208,6 +244,7 @@ static bool satReadTLECache(fs::FS& fs) {
     }
 
     satCatalog.valid = (satCatalog.count > 0);
+    satCatalogEndEdit();
     return satCatalog.valid;
 }
 
@@ -0,0 +1,223 @@
+/*
+ * VAIL SUMMIT - Precompiled Element Sets
+ * The catalog parsed into SGP4 state once per TLE download, so selecting a
+ * satellite copies a ready elsetrec instead of running twoline2rv() and
+ * sgp4init() again. The table is indexed like satCatalog.sats and saved in
+ * binary next to the TLE cache, keyed per entry by NORAD id and the TLE
+ * CRC, so a boot with an unchanged catalog parses nothing.
+ *
+ * sgp4() keeps deep-space integrator state inside the elsetrec, so every
+ * propagator gets its own copy (~800 bytes, memcpy) rather than a pointer
+ * into the table.
+ *
+ * Threading: only the loop task writes the table. satElsetsGen names the
+ * catalog generation it matches and is 0 while a rebuild is writing slots;
+ * readers on other tasks copy a slot and re-check it (sequence lock).
+ */
+
+#ifndef SAT_ELSETS_H
+#define SAT_ELSETS_H
+
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "../thirdparty/sgp4/sgp4.h"
+#include "../storage/atomic_file.h"
+#include "sat_data.h"
+
+// ============================================
+// Configuration
+// ============================================
+
+#define SAT_ES_FILE        "/satellites/elsets.bin"
+#define SAT_ES_MAGIC       0x314C4553   // "SEL1"
+#define SAT_ES_VERSION     1
+#define SAT_ES_BUDGET_MS   8            // parse time per loop pass while rebuilding
+
+// ============================================
+// Data Structures
+// ============================================
+
+struct SatElset {
+    uint32_t norad;
+    uint32_t tleCrc;            // satTleCrc() of the lines it was parsed from
+    vsgp4::elsetrec rec;        // state straight out of twoline2rv()
+};
+
+struct __attribute__((packed)) SatElsetFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;             // records that follow
+    uint32_t recSize;           // sizeof(SatElset) of the build that wrote it
+};
+
+static SatElset* satElsets = nullptr;              // PSRAM, MAX_SATELLITES
+static volatile uint32_t satElsetsGen = 0;         // catalog generation matched, 0 = none
+static uint32_t satElsetsBuildGen = 0;             // generation being built
+static int satElsetsNext = 0;                      // next slot to fill
+static bool satElsetsHave[MAX_SATELLITES];         // slot filled from the saved file
+static bool satElsetsDirty = false;                // parsed slots not saved yet
+
+// ============================================
+// Allocation
+// ============================================
+
+// PSRAM only: without it the propagators keep parsing the text TLEs
+static bool satElsetsInit() {
+    if (satElsets) return true;
+    if (!psramFound()) return false;
+    satElsets = (SatElset*)ps_calloc(MAX_SATELLITES, sizeof(SatElset));
+    if (!satElsets) {
+        Serial.println("[SAT] ERROR: element set table allocation failed");
+        return false;
+    }
+    Serial.printf("[SAT] Element set table allocated: %u bytes\n",
+                  (unsigned)(sizeof(SatElset) * MAX_SATELLITES));
+    return true;
+}
+
+// ============================================
+// Propagator Setup (any task)
+// ============================================
+
+/*
+ * Load catalog entry `idx` into `pred` from the table. `catalogGen` is the
+ * catalog generation the caller's copy of the entry belongs to. Returns
+ * false when the table doesn't match it yet - parse the text TLE instead.
+ * Like Sgp4::init(), a propagator already holding these lines is left as is.
+ */
+static bool satElsetInit(vsgp4::Sgp4& pred, int idx, uint32_t catalogGen,
+                         const char* name, const char* line1, const char* line2) {
+    if (strcmp(pred.line1, line1) == 0) return true;
+
+    uint32_t gen = satElsetsGen;
+    if (gen == 0 || gen != catalogGen || idx < 0 || idx >= MAX_SATELLITES) return false;
+    __sync_synchronize();
+    memcpy(&pred.satrec, &satElsets[idx].rec, sizeof(pred.satrec));
+    __sync_synchronize();
+    if (satElsetsGen != gen) {
+        pred.line1[0] = '\0';  // torn copy: make the fallback init() parse
+        return false;
+    }
+
+    strlcpy(pred.satName, name, sizeof(pred.satName));
+    strlcpy(pred.line1, line1, sizeof(pred.line1));
+    strlcpy(pred.line2, line2, sizeof(pred.line2));
+    pred.revpday = 1440.0 / (2.0 * PI) * pred.satrec.no;
+    return true;
+}
+
+// ============================================
+// Persistence (loop task)
+// ============================================
+
+// Fill the slots whose saved record still matches the catalog entry
+static int satElsetsLoad() {
+    memset(satElsetsHave, 0, sizeof(satElsetsHave));
+    fs::FS* fs = satTLEStorageFS();
+    if (!fs) return 0;
+
+    AtomicFileInfo info;
+    File f = atomicFileOpen(*fs, SAT_ES_FILE, &info);
+    if (!f) return 0;
+
+    SatElsetFileHeader h;
+    if (info.status == ATOMIC_FILE_LEGACY ||
+        f.read((uint8_t*)&h, sizeof(h)) != sizeof(h) ||
+        h.magic != SAT_ES_MAGIC || h.version != SAT_ES_VERSION ||
+        h.recSize != sizeof(SatElset) || h.count > MAX_SATELLITES ||
+        info.length != sizeof(h) + (uint32_t)h.count * sizeof(SatElset)) {
+        f.close();
+        Serial.println("[SAT] Element set cache unreadable - reparsing TLEs");
+        return 0;
+    }
+
+    // Records are in catalog order; a changed or reordered entry just misses
+    int matched = 0;
+    for (int i = 0; i < h.count && i < satCatalog.count; i++) {
+        SatElset& slot = satElsets[i];
+        if (f.read((uint8_t*)&slot, sizeof(slot)) != sizeof(slot)) break;
+        const SatEntry& e = satCatalog.sats[i];
+        if (slot.norad == e.norad && slot.tleCrc == satTleCrc(e.line1, e.line2)) {
+            satElsetsHave[i] = true;
+            matched++;
+        }
+    }
+    f.close();
+    return matched;
+}
+
+static bool satElsetsSave() {
+    fs::FS* fs = satTLEStorageFS();
+    if (!fs) return false;
+    if (fs == &SD && !SD.exists(SAT_SD_DIR)) SD.mkdir(SAT_SD_DIR);
+
+    SatElsetFileHeader h = {};
+    h.magic = SAT_ES_MAGIC;
+    h.version = SAT_ES_VERSION;
+    h.count = (uint16_t)satCatalog.count;
+    h.recSize = sizeof(SatElset);
+
+    AtomicFileWriter out(*fs, SAT_ES_FILE);
+    if (!out.begin()) return false;
+    out.write((const uint8_t*)&h, sizeof(h));
+    out.write((const uint8_t*)satElsets, sizeof(SatElset) * satCatalog.count);
+    if (!out.commit()) return false;
+    Serial.printf("[SAT] Saved %d element sets\n", satCatalog.count);
+    return true;
+}
+
+// ============================================
+// Rebuild (loop task)
+// ============================================
+
+/*
+ * Bring the table in line with the catalog, a few entries per call: slots
+ * whose saved record matches are kept, the rest are parsed from the text
+ * TLEs. Saves once a rebuild had to parse anything. Call from loop().
+ */
+void satElsetsUpdate() {
+    if (!satCatalog.valid || satCatalogEditDepth > 0) return;
+    uint32_t gen = satCatalogGeneration;
+    if (gen == satElsetsGen) {
+        if (satElsetsDirty) {
+            satElsetsDirty = false;   // one try per rebuild; a miss only costs a reparse
+            satElsetsSave();
+        }
+        return;
+    }
+    if (!satElsetsInit()) return;
+
+    if (satElsetsBuildGen != gen) {
+        satElsetsGen = 0;
+        __sync_synchronize();  // readers see "no table" before any slot changes
+        satElsetsBuildGen = gen;
+        satElsetsNext = 0;
+        satElsetsDirty = false;
+        int matched = satElsetsLoad();
+        if (matched > 0) Serial.printf("[SAT] Loaded %d precompiled element sets\n", matched);
+    }
+
+    uint32_t t0 = millis();
+    static char l1[130], l2[130];
+    while (satElsetsNext < satCatalog.count && (millis() - t0) < SAT_ES_BUDGET_MS) {
+        int i = satElsetsNext++;
+        if (satElsetsHave[i]) continue;
+
+        // twoline2rv() mutates its input, as in satPredictorSetup()
+        const SatEntry& e = satCatalog.sats[i];
+        strlcpy(l1, e.line1, sizeof(l1));
+        strlcpy(l2, e.line2, sizeof(l2));
+        SatElset& slot = satElsets[i];
+        slot.norad = e.norad;
+        slot.tleCrc = satTleCrc(e.line1, e.line2);
+        vsgp4::twoline2rv(l1, l2, 'i', vsgp4::wgs84, slot.rec);
+        satElsetsDirty = true;
+    }
+    if (satElsetsNext < satCatalog.count) return;
+
+    __sync_synchronize();  // slots visible before the generation
+    satElsetsGen = gen;
+    Serial.printf("[SAT] Element set table ready (%d)\n", satCatalog.count);
+}
+
+#endif // SAT_ELSETS_H
@@ -0,0 +1,129 @@
+/*
+ * VAIL SUMMIT - Look Angles
+ * Azimuth, elevation, range and range rate straight from an elsetrec, for
+ * the places that sample many points and need nothing else (pass track
+ * tables, live view, the GEO prefilter). Sgp4::findsat() also works out the
+ * sub-satellite point and the sun position on every call; this skips both.
+ *
+ * The ESP32-S3 FPU is single precision only - every double operation is a
+ * software routine. With SAT_LOOK_FLOAT (default) the rotation into the
+ * station's horizon frame runs in float. The parts that need double stay
+ * double: the time since epoch, SGP4 itself, and sidereal time, whose
+ * arguments are Julian dates and radian counts far beyond float's 24 bits.
+ * Float rounding of a ~7000 km position is under a meter, far below what an
+ * antenna or a pass time can resolve; tools/sgp4_bench.cpp measures it.
+ *
+ * Polar motion (tens of meters at the ground) is left out.
+ */
+
+#ifndef SAT_LOOK_H
+#define SAT_LOOK_H
+
+#include <math.h>
+#include <cmath>
+#include "../thirdparty/sgp4/sgp4.h"
+
+// ============================================
+// Configuration
+// ============================================
+
+#ifndef SAT_LOOK_FLOAT
+#define SAT_LOOK_FLOAT 1
+#endif
+
+#if SAT_LOOK_FLOAT
+typedef float SatLookReal;
+#else
+typedef double SatLookReal;
+#endif
+
+#define SAT_LOOK_EARTH_RADIUS_KM  6378.137        // WGS-84, as in vsgp4::site()
+#define SAT_LOOK_EARTH_ECC2       0.006694385     // eccentricity squared
+#define SAT_LOOK_EARTH_RATE       7.292115e-5     // rad/s
+
+// ============================================
+// Data Structures
+// ============================================
+
+// Station in the Earth-fixed frame, prepared once per grid
+struct SatLookSite {
+    SatLookReal x, y, z;            // km
+    SatLookReal sinLat, cosLat;
+    SatLookReal sinLon, cosLon;
+};
+
+struct SatLook {
+    float az;           // degrees, 0 = north
+    float el;           // degrees
+    float rangeKm;
+    float rangeRate;    // m/s, positive = receding
+};
+
+// ============================================
+// Site
+// ============================================
+
+// Geodetic latitude/longitude in degrees, altitude in km
+static void satLookSiteSet(SatLookSite* s, double latDeg, double lonDeg, double altKm) {
+    double lat = latDeg * M_PI / 180.0;
+    double lon = lonDeg * M_PI / 180.0;
+    double sinLat = sin(lat);
+    double c = SAT_LOOK_EARTH_RADIUS_KM / sqrt(1.0 - SAT_LOOK_EARTH_ECC2 * sinLat * sinLat);
+    double rdel = (c + altKm) * cos(lat);
+    s->x = (SatLookReal)(rdel * cos(lon));
+    s->y = (SatLookReal)(rdel * sin(lon));
+    s->z = (SatLookReal)(((1.0 - SAT_LOOK_EARTH_ECC2) * c + altKm) * sinLat);
+    s->sinLat = (SatLookReal)sinLat;
+    s->cosLat = (SatLookReal)cos(lat);
+    s->sinLon = (SatLookReal)sin(lon);
+    s->cosLon = (SatLookReal)cos(lon);
+}
+
+// ============================================
+// Look Angles
+// ============================================
+
+/*
+ * Propagate `rec` to Julian date `jd` and turn the position into look
+ * angles from `site`. `rec` is written to (deep-space integrator state), as
+ * with any sgp4() call. False when SGP4 fails (decayed / bad elements).
+ */
+static bool satLookAngles(vsgp4::elsetrec& rec, const SatLookSite& site, double jd, SatLook* out) {
+    double ro[3], vo[3];
+    double tsince = (jd - rec.jdsatepoch) * 1440.0;
+    vsgp4::sgp4(vsgp4::wgs84, rec, tsince, ro, vo);
+    if (rec.error != 0 || isnan(ro[0])) return false;
+
+    // std:: overloads so the float build calls sinf()/atan2f() and friends
+    double gmst = vsgp4::gstime(jd);
+    SatLookReal sg = (SatLookReal)sin(gmst);
+    SatLookReal cg = (SatLookReal)cos(gmst);
+
+    // TEME -> Earth-fixed: rotate by sidereal time
+    SatLookReal rx = (SatLookReal)ro[0], ry = (SatLookReal)ro[1], rz = (SatLookReal)ro[2];
+    SatLookReal ex = cg * rx + sg * ry;
+    SatLookReal ey = cg * ry - sg * rx;
+    SatLookReal vx = (SatLookReal)vo[0], vy = (SatLookReal)vo[1], vz = (SatLookReal)vo[2];
+    const SatLookReal w = (SatLookReal)SAT_LOOK_EARTH_RATE;
+    SatLookReal evx = cg * vx + sg * vy + w * ey;
+    SatLookReal evy = cg * vy - sg * vx - w * ex;
+
+    // Station -> satellite, then into south/east/zenith
+    SatLookReal dx = ex - site.x, dy = ey - site.y, dz = rz - site.z;
+    SatLookReal range = std::sqrt(dx * dx + dy * dy + dz * dz);
+    SatLookReal t = site.cosLon * dx + site.sinLon * dy;
+    SatLookReal south = site.sinLat * t - site.cosLat * dz;
+    SatLookReal east = site.cosLon * dy - site.sinLon * dx;
+    SatLookReal zen = site.cosLat * t + site.sinLat * dz;
+
+    const SatLookReal deg = (SatLookReal)(180.0 / M_PI);
+    SatLookReal az = std::atan2(east, -south) * deg;
+    if (az < 0) az += 360;
+    out->az = (float)az;
+    out->el = (float)(std::asin(zen / range) * deg);
+    out->rangeKm = (float)range;
+    out->rangeRate = (float)((dx * evx + dy * evy + dz * vz) / range * 1000);
+    return true;
+}
+
+#endif // SAT_LOOK_H
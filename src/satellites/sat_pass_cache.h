@@ -0,0 +1,439 @@
+/*
+ * VAIL SUMMIT - Persistent Pass Prediction Cache
+ * Computed passes per satellite, kept in PSRAM and saved next to the TLE
+ * cache so a screen visit can show passes without running SGP4 again.
+ *
+ * Each entry holds the passes found for one satellite over [from, horizon]:
+ * the list is complete for that span, so an entry with no passes is a
+ * persisted "no pass until <horizon>". Entries are keyed by NORAD id and a
+ * CRC32 of the two TLE lines (which covers the element-set epoch), so a TLE
+ * refresh invalidates exactly the birds whose elements changed. The site
+ * (grid center) and minimum elevation key the whole cache; storing under a
+ * different site clears it.
+ *
+ * The pass worker (core 0) and the passes screen (loop task) share the
+ * table under a mutex - clearing or scanning every slot is too long to run
+ * with interrupts off under a spinlock. Only the loop task touches storage.
+ */
+
+#ifndef SAT_PASS_CACHE_H
+#define SAT_PASS_CACHE_H
+
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "../storage/atomic_file.h"
+#include "sat_data.h"
+#include "sat_predict.h"
+
+// ============================================
+// Configuration
+// ============================================
+
+#define SAT_PC_FILE          "/satellites/passes.bin"
+#define SAT_PC_MAGIC         0x31435053   // "SPC1"
+#define SAT_PC_VERSION       1
+#define SAT_PC_SLOTS         MAX_SATELLITES
+#define SAT_PC_MAX_PASSES    SAT_MAX_PASSES   // per satellite; horizon stops at the last one
+#define SAT_PC_SAVE_SETTLE_MS   10000     // quiet time before a save
+#define SAT_PC_SAVE_MIN_GAP_MS  120000    // at most one save per 2 min while filling
+
+// ============================================
+// Data Structures
+// ============================================
+
+// Everything the cached passes depend on besides the TLE
+struct __attribute__((packed)) SatPassCacheKey {
+    int32_t latE4;              // grid center, 1e-4 degrees
+    int32_t lonE4;
+    int16_t minElevation;
+};
+
+// SatPass in 20 bytes (angles in 0.1 degree)
+struct __attribute__((packed)) SatCachedPass {
+    uint32_t aos;
+    uint32_t los;
+    uint32_t tmax;
+    uint16_t aosAz;
+    uint16_t losAz;
+    uint16_t maxAz;
+    int16_t maxEl;
+};
+
+// On disk each entry is stored up to passes[count]
+struct __attribute__((packed)) SatPassCacheEntry {
+    uint32_t norad;             // 0 = free slot
+    uint32_t tleCrc;            // CRC32 of line 1 + line 2
+    uint32_t from;              // passes[] is complete for [from, horizon]
+    uint32_t horizon;
+    uint8_t count;
+    uint8_t reserved[3];
+    SatCachedPass passes[SAT_PC_MAX_PASSES];
+};
+
+#define SAT_PC_ENTRY_HEAD   offsetof(SatPassCacheEntry, passes)
+
+struct __attribute__((packed)) SatPassCacheFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;             // entries that follow
+    SatPassCacheKey key;
+};
+
+static SatPassCacheEntry* satPcEntries = nullptr;   // PSRAM, SAT_PC_SLOTS
+static SatPassCacheKey satPcKey = {};
+static SemaphoreHandle_t satPcMutex = NULL;        // Created with the table
+static bool satPcLoaded = false;
+static volatile bool satPcDirty = false;
+static volatile uint32_t satPcChangedAt = 0;
+static uint32_t satPcSavedAt = 0;
+
+// ============================================
+// Helpers
+// ============================================
+
+SatPassCacheKey satPassCacheKeyFor(double lat, double lon, int minElevation) {
+    SatPassCacheKey k;
+    k.latE4 = (int32_t)lround(lat * 10000.0);
+    k.lonE4 = (int32_t)lround(lon * 10000.0);
+    k.minElevation = (int16_t)minElevation;
+    return k;
+}
+
+static bool satPcKeyEqual(const SatPassCacheKey& a, const SatPassCacheKey& b) {
+    return a.latE4 == b.latE4 && a.lonE4 == b.lonE4 && a.minElevation == b.minElevation;
+}
+
+static void satPcPack(const SatPass& p, SatCachedPass& c) {
+    c.aos = (uint32_t)p.aos;
+    c.los = (uint32_t)p.los;
+    c.tmax = (uint32_t)p.tmax;
+    c.aosAz = (uint16_t)lroundf(p.aosAz * 10.0f);
+    c.losAz = (uint16_t)lroundf(p.losAz * 10.0f);
+    c.maxAz = (uint16_t)lroundf(p.maxAz * 10.0f);
+    c.maxEl = (int16_t)lroundf(p.maxEl * 10.0f);
+}
+
+static void satPcUnpack(const SatCachedPass& c, SatPass& p) {
+    p.aos = (time_t)c.aos;
+    p.los = (time_t)c.los;
+    p.tmax = (time_t)c.tmax;
+    p.aosAz = c.aosAz / 10.0f;
+    p.losAz = c.losAz / 10.0f;
+    p.maxAz = c.maxAz / 10.0f;
+    p.maxEl = c.maxEl / 10.0f;
+}
+
+static void satPcLock() {
+    xSemaphoreTake(satPcMutex, portMAX_DELAY);
+}
+
+static void satPcUnlock() {
+    xSemaphoreGive(satPcMutex);
+}
+
+// Slot holding `norad`, or -1. Caller holds satPcMutex.
+static int satPcFind(uint32_t norad) {
+    for (int i = 0; i < SAT_PC_SLOTS; i++) {
+        if (satPcEntries[i].norad == norad) return i;
+    }
+    return -1;
+}
+
+static void satPcMarkDirty() {
+    satPcChangedAt = millis();
+    satPcDirty = true;
+}
+
+// Span a finished search is complete for: up to its window end, or only up
+// to the last pass kept when the pass list filled up
+time_t satPassSearchHorizon(const SatPassSearch& s) {
+    time_t end = (time_t)vsgp4::getUnixFromJulian(s.endJd);
+    if (s.count == 0) return end;
+    time_t lastLos = s.passes[s.count - 1].los;
+    if (s.count >= SAT_MAX_PASSES) return lastLos;
+    return lastLos > end ? lastLos : end;
+}
+
+// ============================================
+// Lookup / Store (any task)
+// ============================================
+
+// Loop task, before the pass worker starts
+bool satPassCacheInit() {
+    if (satPcEntries) return true;
+    if (satPcMutex == NULL) satPcMutex = xSemaphoreCreateMutex();
+    if (satPcMutex == NULL) {
+        Serial.println("[SAT] ERROR: pass cache mutex allocation failed");
+        return false;
+    }
+    size_t size = sizeof(SatPassCacheEntry) * SAT_PC_SLOTS;
+    if (psramFound()) satPcEntries = (SatPassCacheEntry*)ps_calloc(SAT_PC_SLOTS, sizeof(SatPassCacheEntry));
+    if (!satPcEntries) satPcEntries = (SatPassCacheEntry*)calloc(SAT_PC_SLOTS, sizeof(SatPassCacheEntry));
+    if (!satPcEntries) {
+        Serial.println("[SAT] ERROR: pass cache allocation failed");
+        return false;
+    }
+    Serial.printf("[SAT] Pass cache allocated: %u bytes\n", (unsigned)size);
+    return true;
+}
+
+/*
+ * Cached passes for a satellite from `at` on. Returns -1 when there's no
+ * usable entry (none, other site or TLE, or it doesn't reach past `at`).
+ * Otherwise copies up to maxOut passes with LOS >= at and returns how many;
+ * *horizon is where the cached knowledge ends (no other passes before it).
+ */
+int satPassCacheLookup(const SatPassCacheKey& key, uint32_t norad, uint32_t tleCrc,
+                       time_t at, SatPass* out, int maxOut, time_t* horizon) {
+    if (!satPcEntries) return -1;
+
+    SatPassCacheEntry e;
+    bool found = false;
+    satPcLock();
+    if (satPcKeyEqual(key, satPcKey)) {
+        int slot = satPcFind(norad);
+        if (slot >= 0) {
+            e = satPcEntries[slot];
+            found = true;
+        }
+    }
+    satPcUnlock();
+
+    if (!found || e.tleCrc != tleCrc) return -1;
+    if ((time_t)e.from > at || (time_t)e.horizon <= at) return -1;
+
+    int n = 0;
+    for (int i = 0; i < e.count && n < maxOut; i++) {
+        if ((time_t)e.passes[i].los < at) continue;   // already over
+        satPcUnpack(e.passes[i], out[n++]);
+    }
+    *horizon = (time_t)e.horizon;
+    return n;
+}
+
+/*
+ * Record the passes found for a satellite over [from, horizon]. Keeps the
+ * existing entry if it already covers that span for the same TLE.
+ */
+void satPassCacheStore(const SatPassCacheKey& key, uint32_t norad, uint32_t tleCrc,
+                       time_t from, time_t horizon, const SatPass* passes, int count) {
+    if (!satPcEntries || norad == 0 || horizon <= from) return;
+
+    SatPassCacheEntry e = {};
+    e.norad = norad;
+    e.tleCrc = tleCrc;
+    e.from = (uint32_t)from;
+    e.horizon = (uint32_t)horizon;
+    for (int i = 0; i < count && e.count < SAT_PC_MAX_PASSES; i++) {
+        satPcPack(passes[i], e.passes[e.count++]);
+    }
+    if (count > SAT_PC_MAX_PASSES) {
+        e.horizon = e.passes[SAT_PC_MAX_PASSES - 1].los;   // complete only this far
+    }
+
+    satPcLock();
+    if (!satPcKeyEqual(key, satPcKey)) {
+        // New grid or min elevation - nothing cached still applies
+        memset(satPcEntries, 0, sizeof(SatPassCacheEntry) * SAT_PC_SLOTS);
+        satPcKey = key;
+    }
+    int slot = satPcFind(norad);
+    bool keep = slot >= 0 && satPcEntries[slot].tleCrc == tleCrc &&
+                satPcEntries[slot].from <= e.from && satPcEntries[slot].horizon >= e.horizon;
+    if (slot < 0) slot = satPcFind(0);
+    if (slot < 0) {
+        // Full: reuse the entry that runs out first
+        slot = 0;
+        for (int i = 1; i < SAT_PC_SLOTS; i++) {
+            if (satPcEntries[i].horizon < satPcEntries[slot].horizon) slot = i;
+        }
+    }
+    if (!keep) satPcEntries[slot] = e;
+    satPcUnlock();
+
+    if (!keep) satPcMarkDirty();
+}
+
+// ============================================
+// Persistence (loop task)
+// ============================================
+
+// Load the saved cache once (after the TLE cache, which decides the storage)
+void satPassCacheLoad() {
+    if (satPcLoaded || !satPassCacheInit()) return;
+    fs::FS* fs = satTLEStorageFS();
+    if (!fs) return;
+    satPcLoaded = true;
+
+    AtomicFileInfo info;
+    File f = atomicFileOpen(*fs, SAT_PC_FILE, &info);
+    if (!f) return;
+
+    SatPassCacheFileHeader h;
+    if (info.status == ATOMIC_FILE_LEGACY ||
+        f.read((uint8_t*)&h, sizeof(h)) != sizeof(h) ||
+        h.magic != SAT_PC_MAGIC || h.version != SAT_PC_VERSION || h.count > SAT_PC_SLOTS) {
+        f.close();
+        Serial.println("[SAT] Pass cache unreadable - starting empty");
+        return;
+    }
+
+    // Read each entry outside the lock, then install it
+    satPcLock();
+    memset(satPcEntries, 0, sizeof(SatPassCacheEntry) * SAT_PC_SLOTS);
+    satPcKey = h.key;
+    satPcUnlock();
+
+    uint32_t consumed = sizeof(h);
+    int loaded = 0;
+    while (loaded < h.count) {
+        SatPassCacheEntry e = {};
+        if (f.read((uint8_t*)&e, SAT_PC_ENTRY_HEAD) != SAT_PC_ENTRY_HEAD ||
+            e.count > SAT_PC_MAX_PASSES) break;
+        size_t bytes = sizeof(SatCachedPass) * e.count;
+        if (f.read((uint8_t*)e.passes, bytes) != bytes) break;
+        consumed += SAT_PC_ENTRY_HEAD + bytes;
+        satPcLock();
+        satPcEntries[loaded] = e;
+        satPcUnlock();
+        loaded++;
+    }
+    f.close();
+    if (loaded != h.count || consumed != info.length) {
+        satPcLock();
+        memset(satPcEntries, 0, sizeof(SatPassCacheEntry) * SAT_PC_SLOTS);
+        satPcUnlock();
+        Serial.println("[SAT] Pass cache truncated - starting empty");
+        return;
+    }
+    Serial.printf("[SAT] Loaded %d cached pass entries\n", loaded);
+}
+
+// Write the cache, dropping entries whose horizon has passed
+bool satPassCacheSave() {
+    if (!satPcEntries) return false;
+    fs::FS* fs = satTLEStorageFS();
+    if (!fs) return false;
+    if (fs == &SD && !SD.exists(SAT_SD_DIR)) SD.mkdir(SAT_SD_DIR);
+
+    uint32_t now = (uint32_t)time(nullptr);
+    satPcDirty = false;
+
+    SatPassCacheFileHeader h = {};
+    h.magic = SAT_PC_MAGIC;
+    h.version = SAT_PC_VERSION;
+    satPcLock();
+    h.key = satPcKey;
+    for (int i = 0; i < SAT_PC_SLOTS; i++) {
+        if (satPcEntries[i].norad != 0 && satPcEntries[i].horizon > now) h.count++;
+    }
+    satPcUnlock();
+
+    AtomicFileWriter out(*fs, SAT_PC_FILE);
+    if (!out.begin()) return false;
+    out.write((const uint8_t*)&h, sizeof(h));
+    int written = 0;
+    for (int i = 0; i < SAT_PC_SLOTS && written < h.count; i++) {
+        SatPassCacheEntry e;
+        satPcLock();
+        e = satPcEntries[i];
+        satPcUnlock();
+        if (e.norad == 0 || e.horizon <= now) continue;
+        out.write((const uint8_t*)&e, SAT_PC_ENTRY_HEAD + sizeof(SatCachedPass) * e.count);
+        written++;
+    }
+    // The worker may have changed an entry between the count and the copy
+    if (written != h.count) {
+        out.abort();
+        satPcDirty = true;
+        return false;
+    }
+    satPcSavedAt = millis();
+    return out.commit();
+}
+
+// Save once the worker has gone quiet for a bit. Call from loop().
+void satPassCacheUpdate() {
+    if (!satPcDirty || !satPcLoaded) return;
+    uint32_t now = millis();
+    if (now - satPcChangedAt < SAT_PC_SAVE_SETTLE_MS) return;
+    if (satPcSavedAt != 0 && now - satPcSavedAt < SAT_PC_SAVE_MIN_GAP_MS) return;
+    if (!satPassCacheSave()) satPcSavedAt = now;   // retry after the gap, not every loop
+}
+
+// ============================================
+// Passes Screen Search
+// ============================================
+
+// Store context for the search started by satStartCachedPassSearch()
+static struct {
+    bool armed;
+    SatPassCacheKey key;
+    uint32_t norad;
+    uint32_t tleCrc;
+    time_t from;
+} satPcSearch = {};
+
+/*
+ * satStartPassSearch() with the cache in front: cached passes go straight
+ * into satSearch, and SGP4 only runs for the part of the lookahead window
+ * past the cached horizon (none at all when the cache covers it).
+ * `useCache` false recomputes from scratch (the cache is refreshed after).
+ */
+bool satStartCachedPassSearch(int catalogIdx, bool useCache) {
+    satPcSearch.armed = false;
+    if (!satCatalog.valid || catalogIdx < 0 || catalogIdx >= satCatalog.count || !ntpSynced) {
+        return satStartPassSearch(catalogIdx);
+    }
+    double lat, lon;
+    if (!gridToLatLon(satEffectiveGrid(), &lat, &lon)) return satStartPassSearch(catalogIdx);
+
+    satPassCacheLoad();
+    const SatEntry& entry = satCatalog.sats[catalogIdx];
+    time_t now = time(nullptr);
+    time_t end = now + (time_t)satSettings.lookaheadHours * 3600;
+    SatPassCacheKey key = satPassCacheKeyFor(lat, lon, satSettings.minElevation);
+    uint32_t crc = satTleCrc(entry.line1, entry.line2);
+
+    static SatPass cached[SAT_MAX_PASSES];
+    time_t horizon = 0;
+    int n = useCache ? satPassCacheLookup(key, entry.norad, crc, now, cached, SAT_MAX_PASSES, &horizon) : -1;
+    while (n > 0 && cached[n - 1].aos > end) n--;     // past the lookahead window
+
+    if (n >= 0 && horizon >= end) {
+        memset(&satSearch, 0, sizeof(satSearch));
+        satSearch.catalogIdx = catalogIdx;
+        satSearch.startJd = vsgp4::getJulianFromUnix((double)now);
+        satSearch.endJd = vsgp4::getJulianFromUnix((double)end);
+        memcpy(satSearch.passes, cached, sizeof(SatPass) * n);
+        satSearch.count = n;
+        satSearch.done = true;
+        return true;
+    }
+
+    // Resume just past the cached horizon: it is at or after the LOS of the
+    // last cached pass, so starting a minute later can't find that pass again
+    time_t resume = (n >= 0) ? horizon + 60 : now;
+    if (n < 0) n = 0;
+    if (resume >= end) resume = end - 60;
+    if (!satStartPassSearchAt(catalogIdx, resume, (end - resume) / 3600.0)) return false;
+    memcpy(satSearch.passes, cached, sizeof(SatPass) * n);
+    satSearch.count = n;
+
+    satPcSearch.armed = true;
+    satPcSearch.key = key;
+    satPcSearch.norad = entry.norad;
+    satPcSearch.tleCrc = crc;
+    satPcSearch.from = now;
+    return true;
+}
+
+// Store the passes screen's finished search
+void satPassCacheStoreSearch() {
+    if (!satPcSearch.armed || !satSearch.done) return;
+    satPcSearch.armed = false;
+    satPassCacheStore(satPcSearch.key, satPcSearch.norad, satPcSearch.tleCrc, satPcSearch.from,
+                      satPassSearchHorizon(satSearch), satSearch.passes, satSearch.count);
+}
+
+#endif // SAT_PASS_CACHE_H
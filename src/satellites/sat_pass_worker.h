@@ -0,0 +1,563 @@
+/*
+ * VAIL SUMMIT - Background Satellite Pass Worker
+ * A low-priority FreeRTOS task that sweeps the whole catalog for next passes
+ * and serves sky-window scans, each on its own propagator. The LVGL screens
+ * only read published snapshots, so the lists fill in while they are closed
+ * and a window scan no longer competes with the UI for 25 ms timer slices.
+ * Both consult the pass cache (sat_pass_cache.h) before running SGP4, and
+ * the sweep stores what it computes there.
+ *
+ * Threading:
+ *  - Inputs (site, min elevation, lookahead, window request) are posted by
+ *    the loop task under a short spinlock.
+ *  - The catalog is read under its sequence lock (satCatalogGeneration):
+ *    each TLE is copied out and discarded if the catalog changed meanwhile.
+ *  - Results are published through sequence-locked snapshots; the worker
+ *    never waits on a reader, readers retry a torn copy.
+ */
+
+#ifndef SAT_PASS_WORKER_H
+#define SAT_PASS_WORKER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "sat_data.h"
+#include "sat_predict.h"
+#include "sat_pass_cache.h"
+#include "sat_freqs.h"
+
+// ============================================
+// Configuration
+// ============================================
+
+#define SAT_WORKER_STACK          6144
+#define SAT_WORKER_PRIORITY       1       // just above idle
+#define SAT_WORKER_CORE           0       // under the audio task; LVGL/loop is on core 1
+#define SAT_WORKER_SLICE_MS       20      // compute between yields
+#define SAT_WORKER_IDLE_MS        30000   // re-check for expired passes
+#define SAT_NP_PUBLISH_EVERY      8       // satellites per next-pass publish
+#define SAT_NP_NONE_RECHECK_SECS  3600    // "no pass in window" goes stale
+#define SAT_WIN_MAX_HITS          40
+
+// One sky-window hit: a catalog index and its pass overlapping the window
+struct SatWindowHit {
+    int catIdx;
+    SatPass pass;
+};
+
+// ============================================
+// Shared State
+// ============================================
+
+// Search inputs, posted by the loop task
+struct SatWorkerParams {
+    uint32_t gen;               // bumped on every change
+    bool valid;                 // site known + clock synced
+    double lat, lon;
+    int minElevation;
+    int lookaheadHours;
+};
+
+struct SatWindowRequest {
+    uint32_t id;                // 0 = none
+    time_t start;
+    uint32_t seconds;
+};
+
+static portMUX_TYPE satWorkerMux = portMUX_INITIALIZER_UNLOCKED;
+static SatWorkerParams satWorkerParams = {};
+static SatWindowRequest satWorkerWinReq = {};
+static TaskHandle_t satWorkerHandle = NULL;
+
+// Next-pass snapshot: aos/los per catalog index, 0 = not computed yet,
+// -1 = no pass within the lookahead window
+struct SatNextPassSnapshot {
+    volatile uint32_t seq;      // odd while being written
+    uint32_t catalogGen;        // catalog the indexes refer to
+    uint32_t paramsGen;
+    time_t aos[MAX_SATELLITES];
+    time_t los[MAX_SATELLITES];
+};
+
+// Sky-window snapshot for the latest request
+struct SatWindowSnapshot {
+    volatile uint32_t seq;
+    uint32_t requestId;
+    uint32_t catalogGen;
+    int scanned;                // catalog entries evaluated so far
+    int total;
+    int count;
+    SatWindowHit hits[SAT_WIN_MAX_HITS];  // sorted by AOS
+};
+
+static SatNextPassSnapshot satNpSnap = {};
+static SatWindowSnapshot satWinSnap = {};
+
+// ============================================
+// Worker-Private State
+// ============================================
+
+// A catalog entry copied out under the catalog's sequence lock
+struct SatWorkerTle {
+    int idx;                    // catalog index
+    char name[25];
+    char line1[130];
+    char line2[130];
+    uint32_t norad;
+    uint32_t crc;               // pass cache key (satTleCrc)
+};
+
+// Separate propagators so a window request doesn't throw away a next-pass
+// search in flight (elsetrec is large; keep them out of the task stack)
+static vsgp4::Sgp4 satWorkerNpPred;
+static vsgp4::Sgp4 satWorkerWinPred;
+static SatPassSearch satWorkerNpSearch;
+static SatPassSearch satWorkerWinSearch;
+static SatWorkerTle satWorkerNpTle;
+static SatWorkerTle satWorkerWinTle;
+
+static SatWorkerParams satWorkerCur = {};     // params the results below are for
+static SatPassCacheKey satWorkerKey = {};
+static time_t satWorkerNpFrom = 0;            // start of the span the search covers
+static uint32_t satWorkerCatalogGen = 1;      // odd = never synced
+static time_t satWorkerNpAos[MAX_SATELLITES];
+static time_t satWorkerNpLos[MAX_SATELLITES];
+static time_t satWorkerNpChecked[MAX_SATELLITES];
+static int satWorkerNpCurrent = -1;
+static int satWorkerNpUnpublished = 0;
+
+static SatWindowRequest satWorkerWin = {};    // request being served
+static int satWorkerWinScan = 0;
+static bool satWorkerWinInflight = false;
+static bool satWorkerWinDone = true;
+static int satWorkerWinCount = 0;
+static SatWindowHit satWorkerWinHits[SAT_WIN_MAX_HITS];
+
+// ============================================
+// Publishing (worker side)
+// ============================================
+
+static void satWorkerPublishNextPass() {
+    satNpSnap.seq++;
+    __sync_synchronize();
+    satNpSnap.catalogGen = satWorkerCatalogGen;
+    satNpSnap.paramsGen = satWorkerCur.gen;
+    memcpy(satNpSnap.aos, satWorkerNpAos, sizeof(satNpSnap.aos));
+    memcpy(satNpSnap.los, satWorkerNpLos, sizeof(satNpSnap.los));
+    __sync_synchronize();
+    satNpSnap.seq++;
+    satWorkerNpUnpublished = 0;
+}
+
+static void satWorkerPublishWindow() {
+    satWinSnap.seq++;
+    __sync_synchronize();
+    satWinSnap.requestId = satWorkerWin.id;
+    satWinSnap.catalogGen = satWorkerCatalogGen;
+    satWinSnap.scanned = satWorkerWinScan;
+    satWinSnap.total = satCatalog.count;
+    satWinSnap.count = satWorkerWinCount;
+    memcpy(satWinSnap.hits, satWorkerWinHits, sizeof(SatWindowHit) * satWorkerWinCount);
+    __sync_synchronize();
+    satWinSnap.seq++;
+}
+
+// ============================================
+// Catalog Access (worker side)
+// ============================================
+
+// Copy a catalog entry. Returns false if the catalog is being rewritten or
+// changed since the worker synced with it.
+static bool satWorkerCopyEntry(int idx, SatWorkerTle& t) {
+    if (idx < 0 || idx >= satCatalog.count) return false;
+
+    const SatEntry& e = satCatalog.sats[idx];
+    t.idx = idx;
+    strlcpy(t.name, e.name, sizeof(t.name));
+    strlcpy(t.line1, e.line1, sizeof(t.line1));
+    strlcpy(t.line2, e.line2, sizeof(t.line2));
+    t.norad = e.norad;
+    __sync_synchronize();
+    if (satCatalogGeneration != satWorkerCatalogGen) return false;
+
+    t.crc = satTleCrc(t.line1, t.line2);
+    return true;
+}
+
+// Load a copied entry into a propagator: precompiled elements when the
+// table matches the synced catalog, else parse. twoline2rv() mutates the
+// lines (as in satPredictorSetup()), so the copy is spent afterwards.
+static void satWorkerInitPred(vsgp4::Sgp4& pred, SatWorkerTle& t) {
+    if (!satElsetInit(pred, t.idx, satWorkerCatalogGen, t.name, t.line1, t.line2)) {
+        pred.init(t.name, t.line1, t.line2);
+    }
+    pred.site(satWorkerCur.lat, satWorkerCur.lon, 100.0);
+}
+
+// Pick up new params / a new catalog. Returns false while there's nothing
+// the worker can compute (no site, no clock, catalog mid-rewrite).
+static bool satWorkerSync() {
+    SatWorkerParams params;
+    SatWindowRequest req;
+    portENTER_CRITICAL(&satWorkerMux);
+    params = satWorkerParams;
+    req = satWorkerWinReq;
+    portEXIT_CRITICAL(&satWorkerMux);
+
+    uint32_t gen = satCatalogGeneration;
+    if (gen & 1) return false;                 // update job is rewriting it
+
+    bool reset = false;
+    if (gen != satWorkerCatalogGen) {
+        satWorkerCatalogGen = gen;
+        reset = true;
+    }
+    if (params.gen != satWorkerCur.gen) {
+        satWorkerCur = params;
+        satWorkerKey = satPassCacheKeyFor(params.lat, params.lon, params.minElevation);
+        reset = true;
+    }
+    if (reset) {
+        memset(satWorkerNpAos, 0, sizeof(satWorkerNpAos));
+        memset(satWorkerNpLos, 0, sizeof(satWorkerNpLos));
+        memset(satWorkerNpChecked, 0, sizeof(satWorkerNpChecked));
+        satWorkerNpCurrent = -1;
+        satWorkerWin.id = 0;                   // re-run the window request too
+        satWorkerPublishNextPass();
+    }
+
+    if (req.id != 0 && req.id != satWorkerWin.id) {
+        satWorkerWin = req;
+        satWorkerWinScan = 0;
+        satWorkerWinInflight = false;
+        satWorkerWinDone = false;
+        satWorkerWinCount = 0;
+        satWorkerPublishWindow();
+    }
+
+    return satWorkerCur.valid && satCatalog.valid && ntpSynced;
+}
+
+// ============================================
+// Next-Pass Sweep (worker side)
+// ============================================
+
+// Priority bucket: favorites, then the curated birds, then the rest
+static int satWorkerNpPriority(int idx) {
+    uint32_t norad = satCatalog.sats[idx].norad;
+    if (isSatFavorite(norad)) return 0;
+    if (lookupSatFreqs(norad) != NULL) return 1;
+    return 2;
+}
+
+static bool satWorkerNpNeeded(int idx, time_t now) {
+    time_t aos = satWorkerNpAos[idx];
+    if (aos == 0) return true;
+    if (aos == (time_t)-1) return now - satWorkerNpChecked[idx] >= SAT_NP_NONE_RECHECK_SECS;
+    return satWorkerNpLos[idx] < now;         // pass is over
+}
+
+// Next catalog index to compute, or -1 when every entry is current
+static int satWorkerNpPick(time_t now) {
+    int count = satCatalog.count;
+    for (int prio = 0; prio <= 2; prio++) {
+        for (int i = 0; i < count; i++) {
+            if (!satWorkerNpNeeded(i, now)) continue;
+            if (satWorkerNpPriority(i) != prio) continue;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void satWorkerNpRecord(int idx, const SatPass* first, time_t now) {
+    satWorkerNpAos[idx] = first ? first->aos : (time_t)-1;
+    satWorkerNpLos[idx] = first ? first->los : (time_t)-1;
+    satWorkerNpChecked[idx] = now;
+    satWorkerNpCurrent = -1;
+    if (++satWorkerNpUnpublished >= SAT_NP_PUBLISH_EVERY) satWorkerPublishNextPass();
+}
+
+// One slice of the sweep. Returns false when there's nothing left to do.
+static bool satWorkerNpStep() {
+    time_t now = time(nullptr);
+
+    if (satWorkerNpCurrent < 0) {
+        int idx = satWorkerNpPick(now);
+        if (idx < 0) {
+            if (satWorkerNpUnpublished > 0) satWorkerPublishNextPass();
+            return false;
+        }
+        if (!satWorkerCopyEntry(idx, satWorkerNpTle)) return true;   // catalog changed - resync
+        satWorkerNpCurrent = idx;
+
+        // Cache first: a hit, or a cached "no pass" reaching past the
+        // lookahead window, needs no SGP4 at all
+        time_t lookEnd = now + (time_t)satWorkerCur.lookaheadHours * 3600;
+        SatPass cached;
+        time_t horizon = 0;
+        int n = satPassCacheLookup(satWorkerKey, satWorkerNpTle.norad, satWorkerNpTle.crc,
+                                   now, &cached, 1, &horizon);
+        if (n == 1 && cached.aos <= lookEnd) {
+            satWorkerNpRecord(idx, &cached, now);
+            return true;
+        }
+        if (n >= 0 && horizon >= lookEnd) {
+            satWorkerNpRecord(idx, NULL, now);
+            return true;
+        }
+
+        // Nothing before a cached horizon: search only past it (a minute
+        // on, so the pass ending there can't be found twice)
+        time_t start = (n == 0) ? horizon + 60 : now;
+        if (start > lookEnd - 60) start = lookEnd - 60;
+        satWorkerNpFrom = now;
+
+        memset(&satWorkerNpSearch, 0, sizeof(satWorkerNpSearch));
+        satWorkerNpSearch.catalogIdx = idx;
+        satWorkerInitPred(satWorkerNpPred, satWorkerNpTle);
+        if (!satPassSearchBegin(satWorkerNpSearch, satWorkerNpPred, start,
+                                (lookEnd - start) / 3600.0,
+                                (double)satWorkerCur.minElevation)) {
+            satWorkerNpSearch.done = true;     // unusable TLE: "no pass"
+        }
+    }
+
+    // Stop at the first pass - that's all the NEXT PASS column shows
+    satPassSearchRun(satWorkerNpSearch, satWorkerNpPred, SAT_WORKER_SLICE_MS);
+    if (satWorkerNpSearch.count == 0 && !satWorkerNpSearch.done) return true;
+
+    // A search stopped at its first pass is complete up to that pass's LOS
+    const SatPassSearch& s = satWorkerNpSearch;
+    time_t horizon = (s.count > 0) ? s.passes[0].los : satPassSearchHorizon(s);
+    satPassCacheStore(satWorkerKey, satWorkerNpTle.norad, satWorkerNpTle.crc,
+                      satWorkerNpFrom, horizon, s.passes, s.count > 0 ? 1 : 0);
+    satWorkerNpRecord(satWorkerNpCurrent, s.count > 0 ? &s.passes[0] : NULL, now);
+    return true;
+}
+
+// ============================================
+// Sky-Window Scan (worker side)
+// ============================================
+
+static void satWorkerWinInsert(int catIdx, const SatPass* p) {
+    if (satWorkerWinCount >= SAT_WIN_MAX_HITS) return;
+    int pos = satWorkerWinCount;
+    while (pos > 0 && satWorkerWinHits[pos - 1].pass.aos > p->aos) {
+        satWorkerWinHits[pos] = satWorkerWinHits[pos - 1];
+        pos--;
+    }
+    satWorkerWinHits[pos].catIdx = catIdx;
+    satWorkerWinHits[pos].pass = *p;
+    satWorkerWinCount++;
+}
+
+static void satWorkerWinAdvance() {
+    satWorkerWinInflight = false;
+    satWorkerWinScan++;
+    // Publish every few birds (and at the end) to keep redraw cost down
+    if ((satWorkerWinScan % 4) == 0 || satWorkerWinScan >= satCatalog.count) {
+        satWorkerPublishWindow();
+    }
+}
+
+// One slice of the window scan: one satellite at a time over
+// [start, start+seconds] plus margin, so a pass peaking just past the end
+// is still found; keeps the first pass that overlaps the window.
+static void satWorkerWinStep() {
+    if (satWorkerWinScan >= satCatalog.count) {
+        satWorkerWinDone = true;
+        satWorkerPublishWindow();
+        return;
+    }
+
+    time_t winEnd = satWorkerWin.start + (time_t)satWorkerWin.seconds;
+    if (!satWorkerWinInflight) {
+        if (!satWorkerCopyEntry(satWorkerWinScan, satWorkerWinTle)) return;  // resync
+
+        // The cached pass list answers windows inside its span
+        SatPass cached;
+        time_t horizon = 0;
+        int n = satPassCacheLookup(satWorkerKey, satWorkerWinTle.norad, satWorkerWinTle.crc,
+                                   satWorkerWin.start, &cached, 1, &horizon);
+        if (n == 1 || (n == 0 && horizon >= winEnd)) {
+            if (n == 1 && cached.aos <= winEnd) satWorkerWinInsert(satWorkerWinScan, &cached);
+            satWorkerWinAdvance();
+            return;
+        }
+
+        memset(&satWorkerWinSearch, 0, sizeof(satWorkerWinSearch));
+        satWorkerWinSearch.catalogIdx = satWorkerWinScan;
+        satWorkerInitPred(satWorkerWinPred, satWorkerWinTle);
+        double hours = satWorkerWin.seconds / 3600.0 + 0.25;
+        if (!satPassSearchBegin(satWorkerWinSearch, satWorkerWinPred, satWorkerWin.start,
+                                hours, (double)satWorkerCur.minElevation)) {
+            satWorkerWinAdvance();
+            return;
+        }
+        satWorkerWinInflight = true;
+    }
+
+    satPassSearchRun(satWorkerWinSearch, satWorkerWinPred, SAT_WORKER_SLICE_MS);
+    if (satWorkerWinSearch.count == 0 && !satWorkerWinSearch.done) return;
+
+    for (int i = 0; i < satWorkerWinSearch.count; i++) {
+        SatPass& p = satWorkerWinSearch.passes[i];
+        if (p.aos <= winEnd && p.los >= satWorkerWin.start) {
+            satWorkerWinInsert(satWorkerWinScan, &p);
+            break;  // one entry per satellite
+        }
+    }
+    satWorkerWinAdvance();
+}
+
+// ============================================
+// Task
+// ============================================
+
+static void satPassWorkerTask(void* param) {
+    Serial.println("[SAT] Pass worker started");
+    for (;;) {
+        bool busy = false;
+        if (satWorkerSync()) {
+            // An open sky window is waiting on its scan - serve it first
+            if (!satWorkerWinDone) {
+                satWorkerWinStep();
+                busy = true;
+            } else {
+                busy = satWorkerNpStep();
+            }
+        }
+        if (busy) {
+            vTaskDelay(1);  // let the idle task run (task WDT) between slices
+        } else {
+            // Sleep until poked, or until a pass may have ended
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SAT_WORKER_IDLE_MS));
+        }
+    }
+}
+
+// ============================================
+// Control (loop task)
+// ============================================
+
+// Post the current site/settings. Cheap - call it from the screens' timers;
+// the worker only restarts when something actually changed.
+void satPassWorkerConfigure() {
+    SatWorkerParams p = {};
+    double lat, lon;
+    p.valid = ntpSynced && gridToLatLon(satEffectiveGrid(), &lat, &lon);
+    p.lat = p.valid ? lat : 0.0;
+    p.lon = p.valid ? lon : 0.0;
+    p.minElevation = satSettings.minElevation;
+    p.lookaheadHours = satSettings.lookaheadHours;
+
+    bool changed = false;
+    portENTER_CRITICAL(&satWorkerMux);
+    if (p.valid != satWorkerParams.valid || p.lat != satWorkerParams.lat ||
+        p.lon != satWorkerParams.lon || p.minElevation != satWorkerParams.minElevation ||
+        p.lookaheadHours != satWorkerParams.lookaheadHours) {
+        p.gen = satWorkerParams.gen + 1;
+        satWorkerParams = p;
+        changed = true;
+    }
+    portEXIT_CRITICAL(&satWorkerMux);
+
+    if (changed && satWorkerHandle) xTaskNotifyGive(satWorkerHandle);
+}
+
+// Start the worker (once) and wake it. Safe to call repeatedly.
+bool satPassWorkerStart() {
+    loadSatSettings();
+    loadSatFavorites();  // Preferences access stays on the loop task
+    satPassCacheLoad();  // and so does storage
+    satPassWorkerConfigure();
+
+    if (satWorkerHandle) {
+        xTaskNotifyGive(satWorkerHandle);
+        return true;
+    }
+    if (xTaskCreatePinnedToCore(satPassWorkerTask, "SatPassWorker", SAT_WORKER_STACK,
+                                nullptr, SAT_WORKER_PRIORITY, &satWorkerHandle,
+                                SAT_WORKER_CORE) != pdPASS) {
+        satWorkerHandle = NULL;
+        Serial.println("[SAT] ERROR: Failed to start pass worker");
+        return false;
+    }
+    return true;
+}
+
+// Ask for every pass overlapping [start, start+seconds]. Replaces any
+// earlier request; returns its id for satPassWorkerReadWindow().
+uint32_t satPassWorkerRequestWindow(time_t start, uint32_t seconds) {
+    satPassWorkerConfigure();
+    portENTER_CRITICAL(&satWorkerMux);
+    uint32_t id = satWorkerWinReq.id + 1;
+    if (id == 0) id = 1;
+    satWorkerWinReq.id = id;
+    satWorkerWinReq.start = start;
+    satWorkerWinReq.seconds = seconds;
+    portEXIT_CRITICAL(&satWorkerMux);
+
+    satPassWorkerStart();
+    return id;
+}
+
+// ============================================
+// Snapshot Readers (loop task)
+// ============================================
+
+// Copy the next-pass snapshot if it changed since *seenSeq. Entries from a
+// catalog that has since been replaced read as "not computed".
+bool satPassWorkerReadNextPass(time_t* aos, time_t* los, uint32_t* seenSeq) {
+    for (int attempt = 0; attempt < 4; attempt++) {
+        uint32_t seq = satNpSnap.seq;
+        if (seq == *seenSeq) return false;
+        if (seq & 1) continue;
+        __sync_synchronize();
+        uint32_t gen = satNpSnap.catalogGen;
+        memcpy(aos, satNpSnap.aos, sizeof(satNpSnap.aos));
+        memcpy(los, satNpSnap.los, sizeof(satNpSnap.los));
+        __sync_synchronize();
+        if (satNpSnap.seq != seq) continue;    // torn - the worker published again
+
+        if (gen != satCatalogGeneration) {
+            memset(aos, 0, sizeof(satNpSnap.aos));
+            memset(los, 0, sizeof(satNpSnap.los));
+        }
+        *seenSeq = seq;
+        return true;
+    }
+    return false;  // worker is busy publishing; try again next tick
+}
+
+// Copy the window results for request `id` if they changed since *seenSeq.
+// *scanned / *total report scan progress.
+bool satPassWorkerReadWindow(uint32_t id, SatWindowHit* hits, int* count,
+                             int* scanned, int* total, uint32_t* seenSeq) {
+    for (int attempt = 0; attempt < 4; attempt++) {
+        uint32_t seq = satWinSnap.seq;
+        if (seq == *seenSeq) return false;
+        if (seq & 1) continue;
+        __sync_synchronize();
+        if (satWinSnap.requestId != id || satWinSnap.catalogGen != satCatalogGeneration) {
+            return false;                      // still working on an older request
+        }
+        int n = satWinSnap.count;
+        int s = satWinSnap.scanned;
+        int t = satWinSnap.total;
+        memcpy(hits, satWinSnap.hits, sizeof(SatWindowHit) * n);
+        __sync_synchronize();
+        if (satWinSnap.seq != seq) continue;
+
+        *count = n;
+        *scanned = s;
+        *total = t;
+        *seenSeq = seq;
+        return true;
+    }
+    return false;
+}
+
+#endif // SAT_PASS_WORKER_H
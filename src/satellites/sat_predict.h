@@ -1,8 +1,9 @@
 /*
  * VAIL SUMMIT - Satellite Pass Prediction
  * Chunked SGP4 pass search + live look-angle tracking, built on the vendored
- * propagator in src/thirdparty/sgp4/. All heavy math runs in small time
- * budgets from an LVGL timer so the UI stays responsive (no blocking loops).
+ * propagator in src/thirdparty/sgp4/. Searches on the UI side run in small
+ * time budgets from an LVGL timer so the UI stays responsive (no blocking
+ * loops); catalog-wide sweeps run on the worker task in sat_pass_worker.h.
  */
 
 #ifndef SAT_PREDICT_H
@@ -13,6 +14,8 @@
 #include "../thirdparty/sgp4/sgp4.h"
 #include "../settings/settings_satellites.h"
 #include "sat_data.h"
+#include "sat_elsets.h"
+#include "sat_look.h"
 
 // ============================================
 // Maidenhead Grid -> Lat/Lon
@@ -117,7 +120,9 @@ struct SatPassSearch {
     double startJd;
     double endJd;
     int catalogIdx;      // catalog index being searched
-    uint16_t calls;      // nextpass() invocations - hard runaway backstop
+    uint16_t calls;      // nextpass() invocations
+    uint16_t maxCalls;   // runaway backstop, sized from the window and mean motion
+    double minEl;        // degrees: passes peaking below this are skipped
 };
 
 static SatPassSearch satSearch = { false, false, 0, {}, 0.0, 0.0, -1 };
@@ -135,37 +140,134 @@ static bool satPredictorSetup(int catalogIdx) {
     if (!gridToLatLon(satEffectiveGrid(), &lat, &lon)) return false;
 
     SatEntry& e = satCatalog.sats[catalogIdx];
-    // twoline2rv() mutates the TLE strings while parsing, so hand the
-    // propagator scratch copies - the catalog entries must stay pristine
-    // (they get re-saved to SD and re-parsed on every screen entry).
-    static char l1[130], l2[130];
-    strlcpy(l1, e.line1, sizeof(l1));
-    strlcpy(l2, e.line2, sizeof(l2));
-    // init() no-ops when the same TLE is already loaded - that's fine
-    satPredictor.init(e.name, l1, l2);
+    // Precompiled elements once the table has caught up with the catalog
+    // (sat_elsets.h); until then parse the text TLE
+    if (!satElsetInit(satPredictor, catalogIdx, satCatalogGeneration, e.name, e.line1, e.line2)) {
+        // twoline2rv() mutates the TLE strings while parsing, so hand the
+        // propagator scratch copies - the catalog entries must stay pristine
+        // (they get re-saved to SD).
+        static char l1[130], l2[130];
+        strlcpy(l1, e.line1, sizeof(l1));
+        strlcpy(l2, e.line2, sizeof(l2));
+        // init() no-ops when the same TLE is already loaded - that's fine
+        satPredictor.init(e.name, l1, l2);
+    }
     satPredictor.site(lat, lon, 100.0);  // altitude barely matters for pass times
     return true;
 }
 
-// Begin a pass search for a catalog entry over an arbitrary window.
-bool satStartPassSearchAt(int catalogIdx, time_t startUnix, double windowHours) {
-    memset(&satSearch, 0, sizeof(satSearch));
-    satSearch.catalogIdx = catalogIdx;
+// ============================================
+// Geometric Prefilter
+// ============================================
+//
+// nextpass() walks a bird orbit by orbit to the end of the window, so birds
+// that never qualify are the most expensive ones to search. Most of them
+// can be ruled out from the mean elements alone. The sub-satellite point
+// never leaves |lat| <= inclination (180 - i for retrograde orbits), and
+// from radius r a bird is above minEl only within the Earth central angle
+//
+//   lambda = acos(Re / r * cos(minEl)) - minEl
+//
+// of the station. A station further than lambda (at apogee) outside that
+// latitude band never sees a qualifying pass. Near-geosynchronous birds
+// hardly move in the sky, so one look angle settles those.
+
+#define SAT_PF_EARTH_RADIUS_KM  6378.137   // WGS-84, the propagator's unit of distance
+#define SAT_PF_POLAR_RADIUS_KM  6356.752   // Smaller Re -> larger lambda (conservative)
+#define SAT_PF_MARGIN_DEG       2.0        // Geodetic vs. geocentric latitude, J2 drift
+#define SAT_PF_DECAYED_KM       90.0       // Mean perigee below this: reentering
+#define SAT_PF_GEO_REVPDAY_MIN  0.9
+#define SAT_PF_GEO_REVPDAY_MAX  1.1
+#define SAT_PF_GEO_ECC_MAX      0.05
+
+enum SatPrefilter {
+    SAT_PF_POSSIBLE = 0,   // Search it
+    SAT_PF_DECAYED,        // Perigee inside the atmosphere
+    SAT_PF_OUT_OF_REACH,   // Ground track never comes within lambda of the station
+    SAT_PF_GEO_LOW,        // Parked below minEl
+    SAT_PF_GEO_UP          // Parked above the horizon: no AOS/LOS to find
+};
 
-    if (!ntpSynced) return false;
-    if (!satPredictorSetup(catalogIdx)) return false;
+// Earth central angle (degrees) within which a bird at `radiusKm` is at
+// least `minElDeg` above the horizon
+static double satCoverageAngle(double radiusKm, double minElDeg) {
+    double el = minElDeg * DEG_TO_RAD;
+    double c = SAT_PF_POLAR_RADIUS_KM / radiusKm * cos(el);
+    if (c >= 1.0) return 0.0;
+    return (acos(c) - el) * RAD_TO_DEG;
+}
+
+// Classify an initialized propagator (TLE + site set) for a pass search.
+// Costs one SGP4 evaluation for near-geosynchronous birds, none otherwise.
+static SatPrefilter satPrefilter(vsgp4::Sgp4& pred, time_t atUnix, double minEl) {
+    const vsgp4::elsetrec& r = pred.satrec;
+    if (r.error != 0 || isnan(r.alta) || isnan(r.altp)) return SAT_PF_DECAYED;
+    if (r.altp * SAT_PF_EARTH_RADIUS_KM < SAT_PF_DECAYED_KM) return SAT_PF_DECAYED;
+
+    double incDeg = r.inclo * RAD_TO_DEG;
+    double band = (incDeg <= 90.0) ? incDeg : 180.0 - incDeg;
+    double apogeeKm = (1.0 + r.alta) * SAT_PF_EARTH_RADIUS_KM;
+    double reach = satCoverageAngle(apogeeKm, minEl);
+    if (fabs(pred.siteLat) - band > reach + SAT_PF_MARGIN_DEG) return SAT_PF_OUT_OF_REACH;
+
+    if (pred.revpday > SAT_PF_GEO_REVPDAY_MIN && pred.revpday < SAT_PF_GEO_REVPDAY_MAX &&
+        r.ecco < SAT_PF_GEO_ECC_MAX) {
+        // The daily figure-eight of an inclined GEO swings the look angle
+        // by about its inclination
+        double swing = 3.0 + 1.5 * band;
+        SatLookSite site;
+        SatLook look;
+        satLookSiteSet(&site, pred.siteLat, pred.siteLon, pred.siteAlt);
+        if (!satLookAngles(pred.satrec, site, vsgp4::getJulianFromUnix((double)atUnix), &look) ||
+            isnan(look.el)) {
+            return SAT_PF_DECAYED;
+        }
+        if (look.el + swing < minEl) return SAT_PF_GEO_LOW;
+        if (look.el - swing > 0.0) return SAT_PF_GEO_UP;
+    }
+    return SAT_PF_POSSIBLE;
+}
 
-    satSearch.startJd = vsgp4::getJulianFromUnix((double)startUnix);
-    satSearch.endJd = satSearch.startJd + windowHours / 24.0;
+// Arm a search on an already initialized propagator (TLE + site set).
+// Shared by the UI-side search below and the background pass worker.
+// A bird the prefilter rules out comes back already done with no passes.
+static bool satPassSearchBegin(SatPassSearch& s, vsgp4::Sgp4& pred,
+                               time_t startUnix, double windowHours, double minEl) {
+    s.startJd = vsgp4::getJulianFromUnix((double)startUnix);
+    s.endJd = s.startJd + windowHours / 24.0;
+    s.minEl = minEl;
+
+    if (satPrefilter(pred, startUnix, minEl) != SAT_PF_POSSIBLE) {
+        s.active = false;
+        s.done = true;
+        return true;
+    }
 
-    if (!satPredictor.initpredpoint((unsigned long)startUnix, 0.0)) {
+    // Each call nets about one orbit; allow for rewinds and the passes
+    // themselves, capped at ~10x a worst-case 72h LEO window
+    double orbits = (windowHours / 24.0) * pred.revpday;
+    double budget = orbits * 1.5 + SAT_MAX_PASSES + 8;
+    s.maxCalls = (uint16_t)(budget < 600.0 ? budget : 600.0);
+
+    if (!pred.initpredpoint((unsigned long)startUnix, 0.0)) {
         Serial.println("[SAT] initpredpoint failed");
         return false;
     }
-    satSearch.active = true;
+    s.active = true;
     return true;
 }
 
+// Begin a pass search for a catalog entry over an arbitrary window.
+bool satStartPassSearchAt(int catalogIdx, time_t startUnix, double windowHours) {
+    memset(&satSearch, 0, sizeof(satSearch));
+    satSearch.catalogIdx = catalogIdx;
+
+    if (!ntpSynced) return false;
+    if (!satPredictorSetup(catalogIdx)) return false;
+    return satPassSearchBegin(satSearch, satPredictor, startUnix, windowHours,
+                              (double)satSettings.minElevation);
+}
+
 // Begin a pass search over the configured lookahead window starting now.
 bool satStartPassSearch(int catalogIdx) {
     return satStartPassSearchAt(catalogIdx, time(nullptr), (double)satSettings.lookaheadHours);
@@ -173,20 +275,19 @@ bool satStartPassSearch(int catalogIdx) {
 
 // Run search iterations for up to budgetMs. Each nextpass(1 iteration) call
 // advances the predictor by roughly one orbit. Returns true when finished.
-bool satPassSearchStep(uint32_t budgetMs) {
-    if (!satSearch.active) return true;
+static bool satPassSearchRun(SatPassSearch& s, vsgp4::Sgp4& pred, uint32_t budgetMs) {
+    if (!s.active) return true;
 
     uint32_t t0 = millis();
     vsgp4::passinfo p;
 
     while ((millis() - t0) < budgetMs) {
-        // 600 calls is ~10x a worst-case 72h LEO window - anything past that
-        // is a runaway, not a search
-        if (satSearch.count >= SAT_MAX_PASSES ||
-            satSearch.calls++ > 600 ||
-            satPredictor.getpredpoint() > satSearch.endJd) {
-            satSearch.active = false;
-            satSearch.done = true;
+        // Past maxCalls is a runaway, not a search
+        if (s.count >= SAT_MAX_PASSES ||
+            s.calls++ > s.maxCalls ||
+            pred.getpredpoint() > s.endJd) {
+            s.active = false;
+            s.done = true;
             return true;
         }
 
@@ -204,23 +305,23 @@ bool satPassSearchStep(uint32_t budgetMs) {
         // can fail), and blindly rewinding one orbit after a one-orbit
         // advance nets zero progress - the search then spins on the same
         // satellite forever (NaN also disables the endJd termination).
-        double before = satPredictor.getpredpoint();
-        bool found = satPredictor.nextpass(&p, 2, false, (double)satSettings.minElevation);
-        double after = satPredictor.getpredpoint();
-        double jump = (satPredictor.revpday > 0.1) ? (1.0 / satPredictor.revpday) : 0.0;
+        double before = pred.getpredpoint();
+        bool found = pred.nextpass(&p, 2, false, s.minEl);
+        double after = pred.getpredpoint();
+        double jump = (pred.revpday > 0.1) ? (1.0 / pred.revpday) : 0.0;
 
         if (isnan(after) || after <= before || jump <= 0.0) {
             // Propagation or bracket search went sideways - this bird is
             // unusable with the current TLE. Report "no passes" and move on.
-            satSearch.active = false;
-            satSearch.done = true;
+            s.active = false;
+            s.done = true;
             return true;
         }
 
         if (!found) {
             // Only un-hop the final orbit when both hops actually happened
             if (after - before >= 1.5 * jump) {
-                satPredictor.setpredpoint(after - jump);
+                pred.setpredpoint(after - jump);
             }
             continue;
         }
@@ -231,14 +332,14 @@ bool satPassSearchStep(uint32_t budgetMs) {
             continue;
         }
 
-        if (p.jdstop < satSearch.startJd) continue;      // pass already over
-        if (p.jdstart > satSearch.endJd) {               // beyond the window
-            satSearch.active = false;
-            satSearch.done = true;
+        if (p.jdstop < s.startJd) continue;      // pass already over
+        if (p.jdstart > s.endJd) {               // beyond the window
+            s.active = false;
+            s.done = true;
             return true;
         }
 
-        SatPass& sp = satSearch.passes[satSearch.count++];
+        SatPass& sp = s.passes[s.count++];
         sp.aos = (time_t)vsgp4::getUnixFromJulian(p.jdstart);
         sp.los = (time_t)vsgp4::getUnixFromJulian(p.jdstop);
         sp.tmax = (time_t)vsgp4::getUnixFromJulian(p.jdmax);
@@ -250,6 +351,11 @@ bool satPassSearchStep(uint32_t budgetMs) {
     return false;  // budget exhausted, more to do
 }
 
+// Step the shared UI-side search (passes screen).
+bool satPassSearchStep(uint32_t budgetMs) {
+    return satPassSearchRun(satSearch, satPredictor, budgetMs);
+}
+
 // Search progress 0-100 for the progress label
 int satPassSearchProgress() {
     if (satSearch.done) return 100;
@@ -280,10 +386,19 @@ bool satLiveUpdate(int catalogIdx, SatLiveState* out) {
     if (!ntpSynced) return false;
     if (!satPredictorSetup(catalogIdx)) return false;
 
-    satPredictor.findsat((unsigned long)time(nullptr));
-    out->az = (float)satPredictor.satAz;
-    out->el = (float)satPredictor.satEl;
-    out->distKm = (float)satPredictor.satDist;
+    static SatLookSite site;
+    static double siteLat = NAN, siteLon = NAN;
+    if (satPredictor.siteLat != siteLat || satPredictor.siteLon != siteLon) {
+        siteLat = satPredictor.siteLat;
+        siteLon = satPredictor.siteLon;
+        satLookSiteSet(&site, siteLat, siteLon, satPredictor.siteAlt);
+    }
+    SatLook look;
+    double jd = vsgp4::getJulianFromUnix((double)time(nullptr));
+    if (!satLookAngles(satPredictor.satrec, site, jd, &look)) return false;
+    out->az = look.az;
+    out->el = look.el;
+    out->distKm = look.rangeKm;
     out->valid = true;
     return true;
 }
@@ -0,0 +1,225 @@
+/*
+ * VAIL SUMMIT - Pass Track Tables
+ * Look angles and range rate sampled across one selected pass, computed a
+ * few SGP4 steps at a time from an LVGL timer while the pass detail / live
+ * screens are open. The sky plot and the Doppler readout interpolate the
+ * table, so nothing on those screens runs SGP4 per frame. Points come from
+ * satLookAngles() (sat_look.h), which gives the range rate directly.
+ */
+
+#ifndef SAT_TRACK_H
+#define SAT_TRACK_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "sat_data.h"
+#include "sat_predict.h"
+#include "sat_look.h"
+#include "sat_freqs.h"
+#include "sat_xmtrs.h"
+
+// ============================================
+// Configuration
+// ============================================
+
+#define SAT_TRACK_MAX_POINTS  360       // 30 min at the minimum step
+#define SAT_TRACK_MIN_STEP    5         // seconds; longer passes get a coarser step
+#define SAT_TRACK_SPEED_OF_LIGHT 299792458.0
+
+// ============================================
+// Data Structures
+// ============================================
+
+// One sample, 8 bytes
+struct SatTrackPoint {
+    int16_t az;             // 0.1 degree
+    int16_t el;             // 0.1 degree
+    int16_t rangeRate;      // m/s, positive = receding
+    uint16_t rangeKm;
+};
+
+struct SatTrack {
+    int catalogIdx;         // -1 = none
+    uint32_t catalogGen;    // satCatalogGeneration it was computed from
+    time_t aos;             // point i is at aos + i * step
+    time_t los;
+    uint16_t step;          // seconds
+    uint16_t count;         // points the pass needs
+    uint16_t filled;        // points computed so far
+    bool ready;             // filled == count
+    SatTrackPoint points[SAT_TRACK_MAX_POINTS];
+};
+
+struct SatTrackSample {
+    float az;
+    float el;
+    float rangeKm;
+    float rangeRate;        // m/s
+};
+
+static SatTrack satTrack = { -1 };
+
+// Own propagator: the live view's satPredictor keeps its TLE/site
+static vsgp4::Sgp4 satTrackPred;
+static SatLookSite satTrackSite;
+
+// ============================================
+// Generation (loop task, timer slices)
+// ============================================
+
+// Start a table for a pass of a catalog entry. Cheap; the points are filled
+// by satTrackStep(). A request for the table already held is a no-op.
+bool satTrackStart(int catalogIdx, const SatPass& pass) {
+    if (satTrack.catalogIdx == catalogIdx && satTrack.catalogGen == satCatalogGeneration &&
+        satTrack.aos == pass.aos && satTrack.los == pass.los) {
+        return true;
+    }
+    satTrack.catalogIdx = -1;
+    satTrack.ready = false;
+    if (!satCatalog.valid || catalogIdx < 0 || catalogIdx >= satCatalog.count) return false;
+    if (pass.los <= pass.aos) return false;
+
+    double lat, lon;
+    if (!gridToLatLon(satEffectiveGrid(), &lat, &lon)) return false;
+    SatEntry& e = satCatalog.sats[catalogIdx];
+    if (!satElsetInit(satTrackPred, catalogIdx, satCatalogGeneration, e.name, e.line1, e.line2)) {
+        static char l1[130], l2[130];   // twoline2rv() mutates its input
+        strlcpy(l1, e.line1, sizeof(l1));
+        strlcpy(l2, e.line2, sizeof(l2));
+        satTrackPred.init(e.name, l1, l2);
+    }
+    satLookSiteSet(&satTrackSite, lat, lon, 0.1);
+
+    long duration = (long)(pass.los - pass.aos);
+    long step = (duration + SAT_TRACK_MAX_POINTS - 3) / (SAT_TRACK_MAX_POINTS - 2);
+    if (step < SAT_TRACK_MIN_STEP) step = SAT_TRACK_MIN_STEP;
+
+    satTrack.catalogIdx = catalogIdx;
+    satTrack.catalogGen = satCatalogGeneration;
+    satTrack.aos = pass.aos;
+    satTrack.los = pass.los;
+    satTrack.step = (uint16_t)step;
+    satTrack.count = (uint16_t)(duration / step + 2);  // last point at or past LOS
+    satTrack.filled = 0;
+    return true;
+}
+
+// Forget the table
+void satTrackClear() {
+    satTrack.catalogIdx = -1;
+    satTrack.ready = false;
+}
+
+// Compute points for up to budgetMs. Returns true once the table is ready.
+bool satTrackStep(uint32_t budgetMs) {
+    if (satTrack.catalogIdx < 0) return false;
+    if (satTrack.ready) return true;
+
+    uint32_t t0 = millis();
+    while (satTrack.filled < satTrack.count && (millis() - t0) < budgetMs) {
+        int i = satTrack.filled;
+        double jd = vsgp4::getJulianFromUnix((double)(satTrack.aos + (time_t)i * satTrack.step));
+        SatLook look;
+        if (!satLookAngles(satTrackPred.satrec, satTrackSite, jd, &look) || isnan(look.el)) {
+            satTrackClear();    // decayed / bad TLE: no table
+            return false;
+        }
+
+        SatTrackPoint& p = satTrack.points[i];
+        p.az = (int16_t)lroundf(look.az * 10.0f);
+        p.el = (int16_t)lroundf(look.el * 10.0f);
+        p.rangeKm = (uint16_t)constrain(lroundf(look.rangeKm), 0L, 65535L);
+        p.rangeRate = (int16_t)constrain(lroundf(look.rangeRate), -32767L, 32767L);
+        satTrack.filled++;
+    }
+    satTrack.ready = (satTrack.filled >= satTrack.count);
+    return satTrack.ready;
+}
+
+// Progress 0-100 for status text
+int satTrackProgress() {
+    if (satTrack.catalogIdx < 0 || satTrack.count == 0) return 0;
+    return (int)(satTrack.filled * 100L / satTrack.count);
+}
+
+// ============================================
+// Lookup
+// ============================================
+
+// Interpolated sample at unix time `t`. False until the table is ready and
+// outside the pass. Azimuth interpolates the short way round through north.
+bool satTrackSample(double t, SatTrackSample* out) {
+    if (satTrack.catalogIdx < 0 || !satTrack.ready) return false;
+    double x = (t - (double)satTrack.aos) / satTrack.step;
+    if (x < 0.0 || x > satTrack.count - 1) return false;
+
+    int i = (int)x;
+    if (i >= satTrack.count - 1) i = satTrack.count - 2;
+    float f = (float)(x - i);
+    const SatTrackPoint& a = satTrack.points[i];
+    const SatTrackPoint& b = satTrack.points[i + 1];
+
+    float dAz = (b.az - a.az) / 10.0f;
+    if (dAz > 180.0f) dAz -= 360.0f;
+    if (dAz < -180.0f) dAz += 360.0f;
+    float az = a.az / 10.0f + dAz * f;
+    if (az < 0.0f) az += 360.0f;
+    if (az >= 360.0f) az -= 360.0f;
+
+    out->az = az;
+    out->el = (a.el + (b.el - a.el) * f) / 10.0f;
+    out->rangeKm = a.rangeKm + (b.rangeKm - a.rangeKm) * f;
+    out->rangeRate = a.rangeRate + (b.rangeRate - a.rangeRate) * f;
+    return true;
+}
+
+// ============================================
+// Doppler
+// ============================================
+
+// Frequency heard on the ground for a satellite transmitting on `hz`
+uint32_t satDopplerDownlinkHz(uint32_t hz, float rangeRate) {
+    return (uint32_t)llround(hz * (1.0 - rangeRate / SAT_TRACK_SPEED_OF_LIGHT));
+}
+
+// Frequency to transmit so the satellite hears `hz`
+uint32_t satDopplerUplinkHz(uint32_t hz, float rangeRate) {
+    return (uint32_t)llround(hz * (1.0 + rangeRate / SAT_TRACK_SPEED_OF_LIGHT));
+}
+
+// First MHz figure of a curated frequency string, or the center of an
+// "a-b" passband ("145.935-145.995"); 0 if there is none
+static uint32_t satFreqTextHz(const char* text) {
+    if (!text) return 0;
+    char* end;
+    double lo = strtod(text, &end);
+    if (end == text || lo <= 0.0) return 0;
+    if (*end == '-' && isdigit((unsigned char)end[1])) {
+        double hi = strtod(end + 1, NULL);
+        if (hi > 0.0) lo = (lo + hi) / 2.0;
+    }
+    return (uint32_t)llround(lo * 1e6);
+}
+
+// Nominal downlink/uplink for the Doppler readout: the curated table first
+// (as on the pass detail screen), else the SatNOGS entry satBestXmtr()
+// picks. False if neither has one.
+bool satTrackFreqs(uint32_t norad, uint32_t* downHz, uint32_t* upHz) {
+    *downHz = 0;
+    *upHz = 0;
+    const SatFreqInfo* fi = lookupSatFreqs(norad);
+    if (fi) {
+        *downHz = satFreqTextHz(fi->downlink);
+        *upHz = satFreqTextHz(fi->uplink);
+    }
+    if (*downHz == 0 && *upHz == 0) {
+        const SatTransmitter* x = satBestXmtr(norad);
+        if (x) {
+            *downHz = x->downHz;
+            *upHz = x->upHz;
+        }
+    }
+    return *downHz != 0 || *upHz != 0;
+}
+
+#endif // SAT_TRACK_H
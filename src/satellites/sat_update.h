@@ -31,17 +31,12 @@ struct SatUpdateJob {
     char line[96];
     int linePos;
     SatTLEParseState tleSt;
-    // transmitter JSON object splitter
-    int oPos;                // -1 = between objects
-    int depth;
-    bool inStr, esc;
     // result
     bool finishedOk;
 };
 
 static SatUpdateJob satUpd = {};
 static HTTPClient satUpdHttp;        // reused across stages; too big for stack
-static char satUpdObj[2048];
 static char satUpdChunk[512];
 
 bool satUpdateJobActive() { return satUpd.stage != SATUPD_IDLE; }
@@ -51,23 +46,22 @@ static void satUpdResetStageState() {
     satUpd.stageTotal = -1;
     satUpd.linePos = 0;
     memset(&satUpd.tleSt, 0, sizeof(satUpd.tleSt));
-    satUpd.oPos = -1;
-    satUpd.depth = 0;
-    satUpd.inStr = false;
-    satUpd.esc = false;
+    satXmtrParseBegin();
 }
 
 // Begin the staged update. Caller must have WiFi up.
 bool satUpdateJobStart() {
     if (satUpdateJobActive()) return true;
     if (WiFi.status() != WL_CONNECTED) return false;
-    if (!initSatCatalog() || !initSatXmtrs()) return false;
+    if (!initSatCatalog()) return false;
 
     memset(&satUpd, 0, sizeof(satUpd));
-    // Rebuild from scratch so decayed/renamed birds don't linger
+    // Rebuild from scratch so decayed/renamed birds don't linger. The edit
+    // closes once both TLE stages are done (the transmitter stage doesn't
+    // touch the catalog).
+    satCatalogBeginEdit();
     satCatalog.count = 0;
     satCatalog.valid = false;
-    satXmtrCount = 0;
     satUpd.stage = SATUPD_TLE_AMATEUR;
     satUpdResetStageState();
     return true;
@@ -102,13 +96,14 @@ static void satUpdAdvanceStage() {
                 satUpd.finishedOk = false;
                 satUpd.stage = SATUPD_IDLE;
             }
+            satCatalogEndEdit();
+            // Saving now picks the storage the transmitter spool goes to
+            if (satUpd.stage == SATUPD_XMTRS) satSaveTLEs();
             break;
         case SATUPD_XMTRS:
-            satSaveTLEs();
-            if (satXmtrCount > 0) {
-                satXmtrsLoaded = true;
-                satSaveXmtrs();
-            }
+            Serial.printf("[SAT] %lu transmitters parsed, %d kept\n",
+                          (unsigned long)satXmtrSeen, satXmtrSpooled);
+            if (satXmtrSpooled > 0) satSaveXmtrs();
             satUpd.finishedOk = true;   // TLEs are in; missing freqs tolerated
             satUpd.stage = SATUPD_IDLE;
             break;
@@ -121,33 +116,7 @@ static void satUpdAdvanceStage() {
 
 static void satUpdConsumeByte(char c) {
     if (satUpd.stage == SATUPD_XMTRS) {
-        // Split the JSON array into per-transmitter objects
-        if (satUpd.oPos < 0) {
-            if (c == '{') {
-                satUpd.depth = 1;
-                satUpd.oPos = 0;
-                satUpdObj[satUpd.oPos++] = c;
-                satUpd.inStr = false;
-                satUpd.esc = false;
-            }
-            return;
-        }
-        if (satUpd.oPos < (int)sizeof(satUpdObj) - 1) satUpdObj[satUpd.oPos++] = c;
-        if (satUpd.esc) { satUpd.esc = false; return; }
-        if (satUpd.inStr) {
-            if (c == '\\') satUpd.esc = true;
-            else if (c == '"') satUpd.inStr = false;
-            return;
-        }
-        if (c == '"') satUpd.inStr = true;
-        else if (c == '{') satUpd.depth++;
-        else if (c == '}') {
-            if (--satUpd.depth == 0) {
-                satUpdObj[satUpd.oPos] = '\0';
-                satParseXmtrObject(satUpdObj);
-                satUpd.oPos = -1;
-            }
-        }
+        satXmtrParseByte(c);
         return;
     }
 
@@ -173,6 +142,7 @@ void satUpdateJobTick(uint32_t budgetMs) {
         if (!url) { satUpd.stage = SATUPD_IDLE; return; }
         satUpdHttp.setTimeout(15000);
         satUpdHttp.setReuse(false);
+        satUpdHttp.useHTTP10(true);     // no chunk headers mixed into the body
         satUpdHttp.begin(url);
         int code = satUpdHttp.GET();
         if (code != HTTP_CODE_OK) {
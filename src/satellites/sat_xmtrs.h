@@ -1,56 +1,66 @@
 /*
  * VAIL SUMMIT - Satellite Transmitter Database
  * Fetches the SatNOGS DB transmitter list (community-maintained), keeps only
- * active entries for satellites present in the TLE catalog, and caches them
- * beside the TLEs (SD preferred, internal SPIFFS fallback) so all frequency
- * data is available offline in the field.
+ * active amateur CW / FM / linear transmitters for satellites present in the
+ * TLE catalog, and caches them beside the TLEs so all frequency data is
+ * available offline in the field.
+ *
+ * The upstream list is several MB of JSON. It is tokenized byte by byte as
+ * it streams in (no document, no per-object buffer), and the records kept
+ * are appended to a spool file as they are found. Once the download ends
+ * the spool is merge-sorted by NORAD id on the card into the table file.
+ * Lookups binary-search that file through a one-record buffer, so neither
+ * ingestion nor lookups hold the table in RAM and it has no size cap.
  */
 
 #ifndef SAT_XMTRS_H
 #define SAT_XMTRS_H
 
 #include <Arduino.h>
-#include <HTTPClient.h>
-#include <ArduinoJson.h>
-#include <esp_task_wdt.h>
+#include <SPIFFS.h>
+#include "../storage/atomic_file.h"
+#include "../network/json_stream.h"
 #include "sat_data.h"
 
-#define SAT_XMTR_URL      "https://db.satnogs.org/api/transmitters/?format=json"
-#define SAT_XMTR_FILE     "/sat/freqs.txt"
-#define SAT_XMTR_MAX      800
-#define SAT_XMTR_PER_SAT  8
-#define SAT_XMTR_TIMEOUT  30000
+#define SAT_XMTR_URL         "https://db.satnogs.org/api/transmitters/?format=json"
+#define SAT_XMTR_FILE        "/satellites/xmtrs.bin"
+#define SAT_XMTR_SPOOL_FILE  "/satellites/xmtrs.spl"   // records kept, download order
+#define SAT_XMTR_SORT_FILE   "/satellites/xmtrs.srt"   // merge sort scratch
+#define SAT_XMTR_LEGACY_FILE "/sat/freqs.txt"          // text cache of older builds
+#define SAT_XMTR_MAGIC       0x314D5853                // "SXM1"
+#define SAT_XMTR_VERSION     1
+#define SAT_XMTR_FILE_MAX    65535                     // header count field
+#define SAT_XMTR_TIMEOUT     30000
 
 struct SatTransmitter {
     uint32_t norad;
     uint32_t downHz;      // 0 = none
     uint32_t upHz;        // 0 = none / receive-only
     uint8_t invert;       // inverting transponder
-    char mode[14];        // "FM", "SSB", "CW", "GMSK9k6", ...
+    char mode[14];        // "FM", "USB", "LSB", "CW", ...
     char desc[40];        // "Mode U/V FM Voice Repeater"
 };
 
-static SatTransmitter* satXmtrs = NULL;
+struct __attribute__((packed)) SatXmtrFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;             // records that follow, sorted by norad
+    uint32_t recSize;           // sizeof(SatTransmitter) of the build that wrote it
+};
+
+// Open table. Lookups read one record at a time into satXmtrBuf; pointers
+// they return stay valid until the next lookup.
+static File satXmtrFile;
+static uint32_t satXmtrBase = 0;      // file offset of record 0
 static int satXmtrCount = 0;
 static bool satXmtrsLoaded = false;   // load-from-storage attempted
+static SatTransmitter satXmtrBuf;
+static int satXmtrBufAt = -1;         // record held in satXmtrBuf
 
-static bool initSatXmtrs() {
-    if (satXmtrs) return true;
-    size_t totalSize = sizeof(SatTransmitter) * SAT_XMTR_MAX;
-    if (psramFound()) {
-        satXmtrs = (SatTransmitter*)ps_malloc(totalSize);
-    }
-    if (!satXmtrs) {
-        satXmtrs = (SatTransmitter*)malloc(totalSize);
-    }
-    if (!satXmtrs) {
-        Serial.println("[SAT] ERROR: transmitter table allocation failed");
-        return false;
-    }
-    memset(satXmtrs, 0, totalSize);
-    satXmtrCount = 0;
-    return true;
-}
+// Spool being filled by a download (or the legacy import)
+static File satXmtrSpool;
+static fs::FS* satXmtrSpoolFS = NULL;
+static int satXmtrSpooled = 0;
 
 static bool satCatalogHasNorad(uint32_t norad) {
     for (int i = 0; i < satCatalog.count; i++) {
@@ -59,41 +69,72 @@ static bool satCatalogHasNorad(uint32_t norad) {
     return false;
 }
 
+// Record i of the open table, read into the shared buffer; NULL past the
+// end or on a read error
+static const SatTransmitter* satXmtrAt(int i) {
+    if (i < 0 || i >= satXmtrCount || !satXmtrFile) return NULL;
+    if (i != satXmtrBufAt) {
+        // Scanning forward the file is already there
+        bool next = satXmtrBufAt >= 0 && i == satXmtrBufAt + 1;
+        satXmtrBufAt = -1;
+        if ((!next && !satXmtrFile.seek(satXmtrBase + (uint32_t)i * sizeof(SatTransmitter))) ||
+            satXmtrFile.read((uint8_t*)&satXmtrBuf, sizeof(satXmtrBuf)) != sizeof(satXmtrBuf)) {
+            return NULL;
+        }
+        satXmtrBufAt = i;
+    }
+    return &satXmtrBuf;
+}
+
+// Index of the first entry for a satellite (or where it would go). The
+// table is sorted by norad; entries of one satellite keep SatNOGS order.
+static int satXmtrLowerBound(uint32_t norad) {
+    int lo = 0, hi = satXmtrCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        const SatTransmitter* x = satXmtrAt(mid);
+        if (!x) return satXmtrCount;
+        if (x->norad < norad) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
 // Number of stored transmitters for a satellite
 int satXmtrCountFor(uint32_t norad) {
     int n = 0;
-    for (int i = 0; i < satXmtrCount; i++) {
-        if (satXmtrs[i].norad == norad) n++;
+    for (int i = satXmtrLowerBound(norad); ; i++) {
+        const SatTransmitter* x = satXmtrAt(i);
+        if (!x || x->norad != norad) break;
+        n++;
     }
     return n;
 }
 
 // nth (0-based) transmitter for a satellite, or NULL
 const SatTransmitter* satXmtrFor(uint32_t norad, int nth) {
-    for (int i = 0; i < satXmtrCount; i++) {
-        if (satXmtrs[i].norad != norad) continue;
-        if (nth-- == 0) return &satXmtrs[i];
-    }
-    return NULL;
+    if (nth < 0) return NULL;
+    const SatTransmitter* x = satXmtrAt(satXmtrLowerBound(norad) + nth);
+    return (x && x->norad == norad) ? x : NULL;
 }
 
 // Best single entry for compact displays: prefer two-way voice (repeater /
 // transponder, i.e. has both uplink and downlink), else anything with a
 // downlink, else the first entry.
 const SatTransmitter* satBestXmtr(uint32_t norad) {
-    const SatTransmitter* withBoth = NULL;
-    const SatTransmitter* withDown = NULL;
-    const SatTransmitter* any = NULL;
-    for (int i = 0; i < satXmtrCount; i++) {
-        SatTransmitter& x = satXmtrs[i];
-        if (x.norad != norad) continue;
-        if (!any) any = &x;
-        if (x.downHz && !withDown) withDown = &x;
-        if (x.downHz && x.upHz && !withBoth) withBoth = &x;
+    int first = satXmtrLowerBound(norad);
+    int withBoth = -1, withDown = -1;
+    int i = first;
+    for (; ; i++) {
+        const SatTransmitter* x = satXmtrAt(i);
+        if (!x || x->norad != norad) break;
+        if (x->downHz && withDown < 0) withDown = i;
+        if (x->downHz && x->upHz && withBoth < 0) withBoth = i;
     }
-    if (withBoth) return withBoth;
-    if (withDown) return withDown;
-    return any;
+    if (i == first) return NULL;
+    if (withBoth >= 0) return satXmtrAt(withBoth);
+    if (withDown >= 0) return satXmtrAt(withDown);
+    return satXmtrAt(first);
 }
 
 // "437.200" from Hz; "-" when absent
@@ -103,62 +144,184 @@ void satFmtMHz(uint32_t hz, char* buf, size_t n) {
              (unsigned long)((hz % 1000000UL) / 1000UL));
 }
 
-static void satAddXmtr(uint32_t norad, uint32_t down, uint32_t up, bool invert,
-                       const char* mode, const char* desc) {
-    if (satXmtrCount >= SAT_XMTR_MAX) return;
-    if (satXmtrCountFor(norad) >= SAT_XMTR_PER_SAT) return;
-    SatTransmitter& x = satXmtrs[satXmtrCount++];
-    memset(&x, 0, sizeof(SatTransmitter));
+// CW, FM voice and linear (SSB) transponders - what can be worked with a
+// handheld or an all-mode rig. Data modes (AFSK, GMSK, BPSK, ...) are not kept.
+static bool satXmtrModeWanted(const char* mode, const char* type) {
+    static const char* const modes[] = { "CW", "FM", "FMN", "SSB", "USB", "LSB" };
+    if (strcmp(type, "Transponder") == 0) return true;
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        if (strcmp(mode, modes[i]) == 0) return true;
+    }
+    return false;
+}
+
+// ============================================
+// Storage (next to the TLE cache)
+// ============================================
+
+static void satXmtrClose() {
+    if (satXmtrFile) satXmtrFile.close();
+    satXmtrCount = 0;
+    satXmtrBufAt = -1;
+}
+
+// Drop any spool a download left behind and start an empty one
+static void satXmtrSpoolReset() {
+    if (satXmtrSpool) satXmtrSpool.close();
+    if (satXmtrSpoolFS) {
+        satXmtrSpoolFS->remove(SAT_XMTR_SPOOL_FILE);
+        satXmtrSpoolFS = NULL;
+    }
+    satXmtrSpooled = 0;
+}
+
+// Append a record to the spool (opened on first use, on the TLE storage)
+static void satXmtrSpoolAdd(uint32_t norad, uint32_t down, uint32_t up, bool invert,
+                            const char* mode, const char* desc) {
+    if (satXmtrSpooled >= SAT_XMTR_FILE_MAX) return;
+    if (!satXmtrSpool) {
+        if (satXmtrSpoolFS) return;  // opened once already and failed since
+        fs::FS* fs = satTLEStorageFS();
+        if (!fs) return;
+        if (fs == &SD && !SD.exists(SAT_SD_DIR)) SD.mkdir(SAT_SD_DIR);
+        satXmtrSpoolFS = fs;
+        satXmtrSpool = fs->open(SAT_XMTR_SPOOL_FILE, FILE_WRITE);
+        if (!satXmtrSpool) {
+            Serial.println("[SAT] ERROR: transmitter spool not opened");
+            return;
+        }
+    }
+
+    SatTransmitter x;
+    memset(&x, 0, sizeof(x));
     x.norad = norad;
     x.downHz = down;
     x.upHz = up;
     x.invert = invert ? 1 : 0;
     strlcpy(x.mode, mode ? mode : "", sizeof(x.mode));
     strlcpy(x.desc, desc ? desc : "", sizeof(x.desc));
+    if (satXmtrSpool.write((const uint8_t*)&x, sizeof(x)) != sizeof(x)) {
+        Serial.println("[SAT] ERROR: transmitter spool write failed");
+        satXmtrSpool.close();
+        return;
+    }
+    satXmtrSpooled++;
 }
 
-// ============================================
-// Storage (mirrors the TLE cache: SD then SPIFFS)
-// ============================================
+static bool satXmtrReadRec(File& f, SatTransmitter& x) {
+    return f.read((uint8_t*)&x, sizeof(x)) == sizeof(x);
+}
 
-static bool satWriteXmtrFile(fs::FS& fs) {
-    File f = fs.open(SAT_XMTR_FILE, FILE_WRITE);
-    if (!f) return false;
-    for (int i = 0; i < satXmtrCount; i++) {
-        SatTransmitter& x = satXmtrs[i];
-        // desc is last so embedded commas are harmless
-        f.printf("%lu,%lu,%lu,%u,%s,%s\n", (unsigned long)x.norad,
-                 (unsigned long)x.downHz, (unsigned long)x.upHz,
-                 (unsigned)x.invert, x.mode, x.desc);
+// One bottom-up merge pass: sorted runs of `width` records in `src` are
+// merged pairwise into `out`, reading each run a record at a time
+static bool satXmtrMergePass(fs::FS& fs, const char* src, uint32_t count, uint32_t width, Print& out) {
+    File a = fs.open(src, FILE_READ);
+    File b = fs.open(src, FILE_READ);
+    bool ok = a && b;
+    SatTransmitter ra, rb;
+    for (uint32_t lo = 0; ok && lo < count; lo += 2 * width) {
+        uint32_t mid = min(lo + width, count);
+        uint32_t hi = min(lo + 2 * width, count);
+        uint32_t i = lo, j = mid;
+        bool haveA = a.seek(i * sizeof(SatTransmitter)) && satXmtrReadRec(a, ra);
+        bool haveB = j < hi && b.seek(j * sizeof(SatTransmitter)) && satXmtrReadRec(b, rb);
+        while (ok && (haveA || haveB)) {
+            // Ties take the left run, keeping SatNOGS order within a satellite
+            if (haveA && (!haveB || ra.norad <= rb.norad)) {
+                ok = out.write((const uint8_t*)&ra, sizeof(ra)) == sizeof(ra);
+                haveA = ++i < mid && satXmtrReadRec(a, ra);
+            } else {
+                ok = out.write((const uint8_t*)&rb, sizeof(rb)) == sizeof(rb);
+                haveB = ++j < hi && satXmtrReadRec(b, rb);
+            }
+        }
+        ok = ok && i == mid && j == hi;  // a short read lost records
     }
-    f.close();
-    return true;
+    if (a) a.close();
+    if (b) b.close();
+    return ok;
 }
 
+static bool satReadXmtrFile(fs::FS& fs);
+
+/*
+ * Sort the spool into the table file and reopen it for lookups. Bottom-up
+ * merge sort between the spool and a scratch file, two records of RAM
+ * whatever the count; the last pass writes the table through an
+ * AtomicFileWriter, so a failure keeps the previous table.
+ */
 bool satSaveXmtrs() {
-    if (satXmtrCount == 0) return false;
-    if (!sdCardAvailable) initSDCard();
-    if (sdCardAvailable) {
-        if (!SD.exists(SAT_SD_DIR)) SD.mkdir(SAT_SD_DIR);
-        if (satWriteXmtrFile(SD)) {
-            Serial.printf("[SAT] Saved %d transmitters to SD\n", satXmtrCount);
-            return true;
+    if (satXmtrSpool) satXmtrSpool.close();
+    fs::FS* fs = satXmtrSpoolFS;
+    uint32_t count = (uint32_t)satXmtrSpooled;
+    if (!fs || count == 0) return false;
+
+    satXmtrClose();  // not open while it is replaced
+    const char* src = SAT_XMTR_SPOOL_FILE;
+    const char* dst = SAT_XMTR_SORT_FILE;
+    bool ok = true;
+    for (uint32_t width = 1; ok; width *= 2) {
+        if (width * 2 >= count) {
+            SatXmtrFileHeader h = {};
+            h.magic = SAT_XMTR_MAGIC;
+            h.version = SAT_XMTR_VERSION;
+            h.count = (uint16_t)count;
+            h.recSize = sizeof(SatTransmitter);
+
+            AtomicFileWriter out(*fs, SAT_XMTR_FILE);
+            ok = out.begin() && out.write((const uint8_t*)&h, sizeof(h)) == sizeof(h) &&
+                 satXmtrMergePass(*fs, src, count, width, out) && out.commit();
+            break;
         }
+        File pass = fs->open(dst, FILE_WRITE);
+        ok = pass && satXmtrMergePass(*fs, src, count, width, pass);
+        if (pass) pass.close();
+        const char* t = src;
+        src = dst;
+        dst = t;
     }
-    if (satEnsureFlashFS() && satWriteXmtrFile(SPIFFS)) {
-        Serial.printf("[SAT] Saved %d transmitters to flash\n", satXmtrCount);
-        return true;
+    fs->remove(SAT_XMTR_SORT_FILE);
+    satXmtrSpoolReset();
+
+    if (!ok) Serial.println("[SAT] ERROR: transmitter cache not saved");
+    else if (fs->exists(SAT_XMTR_LEGACY_FILE)) fs->remove(SAT_XMTR_LEGACY_FILE);
+    satXmtrsLoaded = true;
+    if (satReadXmtrFile(*fs) && ok) {
+        Serial.printf("[SAT] Saved %d transmitters\n", satXmtrCount);
     }
-    Serial.println("[SAT] ERROR: transmitter cache not saved");
-    return false;
+    return ok;
 }
 
+// Open the table file for lookups (left open; satXmtrClose() closes it)
 static bool satReadXmtrFile(fs::FS& fs) {
-    File f = fs.open(SAT_XMTR_FILE);
+    satXmtrClose();
+    AtomicFileInfo info;
+    File f = atomicFileOpen(fs, SAT_XMTR_FILE, &info);
     if (!f) return false;
-    satXmtrCount = 0;
+
+    SatXmtrFileHeader h;
+    if (info.status == ATOMIC_FILE_LEGACY ||
+        f.read((uint8_t*)&h, sizeof(h)) != sizeof(h) ||
+        h.magic != SAT_XMTR_MAGIC || h.version != SAT_XMTR_VERSION ||
+        h.recSize != sizeof(SatTransmitter) ||
+        info.length != sizeof(h) + (uint32_t)h.count * sizeof(SatTransmitter)) {
+        f.close();
+        Serial.println("[SAT] Transmitter cache unreadable");
+        return false;
+    }
+    satXmtrFile = f;
+    satXmtrBase = f.position();
+    satXmtrCount = h.count;
+    return satXmtrCount > 0;
+}
+
+// One-time import of the text cache older builds wrote
+static bool satReadLegacyXmtrFile(fs::FS& fs) {
+    File f = fs.open(SAT_XMTR_LEGACY_FILE);
+    if (!f) return false;
+    satXmtrSpoolReset();
     char line[128];
-    while (f.available() && satXmtrCount < SAT_XMTR_MAX) {
+    while (f.available()) {
         int n = f.readBytesUntil('\n', line, sizeof(line) - 1);
         line[n] = '\0';
         // norad,down,up,invert,mode,desc
@@ -175,58 +338,131 @@ static bool satReadXmtrFile(fs::FS& fs) {
         // strip trailing CR
         char* cr = strchr(desc, '\r');
         if (cr) *cr = '\0';
-        if (norad == 0) continue;
-        satAddXmtr(norad, down, up, inv != 0, modeStart, desc);
+        if (norad == 0 || !satXmtrModeWanted(modeStart, "")) continue;
+        satXmtrSpoolAdd(norad, down, up, inv != 0, modeStart, desc);
     }
     f.close();
-    return satXmtrCount > 0;
+    return satSaveXmtrs() && satXmtrCount > 0;
 }
 
 bool satLoadXmtrsFromStorage() {
     if (satXmtrsLoaded) return satXmtrCount > 0;
     satXmtrsLoaded = true;
-    if (!initSatXmtrs()) return false;
 
-    if (!sdCardAvailable) initSDCard();
-    if (sdCardAvailable && SD.exists(SAT_XMTR_FILE) && satReadXmtrFile(SD)) {
-        Serial.printf("[SAT] Loaded %d transmitters from SD\n", satXmtrCount);
+    fs::FS* fs = satTLEStorageFS();
+    if (!fs) return false;
+    if (satReadXmtrFile(*fs)) {
+        Serial.printf("[SAT] Loaded %d transmitters\n", satXmtrCount);
         return true;
     }
-    if (satEnsureFlashFS() && SPIFFS.exists(SAT_XMTR_FILE) && satReadXmtrFile(SPIFFS)) {
-        Serial.printf("[SAT] Loaded %d transmitters from flash\n", satXmtrCount);
+    // Not while a download is filling the spool
+    if (!satXmtrSpool && satReadLegacyXmtrFile(*fs)) {
+        Serial.printf("[SAT] Imported %d transmitters from the text cache\n", satXmtrCount);
         return true;
     }
     return false;
 }
 
 // ============================================
-// SatNOGS Fetch (streaming)
+// SatNOGS Stream Parser
 // ============================================
+//
+// The document is an array of flat transmitter objects, fed one byte at a
+// time through the shared streaming lexer. Only scalar members of those
+// objects (depth 2) are reported; nested values are skipped by depth.
+// Strings longer than the field they go to are truncated.
 
-// Parse one JSON object from the stream and keep it if relevant.
-// One reused document - allocating a fresh 2KB doc for each of the ~3200
-// stream objects churns the heap for no benefit.
-static void satParseXmtrObject(const char* obj) {
-    static DynamicJsonDocument doc(2048);
-    doc.clear();
-    if (deserializeJson(doc, obj) != DeserializationError::Ok) return;
+enum SatXmtrField : uint8_t {
+    SAT_XF_NONE = 0,
+    SAT_XF_NORAD,
+    SAT_XF_DOWN,
+    SAT_XF_UP,
+    SAT_XF_INVERT,
+    SAT_XF_STATUS,
+    SAT_XF_SERVICE,
+    SAT_XF_TYPE,
+    SAT_XF_MODE,
+    SAT_XF_DESC
+};
 
-    const char* status = doc["status"] | "";
-    if (strcmp(status, "active") != 0) return;
+struct SatXmtrParser {
+    JsonStreamLexer json;
+    // current object
+    uint32_t norad, down, up;
+    bool invert;
+    char status[10];
+    char service[10];
+    char type[14];
+    char mode[14];
+    char desc[40];
+};
 
-    uint32_t norad = doc["norad_cat_id"] | 0UL;
-    if (norad == 0 || !satCatalogHasNorad(norad)) return;
+static SatXmtrParser satXp;
+static uint32_t satXmtrSeen = 0;        // objects parsed this download
 
-    uint32_t down = doc["downlink_low"] | 0UL;
-    uint32_t up = doc["uplink_low"] | 0UL;
-    if (down == 0 && up == 0) return;
+static uint8_t satXmtrFieldFor(const char* key) {
+    static const struct { const char* key; uint8_t field; } fields[] = {
+        { "norad_cat_id", SAT_XF_NORAD },   { "downlink_low", SAT_XF_DOWN },
+        { "uplink_low", SAT_XF_UP },        { "invert", SAT_XF_INVERT },
+        { "status", SAT_XF_STATUS },        { "service", SAT_XF_SERVICE },
+        { "type", SAT_XF_TYPE },            { "mode", SAT_XF_MODE },
+        { "description", SAT_XF_DESC },
+    };
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        if (strcmp(key, fields[i].key) == 0) return fields[i].field;
+    }
+    return SAT_XF_NONE;
+}
+
+// A scalar member of a transmitter object
+static void satXmtrField(void* ctx, const char* key, const char* value, bool isString) {
+    SatXmtrParser& p = *(SatXmtrParser*)ctx;
+    // null leaves the field at its default
+    switch (satXmtrFieldFor(key)) {
+        case SAT_XF_NORAD:   p.norad = strtoul(value, NULL, 10); break;
+        case SAT_XF_DOWN:    p.down = strtoul(value, NULL, 10); break;
+        case SAT_XF_UP:      p.up = strtoul(value, NULL, 10); break;
+        case SAT_XF_INVERT:  p.invert = !isString && strcmp(value, "true") == 0; break;
+        case SAT_XF_STATUS:  if (isString) strlcpy(p.status, value, sizeof(p.status)); break;
+        case SAT_XF_SERVICE: if (isString) strlcpy(p.service, value, sizeof(p.service)); break;
+        case SAT_XF_TYPE:    if (isString) strlcpy(p.type, value, sizeof(p.type)); break;
+        case SAT_XF_MODE:    if (isString) strlcpy(p.mode, value, sizeof(p.mode)); break;
+        case SAT_XF_DESC:    if (isString) strlcpy(p.desc, value, sizeof(p.desc)); break;
+        default: break;
+    }
+}
+
+// A transmitter object opened (clear it) or closed (keep it if relevant)
+static void satXmtrObject(void* ctx, bool open) {
+    SatXmtrParser& p = *(SatXmtrParser*)ctx;
+    if (open) {
+        p.norad = p.down = p.up = 0;
+        p.invert = false;
+        p.status[0] = p.service[0] = p.type[0] = p.mode[0] = p.desc[0] = '\0';
+        return;
+    }
+    satXmtrSeen++;
+    if (strcmp(p.status, "active") != 0) return;
+    if (strcmp(p.service, "Amateur") != 0) return;
+    if (p.norad == 0 || (p.down == 0 && p.up == 0)) return;
+    if (!satXmtrModeWanted(p.mode, p.type)) return;
+    if (!satCatalogHasNorad(p.norad)) return;
+    satXmtrSpoolAdd(p.norad, p.down, p.up, p.invert, p.mode, p.desc);
+}
+
+static void satXmtrParseBegin() {
+    memset(&satXp, 0, sizeof(satXp));
+    jsonStreamBegin(satXp.json, 2, satXmtrField, satXmtrObject, &satXp);
+    satXmtrSeen = 0;
+    satXmtrSpoolReset();
+}
 
-    satAddXmtr(norad, down, up, doc["invert"] | false,
-               doc["mode"] | "", doc["description"] | "");
+void satXmtrParseByte(char c) {
+    jsonStreamByte(satXp.json, c);
 }
 
 // (Downloading lives in sat_update.h as a non-blocking staged job that
-// stream-splits the ~2-3MB SatNOGS JSON into per-transmitter objects and
-// feeds them through satParseXmtrObject above.)
+// feeds the ~2-3MB SatNOGS JSON through satXmtrParseByte() as it arrives,
+// then calls satSaveXmtrs() to sort the spool into the table.)
 
 #endif // SAT_XMTRS_H
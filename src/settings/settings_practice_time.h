@@ -9,6 +9,7 @@
 #include <Preferences.h>
 #include <Arduino.h>
 #include <time.h>
+#include "../core/deferred_save.h"
 
 // ============================================
 // Inactivity Detection Constants
@@ -357,8 +358,9 @@ unsigned long endPracticeSession() {
     practiceTime.lastActivityCheck = 0;
     practiceTime.wasActive = false;
 
-    // Save after each session
-    savePracticeTimeData();
+    // Save after each session (deferred: session end is often the moment a
+    // mode exits, with a final beep or element still sounding)
+    markDeferredSave(savePracticeTimeData);
 
     Serial.printf("[Practice] Today total: %lu sec, lifetime: %lu sec\n",
                   practiceTime.todayPracticeSec, practiceTime.totalPracticeSec);
@@ -12,7 +12,8 @@
  *                            migration runs (disaster recovery for migrations)
  *
  * Triggers (all polled from loop(), skipped during audio-critical modes at the
- * call site so SD writes never crunch active audio):
+ * call site; the file itself is committed through the SD write queue, so the
+ * write also waits out any tone):
  *   - ~60s after boot (captures the previous session's progress)
  *   - 5s after any core setting stops changing (snapshot diff)
  *   - every 10 minutes (catch-all for progress saved by games/training)
@@ -38,6 +39,8 @@
 #include "../core/settings_migration.h"
 #include "../settings/settings_decoder.h"
 #include "../storage/sd_card.h"
+#include "../storage/sd_write_queue.h"
+#include "../storage/atomic_file.h"
 
 #define NVS_BACKUP_PATH             "/nvs_backup.jsonl"
 #define NVS_PREMIGRATION_PATH       "/nvs_premigration.jsonl"
@@ -68,7 +71,7 @@ static bool isSystemNvsNamespace(const char* ns) {
 
 // Serialize one NVS entry as a JSON line. Returns false (and writes nothing)
 // if the value can't be read.
-static bool writeNvsEntryLine(File& f, const nvs_entry_info_t& info) {
+static bool writeNvsEntryLine(Print& f, const nvs_entry_info_t& info) {
   nvs_handle_t h;
   if (nvs_open(info.namespace_name, NVS_READONLY, &h) != ESP_OK) return false;
 
@@ -130,8 +133,14 @@ static bool writeNvsEntryLine(File& f, const nvs_entry_info_t& info) {
   return true;
 }
 
-// Dump every app NVS entry to a JSONL file on SD. Writes to a .tmp file and
-// renames, so a power cut mid-dump can't destroy the previous good backup.
+static void nvsBackupCommitted(bool ok, void* ctx) {
+  if (!ok) Serial.printf("[SDBackup] Failed to write %s\n", (const char*)ctx);
+}
+
+// Dump every app NVS entry to a JSONL file on SD. Queued as a full
+// replacement (.tmp + rename on commit), so a power cut mid-write can't
+// destroy the previous good backup. Call sdQueueFlushPath() if the file must
+// be on the card before continuing.
 bool dumpAllNvsToSD(const char* path) {
   static bool triedInit = false;
   if (!sdCardAvailable) {
@@ -140,10 +149,7 @@ bool dumpAllNvsToSD(const char* path) {
     if (!initSDCard()) return false;
   }
 
-  char tmpPath[48];
-  snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
-  File f = SD.open(tmpPath, FILE_WRITE);
-  if (!f) return false;
+  SDQueuedPrint f(path, SD_WRITE_REPLACE);
 
   int count = 0;
   nvs_iterator_t it = nvs_entry_find("nvs", NULL, NVS_TYPE_ANY);
@@ -155,14 +161,10 @@ bool dumpAllNvsToSD(const char* path) {
     }
     it = nvs_entry_next(it);  // releases the iterator when exhausted
   }
-  f.close();
 
-  if (count == 0) {
-    SD.remove(tmpPath);
-    return false;
-  }
-  SD.remove(path);
-  if (!SD.rename(tmpPath, path)) return false;
+  // Nothing written leaves the previous backup untouched
+  if (count == 0) return false;
+  if (!f.commit(nvsBackupCommitted, (void*)path)) return false;
 
   Serial.printf("[SDBackup] NVS backup: %d entries -> %s\n", count, path);
   return true;
@@ -233,8 +235,8 @@ static bool applyNvsEntryLine(const char* line) {
 // Restore every entry from a JSONL backup file. Returns entries restored.
 int restoreAllNvsFromSD(const char* path) {
   if (!sdCardAvailable && !initSDCard()) return 0;
-  if (!SD.exists(path)) return 0;
-  File f = SD.open(path);
+  sdQueueFlushPath(path);
+  File f = atomicFileOpen(SD, path);  // Payload only; finishes a torn dump
   if (!f) return 0;
 
   int ok = 0, fail = 0;
@@ -259,7 +261,8 @@ int restoreAllNvsFromSD(const char* path) {
 void restoreAllNvsIfWiped() {
   if (!g_nvsWasUnversioned) return;  // NVS had data - nothing to recover
   if (!sdCardAvailable && !initSDCard()) return;
-  if (!SD.exists(NVS_BACKUP_PATH)) return;
+  AtomicFileStatus status = atomicFileRecover(SD, NVS_BACKUP_PATH);
+  if (status == ATOMIC_FILE_MISSING || status == ATOMIC_FILE_CORRUPT) return;
 
   Serial.println("[SDBackup] NVS is empty but an SD backup exists - restoring");
   if (restoreAllNvsFromSD(NVS_BACKUP_PATH) > 0) {
@@ -267,6 +270,7 @@ void restoreAllNvsIfWiped() {
     // backup predates the current schema, migration runs on the next boot.
     if (getStoredSettingsVersion() == 0) writeSettingsVersion(1);
     Serial.println("[SDBackup] Restore complete - rebooting to load restored data");
+    flushSDWriteQueue();
     delay(300);
     ESP.restart();  // does not return
   }
@@ -356,10 +360,9 @@ void removeSettingsBackupFromSD() {
   if (!sdCardAvailable && !initSDCard()) return;
   const char* files[] = { NVS_BACKUP_PATH, NVS_PREMIGRATION_PATH, LEGACY_SETTINGS_BACKUP_PATH };
   for (int i = 0; i < 3; i++) {
-    if (SD.exists(files[i])) {
-      SD.remove(files[i]);
-      Serial.printf("[SDBackup] Removed %s\n", files[i]);
-    }
+    sdQueueDiscard(files[i]);
+    if (SD.exists(files[i])) Serial.printf("[SDBackup] Removed %s\n", files[i]);
+    atomicFileRemove(SD, files[i]);
   }
 }
 
@@ -0,0 +1,476 @@
+/*
+ * Crash-Safe File Replacement
+ *
+ * Metadata files (QSO statistics, the Morse Notes library, NVS backups,
+ * license question pools) are rewritten whole. Truncating them in place
+ * means a power cut mid-write leaves a torn file and a slow rebuild on the
+ * next boot. Writers here instead:
+ *
+ *   1. write "<path>.tmp": placeholder header, then the payload
+ *   2. seek back and fill in the header (generation, length, CRC32), fsync
+ *   3. move the old copy to "<path>.bak", rename .tmp into place, drop .bak
+ *
+ * The header is written last, so a torn .tmp never validates. Whatever step
+ * a crash interrupts, one of path / .tmp / .bak holds a complete copy, and
+ * atomicFileRecover() puts it back in place.
+ *
+ * Header check (magic, header CRC, length vs. file size) is O(1) and is what
+ * readers and the boot check use. atomicFileVerify() also checks the payload
+ * CRC. Files written before this layer (no header) still read as "legacy".
+ *
+ * Files meant to be read as text (JSONL backups, question pools) use
+ * ATOMIC_FORMAT_PLAIN: same .tmp/.bak/rename sequence, no header. A plain
+ * .tmp is only trusted once the old copy has been moved to .bak, which
+ * happens after the .tmp is complete.
+ *
+ * Recovery never touches the side files of a path while an AtomicFileWriter
+ * for it is open (a .tmp being written, or a swap in progress), so readers
+ * may open a file whose replacement is under way on another task.
+ *
+ * Works on any fs::FS (SD, SPIFFS).
+ */
+
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <esp_rom_crc.h>
+
+#define ATOMIC_FILE_MAGIC 0x31474641    // "AFG1"
+#define ATOMIC_FILE_WRITERS 4           // Writers open at once
+
+struct __attribute__((packed)) AtomicFileHeader {
+  uint32_t magic;
+  uint32_t generation;        // Bumped on every replace
+  uint32_t length;            // Payload bytes after the header
+  uint32_t crc;               // CRC32 of the payload
+  uint32_t headerCrc;         // CRC32 of the fields above
+};
+
+enum AtomicFileStatus {
+  ATOMIC_FILE_OK = 0,         // Valid header
+  ATOMIC_FILE_LEGACY,         // No header (written before this layer)
+  ATOMIC_FILE_RECOVERED,      // Restored from .tmp or .bak
+  ATOMIC_FILE_MISSING,
+  ATOMIC_FILE_CORRUPT         // Header present but invalid, no good copy
+};
+
+enum AtomicFileFormat {
+  ATOMIC_FORMAT_HEADER = 0,   // Checksummed header + payload (binary/metadata files)
+  ATOMIC_FORMAT_PLAIN = 1     // Payload only (files meant to be read as text)
+};
+
+struct AtomicFileInfo {
+  AtomicFileStatus status;
+  uint32_t generation;
+  uint32_t length;            // Payload length (file size for legacy files)
+};
+
+// Paths with an open AtomicFileWriter; guarded by atomicFileMutex along
+// with recovery and the final swap
+struct AtomicFileWriterSlot {
+  fs::FS* fs;                 // nullptr = free
+  char path[64];
+};
+
+static AtomicFileWriterSlot atomicFileWriters[ATOMIC_FILE_WRITERS];
+static SemaphoreHandle_t atomicFileMutex = NULL;
+
+// ============================================
+// Header Helpers
+// ============================================
+
+static uint32_t atomicHeaderCrc(const AtomicFileHeader& h) {
+  return esp_rom_crc32_le(0, (const uint8_t*)&h, offsetof(AtomicFileHeader, headerCrc));
+}
+
+static void atomicSidePath(const char* path, const char* ext, char* out, size_t outLen) {
+  snprintf(out, outLen, "%s%s", path, ext);
+}
+
+static void atomicFileLock() {
+  if (atomicFileMutex == NULL) atomicFileMutex = xSemaphoreCreateRecursiveMutex();
+  xSemaphoreTakeRecursive(atomicFileMutex, portMAX_DELAY);
+}
+
+static void atomicFileUnlock() {
+  xSemaphoreGiveRecursive(atomicFileMutex);
+}
+
+static AtomicFileWriterSlot* atomicFileWriterFind(fs::FS* fs, const char* path) {
+  for (int i = 0; i < ATOMIC_FILE_WRITERS; i++) {
+    if (atomicFileWriters[i].fs == fs && strcmp(atomicFileWriters[i].path, path) == 0) {
+      return &atomicFileWriters[i];
+    }
+  }
+  return nullptr;
+}
+
+/*
+ * Read and check a header. Returns ATOMIC_FILE_OK, ATOMIC_FILE_LEGACY (no
+ * magic - plain/text files, only meaningful for the main path or a plain
+ * .tmp) or ATOMIC_FILE_CORRUPT. A header still zeroed (the placeholder of
+ * an unfinished .tmp) is corrupt, not legacy: text never starts with NULs.
+ */
+static AtomicFileStatus atomicReadHeader(fs::FS& fs, const char* path, AtomicFileHeader& h) {
+  File file = fs.open(path, FILE_READ);
+  if (!file) return ATOMIC_FILE_MISSING;
+  size_t size = file.size();
+  bool full = file.read((uint8_t*)&h, sizeof(h)) == sizeof(h);
+  file.close();
+
+  static const AtomicFileHeader placeholder = {};
+  if (full && memcmp(&h, &placeholder, sizeof(h)) == 0) return ATOMIC_FILE_CORRUPT;
+  if (!full || h.magic != ATOMIC_FILE_MAGIC) {
+    memset(&h, 0, sizeof(h));
+    h.length = size;
+    return ATOMIC_FILE_LEGACY;
+  }
+  if (h.headerCrc != atomicHeaderCrc(h) || size != sizeof(h) + h.length) {
+    return ATOMIC_FILE_CORRUPT;
+  }
+  return ATOMIC_FILE_OK;
+}
+
+// ============================================
+// Recovery and Checks
+// ============================================
+
+/*
+ * Make sure `path` holds the newest complete copy, finishing or rolling
+ * back an interrupted replace. Fast: headers only. While a writer for
+ * `path` is open this only reports on the current copy.
+ */
+AtomicFileStatus atomicFileRecover(fs::FS& fs, const char* path, AtomicFileInfo* info = nullptr) {
+  char tmpPath[72], bakPath[72];
+  atomicSidePath(path, ".tmp", tmpPath, sizeof(tmpPath));
+  atomicSidePath(path, ".bak", bakPath, sizeof(bakPath));
+
+  atomicFileLock();
+  AtomicFileHeader h, alt;
+  AtomicFileStatus status = atomicReadHeader(fs, path, h);
+  bool bad = (status == ATOMIC_FILE_MISSING || status == ATOMIC_FILE_CORRUPT);
+  bool writing = atomicFileWriterFind(&fs, path) != nullptr;
+
+  // A complete .tmp newer than the current copy: the crash hit after the
+  // header was written but before the rename finished - install it. A
+  // plain (headerless) .tmp counts once the old copy was moved to .bak.
+  AtomicFileStatus tmpStatus = ATOMIC_FILE_MISSING;
+  if (!writing && fs.exists(tmpPath)) tmpStatus = atomicReadHeader(fs, tmpPath, alt);
+  bool tmpPlainReady = tmpStatus == ATOMIC_FILE_LEGACY && status == ATOMIC_FILE_MISSING &&
+                       fs.exists(bakPath);
+  if ((tmpStatus == ATOMIC_FILE_OK &&
+       (bad || status == ATOMIC_FILE_LEGACY || alt.generation > h.generation)) || tmpPlainReady) {
+    fs.remove(path);
+    if (fs.rename(tmpPath, path)) {
+      h = alt;
+      status = ATOMIC_FILE_RECOVERED;
+      bad = false;
+    }
+  }
+  // Otherwise fall back to the copy moved aside before the rename
+  if (bad && !writing && fs.exists(bakPath) &&
+      atomicReadHeader(fs, bakPath, alt) != ATOMIC_FILE_CORRUPT) {
+    fs.remove(path);
+    if (fs.rename(bakPath, path)) {
+      h = alt;
+      status = ATOMIC_FILE_RECOVERED;
+      bad = false;
+    }
+  }
+  if (status == ATOMIC_FILE_RECOVERED) {
+    Serial.printf("[AtomicFile] Recovered %s (generation %u)\n", path, (unsigned)h.generation);
+  }
+
+  // Leftovers from an interrupted or completed replace
+  if (!bad && !writing) {
+    if (fs.exists(tmpPath)) fs.remove(tmpPath);
+    if (fs.exists(bakPath)) fs.remove(bakPath);
+  }
+  atomicFileUnlock();
+
+  if (info != nullptr) {
+    info->status = status;
+    info->generation = h.generation;
+    info->length = h.length;
+  }
+  return status;
+}
+
+/*
+ * Full check: header plus payload CRC (reads the whole file)
+ */
+bool atomicFileVerify(fs::FS& fs, const char* path) {
+  AtomicFileHeader h;
+  AtomicFileStatus status = atomicReadHeader(fs, path, h);
+  if (status == ATOMIC_FILE_LEGACY) return true;
+  if (status != ATOMIC_FILE_OK) return false;
+
+  File file = fs.open(path, FILE_READ);
+  if (!file) return false;
+  file.seek(sizeof(AtomicFileHeader));
+  uint8_t buf[256];
+  uint32_t crc = 0;
+  size_t n;
+  while ((n = file.read(buf, sizeof(buf))) > 0) {
+    crc = esp_rom_crc32_le(crc, buf, n);
+  }
+  file.close();
+  return crc == h.crc;
+}
+
+/*
+ * Open a file for reading, positioned at the start of its payload.
+ * Runs recovery first. Returns an invalid File if there is no usable copy.
+ */
+File atomicFileOpen(fs::FS& fs, const char* path, AtomicFileInfo* info = nullptr) {
+  AtomicFileInfo local;
+  AtomicFileInfo& fi = info ? *info : local;
+  atomicFileLock();  // No swap between the check and the open
+  AtomicFileStatus status = atomicFileRecover(fs, path, &fi);
+  if (status == ATOMIC_FILE_MISSING || status == ATOMIC_FILE_CORRUPT) {
+    atomicFileUnlock();
+    if (status == ATOMIC_FILE_CORRUPT) Serial.printf("[AtomicFile] %s is corrupt\n", path);
+    return File();
+  }
+
+  File file = fs.open(path, FILE_READ);
+  atomicFileUnlock();
+  if (file && status != ATOMIC_FILE_LEGACY) {
+    // A recovered legacy .bak has no header either
+    AtomicFileHeader h;
+    if (file.read((uint8_t*)&h, sizeof(h)) != sizeof(h) || h.magic != ATOMIC_FILE_MAGIC) {
+      file.seek(0);
+    }
+  }
+  return file;
+}
+
+/*
+ * Open the copy at `path` as it stands, positioned at its payload, without
+ * recovery: no side file is read or touched. For readers that may run
+ * while the file is being replaced. Returns an invalid File if the copy is
+ * missing or corrupt.
+ */
+File atomicFileOpenCurrent(fs::FS& fs, const char* path, AtomicFileInfo* info = nullptr) {
+  AtomicFileHeader h;
+  File file;
+  atomicFileLock();  // Not halfway through a swap
+  AtomicFileStatus status = atomicReadHeader(fs, path, h);
+  if (status == ATOMIC_FILE_OK || status == ATOMIC_FILE_LEGACY) {
+    file = fs.open(path, FILE_READ);
+    if (file && status == ATOMIC_FILE_OK) file.seek(sizeof(h));
+  }
+  atomicFileUnlock();
+
+  if (info != nullptr) {
+    info->status = status;
+    info->generation = h.generation;
+    info->length = h.length;
+  }
+  return file;
+}
+
+// ============================================
+// Writer
+// ============================================
+
+/*
+ * Print target for a whole-file replacement:
+ *
+ *   AtomicFileWriter out(SD, path);
+ *   if (out.begin()) { serializeJson(doc, out); out.commit(); }
+ *
+ * Nothing changes on disk at `path` until commit() succeeds; a writer that
+ * is destroyed without commit() discards its .tmp. Only one writer per path
+ * at a time: begin() fails while another is open.
+ */
+class AtomicFileWriter : public Print {
+public:
+  AtomicFileWriter(fs::FS& fs, const char* path, AtomicFileFormat format = ATOMIC_FORMAT_HEADER)
+    : _fs(fs), _format(format), _length(0), _crc(0), _generation(0), _ok(false), _done(false),
+      _slot(nullptr) {
+    strlcpy(_path, path, sizeof(_path));
+    atomicSidePath(path, ".tmp", _tmpPath, sizeof(_tmpPath));
+  }
+
+  ~AtomicFileWriter() {
+    if (!_done) abort();
+  }
+
+  bool begin() {
+    _done = false;
+    _ok = false;
+    atomicFileLock();
+    if (_slot == nullptr) {
+      if (atomicFileWriterFind(&_fs, _path) != nullptr) {
+        atomicFileUnlock();
+        Serial.printf("[AtomicFile] %s is already being written\n", _path);
+        return false;
+      }
+      AtomicFileInfo info;
+      AtomicFileStatus status = atomicFileRecover(_fs, _path, &info);
+      _generation = (status == ATOMIC_FILE_OK || status == ATOMIC_FILE_RECOVERED) ? info.generation : 0;
+
+      _slot = atomicFileWriterFind(nullptr, "");
+      if (_slot == nullptr) {
+        atomicFileUnlock();
+        Serial.printf("[AtomicFile] Too many writers open for %s\n", _path);
+        return false;
+      }
+      _slot->fs = &_fs;
+      strlcpy(_slot->path, _path, sizeof(_slot->path));
+    }
+    atomicFileUnlock();
+
+    _file = _fs.open(_tmpPath, FILE_WRITE);
+    if (!_file) {
+      release();
+      return false;
+    }
+    _ok = true;
+    if (_format == ATOMIC_FORMAT_HEADER) {
+      AtomicFileHeader placeholder = {};
+      _ok = _file.write((const uint8_t*)&placeholder, sizeof(placeholder)) == sizeof(placeholder);
+    }
+    _length = 0;
+    _crc = 0;
+    return _ok;
+  }
+
+  size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    if (!_ok) return 0;
+    size_t n = _file.write(buffer, size);
+    if (n != size) _ok = false;
+    if (_format == ATOMIC_FORMAT_HEADER) _crc = esp_rom_crc32_le(_crc, buffer, n);
+    _length += n;
+    return n;
+  }
+
+  /*
+   * Finish: header, fsync, swap into place. Returns false (old copy kept)
+   * if any write failed.
+   */
+  bool commit() {
+    _done = true;
+    if (!_ok || !_file) {
+      abort();
+      return false;
+    }
+
+    bool ok = true;
+    if (_format == ATOMIC_FORMAT_HEADER) {
+      AtomicFileHeader h;
+      h.magic = ATOMIC_FILE_MAGIC;
+      h.generation = _generation + 1;
+      h.length = _length;
+      h.crc = _crc;
+      h.headerCrc = atomicHeaderCrc(h);
+      _file.seek(0);
+      ok = _file.write((const uint8_t*)&h, sizeof(h)) == sizeof(h);
+    }
+    _file.flush();  // fsync before the rename makes it visible
+    _file.close();
+    if (!ok) {
+      abort();
+      return false;
+    }
+
+    // Swap under the lock so no reader recovers halfway through it
+    char bakPath[72];
+    atomicSidePath(_path, ".bak", bakPath, sizeof(bakPath));
+    atomicFileLock();
+    _fs.remove(bakPath);
+    if (_fs.exists(_path) && !_fs.rename(_path, bakPath)) {
+      _fs.remove(_path);
+    }
+    bool renamed = _fs.rename(_tmpPath, _path);
+    if (renamed) _fs.remove(bakPath);
+    release();
+    atomicFileUnlock();
+    if (!renamed) {
+      Serial.printf("[AtomicFile] Failed to rename %s\n", _tmpPath);
+      return false;  // .tmp is complete; atomicFileRecover() finishes the job
+    }
+    return true;
+  }
+
+  // Drop the .tmp, leaving the current copy untouched
+  void abort() {
+    _done = true;
+    if (_file) _file.close();
+    atomicFileLock();
+    if (_slot != nullptr) _fs.remove(_tmpPath);  // Only a .tmp this writer owns
+    release();
+    atomicFileUnlock();
+  }
+
+  /*
+   * Reposition within the .tmp, for files built out of order. Plain format
+   * only: a header's payload CRC assumes the bytes arrive in order.
+   */
+  bool seek(uint32_t pos) {
+    if (_format != ATOMIC_FORMAT_PLAIN || !_ok) return false;
+    return _file.seek(pos);
+  }
+
+  bool ok() const { return _ok; }
+  uint32_t generation() const { return _generation + 1; }
+
+private:
+  void release() {
+    atomicFileLock();
+    if (_slot != nullptr) {
+      _slot->fs = nullptr;
+      _slot->path[0] = '\0';
+      _slot = nullptr;
+    }
+    atomicFileUnlock();
+  }
+
+  fs::FS& _fs;
+  File _file;
+  char _path[64];
+  char _tmpPath[72];
+  AtomicFileFormat _format;
+  uint32_t _length;
+  uint32_t _crc;
+  uint32_t _generation;
+  bool _ok;
+  bool _done;
+  AtomicFileWriterSlot* _slot;  // Registration in atomicFileWriters
+};
+
+/*
+ * Remove a file along with any .tmp/.bak copy recovery could bring back
+ */
+void atomicFileRemove(fs::FS& fs, const char* path) {
+  char side[72];
+  atomicFileLock();
+  if (atomicFileWriterFind(&fs, path) == nullptr) {
+    atomicSidePath(path, ".tmp", side, sizeof(side));
+    if (fs.exists(side)) fs.remove(side);
+  }
+  atomicSidePath(path, ".bak", side, sizeof(side));
+  if (fs.exists(side)) fs.remove(side);
+  if (fs.exists(path)) fs.remove(path);
+  atomicFileUnlock();
+}
+
+/*
+ * Replace a file with a buffer in one call
+ */
+bool atomicFileWrite(fs::FS& fs, const char* path, const uint8_t* data, size_t len,
+                     AtomicFileFormat format = ATOMIC_FORMAT_HEADER) {
+  AtomicFileWriter out(fs, path, format);
+  if (!out.begin()) return false;
+  out.write(data, len);
+  return out.commit();
+}
+
+#endif // ATOMIC_FILE_H
@@ -0,0 +1,456 @@
+/*
+ * SD Card Write Queue
+ *
+ * Group-commit scheduler for small SD writes. The SD card shares SPI2 with
+ * the display, and every open/write/close is a burst of FAT traffic that
+ * competes with rendering and - worse - lands in the middle of keyed
+ * elements. Callers queue writes here instead; the main loop commits them
+ * together once audio is idle (same rule as deferred NVS saves:
+ * deferredSavesAllowed()).
+ *
+ * Per file, one pending slot:
+ *   - SD_WRITE_APPEND data is concatenated, so N small appends cost one
+ *     open/write/close
+ *   - SD_WRITE_REPLACE discards whatever is pending for the file and starts
+ *     a new full image; later appends extend that image. Replaces commit
+ *     through atomic_file.h (.tmp + rename, ATOMIC_FORMAT_PLAIN so the
+ *     file stays plain text), so a power cut keeps the old copy.
+ *
+ * A slot commits when its oldest write is SD_QUEUE_FLUSH_MS old, or earlier
+ * once the queue passes SD_QUEUE_HIGH_WATER. Past SD_QUEUE_MAX_BYTES (audio
+ * blocked for a long time) an append slot is written immediately rather
+ * than dropped. A REPLACE image only ever reaches the card whole: it is
+ * queued complete, stays in its slot until committed, and is never
+ * followed by a raw append of its remainder. Commit callbacks run after the
+ * file is closed.
+ *
+ * Callbacks stay with the slot: a REPLACE that supersedes a pending image
+ * inherits its callbacks (they fire when the newer image lands), and the
+ * same callback/context pair is only registered once per slot.
+ *
+ * Code that reads, regenerates or removes a queued file must call
+ * sdQueueFlushPath() / sdQueueDiscard() first. Call flushSDWriteQueue()
+ * before ESP.restart(). Queue state is guarded by a
+ * recursive mutex, so web handlers on the async task may use it too.
+ */
+
+#ifndef SD_WRITE_QUEUE_H
+#define SD_WRITE_QUEUE_H
+
+#include <Arduino.h>
+#include <SD.h>
+#include "atomic_file.h"  // Same folder
+#include "../core/deferred_save.h"
+
+#define SD_QUEUE_SLOTS          8          // Distinct files pending at once
+#define SD_QUEUE_CALLBACKS      4          // Commit callbacks per file
+#define SD_QUEUE_FLUSH_MS       1000       // Max age of a pending write (audio permitting)
+#define SD_QUEUE_HIGH_WATER     16384      // Pending bytes that trigger an early commit
+#define SD_QUEUE_MAX_BYTES      262144     // Pending bytes per file before a forced write
+
+enum SDWriteKind {
+  SD_WRITE_APPEND = 0,
+  SD_WRITE_REPLACE = 1
+};
+
+// Called once the write is on the card (ok=false if it failed or was discarded)
+typedef void (*SDCommitFn)(bool ok, void* ctx);
+
+struct SDQueueSlot {
+  char path[64];              // Empty = free slot
+  uint8_t kind;               // SDWriteKind of the pending image
+  uint8_t* data;
+  size_t len;
+  size_t cap;
+  unsigned long firstAt;      // millis() of the oldest pending write
+  SDCommitFn callbacks[SD_QUEUE_CALLBACKS];
+  void* callbackCtx[SD_QUEUE_CALLBACKS];
+  int callbackCount;
+};
+
+static SDQueueSlot sdQueueSlots[SD_QUEUE_SLOTS];
+static size_t sdQueueBytes = 0;
+static SemaphoreHandle_t sdQueueMutex = NULL;
+
+// ============================================
+// Internals
+// ============================================
+
+static void sdQueueLock() {
+  if (sdQueueMutex == NULL) sdQueueMutex = xSemaphoreCreateRecursiveMutex();
+  xSemaphoreTakeRecursive(sdQueueMutex, portMAX_DELAY);
+}
+
+static void sdQueueUnlock() {
+  xSemaphoreGiveRecursive(sdQueueMutex);
+}
+
+static SDQueueSlot* sdQueueFind(const char* path) {
+  for (int i = 0; i < SD_QUEUE_SLOTS; i++) {
+    if (sdQueueSlots[i].path[0] != '\0' && strcmp(sdQueueSlots[i].path, path) == 0) {
+      return &sdQueueSlots[i];
+    }
+  }
+  return nullptr;
+}
+
+static bool sdQueueHasCallback(const SDQueueSlot& slot, SDCommitFn fn, void* ctx) {
+  for (int i = 0; i < slot.callbackCount; i++) {
+    if (slot.callbacks[i] == fn && slot.callbackCtx[i] == ctx) return true;
+  }
+  return false;
+}
+
+static bool sdQueueReserve(SDQueueSlot& slot, size_t need) {
+  if (need <= slot.cap) return true;
+  size_t cap = slot.cap ? slot.cap : 1024;
+  while (cap < need) cap *= 2;
+  uint8_t* p = psramFound() ? (uint8_t*)ps_realloc(slot.data, cap) : nullptr;
+  if (p == nullptr) p = (uint8_t*)realloc(slot.data, cap);
+  if (p == nullptr) return false;
+  slot.data = p;
+  slot.cap = cap;
+  return true;
+}
+
+static bool sdQueueWriteFile(const SDQueueSlot& slot) {
+  if (slot.kind == SD_WRITE_APPEND) {
+    File file = SD.open(slot.path, FILE_APPEND);
+    if (!file) return false;
+    size_t written = file.write(slot.data, slot.len);
+    file.close();
+    return written == slot.len;
+  }
+
+  // Queued files are text (ADIF, JSONL), so replaces stay headerless
+  return atomicFileWrite(SD, slot.path, slot.data, slot.len, ATOMIC_FORMAT_PLAIN);
+}
+
+// Callbacks of a committed slot, run by the caller after the lock is
+// released (a callback may queue more writes)
+struct SDQueueDone {
+  SDCommitFn callbacks[SD_QUEUE_CALLBACKS];
+  void* callbackCtx[SD_QUEUE_CALLBACKS];
+  int count;
+  bool ok;
+};
+
+// Free a slot (keeps a small buffer for reuse) and hand back its callbacks
+static void sdQueueRelease(SDQueueSlot& slot, bool ok, SDQueueDone& done) {
+  done.count = slot.callbackCount;
+  done.ok = ok;
+  memcpy(done.callbacks, slot.callbacks, sizeof(done.callbacks));
+  memcpy(done.callbackCtx, slot.callbackCtx, sizeof(done.callbackCtx));
+
+  sdQueueBytes -= slot.len;
+  slot.path[0] = '\0';
+  slot.len = 0;
+  slot.callbackCount = 0;
+  if (slot.cap > SD_QUEUE_HIGH_WATER) {
+    // Don't pin a large one-off image (e.g. the NVS backup) in RAM
+    free(slot.data);
+    slot.data = nullptr;
+    slot.cap = 0;
+  }
+}
+
+static void sdQueueRunCallbacks(const SDQueueDone& done) {
+  for (int i = 0; i < done.count; i++) {
+    done.callbacks[i](done.ok, done.callbackCtx[i]);
+  }
+}
+
+static void sdQueueCommitSlot(SDQueueSlot& slot, SDQueueDone& done) {
+  bool ok = sdQueueWriteFile(slot);
+  if (!ok) {
+    Serial.printf("[SDQueue] Failed to write %s (%u bytes)\n", slot.path, (unsigned)slot.len);
+  }
+  sdQueueRelease(slot, ok, done);
+}
+
+// ============================================
+// Public API
+// ============================================
+
+/*
+ * Queue data for a file. Returns false only if the data could not be
+ * queued or written at all.
+ */
+bool sdQueueWrite(const char* path, const void* data, size_t len, SDWriteKind kind,
+                  SDCommitFn onCommit = nullptr, void* ctx = nullptr) {
+  if (strlen(path) >= sizeof(SDQueueSlot::path)) return false;
+
+  SDQueueDone evicted = {}, done = {};
+  bool ok = true;
+  sdQueueLock();
+
+  SDQueueSlot* slot = sdQueueFind(path);
+  if (slot == nullptr) {
+    for (int i = 0; i < SD_QUEUE_SLOTS && slot == nullptr; i++) {
+      if (sdQueueSlots[i].path[0] == '\0') slot = &sdQueueSlots[i];
+    }
+    if (slot == nullptr) {
+      // Table full - commit the oldest file to make room
+      slot = &sdQueueSlots[0];
+      for (int i = 1; i < SD_QUEUE_SLOTS; i++) {
+        if ((long)(sdQueueSlots[i].firstAt - slot->firstAt) < 0) slot = &sdQueueSlots[i];
+      }
+      sdQueueCommitSlot(*slot, evicted);
+    }
+    strlcpy(slot->path, path, sizeof(slot->path));
+    slot->kind = kind;
+    slot->len = 0;
+    slot->firstAt = millis();
+  } else if (kind == SD_WRITE_REPLACE) {
+    // New full image supersedes anything pending
+    sdQueueBytes -= slot->len;
+    slot->len = 0;
+    slot->kind = SD_WRITE_REPLACE;
+  }
+
+  // Repeat saves of the same file usually bring the same callback
+  if (onCommit != nullptr && sdQueueHasCallback(*slot, onCommit, ctx)) onCommit = nullptr;
+
+  // A REPLACE image is only ever written whole: nothing below commits part
+  // of one and appends the rest (SDQueuedPrint hands images over complete)
+  SDCommitFn lateFn = nullptr;    // Callback that didn't fit in the slot
+  if (sdQueueReserve(*slot, slot->len + len)) {
+    memcpy(slot->data + slot->len, data, len);
+    slot->len += len;
+    sdQueueBytes += len;
+    bool callbacksFull = onCommit != nullptr && slot->callbackCount >= SD_QUEUE_CALLBACKS;
+    if (onCommit != nullptr && !callbacksFull) {
+      slot->callbacks[slot->callbackCount] = onCommit;
+      slot->callbackCtx[slot->callbackCount] = ctx;
+      slot->callbackCount++;
+    }
+    if (callbacksFull || (slot->kind == SD_WRITE_APPEND && slot->len >= SD_QUEUE_MAX_BYTES)) {
+      // No room for another callback, or a long run of appends: write the
+      // file (this data included) now
+      sdQueueCommitSlot(*slot, done);
+      ok = done.ok;
+      if (callbacksFull) lateFn = onCommit;
+    }
+  } else {
+    // Out of RAM - write what is pending plus this data directly
+    Serial.printf("[SDQueue] No buffer for %s, writing through\n", path);
+    if (slot->kind == SD_WRITE_REPLACE) {
+      // Pending image + this data as one replacement
+      AtomicFileWriter out(SD, path, ATOMIC_FORMAT_PLAIN);
+      ok = out.begin() && (slot->len == 0 || out.write(slot->data, slot->len) == slot->len) &&
+           out.write((const uint8_t*)data, len) == len && out.commit();
+      sdQueueRelease(*slot, ok, done);
+    } else {
+      if (slot->len > 0) sdQueueCommitSlot(*slot, done);
+      else sdQueueRelease(*slot, true, done);
+      File file = SD.open(path, FILE_APPEND);
+      ok = file && file.write((const uint8_t*)data, len) == len;
+      if (file) file.close();
+    }
+    lateFn = onCommit;
+  }
+
+  sdQueueUnlock();
+  sdQueueRunCallbacks(evicted);
+  sdQueueRunCallbacks(done);
+  if (lateFn != nullptr) lateFn(ok, ctx);
+  return ok;
+}
+
+/*
+ * Commit every pending file now, regardless of audio state (before reboots,
+ * bulk reads, or anything that needs the data on the card)
+ */
+void flushSDWriteQueue() {
+  for (int i = 0; i < SD_QUEUE_SLOTS; i++) {
+    SDQueueDone done = {};
+    sdQueueLock();
+    if (sdQueueSlots[i].path[0] != '\0') sdQueueCommitSlot(sdQueueSlots[i], done);
+    sdQueueUnlock();
+    sdQueueRunCallbacks(done);
+  }
+}
+
+/*
+ * Commit pending writes for one file (call before reading it)
+ */
+void sdQueueFlushPath(const char* path) {
+  SDQueueDone done = {};
+  sdQueueLock();
+  SDQueueSlot* slot = sdQueueFind(path);
+  if (slot != nullptr) sdQueueCommitSlot(*slot, done);
+  sdQueueUnlock();
+  sdQueueRunCallbacks(done);
+}
+
+/*
+ * Drop pending writes for one file (call before regenerating or removing
+ * it). Its callbacks are told the write did not happen.
+ */
+void sdQueueDiscard(const char* path) {
+  SDQueueDone done = {};
+  sdQueueLock();
+  SDQueueSlot* slot = sdQueueFind(path);
+  if (slot != nullptr) sdQueueRelease(*slot, false, done);
+  sdQueueUnlock();
+  sdQueueRunCallbacks(done);
+}
+
+/*
+ * Group commit: write every pending file once the oldest write is due (or
+ * the queue is getting large) and audio is idle. Call from loop().
+ */
+void updateSDWriteQueue() {
+  unsigned long now = millis();
+  bool due = sdQueueBytes >= SD_QUEUE_HIGH_WATER;
+  for (int i = 0; i < SD_QUEUE_SLOTS && !due; i++) {
+    due = sdQueueSlots[i].path[0] != '\0' && (now - sdQueueSlots[i].firstAt) >= SD_QUEUE_FLUSH_MS;
+  }
+  if (due && deferredSavesAllowed()) flushSDWriteQueue();
+}
+
+/*
+ * True if writes for path are waiting in the queue
+ */
+bool sdQueuePending(const char* path) {
+  sdQueueLock();
+  bool pending = sdQueueFind(path) != nullptr;
+  sdQueueUnlock();
+  return pending;
+}
+
+// ============================================
+// Print Adapter
+// ============================================
+
+/*
+ * Print target that queues everything written to it for one file, so
+ * existing Print-based writers (ADIF records, serializeJson) can use the
+ * queue unchanged.
+ *
+ * SD_WRITE_APPEND output is staged in a small local buffer and handed to
+ * the queue on fill, commit() or destruction.
+ *
+ * SD_WRITE_REPLACE builds the whole image first and queues it in one
+ * piece on commit() or destruction, so the queue never holds (or writes)
+ * half an image. If the image outgrows available RAM it is streamed
+ * straight through an AtomicFileWriter instead. Nothing written = nothing
+ * replaced; commit() ends the image.
+ */
+#define SD_QUEUED_PRINT_BUF 256
+
+class SDQueuedPrint : public Print {
+public:
+  SDQueuedPrint(const char* path, SDWriteKind kind = SD_WRITE_APPEND)
+    : _path(path), _kind(kind), _len(0), _ok(true),
+      _image(nullptr), _imageLen(0), _imageCap(0), _direct(nullptr), _ended(false) {}
+
+  ~SDQueuedPrint() {
+    if (_kind == SD_WRITE_REPLACE) endImage(nullptr, nullptr);
+    else flush();
+    free(_image);
+    delete _direct;
+  }
+
+  size_t write(uint8_t c) override {
+    return write(&c, 1);
+  }
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    if (_kind == SD_WRITE_REPLACE) {
+      imageWrite(buffer, size);
+      return size;
+    }
+    if (_len + size > SD_QUEUED_PRINT_BUF) flush();
+    if (size > SD_QUEUED_PRINT_BUF) {
+      handOff(buffer, size, nullptr, nullptr);
+    } else {
+      memcpy(_buf + _len, buffer, size);
+      _len += size;
+    }
+    return size;
+  }
+
+  void flush() override {
+    if (_kind == SD_WRITE_REPLACE) return;  // Images go over whole
+    if (_len > 0) handOff(_buf, _len, nullptr, nullptr);
+    _len = 0;
+  }
+
+  // Hand off everything written so far, with an optional commit callback
+  bool commit(SDCommitFn onCommit = nullptr, void* ctx = nullptr) {
+    if (_kind == SD_WRITE_REPLACE) {
+      endImage(onCommit, ctx);
+      return _ok;
+    }
+    handOff(_buf, _len, onCommit, ctx);
+    _len = 0;
+    return _ok;
+  }
+
+  bool ok() const { return _ok; }
+
+private:
+  void handOff(const uint8_t* data, size_t size, SDCommitFn onCommit, void* ctx) {
+    if (size == 0 && onCommit == nullptr) return;
+    if (!sdQueueWrite(_path, data, size, SD_WRITE_APPEND, onCommit, ctx)) _ok = false;
+  }
+
+  void imageWrite(const uint8_t* data, size_t size) {
+    if (_ended || !_ok) return;
+    if (_direct == nullptr && _imageLen + size > _imageCap) {
+      size_t cap = _imageCap ? _imageCap : 1024;
+      while (cap < _imageLen + size) cap *= 2;
+      uint8_t* p = psramFound() ? (uint8_t*)ps_realloc(_image, cap) : nullptr;
+      if (p == nullptr) p = (uint8_t*)realloc(_image, cap);
+      if (p != nullptr) {
+        _image = p;
+        _imageCap = cap;
+      } else {
+        // Out of RAM: this image replaces anything queued for the file
+        Serial.printf("[SDQueue] No buffer for %s, writing through\n", _path);
+        sdQueueDiscard(_path);
+        _direct = new AtomicFileWriter(SD, _path, ATOMIC_FORMAT_PLAIN);
+        if (!_direct->begin() || _direct->write(_image, _imageLen) != _imageLen) _ok = false;
+        free(_image);
+        _image = nullptr;
+        _imageLen = _imageCap = 0;
+      }
+    }
+    if (_direct != nullptr) {
+      if (_ok && _direct->write(data, size) != size) _ok = false;
+    } else {
+      memcpy(_image + _imageLen, data, size);
+      _imageLen += size;
+    }
+  }
+
+  void endImage(SDCommitFn onCommit, void* ctx) {
+    if (_ended) return;
+    _ended = true;
+    if (_direct != nullptr) {
+      _ok = _ok && _direct->commit();
+      if (onCommit != nullptr) onCommit(_ok, ctx);
+    } else if (_imageLen > 0) {
+      _ok = sdQueueWrite(_path, _image, _imageLen, SD_WRITE_REPLACE, onCommit, ctx) && _ok;
+    } else if (onCommit != nullptr) {
+      onCommit(_ok, ctx);  // Nothing written, nothing replaced
+    }
+    free(_image);
+    _image = nullptr;
+    _imageLen = _imageCap = 0;
+  }
+
+  const char* _path;
+  SDWriteKind _kind;
+  uint8_t _buf[SD_QUEUED_PRINT_BUF];
+  size_t _len;
+  bool _ok;
+  uint8_t* _image;            // SD_WRITE_REPLACE: the image so far
+  size_t _imageLen;
+  size_t _imageCap;
+  AtomicFileWriter* _direct;  // Set once the image no longer fits in RAM
+  bool _ended;
+};
+
+#endif // SD_WRITE_QUEUE_H
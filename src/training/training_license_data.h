@@ -9,6 +9,7 @@
 #include <SD.h>
 #include <ArduinoJson.h>
 #include "../storage/sd_card.h"
+#include "../storage/atomic_file.h"
 #include "../core/config.h"
 
 // Forward declaration from training_license_core.h
@@ -92,8 +93,9 @@ bool loadQuestionPool(QuestionPool* pool) {
   Serial.print("Loading question pool: ");
   Serial.println(pool->filename);
 
-  // Open JSON file
-  File file = SD.open(pool->filename);
+  // Open JSON file (past the atomic_file.h header older downloads carry)
+  AtomicFileInfo info;
+  File file = atomicFileOpen(SD, pool->filename, &info);
   if (!file) {
     Serial.print("ERROR: Failed to open file: ");
     Serial.println(pool->filename);
@@ -101,7 +103,7 @@ bool loadQuestionPool(QuestionPool* pool) {
   }
 
   // Read file into buffer
-  size_t fileSize = file.size();
+  size_t fileSize = info.length;
   Serial.print("File size: ");
   Serial.print(fileSize);
   Serial.println(" bytes");
@@ -10,6 +10,7 @@
 #include <HTTPClient.h>
 #include "../core/config.h"
 #include "../storage/sd_card.h"
+#include "../storage/atomic_file.h"
 #include "../audio/i2s_audio.h"  // For beep() function
 
 // Forward declaration - avoid circular dependency
@@ -38,7 +39,9 @@ enum DownloadStatus {
  */
 bool questionFileExists(const char* filename) {
   if (!sdCardAvailable) return false;
-  return SD.exists(filename);
+  // Also finishes a download whose rename was interrupted
+  AtomicFileStatus status = atomicFileRecover(SD, filename);
+  return status != ATOMIC_FILE_MISSING && status != ATOMIC_FILE_CORRUPT;
 }
 
 /**
@@ -69,9 +72,10 @@ DownloadStatus downloadFile(const char* url, const char* filepath) {
     Serial.print(len);
     Serial.println(" bytes");
 
-    // Open file for writing
-    File file = SD.open(filepath, FILE_WRITE);
-    if (!file) {
+    // Written to a .tmp and renamed into place only once complete; plain
+    // JSON (no atomic header) so the file stays readable off the card
+    AtomicFileWriter file(SD, filepath, ATOMIC_FORMAT_PLAIN);
+    if (!file.begin()) {
       Serial.println("ERROR: Failed to open file for writing");
       http.end();
       return DOWNLOAD_FAILED_WRITE;
@@ -106,18 +110,21 @@ DownloadStatus downloadFile(const char* url, const char* filepath) {
       delay(1);
     }
 
-    file.close();
     http.end();
 
-    // A dropped connection leaves a truncated file that would pass the
-    // exists() check forever - delete it and report failure instead.
+    // A dropped connection would leave a truncated file that passes the
+    // exists() check forever - never commit a partial download.
     if (len > 0 || totalRead == 0) {
       Serial.print("ERROR: Incomplete download (");
       Serial.print(totalRead);
-      Serial.println(" bytes), removing partial file");
-      SD.remove(filepath);
+      Serial.println(" bytes), discarding partial file");
+      file.abort();
       return DOWNLOAD_FAILED_HTTP;
     }
+    if (!file.commit()) {
+      Serial.println("ERROR: Failed to write file");
+      return DOWNLOAD_FAILED_WRITE;
+    }
 
     Serial.print("Download complete: ");
     Serial.print(totalRead);
@@ -11,8 +11,192 @@
 #include "../../morse_notes/morse_notes_types.h"
 #include "../../morse_notes/morse_notes_storage.h"
 #include "../../morse_notes/morse_notes_wav_export.h"
+#include "../../morse_notes/morse_notes_transcript.h"
 #include "../../storage/sd_card.h"
 
+// ===================================
+// LOOP-TASK HANDOFF
+// ===================================
+// The library (in-RAM index, list order, library.bin) belongs to the loop
+// task: recording, the transcript job and search change it there. Loading it
+// may also compact it, and everything here reads the SD, which would race the
+// display for the SPI bus from the AsyncTCP task. So handlers only queue a
+// request and answer 202 {"pending":true}; updateMorseNotesSearch() and
+// updateMorseNotesLibrary() run it from loop(), and repeating the request
+// returns the finished result once. One request of each kind is queued at a
+// time (the latest wins).
+
+static SemaphoreHandle_t mnWebMutex = NULL;
+
+static void mnWebLock() {
+    if (mnWebMutex == NULL) mnWebMutex = xSemaphoreCreateMutex();
+    xSemaphoreTake(mnWebMutex, portMAX_DELAY);
+}
+
+static void mnWebUnlock() {
+    xSemaphoreGive(mnWebMutex);
+}
+
+static void mnWebSendPending(AsyncWebServerRequest *request) {
+    request->send(202, "application/json", "{\"pending\":true}");
+}
+
+// ===================================
+// LIBRARY REQUESTS
+// ===================================
+
+enum MnWebLibraryOp : uint8_t {
+    MN_WEB_NONE = 0,
+    MN_WEB_LIST,
+    MN_WEB_METADATA,
+    MN_WEB_FILE,                   // Recording path, for download
+    MN_WEB_WAV,                    // Export a WAV, result is its path
+    MN_WEB_DELETE,
+    MN_WEB_RENAME
+};
+
+struct MnWebLibraryRequest {
+    uint8_t op;
+    unsigned long id;
+    char title[64];
+};
+
+static MnWebLibraryRequest mnWebQueued = {};   // Waiting for the loop
+static MnWebLibraryRequest mnWebDone = {};     // Request answered below
+static int mnWebDoneCode = 0;                  // HTTP status, 0 = no answer
+static String mnWebDoneBody;                   // JSON, or a file path for FILE/WAV
+
+static bool mnWebSameRequest(const MnWebLibraryRequest& a, const MnWebLibraryRequest& b) {
+    return a.op == b.op && a.id == b.id && strcmp(a.title, b.title) == 0;
+}
+
+/**
+ * Take the finished answer to `req`, or queue it for the loop
+ * @return true with code and body set if the answer was ready
+ */
+static bool mnWebLibraryResult(const MnWebLibraryRequest& req, int& code, String& body) {
+    bool ready = false;
+    mnWebLock();
+    if (mnWebDoneCode != 0 && mnWebSameRequest(mnWebDone, req)) {
+        code = mnWebDoneCode;
+        body = mnWebDoneBody;
+        mnWebDoneCode = 0;
+        mnWebDoneBody = String();
+        ready = true;
+    } else {
+        mnWebQueued = req;
+    }
+    mnWebUnlock();
+    return ready;
+}
+
+static void mnWebMetadataJson(const MorseNoteMetadata& meta, JsonObject obj) {
+    obj["id"] = (unsigned long)meta.id;
+    obj["title"] = String(meta.title);
+    obj["timestamp"] = (unsigned long)meta.timestamp;
+    obj["durationMs"] = (unsigned long)meta.durationMs;
+    obj["eventCount"] = meta.eventCount;
+    obj["avgWPM"] = meta.avgWPM;
+    obj["toneFrequency"] = meta.toneFrequency;
+    obj["tags"] = String(meta.tags);
+}
+
+/**
+ * Run a queued library request. Call from loop().
+ */
+void updateMorseNotesLibrary() {
+    mnWebLock();
+    MnWebLibraryRequest req = mnWebQueued;
+    mnWebQueued.op = MN_WEB_NONE;
+    mnWebUnlock();
+    if (req.op == MN_WEB_NONE) return;
+
+    int code = 200;
+    String body;
+    MorseNoteMetadata meta;
+    JsonDocument doc;
+
+    if (!mnLoadLibrary()) {
+        code = 500;
+        body = "{\"error\":\"Failed to load library\"}";
+    } else {
+        switch (req.op) {
+            case MN_WEB_LIST: {
+                JsonArray recordings = doc["recordings"].to<JsonArray>();
+
+                // A page of metadata at a time (titles and tags are read from SD)
+                static MorseNoteMetadata page[MN_LIBRARY_PAGE_SIZE];
+                int count = mnGetLibraryCount();
+                for (int first = 0; first < count; first += MN_LIBRARY_PAGE_SIZE) {
+                    int n = mnGetMetadataPage(first, page, MN_LIBRARY_PAGE_SIZE);
+                    for (int i = 0; i < n; i++) {
+                        mnWebMetadataJson(page[i], recordings.add<JsonObject>());
+                    }
+                }
+                serializeJson(doc, body);
+                break;
+            }
+
+            case MN_WEB_METADATA:
+                if (mnGetMetadata(req.id, meta)) {
+                    mnWebMetadataJson(meta, doc.to<JsonObject>());
+                    serializeJson(doc, body);
+                } else {
+                    code = 404;
+                    body = "{\"error\":\"Recording not found\"}";
+                }
+                break;
+
+            case MN_WEB_FILE: {
+                // Files are named by timestamp, not id
+                char filename[64] = "";
+                if (mnGetMetadata(req.id, meta)) {
+                    mnGenerateFilename(meta.timestamp, filename, sizeof(filename));
+                }
+                if (filename[0] != '\0' && fileExists(filename)) {
+                    body = filename;
+                } else {
+                    code = 404;
+                    body = "Recording not found";
+                }
+                break;
+            }
+
+            case MN_WEB_WAV:
+                body = mnGenerateWAV(req.id);
+                if (body.isEmpty()) {
+                    code = 500;
+                    body = "Failed to generate WAV file";
+                }
+                break;
+
+            case MN_WEB_DELETE:
+                if (mnDeleteRecording(req.id)) {
+                    body = "{\"success\":true}";
+                } else {
+                    code = 500;
+                    body = "{\"success\":false,\"error\":\"Failed to delete recording\"}";
+                }
+                break;
+
+            case MN_WEB_RENAME:
+                if (mnRenameRecording(req.id, req.title)) {
+                    body = "{\"success\":true}";
+                } else {
+                    code = 500;
+                    body = "{\"success\":false,\"error\":\"Failed to update recording\"}";
+                }
+                break;
+        }
+    }
+
+    mnWebLock();
+    mnWebDone = req;
+    mnWebDoneCode = code;
+    mnWebDoneBody = body;
+    mnWebUnlock();
+}
+
 // ===================================
 // API HANDLERS
 // ===================================
@@ -20,6 +204,7 @@
 /**
  * GET /api/morse-notes/list
  * Returns JSON array of all Morse Notes recordings
+ * 202 {"pending":true} until the list is ready; repeat the request.
  */
 void handleGetMorseNotesList(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -27,36 +212,20 @@ void handleGetMorseNotesList(AsyncWebServerRequest *request) {
         return;
     }
 
-    // Load library
-    if (!mnLoadLibrary()) {
-        request->send(500, "application/json", "{\"error\":\"Failed to load library\"}");
+    MnWebLibraryRequest req = {MN_WEB_LIST};
+    int code;
+    String body;
+    if (!mnWebLibraryResult(req, code, body)) {
+        mnWebSendPending(request);
         return;
     }
-
-    // Build JSON response
-    JsonDocument doc;
-    JsonArray recordings = doc["recordings"].to<JsonArray>();
-
-    for (int i = 0; i < mnLibraryCount; i++) {
-        JsonObject rec = recordings.add<JsonObject>();
-        rec["id"] = (unsigned long)mnLibrary[i].id;
-        rec["title"] = String(mnLibrary[i].title);
-        rec["timestamp"] = (unsigned long)mnLibrary[i].timestamp;
-        rec["durationMs"] = (unsigned long)mnLibrary[i].durationMs;
-        rec["eventCount"] = mnLibrary[i].eventCount;
-        rec["avgWPM"] = mnLibrary[i].avgWPM;
-        rec["toneFrequency"] = mnLibrary[i].toneFrequency;
-        rec["tags"] = String(mnLibrary[i].tags);
-    }
-
-    String response;
-    serializeJson(doc, response);
-    request->send(200, "application/json", response);
+    request->send(code, "application/json", body);
 }
 
 /**
  * GET /api/morse-notes/metadata?id=X
  * Returns JSON metadata for a single recording
+ * 202 {"pending":true} until it has been read; repeat the request.
  */
 void handleGetMorseNoteMetadata(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -69,47 +238,21 @@ void handleGetMorseNoteMetadata(AsyncWebServerRequest *request) {
         return;
     }
 
-    unsigned long id = request->getParam("id")->value().toInt();
-
-    // Load library
-    if (!mnLoadLibrary()) {
-        request->send(500, "application/json", "{\"error\":\"Failed to load library\"}");
+    MnWebLibraryRequest req = {MN_WEB_METADATA};
+    req.id = request->getParam("id")->value().toInt();
+    int code;
+    String body;
+    if (!mnWebLibraryResult(req, code, body)) {
+        mnWebSendPending(request);
         return;
     }
-
-    // Find recording
-    MorseNoteMetadata* metadata = nullptr;
-    for (int i = 0; i < mnLibraryCount; i++) {
-        if (mnLibrary[i].id == id) {
-            metadata = &mnLibrary[i];
-            break;
-        }
-    }
-
-    if (!metadata) {
-        request->send(404, "application/json", "{\"error\":\"Recording not found\"}");
-        return;
-    }
-
-    // Build JSON response
-    JsonDocument doc;
-    doc["id"] = (unsigned long)metadata->id;
-    doc["title"] = String(metadata->title);
-    doc["timestamp"] = (unsigned long)metadata->timestamp;
-    doc["durationMs"] = (unsigned long)metadata->durationMs;
-    doc["eventCount"] = metadata->eventCount;
-    doc["avgWPM"] = metadata->avgWPM;
-    doc["toneFrequency"] = metadata->toneFrequency;
-    doc["tags"] = String(metadata->tags);
-
-    String response;
-    serializeJson(doc, response);
-    request->send(200, "application/json", response);
+    request->send(code, "application/json", body);
 }
 
 /**
  * GET /api/morse-notes/download?id=X
- * Downloads raw .mr file
+ * Downloads raw .mr file (v2 for new recordings, see morse_notes_format.h)
+ * 202 {"pending":true} until the file has been looked up; repeat the request.
  */
 void handleDownloadMorseNote(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -122,24 +265,27 @@ void handleDownloadMorseNote(AsyncWebServerRequest *request) {
         return;
     }
 
-    unsigned long id = request->getParam("id")->value().toInt();
-
-    // Build filename
-    char filename[64];
-    snprintf(filename, sizeof(filename), MN_DIR "/%lu.mr", id);
-
-    if (!fileExists(filename)) {
-        request->send(404, "text/plain", "Recording not found");
+    MnWebLibraryRequest req = {MN_WEB_FILE};
+    req.id = request->getParam("id")->value().toInt();
+    int code;
+    String body;
+    if (!mnWebLibraryResult(req, code, body)) {
+        mnWebSendPending(request);
+        return;
+    }
+    if (code != 200) {
+        request->send(code, "text/plain", body);
         return;
     }
 
     // Send file
-    request->send(SD, filename, "application/octet-stream", true);
+    request->send(SD, body, "application/octet-stream", true);
 }
 
 /**
  * GET /api/morse-notes/export/wav?id=X
  * Exports recording as WAV file
+ * 202 {"pending":true} until the WAV has been written; repeat the request.
  */
 void handleExportMorseNoteWAV(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -152,20 +298,16 @@ void handleExportMorseNoteWAV(AsyncWebServerRequest *request) {
         return;
     }
 
-    unsigned long id = request->getParam("id")->value().toInt();
-
-    // Generate WAV file
-    String wavPath = mnGenerateWAV(id);
-
-    if (wavPath.isEmpty()) {
-        request->send(500, "text/plain", "Failed to generate WAV file");
+    MnWebLibraryRequest req = {MN_WEB_WAV};
+    req.id = request->getParam("id")->value().toInt();
+    int code;
+    String wavPath;
+    if (!mnWebLibraryResult(req, code, wavPath)) {
+        mnWebSendPending(request);
         return;
     }
-
-    // Send WAV file
-    File wavFile = SD.open(wavPath.c_str(), FILE_READ);
-    if (!wavFile) {
-        request->send(500, "text/plain", "Failed to open WAV file");
+    if (code != 200) {
+        request->send(code, "text/plain", wavPath);
         return;
     }
 
@@ -179,7 +321,7 @@ void handleExportMorseNoteWAV(AsyncWebServerRequest *request) {
 
     // Set filename for download
     char filename[128];
-    snprintf(filename, sizeof(filename), "attachment; filename=\"morse_note_%lu.wav\"", id);
+    snprintf(filename, sizeof(filename), "attachment; filename=\"morse_note_%lu.wav\"", req.id);
     response->addHeader("Content-Disposition", filename);
 
     // Send response
@@ -188,9 +330,105 @@ void handleExportMorseNoteWAV(AsyncWebServerRequest *request) {
     // Note: Temp file cleanup happens in mnGenerateWAV or can be done periodically
 }
 
+// ===================================
+// SEARCH
+// ===================================
+
+#define MN_WEB_SEARCH_QUERY_LEN    64
+
+static char mnWebSearchQueued[MN_WEB_SEARCH_QUERY_LEN] = "";   // Waiting for the loop
+static char mnWebSearchDoneQuery[MN_WEB_SEARCH_QUERY_LEN] = "";
+static String mnWebSearchResult;                               // JSON for DoneQuery
+
+/**
+ * GET /api/morse-notes/search?q=X
+ * Full-text search of the decoded transcripts. Each hit carries the event
+ * index and time (ms) where the match starts, for seeking playback.
+ * 202 {"pending":true} until the search has run; repeat the request.
+ */
+void handleSearchMorseNotes(AsyncWebServerRequest *request) {
+    if (!sdCardAvailable) {
+        request->send(503, "application/json", "{\"error\":\"SD card not available\"}");
+        return;
+    }
+
+    if (!request->hasParam("q")) {
+        request->send(400, "application/json", "{\"error\":\"Missing q parameter\"}");
+        return;
+    }
+
+    String query = request->getParam("q")->value();
+    if (query.length() >= MN_WEB_SEARCH_QUERY_LEN) {
+        request->send(400, "application/json", "{\"error\":\"Query too long\"}");
+        return;
+    }
+
+    // A finished result is handed out once; otherwise queue (latest query wins)
+    String response;
+    mnWebLock();
+    if (mnWebSearchResult.length() > 0 && strcmp(mnWebSearchDoneQuery, query.c_str()) == 0) {
+        response = mnWebSearchResult;
+        mnWebSearchResult = String();
+        mnWebSearchDoneQuery[0] = '\0';
+    } else {
+        strlcpy(mnWebSearchQueued, query.c_str(), sizeof(mnWebSearchQueued));
+    }
+    mnWebUnlock();
+
+    if (response.length() > 0) {
+        request->send(200, "application/json", response);
+        return;
+    }
+
+    JsonDocument doc;
+    doc["query"] = query;
+    doc["pending"] = true;
+    serializeJson(doc, response);
+    request->send(202, "application/json", response);
+}
+
+/**
+ * Run a queued web search. Call from loop().
+ */
+void updateMorseNotesSearch() {
+    char query[MN_WEB_SEARCH_QUERY_LEN];
+    mnWebLock();
+    strlcpy(query, mnWebSearchQueued, sizeof(query));
+    mnWebSearchQueued[0] = '\0';
+    mnWebUnlock();
+    if (query[0] == '\0') return;
+
+    static MorseNoteSearchHit hits[MN_SEARCH_MAX_HITS];
+    int count = mnSearchNotes(query, hits, MN_SEARCH_MAX_HITS);
+
+    // Build JSON response
+    JsonDocument doc;
+    doc["query"] = query;
+    doc["pending"] = false;
+    doc["indexing"] = mnTranscriptBusy();
+    JsonArray results = doc["hits"].to<JsonArray>();
+    for (int i = 0; i < count; i++) {
+        MorseNoteMetadata meta;
+        JsonObject hit = results.add<JsonObject>();
+        hit["id"] = (unsigned long)hits[i].id;
+        hit["title"] = mnGetMetadata(hits[i].id, meta) ? String(meta.title) : String("");
+        hit["eventIndex"] = hits[i].eventIndex;
+        hit["startMs"] = hits[i].startMs;
+        hit["snippet"] = String(hits[i].snippet);
+    }
+
+    String response;
+    serializeJson(doc, response);
+    mnWebLock();
+    strlcpy(mnWebSearchDoneQuery, query, sizeof(mnWebSearchDoneQuery));
+    mnWebSearchResult = response;
+    mnWebUnlock();
+}
+
 /**
  * DELETE /api/morse-notes/delete?id=X
  * Deletes a recording
+ * 202 {"pending":true} until it has been deleted; repeat the request.
  */
 void handleDeleteMorseNote(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -203,18 +441,21 @@ void handleDeleteMorseNote(AsyncWebServerRequest *request) {
         return;
     }
 
-    unsigned long id = request->getParam("id")->value().toInt();
-
-    if (mnDeleteRecording(id)) {
-        request->send(200, "application/json", "{\"success\":true}");
-    } else {
-        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to delete recording\"}");
+    MnWebLibraryRequest req = {MN_WEB_DELETE};
+    req.id = request->getParam("id")->value().toInt();
+    int code;
+    String body;
+    if (!mnWebLibraryResult(req, code, body)) {
+        mnWebSendPending(request);
+        return;
     }
+    request->send(code, "application/json", body);
 }
 
 /**
  * PUT /api/morse-notes/update?id=X&title=Y
  * Updates recording title
+ * 202 {"pending":true} until it has been renamed; repeat the request.
  */
 void handleUpdateMorseNote(AsyncWebServerRequest *request) {
     if (!sdCardAvailable) {
@@ -227,14 +468,16 @@ void handleUpdateMorseNote(AsyncWebServerRequest *request) {
         return;
     }
 
-    unsigned long id = request->getParam("id")->value().toInt();
-    String title = request->getParam("title")->value();
-
-    if (mnRenameRecording(id, title.c_str())) {
-        request->send(200, "application/json", "{\"success\":true}");
-    } else {
-        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to update recording\"}");
+    MnWebLibraryRequest req = {MN_WEB_RENAME};
+    req.id = request->getParam("id")->value().toInt();
+    strlcpy(req.title, request->getParam("title")->value().c_str(), sizeof(req.title));
+    int code;
+    String body;
+    if (!mnWebLibraryResult(req, code, body)) {
+        mnWebSendPending(request);
+        return;
     }
+    request->send(code, "application/json", body);
 }
 
 // ===================================
@@ -251,6 +494,9 @@ void registerMorseNotesAPI(AsyncWebServer* server) {
     // Get single recording metadata
     server->on("/api/morse-notes/metadata", HTTP_GET, handleGetMorseNoteMetadata);
 
+    // Search transcripts
+    server->on("/api/morse-notes/search", HTTP_GET, handleSearchMorseNotes);
+
     // Download raw .mr file
     server->on("/api/morse-notes/download", HTTP_GET, handleDownloadMorseNote);
 
@@ -6,6 +6,7 @@
  * Provides REST API endpoints for:
  * - Station settings (callsign, grid square, POTA)
  * - QSO CRUD operations (create, update, delete)
+ * - Streaming ADIF import
  *
  * Extracted from web_server.h for modularity
  */
@@ -18,19 +19,20 @@
 #include <Preferences.h>
 #include <SD.h>
 #include "../../qso/qso_logger.h"
+#include "../../qso/qso_logger_import.h"
 #include "../../storage/sd_card.h"
 
 // External declarations for functions from other modules
-extern bool saveQSO(const QSO& qso);                    // From qso_logger_storage.h
+extern bool saveQSO(QSO& qso);                          // From qso_logger_storage.h
 extern bool isQSOStorageReady();                        // From qso_logger_storage.h
 extern void regenerateADIFFiles(const char* date);      // From qso_logger_storage.h
+extern bool findQSO(const char* date, unsigned long id, QSO* out);  // From qso_logger_storage.h
+extern bool updateQSO(const QSO& qso);                  // From qso_logger_storage.h
+extern bool deleteQSOOnDate(const char* date, unsigned long id);    // From qso_logger_storage.h
 extern String frequencyToBand(float freq);              // From qso_logger_validation.h
 extern String formatCurrentDateTime();                  // From qso_logger_validation.h
 extern bool checkWebAuth(AsyncWebServerRequest *request); // From web_server.h
 
-// QSO directory on SD card
-#define QSO_DIR "/qso"
-
 /*
  * Setup all QSO-related API endpoints
  * Call this from setupWebServer() in web_server.h
@@ -214,70 +216,36 @@ void setupQSOAPI(AsyncWebServer &webServer) {
         return;
       }
 
-      // Load the day's log file from SD card
-      String filename = String(QSO_DIR) + "/qso_" + String(date) + ".json";
-      File file = SD.open(filename, "r");
-      if (!file) {
-        request->send(404, "application/json", "{\"success\":false,\"error\":\"Log file not found\"}");
-        return;
-      }
-
-      String content = file.readString();
-      file.close();
-
-      // Parse log file
-      JsonDocument logDoc;
-      error = deserializeJson(logDoc, content);
-      if (error) {
-        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to parse log file\"}");
-        return;
-      }
-
-      // Find and update the QSO
-      bool found = false;
-      JsonArray logs = logDoc["logs"].as<JsonArray>();
-      for (JsonObject qso : logs) {
-        if (qso["id"].as<unsigned long>() == id) {
-          // Update all fields
-          qso["callsign"] = doc["callsign"];
-          float frequency = doc["frequency"];
-          qso["frequency"] = frequency;
-          qso["mode"] = doc["mode"];
-
-          // Calculate band from frequency
-          String band = frequencyToBand(frequency);
-          qso["band"] = band;
-
-          qso["rst_sent"] = doc["rst_sent"];
-          qso["rst_rcvd"] = doc["rst_rcvd"];
-          qso["gridsquare"] = doc["gridsquare"];
-          qso["my_gridsquare"] = doc["my_gridsquare"];
-          qso["my_pota_ref"] = doc["my_pota_ref"];
-          qso["their_pota_ref"] = doc["their_pota_ref"];
-          qso["notes"] = doc["notes"];
-          found = true;
-          break;
-        }
-      }
-
-      if (!found) {
+      // Find the QSO in the day's journal
+      QSO qso;
+      if (!findQSO(date, id, &qso)) {
         request->send(404, "application/json", "{\"success\":false,\"error\":\"QSO not found\"}");
         return;
       }
 
-      // Save updated log file to SD card
-      file = SD.open(filename, FILE_WRITE);
-      if (!file) {
-        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to open file for writing\"}");
+      // Update editable fields
+      strlcpy(qso.callsign, doc["callsign"] | "", sizeof(qso.callsign));
+      qso.frequency = doc["frequency"] | 0.0f;
+      strlcpy(qso.mode, doc["mode"] | "", sizeof(qso.mode));
+
+      // Calculate band from frequency
+      String band = frequencyToBand(qso.frequency);
+      strlcpy(qso.band, band.c_str(), sizeof(qso.band));
+
+      strlcpy(qso.rst_sent, doc["rst_sent"] | "", sizeof(qso.rst_sent));
+      strlcpy(qso.rst_rcvd, doc["rst_rcvd"] | "", sizeof(qso.rst_rcvd));
+      strlcpy(qso.gridsquare, doc["gridsquare"] | "", sizeof(qso.gridsquare));
+      strlcpy(qso.my_gridsquare, doc["my_gridsquare"] | "", sizeof(qso.my_gridsquare));
+      strlcpy(qso.my_pota_ref, doc["my_pota_ref"] | "", sizeof(qso.my_pota_ref));
+      strlcpy(qso.their_pota_ref, doc["their_pota_ref"] | "", sizeof(qso.their_pota_ref));
+      strlcpy(qso.notes, doc["notes"] | "", sizeof(qso.notes));
+
+      // Appends an update record; ADIF files are regenerated by updateQSO()
+      if (!updateQSO(qso)) {
+        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to save QSO\"}");
         return;
       }
 
-      serializeJson(logDoc, file);
-      file.close();
-
-      // Regenerate ADIF files
-      regenerateADIFFiles(date);
-
       Serial.println("QSO updated via web interface");
       request->send(200, "application/json", "{\"success\":true}");
     });
@@ -300,68 +268,84 @@ void setupQSOAPI(AsyncWebServer &webServer) {
     String date = request->getParam("date")->value();
     unsigned long id = request->getParam("id")->value().toInt();
 
-    // Load the day's log file from SD card
-    String filename = String(QSO_DIR) + "/qso_" + date + ".json";
-    File file = SD.open(filename, "r");
-    if (!file) {
-      request->send(404, "application/json", "{\"success\":false,\"error\":\"Log file not found\"}");
+    // Appends a tombstone; ADIF files are regenerated by deleteQSOOnDate()
+    if (!deleteQSOOnDate(date.c_str(), id)) {
+      request->send(404, "application/json", "{\"success\":false,\"error\":\"QSO not found\"}");
       return;
     }
 
-    String content = file.readString();
-    file.close();
+    Serial.println("QSO deleted via web interface");
+    request->send(200, "application/json", "{\"success\":true}");
+  });
 
-    // Parse log file
-    JsonDocument logDoc;
-    DeserializationError error = deserializeJson(logDoc, content);
-    if (error) {
-      request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to parse log file\"}");
-      return;
-    }
+  // ============================================
+  // ADIF Import
+  // ============================================
 
-    // Find and remove the QSO
-    bool found = false;
-    JsonArray logs = logDoc["logs"].as<JsonArray>();
-    for (size_t i = 0; i < logs.size(); i++) {
-      if (logs[i]["id"].as<unsigned long>() == id) {
-        logs.remove(i);
-        found = true;
-        break;
+  // Upload an ADIF file (multipart "file" field). Parsed as it arrives and
+  // stored by the main loop; /api/import/status reports the final counts.
+  webServer.on("/api/import/adif", HTTP_POST,
+    [](AsyncWebServerRequest *request) {
+      // Response is sent from the upload handler
+    },
+    [](AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final) {
+      static AsyncWebServerRequest* importRequest = nullptr;
+
+      if (index == 0) {
+        if (!checkWebAuth(request)) return;
+        if (!sdCardAvailable) {
+          request->send(503, "application/json", "{\"success\":false,\"error\":\"SD card required for QSO logging\"}");
+          return;
+        }
+        if (!beginADIFImport(request->contentLength())) {
+          request->send(409, "application/json", "{\"success\":false,\"error\":\"Import already running\"}");
+          return;
+        }
+        importRequest = request;
+        Serial.printf("ADIF import upload: %s\n", filename.c_str());
+
+        // Client gone before the last chunk: release the import so the
+        // next upload isn't refused, and still rebuild what was written
+        request->onDisconnect([request]() {
+          if (importRequest != request) return;
+          importRequest = nullptr;
+          abortADIFImport();
+        });
       }
-    }
+      if (request != importRequest) return;
 
-    if (!found) {
-      request->send(404, "application/json", "{\"success\":false,\"error\":\"QSO not found\"}");
-      return;
-    }
+      feedADIFImport(data, len);
 
-    // Update count
-    int newCount = logs.size();
-    logDoc["count"] = newCount;
-
-    // If no QSOs left, delete the JSON file and its ADIF counterpart
-    if (newCount == 0) {
-      SD.remove(filename);
-      String adifFile = String(QSO_DIR) + "/qso_" + date + ".adi";
-      SD.remove(adifFile);
-      Serial.println("Log files deleted (no QSOs remaining)");
-    } else {
-      // Save updated log file to SD card
-      file = SD.open(filename, FILE_WRITE);
-      if (!file) {
-        request->send(500, "application/json", "{\"success\":false,\"error\":\"Failed to open file for writing\"}");
-        return;
+      if (final) {
+        importRequest = nullptr;
+        endADIFImport();  // Queued records, index and ADIF rebuild follow in the main loop
+
+        JsonDocument doc;
+        doc["success"] = true;
+        doc["pending"] = true;
+        doc["records"] = qsoImportProgress.records;
+        String output;
+        serializeJson(doc, output);
+        request->send(202, "application/json", output);
       }
+    });
 
-      serializeJson(logDoc, file);
-      file.close();
-    }
+  // Progress of the running (or last) import
+  webServer.on("/api/import/status", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (!checkWebAuth(request)) return;
 
-    // Regenerate ADIF files
-    regenerateADIFFiles(date.c_str());
+    JsonDocument doc;
+    doc["active"] = qsoImportProgress.active;
+    doc["bytes_received"] = qsoImportProgress.bytesReceived;
+    doc["bytes_total"] = qsoImportProgress.bytesTotal;
+    doc["records"] = qsoImportProgress.records;
+    doc["imported"] = qsoImportProgress.imported;
+    doc["dupes"] = qsoImportProgress.dupes;
+    doc["skipped"] = qsoImportProgress.skipped;
 
-    Serial.println("QSO deleted via web interface");
-    request->send(200, "application/json", "{\"success\":true}");
+    String output;
+    serializeJson(doc, output);
+    request->send(200, "application/json", output);
   });
 }
 
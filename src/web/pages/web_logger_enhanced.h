@@ -263,6 +263,8 @@ const char LOGGER_HTML[] PROGMEM = R"rawliteral(
             <button class="btn btn-primary" onclick="toggleMap()">🗺️ Map</button>
             <button class="btn btn-primary" onclick="exportADIF()">📥 ADIF</button>
             <button class="btn btn-primary" onclick="exportCSV()">📥 CSV</button>
+            <button class="btn btn-primary" id="importBtn" onclick="document.getElementById('importFile').click()">📤 Import ADIF</button>
+            <input type="file" id="importFile" accept=".adi,.adif" style="display:none;" onchange="importADIF(this)">
         </div>
 
         <div class="table-container">
@@ -445,10 +447,21 @@ const char LOGGER_HTML[] PROGMEM = R"rawliteral(
             }
         }
 
+        // Fetch, waiting out 503 + Retry-After while the device rebuilds
+        // the QSO index or an export file
+        async function fetchWhenReady(url) {
+            for (let tries = 0; ; tries++) {
+                const response = await fetch(url);
+                const retryAfter = response.headers.get('Retry-After');
+                if (response.status !== 503 || !retryAfter || tries >= 30) return response;
+                await new Promise(resolve => setTimeout(resolve, (parseInt(retryAfter) || 2) * 1000));
+            }
+        }
+
         // Load QSO logs
         async function loadQSOs() {
             try {
-                const response = await fetch('/api/qsos');
+                const response = await fetchWhenReady('/api/qsos');
                 const data = await response.json();
                 allQSOs = data.logs || [];
 
@@ -720,12 +733,79 @@ const char LOGGER_HTML[] PROGMEM = R"rawliteral(
         }
 
         // Export functions
+        // Download an export once the device has it ready
+        async function downloadExport(url, filename) {
+            try {
+                const response = await fetchWhenReady(url);
+                if (!response.ok) throw new Error(response.status);
+                const link = document.createElement('a');
+                link.href = URL.createObjectURL(await response.blob());
+                link.download = filename;
+                link.click();
+                URL.revokeObjectURL(link.href);
+            } catch (e) {
+                alert('Export failed');
+            }
+        }
+
         function exportADIF() {
-            window.location.href = '/api/export/adif';
+            downloadExport('/api/export/adif', 'vail-summit-logs.adi');
         }
 
         function exportCSV() {
-            window.location.href = '/api/export/csv';
+            downloadExport('/api/export/csv', 'vail-summit-logs.csv');
+        }
+
+        // Wait for the device to finish storing an upload, then return its counts
+        async function waitForImport(btn) {
+            btn.textContent = '📤 Saving...';
+            while (true) {
+                const response = await fetch('/api/import/status');
+                const s = await response.json();
+                if (!s.active) return s;
+                await new Promise(resolve => setTimeout(resolve, 500));
+            }
+        }
+
+        // Import an ADIF file (parsed on the device as it uploads)
+        function importADIF(input) {
+            const file = input.files[0];
+            if (!file) return;
+            const btn = document.getElementById('importBtn');
+            const form = new FormData();
+            form.append('file', file);
+
+            const xhr = new XMLHttpRequest();
+            xhr.open('POST', '/api/import/adif');
+            xhr.upload.onprogress = (e) => {
+                if (e.lengthComputable) {
+                    btn.textContent = `📤 ${Math.round(e.loaded * 100 / e.total)}%`;
+                }
+            };
+            xhr.onload = async () => {
+                input.value = '';
+                try {
+                    let r = JSON.parse(xhr.responseText);
+                    if (r.success) {
+                        if (r.pending) r = await waitForImport(btn);
+                        btn.textContent = '📤 Import ADIF';
+                        alert(`Imported ${r.imported} of ${r.records} QSOs\n${r.dupes} dupes, ${r.skipped} skipped`);
+                        await loadQSOs();
+                    } else {
+                        btn.textContent = '📤 Import ADIF';
+                        alert('Import failed: ' + (r.error || 'Unknown error'));
+                    }
+                } catch (e) {
+                    btn.textContent = '📤 Import ADIF';
+                    alert('Import failed');
+                }
+            };
+            xhr.onerror = () => {
+                btn.textContent = '📤 Import ADIF';
+                input.value = '';
+                alert('Import failed: connection error');
+            };
+            xhr.send(form);
         }
 
         // Initialize on load
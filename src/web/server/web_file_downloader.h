@@ -15,6 +15,7 @@
 #include <Preferences.h>
 #include "../../core/config.h"
 #include "../../storage/sd_card.h"
+#include "../../storage/sd_write_queue.h"
 
 // ============================================
 // Early Boot Download Mode
@@ -54,6 +55,7 @@ void requestWebDownloadAndReboot() {
   prefs.begin(WEB_DOWNLOAD_PREF_NAMESPACE, false);  // read-write
   prefs.putBool(WEB_DOWNLOAD_PREF_PENDING, true);
   prefs.end();
+  flushSDWriteQueue();
   delay(100);
   ESP.restart();
 }
@@ -289,25 +289,65 @@ void setupWebServer() {
   });
 
   // QSO logs list endpoint
+  // Optional paging via the QSO index:
+  //   ?limit=N&cursor=C&newest_first=1&from=YYYYMMDD&to=YYYYMMDD&band=&mode=&call=
   webServer.on("/api/qsos", HTTP_GET, [](AsyncWebServerRequest *request) {
     if (!checkWebAuth(request)) return;
-    request->send(200, "application/json", getQSOLogsJSON());
+    if (!qsoWebIndexReady()) {
+      request->send(qsoExportRetryResponse(request));
+      return;
+    }
+    if (!request->hasParam("limit")) {
+      request->send(beginQSOStreamResponse(request, QSO_STREAM_JSON));
+      return;
+    }
+
+    QSOQueryFilter filter = {};
+    if (request->hasParam("from")) filter.fromDate = request->getParam("from")->value().toInt();
+    if (request->hasParam("to")) filter.toDate = request->getParam("to")->value().toInt();
+    if (request->hasParam("band")) strlcpy(filter.band, request->getParam("band")->value().c_str(), sizeof(filter.band));
+    if (request->hasParam("mode")) strlcpy(filter.mode, request->getParam("mode")->value().c_str(), sizeof(filter.mode));
+    if (request->hasParam("call")) strlcpy(filter.callPrefix, request->getParam("call")->value().c_str(), sizeof(filter.callPrefix));
+
+    String cursor = request->hasParam("cursor") ? request->getParam("cursor")->value() : String();
+    int limit = request->getParam("limit")->value().toInt();
+    bool newestFirst = request->hasParam("newest_first") && request->getParam("newest_first")->value() == "1";
+
+    request->send(200, "application/json", getQSOPageJSON(filter, cursor, limit, newestFirst));
   });
 
   // ADIF export endpoint
   webServer.on("/api/export/adif", HTTP_GET, [](AsyncWebServerRequest *request) {
     if (!checkWebAuth(request)) return;
-    String adif = generateADIF();
-    AsyncWebServerResponse *response = request->beginResponse(200, "application/x-adif", adif);
+    if (!masterADIFWebReady()) {
+      request->send(qsoExportRetryResponse(request));
+      return;
+    }
+    AsyncWebServerResponse *response = beginADIFExportResponse(request);
     response->addHeader("Content-Disposition", "attachment; filename=vail-summit-logs.adi");
     request->send(response);
   });
 
+  // Cabrillo export endpoint (current contest)
+  webServer.on("/api/export/cabrillo", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (!checkWebAuth(request)) return;
+    if (!cabrilloWebReady()) {
+      request->send(qsoExportRetryResponse(request));
+      return;
+    }
+    AsyncWebServerResponse *response = beginCabrilloExportResponse(request);
+    response->addHeader("Content-Disposition", "attachment; filename=contest.log");
+    request->send(response);
+  });
+
   // CSV export endpoint
   webServer.on("/api/export/csv", HTTP_GET, [](AsyncWebServerRequest *request) {
     if (!checkWebAuth(request)) return;
-    String csv = generateCSV();
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/csv", csv);
+    if (!qsoWebIndexReady()) {
+      request->send(qsoExportRetryResponse(request));
+      return;
+    }
+    AsyncWebServerResponse *response = beginQSOStreamResponse(request, QSO_STREAM_CSV);
     response->addHeader("Content-Disposition", "attachment; filename=vail-summit-logs.csv");
     request->send(response);
   });
@@ -8,15 +8,28 @@
 #define WEB_SERVER_API_H
 
 #include <ArduinoJson.h>
+#include <ESPAsyncWebServer.h>
+#include <memory>
 #include <FS.h>
 #include <SD.h>
 #include "../../core/config.h"
 #include "../../storage/sd_card.h"
+#include "../../qso/qso_logger.h"
+#include "../../qso/qso_logger_index.h"
+#include "../../qso/qso_logger_import.h"
+#include "../../qso/qso_logger_contest.h"
 
 // QSO directory on SD card
 #define QSO_DIR "/qso"
 #define MASTER_ADIF_FILE "/qso/vail-summit.adi"
 
+// From qso_logger_storage.h
+extern void qsoToJson(const QSO& qso, JsonObject& obj);
+extern bool ensureMasterADIF();
+extern bool masterADIFCurrent();
+extern bool ensureQSOIndex();
+extern bool readQSOAt(const char* date, uint32_t offset, unsigned long id, QSO* out);
+
 /*
  * Get device status as JSON
  * Returns battery, WiFi, QSO count, firmware version, and active mode
@@ -109,6 +122,7 @@ String getDeviceStatusJSON() {
     case MODE_SUMMIT_CHAT: modeStr = "Summit Chat"; break;
     case MODE_QSO_LOGGER_MENU: modeStr = "QSO Logger Menu"; break;
     case MODE_QSO_LOG_ENTRY: modeStr = "QSO Logger"; break;
+    case MODE_QSO_CONTEST: modeStr = "Contest Logging"; break;
     case MODE_QSO_VIEW_LOGS: modeStr = "View Logs"; break;
     case MODE_QSO_STATISTICS: modeStr = "QSO Statistics"; break;
     case MODE_QSO_LOGGER_SETTINGS: modeStr = "QSO Settings"; break;
@@ -121,18 +135,100 @@ String getDeviceStatusJSON() {
   return output;
 }
 
+// ============================================
+// Export preparation (main loop)
+// ============================================
+//
+// Rebuilding the QSO index, the master ADIF file or the Cabrillo log reads
+// every journal, far too long for an AsyncTCP handler. A request that finds
+// one stale flags it and gets 503 with Retry-After; updateQSOExports()
+// rebuilds it from loop() and the retried request is served.
+
+#define QSO_EXPORT_RETRY_SECONDS "2"
+
+static volatile bool qsoIndexRebuildPending = false;    // Set by the web task
+static volatile bool masterADIFRebuildPending = false;  // Set by the web task
+static volatile bool cabrilloPending = false;           // Set by the web task
+static volatile bool cabrilloReady = false;             // Written by loop(), taken by one download
+
 /*
- * Get all QSO logs as JSON
- * Reads from SD card /qso/ directory
+ * Response telling the client to retry once the main loop has rebuilt
+ * what the request needs
  */
-String getQSOLogsJSON() {
+AsyncWebServerResponse* qsoExportRetryResponse(AsyncWebServerRequest* request) {
+  AsyncWebServerResponse* response = request->beginResponse(503, "application/json",
+      "{\"success\":false,\"pending\":true,\"error\":\"Rebuilding, try again shortly\"}");
+  response->addHeader("Retry-After", QSO_EXPORT_RETRY_SECONDS);
+  return response;
+}
+
+/*
+ * Whether the QSO index can be read now; if not, queue its rebuild.
+ * Without a card the handlers report the error themselves.
+ */
+bool qsoWebIndexReady() {
+  if (!sdCardAvailable || qsoIndexValid()) return true;
+  qsoIndexRebuildPending = true;
+  return false;
+}
+
+/*
+ * Whether the master ADIF file can be served now; if not, queue its rebuild
+ */
+bool masterADIFWebReady() {
+  if (!sdCardAvailable || masterADIFCurrent()) return true;
+  masterADIFRebuildPending = true;
+  return false;
+}
+
+/*
+ * Whether a freshly written Cabrillo file is waiting for this download.
+ * The contest keeps growing, so each file serves one download; otherwise
+ * queue a new one.
+ */
+bool cabrilloWebReady() {
+  if (!sdCardAvailable) return true;
+  if (cabrilloReady) {
+    cabrilloReady = false;
+    return true;
+  }
+  cabrilloPending = true;
+  return false;
+}
+
+/*
+ * Rebuild whatever web requests found stale. Call from loop().
+ */
+void updateQSOExports() {
+  // Clear before the work, so a request arriving meanwhile queues another pass.
+  // A running import rebuilds the index itself when it finishes.
+  if (qsoIndexRebuildPending && !qsoImportProgress.active) {
+    qsoIndexRebuildPending = false;
+    ensureQSOIndex();
+  }
+  if (masterADIFRebuildPending) {
+    masterADIFRebuildPending = false;
+    ensureMasterADIF();
+  }
+  if (cabrilloPending) {
+    cabrilloPending = false;
+    cabrilloReady = generateCabrilloFile();
+  }
+}
+
+#define QSO_PAGE_MAX 100  // Largest page served by /api/qsos?limit=
+
+/*
+ * Get one page of QSO logs as JSON via the QSO index (check
+ * qsoWebIndexReady() first)
+ * cursor is a previous page's "next_cursor" (the key of its last row), or
+ * empty to start at the oldest QSO (the newest with newest_first)
+ */
+String getQSOPageJSON(const QSOQueryFilter& filter, const String& cursorText, int limit, bool newestFirst) {
   JsonDocument doc;
   JsonArray logsArray = doc["logs"].to<JsonArray>();
 
-  int totalCount = 0;
-
-  // Check if SD card is available
-  if (!sdCardAvailable) {
+  if (!sdCardAvailable || !qsoIndexValid()) {
     doc["count"] = 0;
     doc["error"] = "SD card not available";
     String output;
@@ -140,230 +236,236 @@ String getQSOLogsJSON() {
     return output;
   }
 
-  // Iterate through all log files on SD card
-  File root = SD.open(QSO_DIR);
-  if (root && root.isDirectory()) {
-    File file = root.openNextFile();
-    while (file) {
-      if (!file.isDirectory()) {
-        String filename = String(file.name());
-
-        // Process QSO log files (JSON only, not ADIF)
-        if (filename.endsWith(".json")) {
-          JsonDocument logDoc;
-          DeserializationError error = deserializeJson(logDoc, file);
-
-          if (!error && logDoc.containsKey("logs")) {
-            JsonArray logs = logDoc["logs"];
-            for (JsonVariant v : logs) {
-              logsArray.add(v);
-              totalCount++;
-            }
-          }
-        }
-      }
-      file.close();
-      file = root.openNextFile();
+  if (limit < 1) limit = 1;
+  if (limit > QSO_PAGE_MAX) limit = QSO_PAGE_MAX;
+
+  // Start straight at the date range where the sort order allows it
+  uint32_t total = qsoIndexCount();
+  QSOIndexCursor first = QSO_CURSOR_FIRST, last = QSO_CURSOR_LAST;
+  QSOIndexCursor cursor = newestFirst ? last : first;
+  if (cursorText.length() > 0) {
+    if (!qsoIndexCursorParse(cursorText.c_str(), cursor)) {
+      doc["count"] = 0;
+      doc["error"] = "Bad cursor";
+      String output;
+      serializeJson(doc, output);
+      return output;
     }
-    root.close();
+  } else if (newestFirst && filter.toDate) {
+    cursor = {filter.toDate + 1, 0, 0};
+  } else if (!newestFirst && filter.fromDate) {
+    cursor = {filter.fromDate, 0, 0};
   }
 
-  doc["count"] = totalCount;
+  QSOIndexRecord recs[16];
+  int rows = 0;
+  while (rows < limit) {
+    int want = min(16, limit - rows);
+    int n = qsoIndexQuery(&filter, &cursor, newestFirst, recs, want);
+    if (n < 0) break;  // Index mid-update: the client retries from next_cursor
+    for (int i = 0; i < n; i++) {
+      char date[9];
+      qsoIndexDateString(recs[i], date);
+      QSO qso;
+      if (!readQSOAt(date, recs[i].offset, recs[i].id, &qso)) continue;
+      JsonObject obj = logsArray.add<JsonObject>();
+      qsoToJson(qso, obj);
+    }
+    rows += n;
+    if (n < want) break;  // End of index
+  }
+
+  doc["count"] = logsArray.size();
+  doc["total"] = total;
+  if (!qsoIndexCursorDone(cursor, newestFirst)) {
+    char next[32];
+    qsoIndexCursorFormat(cursor, next, sizeof(next));
+    doc["next_cursor"] = next;
+  }
 
   String output;
   serializeJson(doc, output);
   return output;
 }
 
-/*
- * Generate ADIF export
- * First tries to serve pre-generated master ADIF from SD card
- * Falls back to generating from JSON files if master doesn't exist
- */
-String generateADIF() {
-  // Check if SD card is available
-  if (!sdCardAvailable) {
-    return "ADIF Export from VAIL SUMMIT\nError: SD card not available\n<EOH>\n";
+// ============================================
+// Streaming QSO exports
+// ============================================
+//
+// /api/qsos (unpaged) and /api/export/csv walk the QSO index and serialize
+// one record at a time into whatever space the TCP window offers, so memory
+// use does not grow with the log. /api/export/adif sends the master ADIF
+// file straight from SD. Both answer 503 while the main loop rebuilds what
+// they read (see Export preparation above).
+
+#define QSO_STREAM_BATCH 16            // Index records read per refill
+#define QSO_STREAM_LINE_MAX 1024       // Largest serialized record
+
+enum QSOStreamFormat {
+  QSO_STREAM_JSON,
+  QSO_STREAM_CSV
+};
+
+struct QSOStreamState {
+  QSOStreamFormat format;
+  uint8_t stage;                        // 0 = header, 1 = records, 2 = footer, 3 = done
+  QSOIndexCursor cursor;                // Key of the last record read
+  uint32_t count;                       // Records emitted
+  QSOIndexRecord batch[QSO_STREAM_BATCH];
+  int batchLen;
+  int batchPos;
+  bool busy;                            // Index mid-update: try again later
+  char line[QSO_STREAM_LINE_MAX];
+  size_t lineLen;
+  size_t linePos;
+};
+
+static void qsoStreamCSVField(char* out, size_t size, size_t& len, const char* value, bool quoted) {
+  if (quoted && len < size - 1) out[len++] = '"';
+  for (const char* p = value; *p && len < size - 3; p++) {
+    if (quoted && *p == '"') out[len++] = '"';  // Escape quotes
+    out[len++] = *p;
   }
+  if (quoted && len < size - 1) out[len++] = '"';
+  out[len] = '\0';
+}
 
-  // Try to read pre-generated master ADIF file (faster)
-  if (SD.exists(MASTER_ADIF_FILE)) {
-    File adifFile = SD.open(MASTER_ADIF_FILE, "r");
-    if (adifFile) {
-      String content = adifFile.readString();
-      adifFile.close();
-      return content;
-    }
-  }
+static size_t qsoStreamFormatCSV(const QSO& qso, char* out, size_t size) {
+  size_t len = snprintf(out, size, "%s,%.3f,%s,%s,%s,%s,%s,%s,%s,%s,%s,%s,",
+                        qso.callsign, qso.frequency, qso.mode, qso.band, qso.date, qso.time_on,
+                        qso.rst_sent, qso.rst_rcvd, qso.gridsquare, qso.my_gridsquare,
+                        qso.my_pota_ref, qso.their_pota_ref);
+  if (len >= size) len = size - 1;
+  qsoStreamCSVField(out, size, len, qso.notes, true);
+  if (len < size - 1) out[len++] = '\n';
+  out[len] = '\0';
+  return len;
+}
+
+static size_t qsoStreamFormatJSON(const QSO& qso, bool first, char* out, size_t size) {
+  JsonDocument doc;
+  JsonObject obj = doc.to<JsonObject>();
+  qsoToJson(qso, obj);
+  size_t len = 0;
+  if (!first) out[len++] = ',';
+  len += serializeJson(doc, out + len, size - len);
+  return len;
+}
 
-  // Fall back to generating from JSON files
-  String adif = "ADIF Export from VAIL SUMMIT\n";
-  adif += "<PROGRAMID:11>VAIL SUMMIT\n";
-  adif += "<PROGRAMVERSION:" + String(strlen(FIRMWARE_VERSION)) + ">" + String(FIRMWARE_VERSION) + "\n";
-  adif += "<ADIF_VER:5>3.1.4\n";
-  adif += "<EOH>\n\n";
-
-  // Iterate through all log files on SD card
-  File root = SD.open(QSO_DIR);
-  if (root && root.isDirectory()) {
-    File file = root.openNextFile();
-    while (file) {
-      if (!file.isDirectory()) {
-        String filename = String(file.name());
-
-        // Only process JSON files
-        if (filename.endsWith(".json")) {
-          JsonDocument logDoc;
-          DeserializationError error = deserializeJson(logDoc, file);
-
-          if (!error && logDoc.containsKey("logs")) {
-            JsonArray logs = logDoc["logs"];
-            for (JsonVariant v : logs) {
-              JsonObject qso = v.as<JsonObject>();
-
-              // Required fields
-              if (qso.containsKey("callsign") && qso["callsign"].as<String>().length() > 0) {
-                String call = qso["callsign"].as<String>();
-                adif += "<CALL:" + String(call.length()) + ">" + call + " ";
-              }
-
-              if (qso.containsKey("frequency")) {
-                String freq = String(qso["frequency"].as<float>(), 3);
-                adif += "<FREQ:" + String(freq.length()) + ">" + freq + " ";
-              }
-
-              if (qso.containsKey("mode") && qso["mode"].as<String>().length() > 0) {
-                String mode = qso["mode"].as<String>();
-                adif += "<MODE:" + String(mode.length()) + ">" + mode + " ";
-              }
-
-              if (qso.containsKey("band") && qso["band"].as<String>().length() > 0) {
-                String band = qso["band"].as<String>();
-                adif += "<BAND:" + String(band.length()) + ">" + band + " ";
-              }
-
-              if (qso.containsKey("date") && qso["date"].as<String>().length() > 0) {
-                String date = qso["date"].as<String>();
-                adif += "<QSO_DATE:" + String(date.length()) + ">" + date + " ";
-              }
-
-              if (qso.containsKey("time_on") && qso["time_on"].as<String>().length() > 0) {
-                String time = qso["time_on"].as<String>();
-                // Convert HHMM to HHMMSS
-                if (time.length() == 4) {
-                  time += "00";
-                }
-                adif += "<TIME_ON:" + String(time.length()) + ">" + time + " ";
-              }
-
-              // Optional fields
-              if (qso.containsKey("rst_sent") && qso["rst_sent"].as<String>().length() > 0) {
-                String rst = qso["rst_sent"].as<String>();
-                adif += "<RST_SENT:" + String(rst.length()) + ">" + rst + " ";
-              }
-
-              if (qso.containsKey("rst_rcvd") && qso["rst_rcvd"].as<String>().length() > 0) {
-                String rst = qso["rst_rcvd"].as<String>();
-                adif += "<RST_RCVD:" + String(rst.length()) + ">" + rst + " ";
-              }
-
-              if (qso.containsKey("gridsquare") && qso["gridsquare"].as<String>().length() > 0) {
-                String grid = qso["gridsquare"].as<String>();
-                adif += "<GRIDSQUARE:" + String(grid.length()) + ">" + grid + " ";
-              }
-
-              if (qso.containsKey("my_gridsquare") && qso["my_gridsquare"].as<String>().length() > 0) {
-                String grid = qso["my_gridsquare"].as<String>();
-                adif += "<MY_GRIDSQUARE:" + String(grid.length()) + ">" + grid + " ";
-              }
-
-              // POTA support
-              if (qso.containsKey("my_pota_ref") && qso["my_pota_ref"].as<String>().length() > 0) {
-                String pota = qso["my_pota_ref"].as<String>();
-                adif += "<MY_SIG:4>POTA ";
-                adif += "<MY_SIG_INFO:" + String(pota.length()) + ">" + pota + " ";
-              }
-
-              if (qso.containsKey("their_pota_ref") && qso["their_pota_ref"].as<String>().length() > 0) {
-                String pota = qso["their_pota_ref"].as<String>();
-                adif += "<SIG:4>POTA ";
-                adif += "<SIG_INFO:" + String(pota.length()) + ">" + pota + " ";
-              }
-
-              adif += "<EOR>\n";
-            }
+/*
+ * Produce the next piece of output into state.line. Returns false at the
+ * end, or with state.busy set while the index is being updated.
+ */
+static bool qsoStreamNextLine(QSOStreamState& st) {
+  st.lineLen = 0;
+  st.linePos = 0;
+
+  while (st.lineLen == 0) {
+    switch (st.stage) {
+      case 0:
+        st.lineLen = strlcpy(st.line, st.format == QSO_STREAM_JSON ? "{\"logs\":[" :
+            "Callsign,Frequency,Mode,Band,Date,Time,RST Sent,RST Rcvd,Grid,My Grid,My POTA,Their POTA,Notes\n",
+            sizeof(st.line));
+        st.stage = 1;
+        break;
+
+      case 1: {
+        if (st.batchPos >= st.batchLen) {
+          st.batchLen = qsoIndexQuery(nullptr, &st.cursor, false, st.batch, QSO_STREAM_BATCH);
+          st.batchPos = 0;
+          if (st.batchLen < 0) {
+            st.batchLen = 0;
+            st.busy = true;
+            return false;
+          }
+          if (st.batchLen == 0) {
+            st.stage = 2;
+            break;
           }
         }
+        const QSOIndexRecord& rec = st.batch[st.batchPos++];
+        char date[9];
+        qsoIndexDateString(rec, date);
+        QSO qso;
+        if (!readQSOAt(date, rec.offset, rec.id, &qso)) break;
+        st.lineLen = st.format == QSO_STREAM_JSON
+            ? qsoStreamFormatJSON(qso, st.count == 0, st.line, sizeof(st.line))
+            : qsoStreamFormatCSV(qso, st.line, sizeof(st.line));
+        st.count++;
+        break;
       }
-      file.close();
-      file = root.openNextFile();
+
+      case 2:
+        if (st.format == QSO_STREAM_JSON) {
+          st.lineLen = snprintf(st.line, sizeof(st.line), "],\"count\":%u}", (unsigned)st.count);
+        }
+        st.stage = 3;
+        break;
+
+      default:
+        return false;
     }
-    root.close();
   }
-
-  return adif;
+  return true;
 }
 
 /*
- * Generate CSV export
- * Reads from SD card /qso/ directory
+ * Chunked response streaming every QSO as JSON ({"logs":[...],"count":N})
+ * or CSV (check qsoWebIndexReady() first). The state lives as long as the
+ * response.
  */
-String generateCSV() {
-  // Check if SD card is available
-  if (!sdCardAvailable) {
-    return "Error: SD card not available\n";
+AsyncWebServerResponse* beginQSOStreamResponse(AsyncWebServerRequest* request, QSOStreamFormat format) {
+  const char* contentType = format == QSO_STREAM_JSON ? "application/json" : "text/csv";
+
+  if (!sdCardAvailable || !qsoIndexValid()) {
+    return request->beginResponse(200, contentType, format == QSO_STREAM_JSON
+        ? "{\"logs\":[],\"count\":0,\"error\":\"SD card not available\"}"
+        : "Error: SD card not available\n");
   }
 
-  String csv = "Callsign,Frequency,Mode,Band,Date,Time,RST Sent,RST Rcvd,Grid,My Grid,My POTA,Their POTA,Notes\n";
-
-  // Iterate through all log files on SD card
-  File root = SD.open(QSO_DIR);
-  if (root && root.isDirectory()) {
-    File file = root.openNextFile();
-    while (file) {
-      if (!file.isDirectory()) {
-        String filename = String(file.name());
-
-        // Only process JSON files
-        if (filename.endsWith(".json")) {
-          JsonDocument logDoc;
-          DeserializationError error = deserializeJson(logDoc, file);
-
-          if (!error && logDoc.containsKey("logs")) {
-            JsonArray logs = logDoc["logs"];
-            for (JsonVariant v : logs) {
-              JsonObject qso = v.as<JsonObject>();
-
-              csv += qso["callsign"].as<String>() + ",";
-              csv += String(qso["frequency"].as<float>(), 3) + ",";
-              csv += qso["mode"].as<String>() + ",";
-              csv += qso["band"].as<String>() + ",";
-              csv += qso["date"].as<String>() + ",";
-              csv += qso["time_on"].as<String>() + ",";
-              csv += qso["rst_sent"].as<String>() + ",";
-              csv += qso["rst_rcvd"].as<String>() + ",";
-              csv += qso["gridsquare"].as<String>() + ",";
-              csv += qso["my_gridsquare"].as<String>() + ",";
-              csv += qso["my_pota_ref"].as<String>() + ",";
-              csv += qso["their_pota_ref"].as<String>() + ",";
-
-              // Escape quotes in notes
-              String notes = qso["notes"].as<String>();
-              notes.replace("\"", "\"\"");
-              csv += "\"" + notes + "\"";
-
-              csv += "\n";
-            }
-          }
-        }
-      }
-      file.close();
-      file = root.openNextFile();
+  std::shared_ptr<QSOStreamState> st(new QSOStreamState());
+  st->format = format;
+
+  return request->beginChunkedResponse(contentType, [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+    size_t written = 0;
+    while (written < maxLen) {
+      if (st->linePos >= st->lineLen && !qsoStreamNextLine(*st)) break;
+      size_t n = min(maxLen - written, st->lineLen - st->linePos);
+      memcpy(buffer + written, st->line + st->linePos, n);
+      st->linePos += n;
+      written += n;
+    }
+    if (st->busy) {
+      st->busy = false;
+      if (written == 0) return RESPONSE_TRY_AGAIN;  // Asked again on the next ack/poll
     }
-    root.close();
+    return written;  // 0 ends the response
+  });
+}
+
+/*
+ * ADIF export: the master ADIF file served directly from SD (check
+ * masterADIFWebReady() first, so an edit or delete that left it stale
+ * has been rebuilt)
+ */
+AsyncWebServerResponse* beginADIFExportResponse(AsyncWebServerRequest* request) {
+  if (!sdCardAvailable || !masterADIFCurrent()) {
+    return request->beginResponse(200, "application/x-adif",
+        "ADIF Export from VAIL SUMMIT\nError: SD card not available\n<EOH>\n");
   }
+  return request->beginResponse(SD, MASTER_ADIF_FILE, "application/x-adif");
+}
 
-  return csv;
+/*
+ * Cabrillo export of the current contest, served from the file the main
+ * loop wrote for it (check cabrilloWebReady() first)
+ */
+AsyncWebServerResponse* beginCabrilloExportResponse(AsyncWebServerRequest* request) {
+  if (!sdCardAvailable || !SD.exists(CONTEST_CABRILLO_FILE)) {
+    return request->beginResponse(200, "text/plain",
+        "START-OF-LOG: 3.0\nSOAPBOX: SD card not available\nEND-OF-LOG:\n");
+  }
+  return request->beginResponse(SD, CONTEST_CABRILLO_FILE, "text/plain");
 }
 
 #endif // WEB_SERVER_API_H
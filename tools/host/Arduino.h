@@ -0,0 +1,79 @@
+/*
+ * Host stand-in for the Arduino core, enough for the satellite headers the
+ * tools/ harnesses include (sat_xmtrs.h, atomic_file.h, json_stream.h).
+ * Not part of the firmware build.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+static size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+static inline unsigned long millis() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return (unsigned long)duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+static inline void delay(unsigned long) {}
+static inline bool psramFound() { return false; }
+static inline void* ps_malloc(size_t n) { return malloc(n); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) = 0;
+    size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t println(const char* s = "") { return print(s) + print("\n"); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (n < 0) return 0;
+        return write((const uint8_t*)buf, min((size_t)n, sizeof(buf) - 1));
+    }
+};
+
+// Serial goes to stderr, or nowhere when hostSerialQuiet is set
+static bool hostSerialQuiet = false;
+class HostSerial : public Print {
+public:
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        return hostSerialQuiet ? size : fwrite(buffer, 1, size, stderr);
+    }
+};
+static HostSerial Serial;
+
+// FreeRTOS: the harnesses are single-threaded
+typedef void* SemaphoreHandle_t;
+#define portMAX_DELAY 0xffffffffUL
+static inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return (SemaphoreHandle_t)1; }
+static inline int xSemaphoreTakeRecursive(SemaphoreHandle_t, unsigned long) { return 1; }
+static inline int xSemaphoreGiveRecursive(SemaphoreHandle_t) { return 1; }
+
+#endif // HOST_ARDUINO_H
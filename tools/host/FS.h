@@ -0,0 +1,119 @@
+/*
+ * Host stand-in for the ESP32 fs::FS / File API, backed by a directory on
+ * the host. Counts opens, seeks and bytes moved so a harness can report
+ * the storage traffic a routine would cost on the SD card.
+ * Not part of the firmware build.
+ */
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <Arduino.h>
+#include <sys/stat.h>
+#include <memory>
+#include <string>
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+struct HostIOStats {
+    unsigned long opens;
+    unsigned long seeks;
+    unsigned long reads;          // read calls
+    unsigned long writes;         // write calls
+    unsigned long long bytesRead;
+    unsigned long long bytesWritten;
+};
+
+static HostIOStats hostIO = {};
+
+class File : public Print {
+public:
+    File() {}
+    explicit File(FILE* f) : _f(f, fclose) {}
+
+    explicit operator bool() const { return (bool)_f; }
+    void close() { _f.reset(); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override {
+        if (!_f) return 0;
+        hostIO.writes++;
+        size_t n = fwrite(buffer, 1, size, _f.get());
+        hostIO.bytesWritten += n;
+        return n;
+    }
+    size_t read(uint8_t* buffer, size_t size) {
+        if (!_f) return 0;
+        hostIO.reads++;
+        size_t n = fread(buffer, 1, size, _f.get());
+        hostIO.bytesRead += n;
+        return n;
+    }
+    int read() {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+    bool seek(uint32_t pos) {
+        if (!_f) return false;
+        hostIO.seeks++;
+        return fseek(_f.get(), pos, SEEK_SET) == 0;
+    }
+    size_t position() const { return _f ? (size_t)ftell(_f.get()) : 0; }
+    size_t size() const {
+        if (!_f) return 0;
+        long at = ftell(_f.get());
+        fseek(_f.get(), 0, SEEK_END);
+        long end = ftell(_f.get());
+        fseek(_f.get(), at, SEEK_SET);
+        return (size_t)end;
+    }
+    int available() { return _f ? (int)(size() - position()) : 0; }
+    void flush() { if (_f) fflush(_f.get()); }
+    size_t readBytesUntil(char terminator, char* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length) {
+            int c = read();
+            if (c < 0 || c == terminator) break;
+            buffer[n++] = (char)c;
+        }
+        return n;
+    }
+
+private:
+    std::shared_ptr<FILE> _f;
+};
+
+class FS {
+public:
+    explicit FS(const char* root = "") : _root(root) {}
+    void setRoot(const std::string& root) { _root = root; }
+
+    File open(const char* path, const char* mode = FILE_READ) {
+        FILE* f = fopen(host(path).c_str(), mode[0] == 'w' ? "wb" : mode[0] == 'a' ? "ab" : "rb");
+        if (f) hostIO.opens++;
+        return f ? File(f) : File();
+    }
+    bool exists(const char* path) {
+        struct stat st;
+        return stat(host(path).c_str(), &st) == 0;
+    }
+    bool remove(const char* path) { return ::remove(host(path).c_str()) == 0; }
+    bool rename(const char* from, const char* to) {
+        return ::rename(host(from).c_str(), host(to).c_str()) == 0;
+    }
+    bool mkdir(const char* path) { return ::mkdir(host(path).c_str(), 0755) == 0; }
+
+private:
+    std::string host(const char* path) const { return _root + path; }
+    std::string _root;
+};
+
+} // namespace fs
+
+using fs::File;
+
+#endif // HOST_FS_H
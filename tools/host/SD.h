@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for the SD library (see FS.h). Not part of the firmware build.
+ */
+
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include <FS.h>
+
+static fs::FS SD;
+
+#endif // HOST_SD_H
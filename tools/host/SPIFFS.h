@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for SPIFFS (see FS.h). Not part of the firmware build.
+ */
+
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include <FS.h>
+
+static fs::FS SPIFFS;
+
+#endif // HOST_SPIFFS_H
@@ -0,0 +1,20 @@
+/*
+ * Host stand-in for the ESP32 ROM CRC32 (IEEE, little-endian, same
+ * pre/post inversion as esp_rom_crc32_le). Not part of the firmware build.
+ */
+
+#ifndef HOST_ESP_ROM_CRC_H
+#define HOST_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+static inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buf, uint32_t len) {
+    crc = ~crc;
+    while (len--) {
+        crc ^= *buf++;
+        for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+#endif // HOST_ESP_ROM_CRC_H
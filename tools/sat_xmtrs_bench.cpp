@@ -0,0 +1,337 @@
+/*
+ * Host-side check and benchmark for the file-backed transmitter table in
+ * src/satellites/sat_xmtrs.h.
+ *
+ * Streams a SatNOGS transmitter document through satXmtrParseByte() (the
+ * path the update job uses), sorts the spool with satSaveXmtrs() and checks
+ * the table against a std::stable_sort of the spool:
+ *
+ *   - filter: with the recorded stand-in (tools/satnogs_transmitters_sample.json,
+ *     SatNOGS DB schema, one object per line), the records kept and the
+ *     order within a satellite are compared against known answers
+ *   - sort: every record in place, ties in download order, no size caps
+ *   - lookups: satXmtrCountFor() / satXmtrFor() / satBestXmtr() for every
+ *     catalog bird and a few absent ones
+ *   - reload of the saved table and the one-time legacy text import
+ *
+ * Storage is a scratch directory standing in for the SD card; the report
+ * gives the opens, seeks and bytes each step moved, which is what costs
+ * time on the card.
+ *
+ * Build and run (Linux, from the repo root):
+ *
+ *   g++ -O2 -std=c++17 -Itools/host -o /tmp/sat_xmtrs_bench tools/sat_xmtrs_bench.cpp
+ *   /tmp/sat_xmtrs_bench tools/satnogs_transmitters_sample.json
+ *   /tmp/sat_xmtrs_bench --synthetic 20000 [satellites]
+ *
+ * The synthetic run builds a document of N wanted transmitters spread over
+ * the given number of satellites (default MAX_SATELLITES) in random order.
+ * A real dump (curl -o /tmp/xmtrs.json "<SAT_XMTR_URL>") also works as the
+ * input; the known-answer checks then only run on the stand-in.
+ *
+ * Exits 1 on any mismatch.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <Arduino.h>
+#include <SD.h>
+
+// ============================================
+// sat_data.h stand-in: the catalog and storage sat_xmtrs.h uses
+// ============================================
+
+#define SAT_DATA_H
+#define MAX_SATELLITES 160
+#define SAT_SD_DIR     "/satellites"
+
+struct SatEntry {
+    char name[25];
+    char line1[71];
+    char line2[71];
+    uint32_t norad;
+};
+
+struct SatCatalog {
+    SatEntry* sats;
+    int count;
+};
+
+static std::vector<SatEntry> benchSats;
+static SatCatalog satCatalog = {};
+
+static fs::FS* satTLEStorageFS() { return &SD; }
+
+#include "../src/satellites/sat_xmtrs.h"
+
+// ============================================
+// Harness
+// ============================================
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { failures++; printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\n"); } \
+} while (0)
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void setCatalog(const std::vector<uint32_t>& norads) {
+    benchSats.assign(norads.size(), SatEntry());
+    for (size_t i = 0; i < norads.size(); i++) {
+        memset(&benchSats[i], 0, sizeof(SatEntry));
+        snprintf(benchSats[i].name, sizeof(benchSats[i].name), "SAT %u", (unsigned)norads[i]);
+        benchSats[i].norad = norads[i];
+    }
+    satCatalog.sats = benchSats.data();
+    satCatalog.count = (int)benchSats.size();
+}
+
+static std::vector<SatTransmitter> readRecords(const char* path) {
+    std::vector<SatTransmitter> out;
+    File f = SD.open(path);
+    SatTransmitter x;
+    while (f && f.read((uint8_t*)&x, sizeof(x)) == sizeof(x)) out.push_back(x);
+    return out;
+}
+
+static bool sameRecord(const SatTransmitter& a, const SatTransmitter& b) {
+    return memcmp(&a, &b, sizeof(SatTransmitter)) == 0;
+}
+
+static void printIO(const char* what, double ms, const fs::HostIOStats& io) {
+    printf("  %-22s %9.2f ms  %7lu opens %8lu seeks %8lu reads %9llu B read %9llu B written\n",
+           what, ms, io.opens, io.seeks, io.reads, io.bytesRead, io.bytesWritten);
+}
+
+// Reference for satBestXmtr(): first with both links, else first with a
+// downlink, else the first
+static int referenceBest(const std::vector<SatTransmitter>& recs, size_t first, size_t end) {
+    for (size_t i = first; i < end; i++) if (recs[i].downHz && recs[i].upHz) return (int)i;
+    for (size_t i = first; i < end; i++) if (recs[i].downHz) return (int)i;
+    return first < end ? (int)first : -1;
+}
+
+/*
+ * Stream a document in, sort it, and check the table against the spool
+ */
+static void runDocument(const std::string& doc) {
+    printf("Document: %zu bytes, catalog of %d satellites\n", doc.size(), satCatalog.count);
+
+    fs::hostIO = {};
+    double t0 = nowMs();
+    satXmtrParseBegin();
+    for (char c : doc) satXmtrParseByte(c);
+    double t1 = nowMs();
+    printIO("parse + spool", t1 - t0, fs::hostIO);
+    printf("  %lu objects parsed, %d kept\n", (unsigned long)satXmtrSeen, satXmtrSpooled);
+    CHECK(satXp.json.done, "document did not close");
+
+    satXmtrSpool.flush();
+    std::vector<SatTransmitter> ref = readRecords(SAT_XMTR_SPOOL_FILE);
+    CHECK((int)ref.size() == satXmtrSpooled, "spool holds %zu records, %d counted", ref.size(), satXmtrSpooled);
+    std::stable_sort(ref.begin(), ref.end(),
+                     [](const SatTransmitter& a, const SatTransmitter& b) { return a.norad < b.norad; });
+
+    fs::hostIO = {};
+    t0 = nowMs();
+    bool saved = satSaveXmtrs();
+    t1 = nowMs();
+    printIO("sort into table", t1 - t0, fs::hostIO);
+    CHECK(saved || ref.empty(), "satSaveXmtrs failed");
+    CHECK(!SD.exists(SAT_XMTR_SPOOL_FILE) && !SD.exists(SAT_XMTR_SORT_FILE), "spool or scratch file left behind");
+    CHECK(satXmtrCount == (int)ref.size(), "table holds %d records, expected %zu", satXmtrCount, ref.size());
+
+    std::vector<SatTransmitter> table;
+    for (int i = 0; i < satXmtrCount; i++) {
+        const SatTransmitter* x = satXmtrAt(i);
+        if (!x) break;
+        table.push_back(*x);
+    }
+    bool same = table.size() == ref.size();
+    for (size_t i = 0; same && i < ref.size(); i++) same = sameRecord(table[i], ref[i]);
+    CHECK(same, "table differs from a stable sort of the spool");
+
+    // Lookups for every catalog bird, against the reference
+    fs::hostIO = {};
+    t0 = nowMs();
+    int lookups = 0, maxPerSat = 0;
+    for (int s = 0; s < satCatalog.count; s++) {
+        uint32_t norad = satCatalog.sats[s].norad;
+        size_t first = std::lower_bound(ref.begin(), ref.end(), norad,
+            [](const SatTransmitter& x, uint32_t n) { return x.norad < n; }) - ref.begin();
+        size_t end = first;
+        while (end < ref.size() && ref[end].norad == norad) end++;
+        maxPerSat = max(maxPerSat, (int)(end - first));
+
+        int n = satXmtrCountFor(norad);
+        CHECK(n == (int)(end - first), "norad %u: %d transmitters, expected %zu", (unsigned)norad, n, end - first);
+        for (size_t i = first; i < end; i++) {
+            const SatTransmitter* x = satXmtrFor(norad, (int)(i - first));
+            CHECK(x && sameRecord(*x, ref[i]), "norad %u: entry %zu differs", (unsigned)norad, i - first);
+        }
+        CHECK(satXmtrFor(norad, (int)(end - first)) == NULL, "norad %u: entry past the end", (unsigned)norad);
+        int best = referenceBest(ref, first, end);
+        const SatTransmitter* bx = satBestXmtr(norad);
+        CHECK(best < 0 ? bx == NULL : (bx && sameRecord(*bx, ref[best])), "norad %u: wrong best entry", (unsigned)norad);
+        lookups++;
+    }
+    t1 = nowMs();
+    printIO("lookups", t1 - t0, fs::hostIO);
+    if (lookups) {
+        printf("  %d satellites (up to %d transmitters each): %.1f seeks per satellite\n",
+               lookups, maxPerSat, (double)fs::hostIO.seeks / lookups);
+    }
+    CHECK(satXmtrCountFor(0) == 0 && satXmtrCountFor(0xFFFFFFFFu) == 0, "absent norad found");
+    CHECK(satBestXmtr(1) == NULL, "best entry for an absent norad");
+
+    // Reload from the file as a fresh boot would
+    satXmtrClose();
+    satXmtrsLoaded = false;
+    CHECK(satLoadXmtrsFromStorage() == !ref.empty(), "reload failed");
+    CHECK(satXmtrCount == (int)ref.size(), "reload holds %d records, expected %zu", satXmtrCount, ref.size());
+}
+
+// Known answers for tools/satnogs_transmitters_sample.json
+static void checkStandIn() {
+    CHECK(satXmtrCount == 20, "stand-in: %d kept, expected 20", satXmtrCount);
+
+    static const char* const iss[] = {
+        "Mode V/U FM Voice Repeater", "Mode V FM Voice (ARISS contacts)", "SSTV",
+        "Mode U/V FM Voice Repeater (cross band)",
+    };
+    CHECK(satXmtrCountFor(25544) == 4, "stand-in: ISS has %d, expected 4", satXmtrCountFor(25544));
+    for (int i = 0; i < 4; i++) {
+        const SatTransmitter* x = satXmtrFor(25544, i);
+        CHECK(x && strcmp(x->desc, iss[i]) == 0, "stand-in: ISS entry %d is \"%s\"", i, x ? x->desc : "(none)");
+    }
+    const SatTransmitter* x = satBestXmtr(25544);
+    CHECK(x && x->upHz == 145990000 && x->downHz == 437800000, "stand-in: wrong ISS best entry");
+
+    x = satBestXmtr(7530);
+    CHECK(x && x->invert && strcmp(x->mode, "USB") == 0 && x->downHz == 145975000, "stand-in: wrong AO-7 best entry");
+    x = satXmtrFor(7530, 2);
+    CHECK(x && strcmp(x->desc, "Mode B CW Beacon \"HI HI\"") == 0, "stand-in: escapes not kept");
+    x = satXmtrFor(27607, 1);
+    CHECK(x && strcmp(x->desc, "Downlink only ? test") == 0 && x->upHz == 0, "stand-in: \\u escape or null uplink");
+
+    CHECK(satXmtrCountFor(43017) == 1, "stand-in: AO-91 data/empty entries kept");
+    CHECK(satXmtrCountFor(53106) == 0, "stand-in: GMSK-only bird kept");
+    CHECK(satXmtrCountFor(33591) == 0, "stand-in: non-amateur bird kept");
+    CHECK(satXmtrCountFor(99901) == 0, "stand-in: bird outside the catalog kept");
+}
+
+// The text cache of older builds imports once and is removed
+static void checkLegacyImport() {
+    satXmtrClose();
+    atomicFileRemove(SD, SAT_XMTR_FILE);
+    File f = SD.open(SAT_XMTR_LEGACY_FILE, FILE_WRITE);
+    f.print("43017,145960000,435250000,0,FM,AO-91 repeater\r\n");
+    f.print("7530,145975000,432125000,1,USB,AO-7 mode B\n");
+    f.print("7530,0,0,0,GMSK,data\n");
+    f.print("garbage line\n");
+    f.print("7530,145975000,0,0,CW,AO-7 beacon\n");
+    f.close();
+
+    satXmtrsLoaded = false;
+    CHECK(satLoadXmtrsFromStorage(), "legacy import failed");
+    CHECK(satXmtrCount == 3, "legacy import kept %d, expected 3", satXmtrCount);
+    const SatTransmitter* x = satXmtrFor(7530, 1);
+    CHECK(x && strcmp(x->desc, "AO-7 beacon") == 0, "legacy import out of order");
+    x = satXmtrFor(43017, 0);
+    CHECK(x && strcmp(x->desc, "AO-91 repeater") == 0, "legacy import kept the CR");
+    CHECK(!SD.exists(SAT_XMTR_LEGACY_FILE), "legacy file not removed");
+}
+
+static std::string syntheticDocument(int n, int sats, std::vector<uint32_t>& norads) {
+    static const char* const modes[] = { "FM", "CW", "USB", "LSB", "FMN", "SSB" };
+    norads.clear();
+    for (int s = 0; s < sats; s++) norads.push_back(20000 + (uint32_t)s * 37);
+    srand(12345);
+    std::string doc = "[";
+    char obj[512], upText[16];
+    for (int i = 0; i < n; i++) {
+        uint32_t norad = norads[rand() % sats];
+        uint32_t down = 435000000u + (uint32_t)(rand() % 2000) * 1000u;
+        uint32_t up = (rand() % 3) ? 145800000u + (uint32_t)(rand() % 200) * 1000u : 0;
+        if (up) snprintf(upText, sizeof(upText), "%u", (unsigned)up);
+        else strlcpy(upText, "null", sizeof(upText));
+        snprintf(obj, sizeof(obj),
+                 "%s{\"uuid\":\"syn-%d\",\"description\":\"#%d\",\"alive\":true,\"type\":\"%s\","
+                 "\"uplink_low\":%s,\"downlink_low\":%u,\"mode\":\"%s\",\"invert\":%s,"
+                 "\"norad_cat_id\":%u,\"status\":\"active\",\"service\":\"Amateur\","
+                 "\"itu_notification\":{\"urls\":[\"x\"]}}",
+                 i ? ",\n" : "", i, i, up ? "Transceiver" : "Transmitter",
+                 upText, (unsigned)down, modes[rand() % 6],
+                 (rand() % 5) ? "false" : "true", (unsigned)norad);
+        doc += obj;
+    }
+    doc += "]\n";
+    return doc;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s transmitters.json | --synthetic N [satellites]\n", argv[0]);
+        return 2;
+    }
+
+    char root[] = "/tmp/sat_xmtrs_bench.XXXXXX";
+    if (!mkdtemp(root)) {
+        perror("mkdtemp");
+        return 2;
+    }
+    SD.setRoot(root);
+    SD.mkdir(SAT_SD_DIR);
+    SD.mkdir("/sat");
+    hostSerialQuiet = true;
+
+    std::string doc;
+    std::vector<uint32_t> norads;
+    bool standIn = false;
+    if (strcmp(argv[1], "--synthetic") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 20000;
+        int sats = argc > 3 ? atoi(argv[3]) : MAX_SATELLITES;
+        if (n < 0 || n > SAT_XMTR_FILE_MAX || sats < 1) {
+            fprintf(stderr, "N must be 0..%d, satellites at least 1\n", SAT_XMTR_FILE_MAX);
+            return 2;
+        }
+        doc = syntheticDocument(n, sats, norads);
+    } else {
+        FILE* f = fopen(argv[1], "rb");
+        if (!f) {
+            perror(argv[1]);
+            return 2;
+        }
+        char buf[4096];
+        size_t n;
+        while ((n = fread(buf, 1, sizeof(buf), f)) > 0) doc.append(buf, n);
+        fclose(f);
+        standIn = strstr(argv[1], "satnogs_transmitters_sample") != NULL;
+        // The amateur birds of the stand-in (and of the Celestrak amateur
+        // group); 99901 and the NOAA bird are left out on purpose
+        norads = { 25544, 27607, 43017, 7530, 24278, 44909, 22825, 53106, 43678, 42761, 40903 };
+    }
+    setCatalog(norads);
+
+    runDocument(doc);
+    if (standIn) checkStandIn();
+    checkLegacyImport();
+
+    satXmtrClose();
+    std::string cleanup = std::string("rm -rf ") + root;
+    if (system(cleanup.c_str()) != 0) fprintf(stderr, "could not remove %s\n", root);
+
+    printf(failures ? "%d check(s) FAILED\n" : "All checks passed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * Host-side SGP4 benchmark and accuracy check for src/satellites/sat_look.h.
+ *
+ * Runs the vendored propagator over a TLE file (the Celestrak amateur set
+ * the device downloads: SAT_TLE_URL_AMATEUR in src/satellites/sat_data.h)
+ * and compares satLookAngles() against the vendored double-precision path
+ * (Sgp4::findsat() / rv2azel()) as the reference:
+ *
+ *   - propagations per second: raw sgp4(), findsat(), satLookAngles()
+ *   - look-angle error: azimuth/elevation (deg), range (m), and the
+ *     resulting position error (m) of the satellite seen from the site
+ *   - AOS/LOS: every pass nextpass() finds in the window, re-timed with
+ *     satLookAngles() by bisection; reports the worst difference in seconds
+ *
+ * Build and run (Linux, from the repo root), once per precision:
+ *
+ *   g++ -O2 -std=c++17 -o /tmp/sgp4_bench tools/sgp4_bench.cpp
+ *   g++ -O2 -std=c++17 -DSAT_LOOK_FLOAT=0 -o /tmp/sgp4_bench_d tools/sgp4_bench.cpp
+ *   curl -o /tmp/amateur.txt "https://celestrak.org/NORAD/elements/gp.php?GROUP=amateur&FORMAT=tle"
+ *   /tmp/sgp4_bench /tmp/amateur.txt [lat lon [unix_start [hours]]]
+ *
+ * Exits 1 if any AOS/LOS moves by more than SAT_BENCH_MAX_AOS_ERR_S.
+ * Host timings only show relative cost; the ESP32-S3 emulates double in
+ * software, so the float build gains far more on the device than here.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+#include <vector>
+
+#if defined(__GLIBC__) && !__GLIBC_PREREQ(2, 38)
+// The vendored Sgp4::init() uses strlcpy(), which older glibc lacks
+static size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+#include "../src/satellites/sat_look.h"
+
+#define SAT_BENCH_MAX_AOS_ERR_S  2.0
+#define SAT_BENCH_STEP_S         60       // look-angle comparison grid
+#define SAT_BENCH_MIN_EL         0.0
+
+struct BenchTle {
+    char name[25];
+    char line1[130];
+    char line2[130];
+};
+
+static std::vector<BenchTle> loadTles(const char* path) {
+    std::vector<BenchTle> out;
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(2);
+    }
+    char line[160], name[160] = "";
+    BenchTle t = {};
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '1' && line[1] == ' ') {
+            strlcpy(t.line1, line, sizeof(t.line1));
+        } else if (line[0] == '2' && line[1] == ' ' && t.line1[0]) {
+            strlcpy(t.line2, line, sizeof(t.line2));
+            strlcpy(t.name, name, sizeof(t.name));
+            out.push_back(t);
+            t = {};
+            name[0] = '\0';
+        } else if (line[0]) {
+            strlcpy(name, line, sizeof(name));
+        }
+    }
+    fclose(f);
+    return out;
+}
+
+static double nowSeconds() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Satellite position relative to the site in south/east/zenith, km
+static void toSez(double azDeg, double elDeg, double rangeKm, double v[3]) {
+    double az = azDeg * M_PI / 180.0, el = elDeg * M_PI / 180.0;
+    v[0] = -rangeKm * cos(el) * cos(az);
+    v[1] = rangeKm * cos(el) * sin(az);
+    v[2] = rangeKm * sin(el);
+}
+
+// Horizon crossing between jdA and jdB (elevation changes sign), by bisection
+static double crossing(vsgp4::elsetrec& rec, const SatLookSite& site, double jdA, double jdB) {
+    SatLook look;
+    satLookAngles(rec, site, jdA, &look);
+    bool aboveA = look.el > SAT_BENCH_MIN_EL;
+    for (int i = 0; i < 40; i++) {
+        double mid = (jdA + jdB) / 2.0;
+        satLookAngles(rec, site, mid, &look);
+        if ((look.el > SAT_BENCH_MIN_EL) == aboveA) jdA = mid;
+        else jdB = mid;
+    }
+    return (jdA + jdB) / 2.0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s tles.txt [lat lon [unix_start [hours]]]\n", argv[0]);
+        return 2;
+    }
+    double lat = argc > 3 ? atof(argv[2]) : 39.74;
+    double lon = argc > 3 ? atof(argv[3]) : -104.99;
+    double startUnix = argc > 4 ? atof(argv[4]) : (double)time(nullptr);
+    double hours = argc > 5 ? atof(argv[5]) : 24.0;
+
+    std::vector<BenchTle> tles = loadTles(argv[1]);
+    printf("%zu TLEs, site %.3f %.3f, %.0f h from %.0f, look angles in %s\n",
+           tles.size(), lat, lon, hours, startUnix, SAT_LOOK_FLOAT ? "float" : "double");
+
+    SatLookSite site;
+    satLookSiteSet(&site, lat, lon, 0.1);
+    double jd0 = vsgp4::getJulianFromUnix(startUnix);
+    double jd1 = jd0 + hours / 24.0;
+    int steps = (int)(hours * 3600.0 / SAT_BENCH_STEP_S);
+
+    std::vector<vsgp4::Sgp4> preds(tles.size());
+    for (size_t i = 0; i < tles.size(); i++) {
+        BenchTle t = tles[i];   // twoline2rv() mutates its input
+        preds[i].init(t.name, t.line1, t.line2);
+        preds[i].site(lat, lon, 100.0);
+    }
+
+    // ---- Throughput ----
+    long n = 0;
+    double ro[3], vo[3], t0 = nowSeconds();
+    for (auto& p : preds) {
+        double tsince0 = (jd0 - p.satrec.jdsatepoch) * 1440.0;
+        for (int s = 0; s < steps; s++, n++) {
+            vsgp4::sgp4(vsgp4::wgs84, p.satrec, tsince0 + s * SAT_BENCH_STEP_S / 60.0, ro, vo);
+        }
+    }
+    double rawRate = n / (nowSeconds() - t0);
+
+    n = 0;
+    t0 = nowSeconds();
+    for (auto& p : preds) {
+        for (int s = 0; s < steps; s++, n++) p.findsat(jd0 + s * SAT_BENCH_STEP_S / 86400.0);
+    }
+    double findsatRate = n / (nowSeconds() - t0);
+
+    n = 0;
+    t0 = nowSeconds();
+    SatLook look;
+    for (auto& p : preds) {
+        for (int s = 0; s < steps; s++, n++) {
+            satLookAngles(p.satrec, site, jd0 + s * SAT_BENCH_STEP_S / 86400.0, &look);
+        }
+    }
+    double lookRate = n / (nowSeconds() - t0);
+
+    printf("\nPropagations per second\n");
+    printf("  sgp4() only          %12.0f\n", rawRate);
+    printf("  Sgp4::findsat()      %12.0f\n", findsatRate);
+    printf("  satLookAngles()      %12.0f\n", lookRate);
+
+    // ---- Look-angle error against findsat() ----
+    double maxAz = 0, maxEl = 0, maxRange = 0, maxPos = 0, sumPos = 0;
+    long visible = 0, failed = 0;
+    for (auto& p : preds) {
+        for (int s = 0; s < steps; s++) {
+            double jd = jd0 + s * SAT_BENCH_STEP_S / 86400.0;
+            p.findsat(jd);
+            if (!satLookAngles(p.satrec, site, jd, &look)) {
+                if (!isnan(p.satEl)) failed++;
+                continue;
+            }
+            if (p.satEl < SAT_BENCH_MIN_EL) continue;
+            visible++;
+            double dAz = fabs(look.az - p.satAz);
+            if (dAz > 180.0) dAz = 360.0 - dAz;
+            if (p.satEl < 89.0 && dAz > maxAz) maxAz = dAz;   // az is undefined at zenith
+            if (fabs(look.el - p.satEl) > maxEl) maxEl = fabs(look.el - p.satEl);
+            double dr = fabs(look.rangeKm - p.satDist) * 1000.0;
+            if (dr > maxRange) maxRange = dr;
+            double a[3], b[3];
+            toSez(look.az, look.el, look.rangeKm, a);
+            toSez(p.satAz, p.satEl, p.satDist, b);
+            double dp = sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) +
+                             (a[2] - b[2]) * (a[2] - b[2])) * 1000.0;
+            if (dp > maxPos) maxPos = dp;
+            sumPos += dp;
+        }
+    }
+    printf("\nLook angles vs findsat(), %ld samples above the horizon\n", visible);
+    printf("  azimuth   max %.5f deg\n", maxAz);
+    printf("  elevation max %.5f deg\n", maxEl);
+    printf("  range     max %.1f m\n", maxRange);
+    printf("  position  max %.1f m, mean %.1f m\n", maxPos, visible ? sumPos / visible : 0.0);
+    if (failed) printf("  %ld samples failed only in satLookAngles()\n", failed);
+
+    // ---- AOS/LOS against nextpass() ----
+    double maxAos = 0, maxLos = 0;
+    int passes = 0;
+    for (auto& p : preds) {
+        if (p.satrec.error != 0 || !p.initpredpoint(jd0, SAT_BENCH_MIN_EL)) continue;
+        vsgp4::passinfo pi;
+        double jump = 1.0 / p.revpday;
+        // Same stepping as satPassSearchRun(): two iterations per call, and
+        // un-hop the last orbit on a miss (see the notes there)
+        for (int calls = 0; calls < 2000 && p.getpredpoint() < jd1; calls++) {
+            double before = p.getpredpoint();
+            bool found = p.nextpass(&pi, 2, false, SAT_BENCH_MIN_EL);
+            double after = p.getpredpoint();
+            if (isnan(after) || after <= before) break;
+            if (!found) {
+                if (after - before >= 1.5 * jump) p.setpredpoint(after - jump);
+                continue;
+            }
+            if (isnan(pi.jdstart) || isnan(pi.jdstop) || pi.jdstop <= pi.jdstart) continue;
+            if (pi.jdstop < jd0 || pi.jdstart > jd1) continue;
+
+            // Bracket each crossing tightly: eccentric orbits can dip below
+            // the horizon and rise again within one nextpass() pass
+            double pad = fmin(30.0 / 86400.0, (pi.jdstop - pi.jdstart) / 2.0);
+            double aos = crossing(p.satrec, site, pi.jdstart - pad, pi.jdstart + pad);
+            double los = crossing(p.satrec, site, pi.jdstop - pad, pi.jdstop + pad);
+            double dAos = fabs(aos - pi.jdstart) * 86400.0;
+            double dLos = fabs(los - pi.jdstop) * 86400.0;
+            if (dAos > maxAos) maxAos = dAos;
+            if (dLos > maxLos) maxLos = dLos;
+            passes++;
+        }
+    }
+    printf("\nAOS/LOS vs nextpass(), %d passes\n", passes);
+    printf("  AOS max %.2f s\n", maxAos);
+    printf("  LOS max %.2f s\n", maxLos);
+
+    bool ok = maxAos <= SAT_BENCH_MAX_AOS_ERR_S && maxLos <= SAT_BENCH_MAX_AOS_ERR_S;
+    printf("\n%s (limit %.1f s)\n", ok ? "PASS" : "FAIL", SAT_BENCH_MAX_AOS_ERR_S);
+    return ok ? 0 : 1;
+}
@@ -116,6 +116,8 @@ using namespace lgfx::v1::fonts;
 #include "src/qso/qso_logger_view.h"
 #include "src/qso/qso_logger_statistics.h"
 #include "src/qso/qso_logger_settings.h"
+#include "src/qso/qso_logger_import.h"
+#include "src/qso/qso_logger_contest.h"
 
 // POTA Recorder (must come after QSO Logger for storage access)
 #include "src/pota/pota_recorder.h"
@@ -439,6 +441,7 @@ void setup() {
       delay(100);
 
       delay(1500);  // Show result message briefly
+      flushSDWriteQueue();
       ESP.restart();
     } else {
       Serial.println("No saved WiFi credentials - clearing flag and continuing");
@@ -446,6 +449,7 @@ void setup() {
       // Show error on screen
       earlyBootProgressCallback("No WiFi credentials saved!", 0, 0);
       delay(2000);
+      flushSDWriteQueue();
       ESP.restart();
     }
   }
@@ -482,6 +486,7 @@ void setup() {
   if (settingsMigrationPending()) {
     if (sdCardAvailable || initSDCard()) {
       dumpAllNvsToSD(NVS_PREMIGRATION_PATH);
+      sdQueueFlushPath(NVS_PREMIGRATION_PATH);  // must be on the card before migrating
     }
   }
   runSettingsMigrations();
@@ -923,6 +928,36 @@ void loop() {
   // Commit deferred NVS saves once values settle and audio is idle
   updateDeferredSaves();
 
+  // Group-commit queued SD writes (ADIF mirrors, library, backups) when audio is idle
+  updateSDWriteQueue();
+
+  // Store a web ADIF import's queued QSOs, then rebuild the index and ADIF files
+  updateADIFImport();
+
+  // Rebuild the QSO index / master ADIF / Cabrillo log for waiting web requests
+  updateQSOExports();
+
+  // Morse Notes searches and library requests queued by the web API
+  // (SD reads and library changes stay off AsyncTCP)
+  updateMorseNotesSearch();
+  updateMorseNotesLibrary();
+
+  // Stream an in-progress Morse Notes recording to its file (every pass,
+  // audio or not: the ring only holds a couple of minutes of keying)
+  mnRecordingUpdate();
+
+  // Morse Notes transcripts and search index, one small step at a time
+  if (deferredSavesAllowed() && !mnIsRecording() && !mnSessionIsActive()) {
+    mnTranscriptUpdate();
+  }
+
+  // Persist passes computed by the satellite pass worker once it goes quiet;
+  // precompile the satellite element sets after a TLE load or download
+  if (deferredSavesAllowed()) {
+    satPassCacheUpdate();
+    satElsetsUpdate();
+  }
+
   // Mirror changed settings to the SD backup (debounced; skipped during
   // audio-critical modes so an SD write never crunches active audio)
   if (!isModeAudioCritical((int)currentMode)) {